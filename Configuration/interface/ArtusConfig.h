@@ -66,6 +66,21 @@ public:
 
 	static NodeTypePair ParseProcessNode(std::string const& sInp);
 
+	/// leading processors of a pipeline, which are run only once for several pipelines
+	struct SharedProcessors
+	{
+		size_t firstPipeline; // index of the first pipeline with these processors
+		size_t nProcessors; // 0 if the processors are not shared
+	};
+
+	// Determine the shared processors of all pipelines (given in the order of the configuration),
+	// if the global setting ShareCommonPipelineProcessors is enabled. Level one pipelines can share
+	// their common leading processors, if their settings are identical apart from the lists of
+	// processors and consumers and the settings in the global map "SystematicShiftProcessors", e.g.
+	//     "SystematicShiftProcessors": {"JetEnergyCorrectionUncertaintyShift": ["producer:JetCorrectionsProducer"]}
+	// If one of these settings differs between the pipelines, they fork at the first processor reading it.
+	std::vector<SharedProcessors> FindSharedProcessors(std::vector<std::string> const& pipelineNames);
+
 private:
 
 	void InitConfig(bool configPreLoaded = false);
@@ -82,6 +97,10 @@ private:
 		LOG(DEBUG) << "Initialize global pipeline...";
 		
 		TGlobalSettings gSettings = GetSettings<TGlobalSettings>();
+
+		// the pipelines take over this flag with the global metadata
+		runner.GetGlobalMetadata().m_memoiseQuantities = gSettings.GetMemoiseQuantities();
+
 		std::vector<std::string> globalProds = gSettings.GetProcessors();
 		for (std::vector<std::string>::const_iterator it = globalProds.begin(); it != globalProds.end(); ++it)
 		{
@@ -130,13 +149,20 @@ private:
 		typedef typename TPipelineInitializer::setting_type setting_type;
 		typedef typename TPipelineInitializer::pipeline_type pipeline_type;
 
+		std::vector<std::string> pipelineNames;
 		BOOST_FOREACH(boost::property_tree::ptree::value_type& v, m_propTreeRoot.get_child("Pipelines"))
 		{
-			setting_type pset;
-
 			// the key name of the dictionary will also become the 
 			// pipeline name
-			std::string sKeyName = v.first.data();
+			pipelineNames.push_back(v.first.data());
+		}
+		std::vector<SharedProcessors> sharedProcessors = FindSharedProcessors(pipelineNames);
+		std::vector<pipeline_type*> sharedStages(pipelineNames.size(), nullptr);
+
+		for (size_t pipelineIndex = 0; pipelineIndex < pipelineNames.size(); ++pipelineIndex)
+		{
+			setting_type pset;
+			std::string const& sKeyName = pipelineNames[pipelineIndex];
 
 			// set up the Settings class access to the property tree
 			// in order to be able to load additional settings
@@ -147,39 +173,21 @@ private:
 
 			pipeline_type* pLine = new pipeline_type; //CreateDefaultPipeline();
 
-			// add local producer
-			std::vector<std::string> localProducers = pset.GetProcessors();
-			for (std::vector<std::string>::const_iterator it = localProducers.begin(); it != localProducers.end(); ++it)
+			// the shared processors are added to a stage, which is set up with the settings
+			// of the first pipeline and run once for all pipelines sharing these processors
+			SharedProcessors const& shared = sharedProcessors[pipelineIndex];
+			if ((shared.nProcessors > 0) && (shared.firstPipeline == pipelineIndex))
 			{
-					NodeTypePair ntype = ParseProcessNode(*it);
+				sharedStages[pipelineIndex] = new pipeline_type;
+				AddProcessors(*(sharedStages[pipelineIndex]), pset.GetProcessors().begin(),
+				              pset.GetProcessors().begin() + shared.nProcessors, factory);
+				sharedStages[pipelineIndex]->InitSharedStage(pset, runner.GetGlobalMetadata());
+				runner.AddSharedStage(sharedStages[pipelineIndex]);
+			}
 
-					if (ntype.first == ProcessNodeType::Producer)
-					{
-						ProducerBaseUntemplated* pProducer = factory.createProducer(ntype.second);
-
-						if (pProducer == nullptr)
-						{
-							 LOG(FATAL) << "Local Producer with id " << ntype.second << " not found!";
-						}
-						else
-						{
-							pLine->AddProducer(pProducer);
-						}
-					}
-					else if (ntype.first == ProcessNodeType::Filter)
-					{
-						FilterBaseUntemplated* pProducer = factory.createFilter(ntype.second);
-
-						if (pProducer == nullptr)
-						{
-							 LOG(FATAL) << "Local Filter with id " << ntype.second << " not found!";
-						}
-						else
-						{
-							pLine->AddFilter(pProducer);
-						}
-					}
-				}
+			// add local producer
+			std::vector<std::string> const& localProducers = pset.GetProcessors();
+			AddProcessors(*pLine, localProducers.begin() + shared.nProcessors, localProducers.end(), factory);
 
 			// add consumer
 			std::vector<std::string> localConsumers = pset.GetConsumers();
@@ -197,11 +205,61 @@ private:
 					}
 				}
 
-			pLine->InitPipeline(pset, runner.GetGlobalMetadata(), pInit);
+			if (shared.nProcessors > 0)
+			{
+				// the metadata of the stage contains e.g. the quantities registered by its producers
+				pipeline_type* sharedStage = sharedStages[shared.firstPipeline];
+				LOG(DEBUG) << "Pipeline \"" << sKeyName << "\" shares its first " << shared.nProcessors
+				           << " processors with pipeline \"" << pipelineNames[shared.firstPipeline] << "\".";
+				pLine->SetSharedStage(sharedStage);
+				pLine->InitPipeline(pset, sharedStage->GetMetadata(), pInit);
+			}
+			else
+			{
+				pLine->InitPipeline(pset, runner.GetGlobalMetadata(), pInit);
+			}
 			runner.AddPipeline(pLine);
 		}
 	}
 
+	// add the producers and filters of a pipeline
+	template<class TPipeline, class TFactory>
+	void AddProcessors(TPipeline& pipeline, std::vector<std::string>::const_iterator firstProcessor,
+	                   std::vector<std::string>::const_iterator lastProcessor, TFactory& factory)
+	{
+		for (std::vector<std::string>::const_iterator it = firstProcessor; it != lastProcessor; ++it)
+		{
+			NodeTypePair ntype = ParseProcessNode(*it);
+
+			if (ntype.first == ProcessNodeType::Producer)
+			{
+				ProducerBaseUntemplated* pProducer = factory.createProducer(ntype.second);
+
+				if (pProducer == nullptr)
+				{
+					LOG(FATAL) << "Local Producer with id " << ntype.second << " not found!";
+				}
+				else
+				{
+					pipeline.AddProducer(pProducer);
+				}
+			}
+			else if (ntype.first == ProcessNodeType::Filter)
+			{
+				FilterBaseUntemplated* pProducer = factory.createFilter(ntype.second);
+
+				if (pProducer == nullptr)
+				{
+					LOG(FATAL) << "Local Filter with id " << ntype.second << " not found!";
+				}
+				else
+				{
+					pipeline.AddFilter(pProducer);
+				}
+			}
+		}
+	}
+
 	std::string m_jsonConfigFileName;
 	std::string m_outputPath;
 	std::vector<std::string> m_fileNames;
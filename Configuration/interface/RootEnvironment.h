@@ -6,6 +6,7 @@
 #include <TFile.h>
 
 #include <string>
+#include <vector>
 
 
 class RootEnvironment {
@@ -14,10 +15,17 @@ public:
 	~RootEnvironment();
 	
 	inline TFile* GetRootFile() const { return m_rootFile; };
+
+	// temporary output file for a replica of the pipelines (see PipelineRunner::RunPipelinesParallel),
+	// whose results are merged into the output file before it is closed. Close removes these files.
+	TFile* CreateReplicaFile();
+
 	void Close();
 	
 private:
 	TFile* m_rootFile;
 	std::string m_rootFileName;
+	std::vector<TFile*> m_replicaFiles;
+	std::vector<std::string> m_replicaFileNames;
 };
 
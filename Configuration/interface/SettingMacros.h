@@ -1,10 +1,23 @@
 
 #pragma once
 
+#include <type_traits>
+
 #include "VarCache.h"
 #include "Artus/Utility/interface/Utility.h"
 
 
+/**
+   Return type of the accessors of single-valued settings: numbers, enums and pointers are
+   returned by value, all other types (e.g. strings) as const reference to the cached value
+*/
+template<class TYPE>
+struct SettingReturnType
+{
+	typedef typename std::conditional<std::is_scalar<TYPE>::value, TYPE, TYPE const&>::type type;
+};
+
+
 /**
    Implements a Setting with automatic read + caching from a Boost PropertyTree
    You can access the value via myObject.GetSNAME
@@ -25,9 +38,9 @@ public: \
 		} \
 	} \
 	mutable VarCache<TYPE> Cache##SNAME; \
-	TYPE Get##SNAME ( ) const { \
+	typename SettingReturnType<TYPE>::type Get##SNAME ( ) const { \
 		if (Cache##SNAME.IsCached()) { \
-			return Cache##SNAME.GetValue(); \
+			return Cache##SNAME.GetCachedValue(); \
 		} \
 		TYPE val = TYPE(); \
 		try { \
@@ -40,7 +53,7 @@ public: \
 			} \
 		} \
 		Cache##SNAME.SetCache( val ); \
-		return val; \
+		return Cache##SNAME.GetCachedValue(); \
 	}
 
 /**
@@ -64,9 +77,9 @@ public: \
 		} \
 	} \
 	mutable VarCache<TYPE> Cache##SNAME; \
-	TYPE Get##SNAME ( ) const { \
+	typename SettingReturnType<TYPE>::type Get##SNAME ( ) const { \
 		if (Cache##SNAME.IsCached()) { \
-			return Cache##SNAME.GetValue(); \
+			return Cache##SNAME.GetCachedValue(); \
 		} \
 		TYPE val; \
 		try { \
@@ -75,7 +88,7 @@ public: \
 		val = GetPropTree()->get< TYPE >( Key##SNAME (), DEFAULT_VAL ); \
 		} \
 		Cache##SNAME.SetCache( val ); \
-		return val; \
+		return Cache##SNAME.GetCachedValue(); \
 	}
 
 #define IMPL_SETTING(TYPE, SNAME) IMPL_SETTING_PRIVATE(TYPE, SNAME, false)
@@ -39,10 +39,17 @@ public:
 	IMPL_SETTING_DEFAULT(long long, FirstEvent, 0)
 	IMPL_SETTING_DEFAULT(long long, ProcessNEvents, -1) // -1 for no limit
 
+	/// number of threads processing the events, each additional thread runs its own replica of the
+	/// pipelines writing to a temporary output file (see PipelineRunner::RunPipelinesParallel)
+	IMPL_SETTING_DEFAULT(size_t, NThreads, 1)
+
 	IMPL_PROPERTY( std::string, Name )
 
 	IMPL_SETTING_DEFAULT( std::string , LogLevel, "unknown" )
 
+	/// measure the run times of all producers and filters (see RunTimeStatistics and RunTimeConsumer)
+	IMPL_SETTING_DEFAULT(bool, RunTimeMeasurement, false)
+
 	/// Input file names
 	IMPL_SETTING_STRINGLIST(InputFiles);
 
@@ -75,6 +82,17 @@ public:
 	// list of quantities needed for ntuple consumers
 	//IMPL_SETTING_STRINGLIST(Quantities);
 	IMPL_SETTING_SORTED_STRINGLIST(Quantities);
+	/// number of events collected by the ntuple consumers before the baskets are flushed
+	/// (TTree::SetAutoFlush, negative values are in bytes), 0 for the ROOT default
+	IMPL_SETTING_DEFAULT(long long, NtupleAutoFlush, 0)
+
+	/// evaluate every lambda quantity at most once per event and pipeline (see QuantityCache)
+	IMPL_SETTING_DEFAULT(bool, MemoiseQuantities, false)
+
+	/// run the leading processors, which several level one pipelines have in common, only once per event
+	/// (see ArtusConfig::FindSharedProcessors), the settings which only steer systematic shifts can be
+	/// given together with the processors reading them in the global map "SystematicShiftProcessors"
+	IMPL_SETTING_DEFAULT(bool, ShareCommonPipelineProcessors, false)
 
 	virtual std::vector<std::string> GetFilters () const;
 
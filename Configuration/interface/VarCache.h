@@ -2,6 +2,7 @@
 #pragma once
 
 #include <assert.h>
+#include <utility>
 
 /*
  * Convenience class to implement for an arbitrary type TData. This class is useful
@@ -19,7 +20,7 @@ public:
 	 * Sets the cached varible to a certain value.
 	 */
 	inline void SetCache(TData t) const {
-		m_val = t;
+		m_val = std::move(t);
 		m_isCached = true;
 	}
 
@@ -33,6 +34,13 @@ public:
 		return m_val;
 	}
 
+	/*
+	 * Returns the cached value without checking, to be used after IsCached()
+	 */
+	inline TData const& GetCachedValue() const {
+		return m_val;
+	}
+
 	/*
 	 * Returns true, if the value has already been cached
 	 */
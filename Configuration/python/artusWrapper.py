@@ -310,6 +310,9 @@ class ArtusWrapper(object):
 		if not self._args.n_events is None:
 			self._config["ProcessNEvents"] = self._args.n_events
 
+		if not self._args.n_threads is None:
+			self._config["NThreads"] = self._args.n_threads
+
 		# shrink Input Files to requested Number
 		self.removeUnwantedInputFiles()
 
@@ -452,6 +455,8 @@ class ArtusWrapper(object):
 		                                help="Limit number of input files or grid-control jobs. 3=files[0:3].")
 		self.configOptionsGroup.add_argument("-e", "--n-events", type=int,
 		                                help="Limit number of events to process.")
+		self.configOptionsGroup.add_argument("--n-threads", type=int,
+		                                help="Number of threads processing the events. [Default: taken from JSON config or 1]")
 		self.configOptionsGroup.add_argument("--gc-config", default="$CMSSW_BASE/src/Artus/Configuration/data/grid-control_base_config.conf",
 		                                help="Path to grid-control base config that is replace by the wrapper. [Default: %(default)s]")
 		self.configOptionsGroup.add_argument("--gc-config-includes", nargs="+",
@@ -1,6 +1,8 @@
 
 #include <iostream>
 #include <cstdlib>
+#include <algorithm>
+#include <map>
 
 #include <boost/program_options.hpp>
 #include <boost/algorithm/string/trim.hpp>
@@ -9,6 +11,7 @@
 
 #include "Artus/Configuration/interface/ArtusConfig.h"
 #include "Artus/Configuration/interface/PropertyTreeSupport.h"
+#include "Artus/Configuration/interface/SettingsBase.h"
 #include "Artus/Utility/interface/Utility.h"
 
 
@@ -196,3 +199,128 @@ ArtusConfig::NodeTypePair ArtusConfig::ParseProcessNode(std::string const& sInp)
 
 	return std::make_pair(ntype, splitted[1]);
 }
+
+std::vector<ArtusConfig::SharedProcessors> ArtusConfig::FindSharedProcessors(std::vector<std::string> const& pipelineNames)
+{
+	std::vector<SharedProcessors> sharedProcessors(pipelineNames.size());
+	for (size_t pipelineIndex = 0; pipelineIndex < pipelineNames.size(); ++pipelineIndex)
+	{
+		sharedProcessors[pipelineIndex].firstPipeline = pipelineIndex;
+		sharedProcessors[pipelineIndex].nProcessors = 0;
+	}
+
+	SettingsBase globalSettings;
+	globalSettings.SetPropTreePath("");
+	globalSettings.SetPropTree(&m_propTreeRoot);
+	if (! globalSettings.GetShareCommonPipelineProcessors())
+	{
+		return sharedProcessors;
+	}
+
+	std::map<std::string, std::vector<std::string> > systematicShiftProcessors;
+	if (m_propTreeRoot.get_child_optional("SystematicShiftProcessors"))
+	{
+		systematicShiftProcessors = PropertyTreeSupport::GetAsMapStringToListOfStrings(&m_propTreeRoot, "SystematicShiftProcessors");
+	}
+
+	// the settings of the pipelines without the ones, which may differ between pipelines sharing processors
+	std::vector<boost::property_tree::ptree> pipelineSettings;
+	std::vector<boost::property_tree::ptree> reducedPipelineSettings;
+	std::vector<std::vector<std::string> > processors;
+	std::vector<size_t> levels;
+	for (std::string const& pipelineName : pipelineNames)
+	{
+		SettingsBase pset(pipelineName);
+		pset.SetPropTreePath("Pipelines." + pipelineName);
+		pset.SetPropTree(&m_propTreeRoot);
+		processors.push_back(pset.GetProcessors());
+		levels.push_back(pset.GetLevel());
+
+		pipelineSettings.push_back(m_propTreeRoot.get_child("Pipelines." + pipelineName));
+		boost::property_tree::ptree reducedSettings = pipelineSettings.back();
+		reducedSettings.erase("Processors");
+		reducedSettings.erase("Consumers");
+		for (std::map<std::string, std::vector<std::string> >::const_iterator systematicShift = systematicShiftProcessors.begin();
+		     systematicShift != systematicShiftProcessors.end(); ++systematicShift)
+		{
+			reducedSettings.erase(systematicShift->first);
+		}
+		reducedPipelineSettings.push_back(reducedSettings);
+	}
+
+	// every pipeline joins the group of the first previous pipeline with the same reduced settings
+	for (size_t pipelineIndex = 0; pipelineIndex < pipelineNames.size(); ++pipelineIndex)
+	{
+		if (levels[pipelineIndex] != 1)
+		{
+			continue;
+		}
+		for (size_t firstPipeline = 0; firstPipeline < pipelineIndex; ++firstPipeline)
+		{
+			if ((levels[firstPipeline] == 1) && (sharedProcessors[firstPipeline].firstPipeline == firstPipeline) &&
+			    (reducedPipelineSettings[firstPipeline] == reducedPipelineSettings[pipelineIndex]))
+			{
+				sharedProcessors[pipelineIndex].firstPipeline = firstPipeline;
+				break;
+			}
+		}
+	}
+
+	for (size_t firstPipeline = 0; firstPipeline < pipelineNames.size(); ++firstPipeline)
+	{
+		if (sharedProcessors[firstPipeline].firstPipeline != firstPipeline)
+		{
+			continue;
+		}
+
+		// common leading processors of the group
+		std::vector<size_t> group;
+		size_t nProcessors = processors[firstPipeline].size();
+		for (size_t pipelineIndex = firstPipeline; pipelineIndex < pipelineNames.size(); ++pipelineIndex)
+		{
+			if (sharedProcessors[pipelineIndex].firstPipeline == firstPipeline)
+			{
+				group.push_back(pipelineIndex);
+				size_t nCommonProcessors = 0;
+				while ((nCommonProcessors < nProcessors) && (nCommonProcessors < processors[pipelineIndex].size()) &&
+				       (processors[pipelineIndex][nCommonProcessors] == processors[firstPipeline][nCommonProcessors]))
+				{
+					++nCommonProcessors;
+				}
+				nProcessors = nCommonProcessors;
+			}
+		}
+		if (group.size() < 2)
+		{
+			continue;
+		}
+
+		// fork at the first processor reading a systematic shift, which differs within the group
+		for (std::map<std::string, std::vector<std::string> >::const_iterator systematicShift = systematicShiftProcessors.begin();
+		     systematicShift != systematicShiftProcessors.end(); ++systematicShift)
+		{
+			boost::optional<boost::property_tree::ptree&> firstShift = pipelineSettings[firstPipeline].get_child_optional(systematicShift->first);
+			bool shiftDiffers = false;
+			for (size_t pipelineIndex : group)
+			{
+				boost::optional<boost::property_tree::ptree&> shift = pipelineSettings[pipelineIndex].get_child_optional(systematicShift->first);
+				shiftDiffers = shiftDiffers || (firstShift.is_initialized() != shift.is_initialized()) ||
+				               (firstShift.is_initialized() && (*firstShift != *shift));
+			}
+			if (shiftDiffers)
+			{
+				for (std::string const& processor : systematicShift->second)
+				{
+					nProcessors = std::find(processors[firstPipeline].begin(), processors[firstPipeline].begin() + nProcessors, processor) - processors[firstPipeline].begin();
+				}
+			}
+		}
+
+		for (size_t pipelineIndex : group)
+		{
+			sharedProcessors[pipelineIndex].nProcessors = nProcessors;
+		}
+	}
+
+	return sharedProcessors;
+}
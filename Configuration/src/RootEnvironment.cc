@@ -1,5 +1,6 @@
 
 #include <iostream>
+#include <cstdio>
 
 #include "Artus/Configuration/interface/RootEnvironment.h"
 
@@ -17,6 +18,13 @@ RootEnvironment::~RootEnvironment() {
 	Close();
 }
 
+TFile* RootEnvironment::CreateReplicaFile() {
+	m_replicaFileNames.push_back(m_rootFileName + ".replica" + std::to_string(m_replicaFileNames.size() + 1));
+	m_replicaFiles.push_back(new TFile(m_replicaFileNames.back().c_str(), "RECREATE"));
+	LOG(DEBUG) << "Temporary output file \"" << m_replicaFileNames.back() << "\" created.";
+	return m_replicaFiles.back();
+}
+
 void RootEnvironment::Close() {
 	if(m_rootFile) {
 		m_rootFile->Close();
@@ -24,4 +32,14 @@ void RootEnvironment::Close() {
 		delete m_rootFile;
 		m_rootFile = nullptr;
 	}
+
+	// the results of the replicas have been merged into the output file
+	for (size_t replica = 0; replica < m_replicaFiles.size(); ++replica) {
+		m_replicaFiles[replica]->Close();
+		delete m_replicaFiles[replica];
+		std::remove(m_replicaFileNames[replica].c_str());
+		LOG(DEBUG) << "Temporary output file \"" << m_replicaFileNames[replica] << "\" removed.";
+	}
+	m_replicaFiles.clear();
+	m_replicaFileNames.clear();
 }
@@ -27,12 +27,22 @@ public:
 
 	void ProcessEvent(event_type const& event, product_type const& product,
 	                  setting_type const& settings, metadata_type const& metadata,
-	                  FilterResult & result) override
+	                  FilterResult const& result) override
 	{
 		ConsumerBase<TTypes>::ProcessEvent(event, product, settings, metadata, result);
 		m_flow.AddFilterResult(result);
 	}
 
+	bool SupportsMerge() const override
+	{
+		return true;
+	}
+
+	void Merge(ConsumerBase<TTypes> const& replica, setting_type const& settings, metadata_type const& metadata) override
+	{
+		m_flow.Merge(static_cast<CutFlowConsumerBase<TTypes> const&>(replica).m_flow);
+	}
+
 	void Finish(setting_type const& settings, metadata_type const& metadata) override
 	{
 		// at this point, m_flow contains all the filter results of all events
@@ -45,7 +45,7 @@ public:
 
 	void ProcessEvent(event_type const& event, product_type const& product,
 	                  setting_type const& settings, metadata_type const& metadata,
-	                  FilterResult & filterResult) override
+	                  FilterResult const& filterResult) override
 	{
 		CutFlowConsumerBase<TTypes>::ProcessEvent(event, product, settings, metadata, filterResult);
 
@@ -65,13 +65,11 @@ public:
 		}
 
 		// fill bins of histograms corresponding to passed filters
-		FilterResult::FilterDecisions const& filterDecisions = filterResult.GetFilterDecisions();
-		for(FilterResult::FilterDecisions::const_iterator filterDecision = filterDecisions.begin();
-		    filterDecision != filterDecisions.end(); ++filterDecision)
+		for(size_t filterIndex = 0; filterIndex < filterResult.GetNumberOfFilters(); ++filterIndex)
 		{
 			++bin;
-			if (filterDecision->filterDecision == FilterResult::Decision::Passed ||
-			    filterDecision->taggingMode == FilterResult::TaggingMode::Tagging)
+			if (filterResult.GetFilterDecision(filterIndex) == FilterResult::Decision::Passed ||
+			    filterResult.GetTaggingMode(filterIndex) == FilterResult::TaggingMode::Tagging)
 			{
 				m_cutFlowUnweightedHist->Fill(static_cast<float>(bin));
 
@@ -82,6 +80,34 @@ public:
 		}
 	}
 
+	void Merge(ConsumerBase<TTypes> const& replica, setting_type const& settings, metadata_type const& metadata) override
+	{
+		CutFlowConsumerBase<TTypes>::Merge(replica, settings, metadata);
+
+		CutFlowHistogramConsumer<TTypes> const& specReplica = static_cast<CutFlowHistogramConsumer<TTypes> const&>(replica);
+		if (! specReplica.m_histogramsInitialised)
+		{
+			return;
+		}
+
+		if (m_histogramsInitialised)
+		{
+			m_cutFlowUnweightedHist->Add(specReplica.m_cutFlowUnweightedHist);
+			if(m_addWeightedCutFlow) {
+				m_cutFlowWeightedHist->Add(specReplica.m_cutFlowWeightedHist);
+			}
+		}
+		else
+		{
+			// this consumer has not seen any event, take over the histograms of the replica
+			m_cutFlowUnweightedHist = static_cast<TH1F*>(specReplica.m_cutFlowUnweightedHist->Clone());
+			if(m_addWeightedCutFlow) {
+				m_cutFlowWeightedHist = static_cast<TH1F*>(specReplica.m_cutFlowWeightedHist->Clone());
+			}
+			m_histogramsInitialised = true;
+		}
+	}
+
 	void Finish(setting_type const& settings, metadata_type const& metadata) override {
 		CutFlowConsumerBase<TTypes>::Finish(settings, metadata);
 		
@@ -109,7 +135,7 @@ private:
 	bool m_histogramsInitialised;
 
 	// initialise histograms; to be called in first event
-	bool InitialiseHistograms( setting_type const& settings, FilterResult & filterResult) {
+	bool InitialiseHistograms( setting_type const& settings, FilterResult const& filterResult) {
 
 		// filters
 		std::vector<std::string> filterNames = filterResult.GetFilterNames();
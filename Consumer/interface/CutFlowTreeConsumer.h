@@ -46,7 +46,7 @@ public:
 
 	void ProcessEvent(event_type const& event, product_type const& product,
 	                  setting_type const& settings, metadata_type const& metadata,
-	                  FilterResult & filterResult) override
+	                  FilterResult const& filterResult) override
 	{
 		CutFlowConsumerBase<TTypes>::ProcessEvent(event, product, settings, metadata, filterResult);
 		
@@ -60,18 +60,42 @@ public:
 		m_event = m_eventExtractor(event, product, settings);
 		
 		// fill tree corresponding to non-passed filters
-		size_t filterIndex = 0;
-		FilterResult::FilterDecisions const& filterDecisions = filterResult.GetFilterDecisions();
-		for(FilterResult::FilterDecisions::const_iterator filterDecision = filterDecisions.begin();
-		    filterDecision != filterDecisions.end(); ++filterDecision)
+		for(size_t filterIndex = 0; filterIndex < filterResult.GetNumberOfFilters(); ++filterIndex)
 		{
-			if ((filterDecision->filterDecision != FilterResult::Decision::Passed) &&
-			    (filterDecision->taggingMode == FilterResult::TaggingMode::Filtering)) {
+			if ((filterResult.GetFilterDecision(filterIndex) != FilterResult::Decision::Passed) &&
+			    (filterResult.GetTaggingMode(filterIndex) == FilterResult::TaggingMode::Filtering)) {
 				m_cutFlowTrees[filterIndex]->Fill();
 				break;
 			}
-			
-			++filterIndex;
+		}
+	}
+
+	void Merge(ConsumerBase<TTypes> const& replica, setting_type const& settings, metadata_type const& metadata) override
+	{
+		CutFlowConsumerBase<TTypes>::Merge(replica, settings, metadata);
+
+		CutFlowTreeConsumer<TTypes> const& specReplica = static_cast<CutFlowTreeConsumer<TTypes> const&>(replica);
+		if (! specReplica.m_treesInitialised)
+		{
+			return;
+		}
+
+		if (! m_treesInitialised)
+		{
+			// this consumer has not seen any event, take over the trees of the replica
+			TDirectory* tmpDirectory = gDirectory;
+			RootFileHelper::SafeCd(settings.GetRootOutFile(), settings.GetRootFileFolder());
+			for (TTree* replicaTree : specReplica.m_cutFlowTrees)
+			{
+				m_cutFlowTrees.push_back(replicaTree->CloneTree(0));
+			}
+			gDirectory = tmpDirectory;
+			m_treesInitialised = true;
+		}
+
+		for (size_t filterIndex = 0; filterIndex < m_cutFlowTrees.size(); ++filterIndex)
+		{
+			m_cutFlowTrees[filterIndex]->CopyEntries(specReplica.m_cutFlowTrees.at(filterIndex));
 		}
 	}
 
@@ -104,7 +128,7 @@ private:
 	uint64_t m_event;
 	
 	// initialise histograms; to be called in first event
-	bool InitialiseTrees(setting_type const& settings, FilterResult & filterResult) {
+	bool InitialiseTrees(setting_type const& settings, FilterResult const& filterResult) {
 
 		// filters
 		std::vector<std::string> filterNames = filterResult.GetFilterNames();
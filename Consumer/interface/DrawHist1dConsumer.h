@@ -52,6 +52,14 @@ public:
 		m_hist->Store(settings.GetRootOutFile());
 	}
 
+	bool SupportsMerge() const override {
+		return true;
+	}
+
+	void Merge(ConsumerBase<TTypes> const& replica, setting_type const& settings, metadata_type const& metadata) override {
+		m_hist->Add(*(static_cast<DrawHist1dConsumerBase<TTypes> const&>(replica).m_hist));
+	}
+
 	void ProcessFilteredEvent(event_type const& event, product_type const& product,
 			setting_type const& settings, metadata_type const& metadata) override {
 
@@ -26,6 +26,8 @@ public:
 
 	void Fill(double val, double weight);
 
+	void Add(Hist1D const& other);
+
 	int m_iBinCount;
 	double m_dBinLower;
 	double m_dBinUpper;
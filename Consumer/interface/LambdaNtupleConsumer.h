@@ -3,6 +3,10 @@
 
 #include <cstdint>
 #include <cassert>
+#include <map>
+#include <set>
+#include <string>
+#include <vector>
 
 #include <boost/algorithm/string/predicate.hpp>
 
@@ -15,6 +19,7 @@
 #include "Artus/Core/interface/ProductBase.h"
 #include "Artus/Configuration/interface/SettingsBase.h"
 #include "Artus/Core/interface/MetadataBase.h"
+#include "Artus/Core/interface/QuantityCache.h"
 
 #include "Artus/Core/interface/ConsumerBase.h"
 
@@ -55,261 +60,139 @@ public:
 	typedef std::function<std::vector<std::string>(event_type const&, product_type const&)> vString_extractor_lambda_spec;
 	typedef std::function<std::vector<int>(event_type const&, product_type const&)> vInt_extractor_lambda_spec;
 
-	static void AddBoolQuantity(metadata_type& metadata, std::string const& name, bool_extractor_lambda_spec valueExtractor)
+	// The extractors are stored in the metadata as they are, only wrapped into a single
+	// std::function taking the base types (the static_casts are for free). Passing a lambda
+	// instead of a *_extractor_lambda_spec therefore saves one indirect call per event.
+	// If MemoiseQuantities is enabled, the values are cached in the product (see QuantityCache),
+	// such that every quantity is evaluated at most once per event and pipeline, even if it is
+	// needed by several consumers or producers. This only pays off for quantities which are expensive
+	// to compute. Producers reading quantities after modifying the product have to invalidate the cache.
+	template<class TExtractor>
+	static void AddBoolQuantity(metadata_type& metadata, std::string const& name, TExtractor valueExtractor)
 	{
-		metadata.m_commonBoolQuantities[name] = [valueExtractor](EventBase const& event, ProductBase const& product) -> bool
-		{
-			event_type const& specEvent = static_cast<event_type const&>(event);
-			product_type const& specProduct = static_cast<product_type const&>(product);
-			return valueExtractor(specEvent, specProduct);
-		};
+		metadata.m_commonBoolQuantities[name] = WrapValueExtractor<bool>(name, valueExtractor, metadata.m_memoiseQuantities);
 	}
-	static void AddIntQuantity(metadata_type& metadata, std::string const& name, int_extractor_lambda_spec valueExtractor)
+	template<class TExtractor>
+	static void AddIntQuantity(metadata_type& metadata, std::string const& name, TExtractor valueExtractor)
 	{
-		metadata.m_commonIntQuantities[name] = [valueExtractor](EventBase const& event, ProductBase const& product) -> int
-		{
-			event_type const& specEvent = static_cast<event_type const&>(event);
-			product_type const& specProduct = static_cast<product_type const&>(product);
-			return valueExtractor(specEvent, specProduct);
-		};
+		metadata.m_commonIntQuantities[name] = WrapValueExtractor<int>(name, valueExtractor, metadata.m_memoiseQuantities);
 	}
-	static void AddUInt64Quantity(metadata_type& metadata, std::string const& name, uint64_extractor_lambda_spec valueExtractor)
+	template<class TExtractor>
+	static void AddUInt64Quantity(metadata_type& metadata, std::string const& name, TExtractor valueExtractor)
 	{
-		metadata.m_commonUInt64Quantities[name] = [valueExtractor](EventBase const& event, ProductBase const& product) -> uint64_t
-		{
-			event_type const& specEvent = static_cast<event_type const&>(event);
-			product_type const& specProduct = static_cast<product_type const&>(product);
-			return valueExtractor(specEvent, specProduct);
-		};
+		metadata.m_commonUInt64Quantities[name] = WrapValueExtractor<uint64_t>(name, valueExtractor, metadata.m_memoiseQuantities);
 	}
-	static void AddFloatQuantity(metadata_type& metadata, std::string const& name, float_extractor_lambda_spec valueExtractor)
+	template<class TExtractor>
+	static void AddFloatQuantity(metadata_type& metadata, std::string const& name, TExtractor valueExtractor)
 	{
-		metadata.m_commonFloatQuantities[name] = [valueExtractor](EventBase const& event, ProductBase const& product) -> float
-		{
-			event_type const& specEvent = static_cast<event_type const&>(event);
-			product_type const& specProduct = static_cast<product_type const&>(product);
-			return valueExtractor(specEvent, specProduct);
-		};
+		metadata.m_commonFloatQuantities[name] = WrapValueExtractor<float>(name, valueExtractor, metadata.m_memoiseQuantities);
 	}
-	static void AddDoubleQuantity(metadata_type& metadata, std::string const& name, double_extractor_lambda_spec valueExtractor)
+	template<class TExtractor>
+	static void AddDoubleQuantity(metadata_type& metadata, std::string const& name, TExtractor valueExtractor)
 	{
-		metadata.m_commonDoubleQuantities[name] = [valueExtractor](EventBase const& event, ProductBase const& product) -> double
-		{
-			event_type const& specEvent = static_cast<event_type const&>(event);
-			product_type const& specProduct = static_cast<product_type const&>(product);
-			return valueExtractor(specEvent, specProduct);
-		};
+		metadata.m_commonDoubleQuantities[name] = WrapValueExtractor<double>(name, valueExtractor, metadata.m_memoiseQuantities);
 	}
-	static void AddPtEtaPhiMVectorQuantity(metadata_type& metadata, std::string const& name, ptEtaPhiMVector_extractor_lambda_spec valueExtractor)
+	template<class TExtractor>
+	static void AddPtEtaPhiMVectorQuantity(metadata_type& metadata, std::string const& name, TExtractor valueExtractor)
 	{
-		metadata.m_commonPtEtaPhiMVectorQuantities[name] = [valueExtractor](EventBase const& event, ProductBase const& product) -> ROOT::Math::PtEtaPhiMVector
-		{
-			event_type const& specEvent = static_cast<event_type const&>(event);
-			product_type const& specProduct = static_cast<product_type const&>(product);
-			return valueExtractor(specEvent, specProduct);
-		};
+		metadata.m_commonPtEtaPhiMVectorQuantities[name] = WrapValueExtractor<ROOT::Math::PtEtaPhiMVector>(name, valueExtractor, metadata.m_memoiseQuantities);
 	}
-	static void AddRMFLVQuantity(metadata_type& metadata, std::string const& name, rmflv_extractor_lambda_spec valueExtractor)
+	template<class TExtractor>
+	static void AddRMFLVQuantity(metadata_type& metadata, std::string const& name, TExtractor valueExtractor)
 	{
-		metadata.m_commonRMFLVQuantities[name] = [valueExtractor](EventBase const& event, ProductBase const& product) -> RMFLV
-		{
-			event_type const& specEvent = static_cast<event_type const&>(event);
-			product_type const& specProduct = static_cast<product_type const&>(product);
-			return valueExtractor(specEvent, specProduct);
-		};
+		metadata.m_commonRMFLVQuantities[name] = WrapValueExtractor<RMFLV>(name, valueExtractor, metadata.m_memoiseQuantities);
 	}
-	static void AddCartesianRMFLVQuantity(metadata_type& metadata, std::string const& name, cartesianRMFLV_extractor_lambda_spec valueExtractor)
+	template<class TExtractor>
+	static void AddCartesianRMFLVQuantity(metadata_type& metadata, std::string const& name, TExtractor valueExtractor)
 	{
-		metadata.m_commonCartesianRMFLVQuantities[name] = [valueExtractor](EventBase const& event, ProductBase const& product) -> CartesianRMFLV
-		{
-			event_type const& specEvent = static_cast<event_type const&>(event);
-			product_type const& specProduct = static_cast<product_type const&>(product);
-			return valueExtractor(specEvent, specProduct);
-		};
+		metadata.m_commonCartesianRMFLVQuantities[name] = WrapValueExtractor<CartesianRMFLV>(name, valueExtractor, metadata.m_memoiseQuantities);
 	}
-	static void AddStringQuantity(metadata_type& metadata, std::string const& name, string_extractor_lambda_spec valueExtractor)
+	template<class TExtractor>
+	static void AddStringQuantity(metadata_type& metadata, std::string const& name, TExtractor valueExtractor)
 	{
-		metadata.m_commonStringQuantities[name] = [valueExtractor](EventBase const& event, ProductBase const& product) -> std::string
-		{
-			event_type const& specEvent = static_cast<event_type const&>(event);
-			product_type const& specProduct = static_cast<product_type const&>(product);
-			return valueExtractor(specEvent, specProduct);
-		};
+		metadata.m_commonStringQuantities[name] = WrapValueExtractor<std::string>(name, valueExtractor, metadata.m_memoiseQuantities);
 	}
-	static void AddVDoubleQuantity(metadata_type& metadata, std::string const& name, vDouble_extractor_lambda_spec valueExtractor)
+	template<class TExtractor>
+	static void AddVDoubleQuantity(metadata_type& metadata, std::string const& name, TExtractor valueExtractor)
 	{
-		metadata.m_commonVDoubleQuantities[name] = [valueExtractor](EventBase const& event, ProductBase const& product) -> std::vector<double>
-		{
-			event_type const& specEvent = static_cast<event_type const&>(event);
-			product_type const& specProduct = static_cast<product_type const&>(product);
-			return valueExtractor(specEvent, specProduct);
-		};
+		metadata.m_commonVDoubleQuantities[name] = WrapValueExtractor<std::vector<double> >(name, valueExtractor, metadata.m_memoiseQuantities);
 	}
-	static void AddVFloatQuantity(metadata_type& metadata, std::string const& name, vFloat_extractor_lambda_spec valueExtractor)
+	template<class TExtractor>
+	static void AddVFloatQuantity(metadata_type& metadata, std::string const& name, TExtractor valueExtractor)
 	{
-		metadata.m_commonVFloatQuantities[name] = [valueExtractor](EventBase const& event, ProductBase const& product) -> std::vector<float>
-		{
-			event_type const& specEvent = static_cast<event_type const&>(event);
-			product_type const& specProduct = static_cast<product_type const&>(product);
-			return valueExtractor(specEvent, specProduct);
-		};
+		metadata.m_commonVFloatQuantities[name] = WrapValueExtractor<std::vector<float> >(name, valueExtractor, metadata.m_memoiseQuantities);
 	}
-	static void AddVRMFLVQuantity(metadata_type& metadata, std::string const& name, vRMFLV_extractor_lambda_spec valueExtractor)
+	template<class TExtractor>
+	static void AddVRMFLVQuantity(metadata_type& metadata, std::string const& name, TExtractor valueExtractor)
 	{
-		metadata.m_commonVRMFLVQuantities[name] = [valueExtractor](EventBase const& event, ProductBase const& product) -> std::vector<RMFLV>
-		{
-			event_type const& specEvent = static_cast<event_type const&>(event);
-			product_type const& specProduct = static_cast<product_type const&>(product);
-			return valueExtractor(specEvent, specProduct);
-		};
+		metadata.m_commonVRMFLVQuantities[name] = WrapValueExtractor<std::vector<RMFLV> >(name, valueExtractor, metadata.m_memoiseQuantities);
 	}
-	static void AddVStringQuantity(metadata_type& metadata, std::string const& name, vString_extractor_lambda_spec valueExtractor)
+	template<class TExtractor>
+	static void AddVStringQuantity(metadata_type& metadata, std::string const& name, TExtractor valueExtractor)
 	{
-		metadata.m_commonVStringQuantities[name] = [valueExtractor](EventBase const& event, ProductBase const& product) -> std::vector<std::string>
-		{
-			event_type const& specEvent = static_cast<event_type const&>(event);
-			product_type const& specProduct = static_cast<product_type const&>(product);
-			return valueExtractor(specEvent, specProduct);
-		};
+		metadata.m_commonVStringQuantities[name] = WrapValueExtractor<std::vector<std::string> >(name, valueExtractor, metadata.m_memoiseQuantities);
 	}
-	static void AddVIntQuantity(metadata_type& metadata, std::string const& name, vInt_extractor_lambda_spec valueExtractor)
+	template<class TExtractor>
+	static void AddVIntQuantity(metadata_type& metadata, std::string const& name, TExtractor valueExtractor)
 	{
-		metadata.m_commonVIntQuantities[name] = [valueExtractor](EventBase const& event, ProductBase const& product) -> std::vector<int>
-		{
-			event_type const& specEvent = static_cast<event_type const&>(event);
-			product_type const& specProduct = static_cast<product_type const&>(product);
-			return valueExtractor(specEvent, specProduct);
-		};
+		metadata.m_commonVIntQuantities[name] = WrapValueExtractor<std::vector<int> >(name, valueExtractor, metadata.m_memoiseQuantities);
+	}
+
+	// Declare the event members read by a quantity (see ProcessNodeBase::GetRequiredEventMembers).
+	// Quantities only computed from the product need no declaration.
+	static void SetEventMembersOfQuantity(metadata_type& metadata, std::string const& name, std::vector<std::string> const& eventMembers)
+	{
+		metadata.m_eventMembersOfQuantities[name] = eventMembers;
 	}
 
 	void Init(setting_type const& settings, metadata_type& metadata) override {
 		ConsumerBase<TTypes>::Init(settings, metadata);
 
-		// construct value extractors
-		m_boolValueExtractors.clear();
-		m_floatValueExtractors.clear();
-		m_intValueExtractors.clear();
-		m_uint64ValueExtractors.clear();
-		m_doubleValueExtractors.clear();
-		m_ptEtaPhiMVectorValueExtractors.clear();
-		m_rmflvValueExtractors.clear();
-		m_cartesianRMFLVValueExtractors.clear();
-		m_stringValueExtractors.clear();
-		m_vDoubleValueExtractors.clear();
-		m_vFloatValueExtractors.clear();
-		m_vRMFLVValueExtractors.clear();
-		m_vStringValueExtractors.clear();
-		m_vIntValueExtractors.clear();
-		
-		m_boolQuantities.clear();
-		m_intQuantities.clear();
-		m_uint64Quantities.clear();
-		m_floatQuantities.clear();
-		m_doubleQuantities.clear();
-		m_ptEtaPhiMVectorQuantities.clear();
-		m_rmflvQuantities.clear();
-		m_cartesianRMFLVQuantities.clear();
-		m_stringQuantities.clear();
-		m_vDoubleQuantities.clear();
-		m_vFloatQuantities.clear();
-		m_vRMFLVQuantities.clear();
-		m_vStringQuantities.clear();
-		m_vIntQuantities.clear();
-		
-		size_t quantityIndex = 0;
+		// compile the list of quantities into one column per type, such that the values can be
+		// filled without any lookup; m_branches remembers the order of the quantities for the branches
+		m_branches.clear();
+		m_requiredEventMembers.clear();
+		m_boolColumn.Clear();
+		m_intColumn.Clear();
+		m_uint64Column.Clear();
+		m_floatColumn.Clear();
+		m_doubleColumn.Clear();
+		m_ptEtaPhiMVectorColumn.Clear();
+		m_rmflvColumn.Clear();
+		m_cartesianRMFLVColumn.Clear();
+		m_stringColumn.Clear();
+		m_vDoubleColumn.Clear();
+		m_vFloatColumn.Clear();
+		m_vRMFLVColumn.Clear();
+		m_vStringColumn.Clear();
+		m_vIntColumn.Clear();
+
 		for (std::vector<std::string>::iterator quantity = settings.GetQuantities().begin();
 		     quantity != settings.GetQuantities().end(); ++quantity)
 		{
-			if (metadata.m_commonFloatQuantities.count(*quantity) > 0)
-			{
-				//LOG(DEBUG) << "Init float quantity: " <<  << *quantity << " (index " << m_floatValueExtractors.size() << ")");
-				m_floatValueExtractors.push_back(SafeMap::Get(metadata.m_commonFloatQuantities, *quantity));
-				m_floatQuantities.push_back(*quantity);
-			}
-			else if (metadata.m_commonIntQuantities.count(*quantity) > 0)
-			{
-				//LOG(DEBUG) << "Init int quantity: " <<  << *quantity << " (index " << m_floatValueExtractors.size() << ")");
-				m_intValueExtractors.push_back(SafeMap::Get(metadata.m_commonIntQuantities, *quantity));
-				m_intQuantities.push_back(*quantity);
-			}
-			else if (metadata.m_commonUInt64Quantities.count(*quantity) > 0)
-			{
-				//LOG(DEBUG) << "Init uint64 quantity: " <<  << *quantity << " (index " << m_floatValueExtractors.size() << ")");
-				m_uint64ValueExtractors.push_back(SafeMap::Get(metadata.m_commonUInt64Quantities, *quantity));
-				m_uint64Quantities.push_back(*quantity);
-			}
-			else if (metadata.m_commonDoubleQuantities.count(*quantity) > 0)
-			{
-				//LOG(DEBUG) << "Init double quantity: " <<  << *quantity << " (index " << m_floatValueExtractors.size() << ")");
-				m_doubleValueExtractors.push_back(SafeMap::Get(metadata.m_commonDoubleQuantities, *quantity));
-				m_doubleQuantities.push_back(*quantity);
-			}
-			else if (metadata.m_commonVDoubleQuantities.count(*quantity) > 0)
-			{
-				//LOG(DEBUG) << "Init vDouble quantity: " <<  << *quantity << " (index " << m_floatValueExtractors.size() << ")");
-				m_vDoubleValueExtractors.push_back(SafeMap::Get(metadata.m_commonVDoubleQuantities, *quantity));
-				m_vDoubleQuantities.push_back(*quantity);
-			}
-			else if (metadata.m_commonVFloatQuantities.count(*quantity) > 0)
-			{
-				//LOG(DEBUG) << "Init vFloat quantity: " <<  << *quantity << " (index " << m_floatValueExtractors.size() << ")");
-				m_vFloatValueExtractors.push_back(SafeMap::Get(metadata.m_commonVFloatQuantities, *quantity));
-				m_vFloatQuantities.push_back(*quantity);
-			}
-			else if (metadata.m_commonBoolQuantities.count(*quantity) > 0)
-			{
-				//LOG(DEBUG) << "Init bool quantity: " <<  << *quantity << " (index " << m_floatValueExtractors.size() << ")");
-				m_boolValueExtractors.push_back(SafeMap::Get(metadata.m_commonBoolQuantities, *quantity));
-				m_boolQuantities.push_back(*quantity);
-			}
-			else if (metadata.m_commonVIntQuantities.count(*quantity) > 0)
-			{
-				//LOG(DEBUG) << "Init vBool quantity: " <<  << *quantity << " (index " << m_floatValueExtractors.size() << ")");
-				m_vIntValueExtractors.push_back(SafeMap::Get(metadata.m_commonVIntQuantities, *quantity));
-				m_vIntQuantities.push_back(*quantity);
-			}
-			else if (metadata.m_commonPtEtaPhiMVectorQuantities.count(*quantity) > 0)
-			{
-				//LOG(DEBUG) << "Init ROOT::Math::PtEtaPhiMVector quantity: " <<  << *quantity << " (index " << m_floatValueExtractors.size() << ")");
-				m_ptEtaPhiMVectorValueExtractors.push_back(SafeMap::Get(metadata.m_commonPtEtaPhiMVectorQuantities, *quantity));
-				m_ptEtaPhiMVectorQuantities.push_back(*quantity);
-			}
-			else if (metadata.m_commonRMFLVQuantities.count(*quantity) > 0)
-			{
-				//LOG(DEBUG) << "Init RMFLV quantity: " <<  << *quantity << " (index " << m_floatValueExtractors.size() << ")");
-				m_rmflvValueExtractors.push_back(SafeMap::Get(metadata.m_commonRMFLVQuantities, *quantity));
-				m_rmflvQuantities.push_back(*quantity);
-			}
-			else if (metadata.m_commonCartesianRMFLVQuantities.count(*quantity) > 0)
-			{
-				//LOG(DEBUG) << "Init CartesianRMFLV quantity: " <<  << *quantity << " (index " << m_floatValueExtractors.size() << ")");
-				m_cartesianRMFLVValueExtractors.push_back(SafeMap::Get(metadata.m_commonCartesianRMFLVQuantities, *quantity));
-				m_cartesianRMFLVQuantities.push_back(*quantity);
-			}
-			else if (metadata.m_commonVRMFLVQuantities.count(*quantity) > 0)
-			{
-				//LOG(DEBUG) << "Init vRMFLV quantity: " <<  << *quantity << " (index " << m_floatValueExtractors.size() << ")");
-				m_vRMFLVValueExtractors.push_back(SafeMap::Get(metadata.m_commonVRMFLVQuantities, *quantity));
-				m_vRMFLVQuantities.push_back(*quantity);
-			}
-			else if (metadata.m_commonStringQuantities.count(*quantity) > 0)
-			{
-				//LOG(DEBUG) << "Init string quantity: " <<  << *quantity << " (index " << m_floatValueExtractors.size() << ")");
-				m_stringValueExtractors.push_back(SafeMap::Get(metadata.m_commonStringQuantities, *quantity));
-				m_stringQuantities.push_back(*quantity);
-			}
-			else if (metadata.m_commonVStringQuantities.count(*quantity) > 0)
-			{
-				//LOG(DEBUG) << "Init vString quantity: " <<  << *quantity << " (index " << m_floatValueExtractors.size() << ")");
-				m_vStringValueExtractors.push_back(SafeMap::Get(metadata.m_commonVStringQuantities, *quantity));
-				m_vStringQuantities.push_back(*quantity);
-			}
-			else
+			if (! (AddToColumn(QuantityType::Float, metadata.m_commonFloatQuantities, *quantity, m_floatColumn) ||
+			       AddToColumn(QuantityType::Int, metadata.m_commonIntQuantities, *quantity, m_intColumn) ||
+			       AddToColumn(QuantityType::UInt64, metadata.m_commonUInt64Quantities, *quantity, m_uint64Column) ||
+			       AddToColumn(QuantityType::Double, metadata.m_commonDoubleQuantities, *quantity, m_doubleColumn) ||
+			       AddToColumn(QuantityType::VDouble, metadata.m_commonVDoubleQuantities, *quantity, m_vDoubleColumn) ||
+			       AddToColumn(QuantityType::VFloat, metadata.m_commonVFloatQuantities, *quantity, m_vFloatColumn) ||
+			       AddToColumn(QuantityType::Bool, metadata.m_commonBoolQuantities, *quantity, m_boolColumn) ||
+			       AddToColumn(QuantityType::VInt, metadata.m_commonVIntQuantities, *quantity, m_vIntColumn) ||
+			       AddToColumn(QuantityType::PtEtaPhiMVector, metadata.m_commonPtEtaPhiMVectorQuantities, *quantity, m_ptEtaPhiMVectorColumn) ||
+			       AddToColumn(QuantityType::RMFLV, metadata.m_commonRMFLVQuantities, *quantity, m_rmflvColumn) ||
+			       AddToColumn(QuantityType::CartesianRMFLV, metadata.m_commonCartesianRMFLVQuantities, *quantity, m_cartesianRMFLVColumn) ||
+			       AddToColumn(QuantityType::VRMFLV, metadata.m_commonVRMFLVQuantities, *quantity, m_vRMFLVColumn) ||
+			       AddToColumn(QuantityType::String, metadata.m_commonStringQuantities, *quantity, m_stringColumn) ||
+			       AddToColumn(QuantityType::VString, metadata.m_commonVStringQuantities, *quantity, m_vStringColumn)))
 			{
 				LOG(FATAL) << "No lambda expression available for quantity \"" << *quantity << "\" (pipeline \"" << settings.GetName() << "\")!";
 			}
 
-			++quantityIndex;
+			std::map<std::string, std::vector<std::string> >::const_iterator eventMembers = metadata.m_eventMembersOfQuantities.find(*quantity);
+			if (eventMembers != metadata.m_eventMembersOfQuantities.end())
+			{
+				m_requiredEventMembers.insert(eventMembers->second.begin(), eventMembers->second.end());
+			}
 		}
 
 		// create tree
@@ -318,384 +201,212 @@ public:
 		m_tree = new TTree("ntuple", ("Tree for Pipeline \"" + settings.GetName() + "\"").c_str());
 		gDirectory = tmpDirectory;
 
-		// create branches
-		m_boolValues.resize(m_boolValueExtractors.size());
-		m_intValues.resize(m_intValueExtractors.size());
-		m_uint64Values.resize(m_uint64ValueExtractors.size());
-		m_floatValues.resize(m_floatValueExtractors.size());
-		m_doubleValues.resize(m_doubleValueExtractors.size());
-		m_ptEtaPhiMVectorValues.resize(m_ptEtaPhiMVectorValueExtractors.size());
-		m_rmflvValues.resize(m_rmflvValueExtractors.size());
-		m_cartesianRMFLVValues.resize(m_cartesianRMFLVValueExtractors.size());
-		m_stringValues.resize(m_stringValueExtractors.size());
-		m_vDoubleValues.resize(m_vDoubleValueExtractors.size());
-		m_vFloatValues.resize(m_vFloatValueExtractors.size());
-		m_vRMFLVValues.resize(m_vRMFLVValueExtractors.size());
-		m_vStringValues.resize(m_vStringValueExtractors.size());
-		m_vIntValues.resize(m_vIntValueExtractors.size());
-
-		size_t boolQuantityIndex = 0;
-		size_t intQuantityIndex = 0;
-		size_t uint64QuantityIndex = 0;
-		size_t floatQuantityIndex = 0;
-		size_t doubleQuantityIndex = 0;
-		size_t ptEtaPhiMVectorQuantityIndex = 0;
-		size_t rmflvQuantityIndex = 0;
-		size_t cartesianRMFLVQuantityIndex = 0;
-		size_t stringQuantityIndex = 0;
-		size_t vDoubleQuantityIndex = 0;
-		size_t vFloatQuantityIndex = 0;
-		size_t vRMFLVQuantityIndex = 0;
-		size_t vStringQuantityIndex = 0;
-		size_t vIntQuantityIndex = 0;
-		for (std::vector<std::string>::iterator quantity = settings.GetQuantities().begin();
-		     quantity != settings.GetQuantities().end(); ++quantity)
+		// the tree collects the values of NtupleAutoFlush events in its column buffers (baskets)
+		// before they are compressed and written out together
+		if (settings.GetNtupleAutoFlush() != 0)
 		{
-			if (metadata.m_commonFloatQuantities.count(*quantity) > 0)
-			{
-				m_tree->Branch(quantity->c_str(), &(m_floatValues[floatQuantityIndex]), (*quantity + "/F").c_str());
-				++floatQuantityIndex;
-			}
-			else if (metadata.m_commonIntQuantities.count(*quantity) > 0)
-			{
-				m_tree->Branch(quantity->c_str(), &(m_intValues[intQuantityIndex]), (*quantity + "/I").c_str());
-				++intQuantityIndex;
-			}
-			else if (metadata.m_commonUInt64Quantities.count(*quantity) > 0)
-			{
-				m_tree->Branch(quantity->c_str(), &(m_uint64Values[uint64QuantityIndex]), (*quantity + "/l").c_str());
-				++uint64QuantityIndex;
-			}
-			else if (metadata.m_commonDoubleQuantities.count(*quantity) > 0)
-			{
-				m_tree->Branch(quantity->c_str(), &(m_doubleValues[doubleQuantityIndex]), (*quantity + "/D").c_str());
-				++doubleQuantityIndex;
-			}
-			else if (metadata.m_commonVDoubleQuantities.count(*quantity) > 0)
-			{
-				m_tree->Branch(quantity->c_str(), &(m_vDoubleValues[vDoubleQuantityIndex]));
-				++vDoubleQuantityIndex;
-			}
-			else if (metadata.m_commonVFloatQuantities.count(*quantity) > 0)
-			{
-				m_tree->Branch(quantity->c_str(), &(m_vFloatValues[vFloatQuantityIndex]));
-				++vFloatQuantityIndex;
-			}
-			else if (metadata.m_commonBoolQuantities.count(*quantity) > 0)
-			{
-				m_tree->Branch(quantity->c_str(), &(m_boolValues[boolQuantityIndex]), (*quantity + "/O").c_str());
-				++boolQuantityIndex;
-			}
-			else if (metadata.m_commonPtEtaPhiMVectorQuantities.count(*quantity) > 0)
-			{
-				m_tree->Branch(quantity->c_str(), "ROOT::Math::PtEtaPhiMVector", &(m_ptEtaPhiMVectorValues[ptEtaPhiMVectorQuantityIndex]));
-				++ptEtaPhiMVectorQuantityIndex;
-			}
-			else if (metadata.m_commonRMFLVQuantities.count(*quantity) > 0)
-			{
-				m_tree->Branch(quantity->c_str(), &(m_rmflvValues[rmflvQuantityIndex]));
-				++rmflvQuantityIndex;
-			}
-			else if (metadata.m_commonCartesianRMFLVQuantities.count(*quantity) > 0)
-			{
-				m_tree->Branch(quantity->c_str(), &(m_cartesianRMFLVValues[cartesianRMFLVQuantityIndex]));
-				++cartesianRMFLVQuantityIndex;
-			}
-			else if (metadata.m_commonVRMFLVQuantities.count(*quantity) > 0)
-			{
-				m_tree->Branch(quantity->c_str(), &(m_vRMFLVValues[vRMFLVQuantityIndex]));
-				++vRMFLVQuantityIndex;
-			}
-			else if (metadata.m_commonStringQuantities.count(*quantity) > 0)
-			{
-				m_tree->Branch(quantity->c_str(), &(m_stringValues[stringQuantityIndex]));
-				++stringQuantityIndex;
-			}
-			else if (metadata.m_commonVStringQuantities.count(*quantity) > 0)
-			{
-				m_tree->Branch(quantity->c_str(), &(m_vStringValues[vStringQuantityIndex]));
-				++vStringQuantityIndex;
-			}
-			else if (metadata.m_commonVIntQuantities.count(*quantity) > 0)
-			{
-				m_tree->Branch(quantity->c_str(), &(m_vIntValues[vIntQuantityIndex]));
-				++vIntQuantityIndex;
+			m_tree->SetAutoFlush(settings.GetNtupleAutoFlush());
+		}
+
+		// create branches (the values must not be reallocated afterwards)
+		for (std::pair<QuantityType, size_t> const& branch : m_branches)
+		{
+			size_t index = branch.second;
+			switch (branch.first)
+			{
+			case QuantityType::Bool:
+				m_tree->Branch(m_boolColumn.quantities[index].c_str(), &(m_boolColumn.values[index]), (m_boolColumn.quantities[index] + "/O").c_str());
+				break;
+			case QuantityType::Int:
+				m_tree->Branch(m_intColumn.quantities[index].c_str(), &(m_intColumn.values[index]), (m_intColumn.quantities[index] + "/I").c_str());
+				break;
+			case QuantityType::UInt64:
+				m_tree->Branch(m_uint64Column.quantities[index].c_str(), &(m_uint64Column.values[index]), (m_uint64Column.quantities[index] + "/l").c_str());
+				break;
+			case QuantityType::Float:
+				m_tree->Branch(m_floatColumn.quantities[index].c_str(), &(m_floatColumn.values[index]), (m_floatColumn.quantities[index] + "/F").c_str());
+				break;
+			case QuantityType::Double:
+				m_tree->Branch(m_doubleColumn.quantities[index].c_str(), &(m_doubleColumn.values[index]), (m_doubleColumn.quantities[index] + "/D").c_str());
+				break;
+			case QuantityType::PtEtaPhiMVector:
+				m_tree->Branch(m_ptEtaPhiMVectorColumn.quantities[index].c_str(), "ROOT::Math::PtEtaPhiMVector", &(m_ptEtaPhiMVectorColumn.values[index]));
+				break;
+			case QuantityType::RMFLV:
+				m_tree->Branch(m_rmflvColumn.quantities[index].c_str(), &(m_rmflvColumn.values[index]));
+				break;
+			case QuantityType::CartesianRMFLV:
+				m_tree->Branch(m_cartesianRMFLVColumn.quantities[index].c_str(), &(m_cartesianRMFLVColumn.values[index]));
+				break;
+			case QuantityType::String:
+				m_tree->Branch(m_stringColumn.quantities[index].c_str(), &(m_stringColumn.values[index]));
+				break;
+			case QuantityType::VDouble:
+				m_tree->Branch(m_vDoubleColumn.quantities[index].c_str(), &(m_vDoubleColumn.values[index]));
+				break;
+			case QuantityType::VFloat:
+				m_tree->Branch(m_vFloatColumn.quantities[index].c_str(), &(m_vFloatColumn.values[index]));
+				break;
+			case QuantityType::VRMFLV:
+				m_tree->Branch(m_vRMFLVColumn.quantities[index].c_str(), &(m_vRMFLVColumn.values[index]));
+				break;
+			case QuantityType::VString:
+				m_tree->Branch(m_vStringColumn.quantities[index].c_str(), &(m_vStringColumn.values[index]));
+				break;
+			case QuantityType::VInt:
+				m_tree->Branch(m_vIntColumn.quantities[index].c_str(), &(m_vIntColumn.values[index]));
+				break;
 			}
 		}
 	}
 
+	void GetRequiredEventMembers(std::set<std::string>& eventMembers) const override
+	{
+		eventMembers.insert(m_requiredEventMembers.begin(), m_requiredEventMembers.end());
+	}
+
 	void ProcessFilteredEvent(event_type const& event, product_type const& product, setting_type const& settings, metadata_type const& metadata ) override
 	{
 		ConsumerBase<TTypes>::ProcessFilteredEvent(event, product, settings, metadata);
 
 		// calculate values
-		size_t boolValueIndex = 0;
-		for(typename std::vector<bool_extractor_lambda_base>::iterator valueExtractor = m_boolValueExtractors.begin();
-		    valueExtractor != m_boolValueExtractors.end(); ++valueExtractor)
-		{
-			try
-			{
-				m_boolValues[boolValueIndex] = (*valueExtractor)(event, product);
-			}
-			catch (...)
-			{
-				LOG(FATAL) << "Could not call lambda function for bool quantity \"" << m_boolQuantities.at(boolValueIndex) << "\" (pipeline \"" << settings.GetName() << "\")!";
-			}
-			++boolValueIndex;
-		}
+		FillColumn(m_boolColumn, "bool", event, product, settings);
+		FillColumn(m_intColumn, "int", event, product, settings);
+		FillColumn(m_uint64Column, "uint64", event, product, settings);
+		FillColumn(m_floatColumn, "float", event, product, settings);
+		FillColumn(m_doubleColumn, "double", event, product, settings);
+		FillColumn(m_ptEtaPhiMVectorColumn, "ROOT::Math::PtEtaPhiMVector", event, product, settings);
+		FillColumn(m_rmflvColumn, "RMFLV", event, product, settings);
+		FillColumn(m_cartesianRMFLVColumn, "CartesianRMFLV", event, product, settings);
+		FillColumn(m_stringColumn, "string", event, product, settings);
+		FillColumn(m_vDoubleColumn, "vDouble", event, product, settings);
+		FillColumn(m_vFloatColumn, "vFloat", event, product, settings);
+		FillColumn(m_vRMFLVColumn, "vRMFLV", event, product, settings);
+		FillColumn(m_vStringColumn, "vString", event, product, settings);
+		FillColumn(m_vIntColumn, "vInt", event, product, settings);
 
-		size_t intValueIndex = 0;
-		for(typename std::vector<int_extractor_lambda_base>::iterator valueExtractor = m_intValueExtractors.begin();
-		    valueExtractor != m_intValueExtractors.end(); ++valueExtractor)
-		{
-			try
-			{
-				m_intValues[intValueIndex] = (*valueExtractor)(event, product);
-			}
-			catch (...)
-			{
-				LOG(FATAL) << "Could not call lambda function for int quantity \"" << m_intQuantities.at(intValueIndex) << "\" (pipeline \"" << settings.GetName() << "\")!";
-			}
-			++intValueIndex;
-		}
+		// fill tree
+		this->m_tree->Fill();
+	}
 
-		size_t uint64ValueIndex = 0;
-		for(typename std::vector<uint64_extractor_lambda_base>::iterator valueExtractor = m_uint64ValueExtractors.begin();
-		    valueExtractor != m_uint64ValueExtractors.end(); ++valueExtractor)
-		{
-			try
-			{
-				m_uint64Values[uint64ValueIndex] = (*valueExtractor)(event, product);
-			}
-			catch (...)
-			{
-				LOG(FATAL) << "Could not call lambda function for uint64 quantity \"" << m_uint64Quantities.at(uint64ValueIndex) << "\" (pipeline \"" << settings.GetName() << "\")!";
-			}
-			++uint64ValueIndex;
-		}
+	bool SupportsMerge() const override
+	{
+		return true;
+	}
 
-		size_t floatValueIndex = 0;
-		for(typename std::vector<float_extractor_lambda_base>::iterator valueExtractor = m_floatValueExtractors.begin();
-		    valueExtractor != m_floatValueExtractors.end(); ++valueExtractor)
-		{
-			try
-			{
-				m_floatValues[floatValueIndex] = (*valueExtractor)(event, product);
-			}
-			catch (...)
-			{
-				LOG(FATAL) << "Could not call lambda function for float quantity \"" << m_floatQuantities.at(floatValueIndex) << "\" (pipeline \"" << settings.GetName() << "\")!";
-			}
-			++floatValueIndex;
-		}
+	void Merge(ConsumerBase<TTypes> const& replica, setting_type const& settings, metadata_type const& metadata) override
+	{
+		m_tree->CopyEntries(static_cast<LambdaNtupleConsumer<TTypes> const&>(replica).m_tree);
+	}
 
-		size_t doubleValueIndex = 0;
-		for(typename std::vector<double_extractor_lambda_base>::iterator valueExtractor = m_doubleValueExtractors.begin();
-		    valueExtractor != m_doubleValueExtractors.end(); ++valueExtractor)
-		{
-			try
-			{
-				m_doubleValues[doubleValueIndex] = (*valueExtractor)(event, product);
-			}
-			catch (...)
-			{
-				LOG(FATAL) << "Could not call lambda function for double quantity \"" << m_doubleQuantities.at(doubleValueIndex) << "\" (pipeline \"" << settings.GetName() << "\")!";
-			}
-			++doubleValueIndex;
-		}
-		
-		size_t ptEtaPhiMVectorValueIndex = 0;
-		for(typename std::vector<ptEtaPhiMVector_extractor_lambda_base>::iterator valueExtractor = m_ptEtaPhiMVectorValueExtractors.begin();
-		    valueExtractor != m_ptEtaPhiMVectorValueExtractors.end(); ++valueExtractor)
-		{
-			try
-			{
-				m_ptEtaPhiMVectorValues[ptEtaPhiMVectorValueIndex] = (*valueExtractor)(event, product);
-			}
-			catch (...)
-			{
-				LOG(FATAL) << "Could not call lambda function for ROOT::Math::PtEtaPhiMVector quantity \"" << m_ptEtaPhiMVectorQuantities.at(ptEtaPhiMVectorValueIndex) << "\" (pipeline \"" << settings.GetName() << "\")!";
-			}
-			++ptEtaPhiMVectorValueIndex;
-		}
-		
-		size_t rmflvValueIndex = 0;
-		for(typename std::vector<rmflv_extractor_lambda_base>::iterator valueExtractor = m_rmflvValueExtractors.begin();
-		    valueExtractor != m_rmflvValueExtractors.end(); ++valueExtractor)
-		{
-			try
-			{
-				m_rmflvValues[rmflvValueIndex] = (*valueExtractor)(event, product);
-			}
-			catch (...)
-			{
-				LOG(FATAL) << "Could not call lambda function for RMFLV quantity \"" << m_rmflvQuantities.at(rmflvValueIndex) << "\" (pipeline \"" << settings.GetName() << "\")!";
-			}
-			++rmflvValueIndex;
-		}
-		
-		size_t cartesianRMFLVValueIndex = 0;
-		for(typename std::vector<cartesianRMFLV_extractor_lambda_base>::iterator valueExtractor = m_cartesianRMFLVValueExtractors.begin();
-		    valueExtractor != m_cartesianRMFLVValueExtractors.end(); ++valueExtractor)
-		{
-			try
-			{
-				m_cartesianRMFLVValues[cartesianRMFLVValueIndex] = (*valueExtractor)(event, product);
-			}
-			catch (...)
-			{
-				LOG(FATAL) << "Could not call lambda function for CartesianRMFLV quantity \"" << m_cartesianRMFLVQuantities.at(cartesianRMFLVValueIndex) << "\" (pipeline \"" << settings.GetName() << "\")!";
-			}
-			++cartesianRMFLVValueIndex;
-		}
-		
-		size_t stringValueIndex = 0;
-		for(typename std::vector<string_extractor_lambda_base>::iterator valueExtractor = m_stringValueExtractors.begin();
-		    valueExtractor != m_stringValueExtractors.end(); ++valueExtractor)
+	void Finish(setting_type const& settings, metadata_type const& metadata) override
+	{
+		RootFileHelper::SafeCd(settings.GetRootOutFile(), settings.GetRootFileFolder());
+		m_tree->Write(m_tree->GetName());
+	}
+
+
+private:
+
+	enum class QuantityType { Bool, Int, UInt64, Float, Double, PtEtaPhiMVector, RMFLV, CartesianRMFLV, String,
+	                          VDouble, VFloat, VRMFLV, VString, VInt };
+
+	// quantities of one type with their extractors and the values the branches point to
+	template<class TValue, class TStorage = TValue>
+	struct QuantityColumn
+	{
+		typedef std::function<TValue(EventBase const&, ProductBase const&)> extractor_type;
+
+		std::vector<std::string> quantities;
+		std::vector<extractor_type> valueExtractors;
+		std::vector<TStorage> values;
+
+		void Clear()
 		{
-			try
-			{
-				m_stringValues[stringValueIndex] = (*valueExtractor)(event, product);
-			}
-			catch (...)
-			{
-				LOG(FATAL) << "Could not call lambda function for string quantity \"" << m_stringQuantities.at(stringValueIndex) << "\" (pipeline \"" << settings.GetName() << "\")!";
-			}
-			++stringValueIndex;
+			quantities.clear();
+			valueExtractors.clear();
+			values.clear();
 		}
-		
-		size_t vDoubleValueIndex = 0;
-		for(typename std::vector<vDouble_extractor_lambda_base>::iterator valueExtractor = m_vDoubleValueExtractors.begin();
-		    valueExtractor != m_vDoubleValueExtractors.end(); ++valueExtractor)
+	};
+
+	template<class TValue, class TExtractor>
+	static std::function<TValue(EventBase const&, ProductBase const&)> WrapValueExtractor(std::string const& name, TExtractor valueExtractor, bool memoise)
+	{
+		if (! memoise)
 		{
-			try
-			{
-				m_vDoubleValues[vDoubleValueIndex] = (*valueExtractor)(event, product);
-			}
-			catch (...)
+			return [valueExtractor](EventBase const& event, ProductBase const& product) -> TValue
 			{
-				LOG(FATAL) << "Could not call lambda function for vDouble quantity \"" << m_vDoubleQuantities.at(vDoubleValueIndex) << "\" (pipeline \"" << settings.GetName() << "\")!";
-			}
-			++vDoubleValueIndex;
+				return valueExtractor(static_cast<event_type const&>(event), static_cast<product_type const&>(product));
+			};
 		}
-		
-		size_t vFloatValueIndex = 0;
-		for(typename std::vector<vFloat_extractor_lambda_base>::iterator valueExtractor = m_vFloatValueExtractors.begin();
-		    valueExtractor != m_vFloatValueExtractors.end(); ++valueExtractor)
+
+		const size_t cacheSlot = QuantityCache::GetSlot<TValue>(name);
+		return [valueExtractor, cacheSlot](EventBase const& event, ProductBase const& product) -> TValue
 		{
-			try
+			TValue const* value = product.quantityCache.Get<TValue>(cacheSlot);
+			if (value == nullptr)
 			{
-				m_vFloatValues[vFloatValueIndex] = (*valueExtractor)(event, product);
+				value = &(product.quantityCache.Set<TValue>(cacheSlot, valueExtractor(static_cast<event_type const&>(event), static_cast<product_type const&>(product))));
 			}
-			catch (...)
-			{
-				LOG(FATAL) << "Could not call lambda function for vFloat quantity \"" << m_vFloatQuantities.at(vFloatValueIndex) << "\" (pipeline \"" << settings.GetName() << "\")!";
-			}
-			++vFloatValueIndex;
-		}
-		
-		size_t vRMFLVValueIndex = 0;
-		for(typename std::vector<vRMFLV_extractor_lambda_base>::iterator valueExtractor = m_vRMFLVValueExtractors.begin();
-		    valueExtractor != m_vRMFLVValueExtractors.end(); ++valueExtractor)
+			return *value;
+		};
+	}
+
+	template<class TValue, class TStorage>
+	bool AddToColumn(QuantityType quantityType,
+	                 std::map<std::string, typename QuantityColumn<TValue, TStorage>::extractor_type> const& commonQuantities,
+	                 std::string const& quantity, QuantityColumn<TValue, TStorage>& column)
+	{
+		typename std::map<std::string, typename QuantityColumn<TValue, TStorage>::extractor_type>::const_iterator valueExtractor = commonQuantities.find(quantity);
+		if (valueExtractor == commonQuantities.end())
 		{
-			try
-			{
-				m_vRMFLVValues[vRMFLVValueIndex] = (*valueExtractor)(event, product);
-			}
-			catch (...)
-			{
-				LOG(FATAL) << "Could not call lambda function for vRMFLV quantity \"" << m_vRMFLVQuantities.at(vRMFLVValueIndex) << "\" (pipeline \"" << settings.GetName() << "\")!";
-			}
-			++vRMFLVValueIndex;
+			return false;
 		}
-		
-		size_t vStringValueIndex = 0;
-		for(typename std::vector<vString_extractor_lambda_base>::iterator valueExtractor = m_vStringValueExtractors.begin();
-		    valueExtractor != m_vStringValueExtractors.end(); ++valueExtractor)
+
+		m_branches.push_back(std::make_pair(quantityType, column.quantities.size()));
+		column.quantities.push_back(quantity);
+		column.valueExtractors.push_back(valueExtractor->second);
+		column.values.resize(column.quantities.size());
+		return true;
+	}
+
+	// a single exception frame for all extractors of a column
+	template<class TValue, class TStorage>
+	static void FillColumn(QuantityColumn<TValue, TStorage>& column, char const* typeName,
+	                       event_type const& event, product_type const& product, setting_type const& settings)
+	{
+		size_t index = 0;
+		try
 		{
-			try
-			{
-				m_vStringValues[vStringValueIndex] = (*valueExtractor)(event, product);
-			}
-			catch (...)
+			for (; index < column.valueExtractors.size(); ++index)
 			{
-				LOG(FATAL) << "Could not call lambda function for vString quantity \"" << m_vStringQuantities.at(vStringValueIndex) << "\" (pipeline \"" << settings.GetName() << "\")!";
+				column.values[index] = column.valueExtractors[index](event, product);
 			}
-			++vStringValueIndex;
 		}
-
-		size_t vIntValueIndex = 0;
-		for(typename std::vector<vInt_extractor_lambda_base>::iterator valueExtractor = m_vIntValueExtractors.begin();
-		    valueExtractor != m_vIntValueExtractors.end(); ++valueExtractor)
+		catch (...)
 		{
-			try
-			{
-				m_vIntValues[vIntValueIndex] = (*valueExtractor)(event, product);
-			}
-			catch (...)
-			{
-				LOG(FATAL) << "Could not call lambda function for vInt quantity \"" << m_vIntQuantities.at(vIntValueIndex) << "\" (pipeline \"" << settings.GetName() << "\")!";
-			}
-			++vIntValueIndex;
+			LOG(FATAL) << "Could not call lambda function for " << typeName << " quantity \"" << column.quantities.at(index) << "\" (pipeline \"" << settings.GetName() << "\")!";
 		}
-
-		// fill tree
-		this->m_tree->Fill();
 	}
 
-	void Finish(setting_type const& settings, metadata_type const& metadata) override
-	{
-		RootFileHelper::SafeCd(settings.GetRootOutFile(), settings.GetRootFileFolder());
-		m_tree->Write(m_tree->GetName());
-	}
-
-
-private:
 	TTree* m_tree = nullptr;
 
-	std::vector<bool_extractor_lambda_base> m_boolValueExtractors;
-	std::vector<int_extractor_lambda_base> m_intValueExtractors;
-	std::vector<uint64_extractor_lambda_base> m_uint64ValueExtractors;
-	std::vector<float_extractor_lambda_base> m_floatValueExtractors;
-	std::vector<double_extractor_lambda_base> m_doubleValueExtractors;
-	std::vector<ptEtaPhiMVector_extractor_lambda_base> m_ptEtaPhiMVectorValueExtractors;
-	std::vector<rmflv_extractor_lambda_base> m_rmflvValueExtractors;
-	std::vector<cartesianRMFLV_extractor_lambda_base> m_cartesianRMFLVValueExtractors;
-	std::vector<string_extractor_lambda_base> m_stringValueExtractors;
-	std::vector<vDouble_extractor_lambda_base> m_vDoubleValueExtractors;
-	std::vector<vFloat_extractor_lambda_base> m_vFloatValueExtractors;
-	std::vector<vRMFLV_extractor_lambda_base> m_vRMFLVValueExtractors;
-	std::vector<vString_extractor_lambda_base> m_vStringValueExtractors;
-	std::vector<vInt_extractor_lambda_base> m_vIntValueExtractors;
-
-	std::vector<std::string> m_boolQuantities;
-	std::vector<std::string> m_intQuantities;
-	std::vector<std::string> m_uint64Quantities;
-	std::vector<std::string> m_floatQuantities;
-	std::vector<std::string> m_doubleQuantities;
-	std::vector<std::string> m_ptEtaPhiMVectorQuantities;
-	std::vector<std::string> m_rmflvQuantities;
-	std::vector<std::string> m_cartesianRMFLVQuantities;
-	std::vector<std::string> m_stringQuantities;
-	std::vector<std::string> m_vDoubleQuantities;
-	std::vector<std::string> m_vFloatQuantities;
-	std::vector<std::string> m_vRMFLVQuantities;
-	std::vector<std::string> m_vStringQuantities;
-	std::vector<std::string> m_vIntQuantities;
-
-	std::vector<char> m_boolValues; // needs to be char vector because of bitset treatment of bool vector
-	std::vector<int> m_intValues;
-	std::vector<uint64_t> m_uint64Values;
-	std::vector<float> m_floatValues;
-	std::vector<double> m_doubleValues;
-	std::vector<ROOT::Math::PtEtaPhiMVector> m_ptEtaPhiMVectorValues;
-	std::vector<RMFLV> m_rmflvValues;
-	std::vector<CartesianRMFLV> m_cartesianRMFLVValues;
-	std::vector<std::string> m_stringValues;
-	std::vector<std::vector<double> > m_vDoubleValues;
-	std::vector<std::vector<float> > m_vFloatValues;
-	std::vector<std::vector<RMFLV> > m_vRMFLVValues;
-	std::vector<std::vector<std::string> > m_vStringValues;
-	std::vector<std::vector<int> > m_vIntValues;
+	std::vector<std::pair<QuantityType, size_t> > m_branches;
+	std::set<std::string> m_requiredEventMembers;
+
+	QuantityColumn<bool, char> m_boolColumn; // needs to be char vector because of bitset treatment of bool vector
+	QuantityColumn<int> m_intColumn;
+	QuantityColumn<uint64_t> m_uint64Column;
+	QuantityColumn<float> m_floatColumn;
+	QuantityColumn<double> m_doubleColumn;
+	QuantityColumn<ROOT::Math::PtEtaPhiMVector> m_ptEtaPhiMVectorColumn;
+	QuantityColumn<RMFLV> m_rmflvColumn;
+	QuantityColumn<CartesianRMFLV> m_cartesianRMFLVColumn;
+	QuantityColumn<std::string> m_stringColumn;
+	QuantityColumn<std::vector<double> > m_vDoubleColumn;
+	QuantityColumn<std::vector<float> > m_vFloatColumn;
+	QuantityColumn<std::vector<RMFLV> > m_vRMFLVColumn;
+	QuantityColumn<std::vector<std::string> > m_vStringColumn;
+	QuantityColumn<std::vector<int> > m_vIntColumn;
 };
 
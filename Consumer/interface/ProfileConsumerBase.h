@@ -51,7 +51,7 @@ public:
 
 	void ProcessEvent(event_type const& event, product_type const& product,
 			setting_type const& settings, metadata_type const& metadata,
-			FilterResult& result) override {
+			FilterResult const& result) override {
 		ConsumerBase<TTypes>::ProcessEvent(event, product, settings, metadata, result);
 
 		// not supported ..
@@ -8,11 +8,20 @@
 #include <TTree.h>
 
 #include "Artus/Core/interface/ConsumerBase.h"
-#include "Artus/Utility/interface/SafeMap.h"
-#include "Artus/Utility/interface/DefaultValues.h"
+#include "Artus/Core/interface/RunTimeStatistics.h"
 #include "Artus/Configuration/interface/ArtusConfig.h"
 
 
+/**
+   \brief Writes the run times of all processors of the pipeline (including the global ones).
+
+   The run times are measured by the pipeline (runner) if the setting RunTimeMeasurement is enabled
+   and are aggregated over all events. They are written once at the end of the processing:
+   - the tree runTime contains one entry per processor with the number of calls and the total,
+     mean, minimum and maximum run time in us
+   - the histograms runTime_<processor> contain the distributions of the run times in us
+     (logarithmic binning, see RunTimeStatistics)
+*/
 template < class TTypes >
 class RunTimeConsumer: public ConsumerBase<TTypes>{
 public:
@@ -35,23 +44,16 @@ public:
 	void Init(setting_type const& settings, metadata_type& metadata) override
 	{
 		ConsumerBase<TTypes>::Init(settings, metadata);
-		std::vector<std::string> processors = settings.GetAllProcessors();
-
-		// save file
-		RootFileHelper::SafeCd(settings.GetRootOutFile(),
-				settings.GetRootFileFolder());
 
-		m_tree = new TTree("runTime", "runTime");
+		if (! settings.GetRunTimeMeasurement())
+		{
+			LOG(WARNING) << "The RunTimeConsumer in pipeline \"" << settings.GetName()
+			             << "\" requires the setting \"RunTimeMeasurement\" to be enabled! No run times will be written.";
+		}
 
-		// initialize branches
-		int i = 0;
-		std::string processorName;
-		m_runTime.resize(processors.size());
-		for (std::string processor : processors) {
-		    processorName = ArtusConfig::ParseProcessNode(processor).second;
-		    m_processorNames.push_back(processorName);
-			m_tree->Branch(processorName.c_str(), &(m_runTime[i]), (processorName + "/I").c_str());
-			++i;
+		for (std::string const& processor : settings.GetAllProcessors())
+		{
+			m_processorNames.push_back(ArtusConfig::ParseProcessNode(processor).second);
 		}
 	}
 
@@ -61,29 +63,65 @@ public:
 		RootFileHelper::SafeCd(settings.GetRootOutFile(),
 				settings.GetRootFileFolder());
 
-		m_tree->Write("runTime");
+		TTree* tree = new TTree("runTime", "runTime");
+		std::string processorName;
+		unsigned long long calls = 0;
+		double totalRunTime = 0.0;
+		double meanRunTime = 0.0;
+		double minRunTime = 0.0;
+		double maxRunTime = 0.0;
+		tree->Branch("processor", &processorName);
+		tree->Branch("calls", &calls, "calls/l");
+		tree->Branch("totalRunTime", &totalRunTime, "totalRunTime/D");
+		tree->Branch("meanRunTime", &meanRunTime, "meanRunTime/D");
+		tree->Branch("minRunTime", &minRunTime, "minRunTime/D");
+		tree->Branch("maxRunTime", &maxRunTime, "maxRunTime/D");
+
+		std::vector<double> binEdges(RunTimeStatistics::NumberOfHistogramBins + 1);
+		for (size_t bin = 0; bin < binEdges.size(); ++bin)
+		{
+			binEdges[bin] = RunTimeStatistics::GetHistogramBinLowEdge(bin) / 1000.0;
+		}
+
+		for (std::string const& processor : m_processorNames)
+		{
+			RunTimeStatistics::ProcessorStatistics const* statistics = metadata.GetProcessorRunTimeStatistics(processor);
+			if ((statistics == nullptr) || (statistics->count == 0))
+			{
+				continue;
+			}
+
+			processorName = processor;
+			calls = statistics->count;
+			totalRunTime = statistics->sum / 1000.0;
+			meanRunTime = statistics->GetMean() / 1000.0;
+			minRunTime = statistics->min / 1000.0;
+			maxRunTime = statistics->max / 1000.0;
+			tree->Fill();
+
+			TH1D* histogram = new TH1D(("runTime_" + processor).c_str(), processor.c_str(),
+			                           RunTimeStatistics::NumberOfHistogramBins, binEdges.data());
+			for (size_t bin = 0; bin < RunTimeStatistics::NumberOfHistogramBins; ++bin)
+			{
+				histogram->SetBinContent(bin + 1, statistics->histogram[bin]);
+			}
+			histogram->SetEntries(statistics->count);
+			histogram->Write(histogram->GetName());
+		}
+
+		tree->Write("runTime");
 	}
 
-	void ProcessEvent(event_type const& event, product_type const& product,
-	                  setting_type const& settings, metadata_type const& metadata,
-	                  FilterResult & filterResult) override
+	bool SupportsMerge() const override
 	{
-		ConsumerBase<TTypes>::ProcessEvent(event, product, settings, metadata, filterResult);
-
-		// set values of runtime
-		int i=0;
-		for (std::string processor : m_processorNames) {
-			m_runTime[i]=SafeMap::GetWithDefault (product.processorRunTime, processor, DefaultValues::UndefinedInt);
-			++i;
-		}
+		return true;
+	}
 
-		// fill tree
-		m_tree->Fill();
+	// the run times of the replicas are merged by the pipelines
+	void Merge(ConsumerBase<TTypes> const& replica, setting_type const& settings, metadata_type const& metadata) override
+	{
 	}
 
 protected:
 	std::vector<std::string> m_processorNames;
-	std::vector<int> m_runTime;
-	TTree* m_tree = 0;
-
 };
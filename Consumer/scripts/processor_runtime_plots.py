@@ -30,23 +30,25 @@ if __name__ == "__main__":
 	args = parser.parse_args()
 	logger.initLogger(args)
 	
-	folder = args.pipeline+"/runTime"
+	folder = args.pipeline
 	
-	# retrieve list of processors
-	runtime_tree = ROOT.TChain(folder)
+	# retrieve list of processors (one entry per processor in the runTime tree)
+	runtime_tree = ROOT.TChain(folder+"/runTime")
 	runtime_tree.Add(args.input)
-	processors = [leaf.GetName() for leaf in runtime_tree.GetListOfLeaves()]
+	processors = []
+	for entry in runtime_tree:
+		processors.append(str(entry.processor))
 	
-	# plot all runtimes
+	# plot the run time distributions of all processors
 	plot_configs = []
 	for processor in processors:
 		plot_config = {}
 		plot_config["files"] = [args.input]
 		plot_config["folders"] = [folder]
-		plot_config["x_expressions"] = [processor]
-		plot_config["weights"] = ["{p} >= 0.0".format(p=processor)]
+		plot_config["x_expressions"] = ["runTime_"+processor]
 		plot_config["colors"] = ["#FF0000"]
 		plot_config["x_label"] = "runtime / us"
+		plot_config["x_log"] = True
 		plot_config["filename"] = processor
 		
 		if not args.output_dir is None:
@@ -56,17 +58,15 @@ if __name__ == "__main__":
 	
 	plot_config_combined = {}
 	plot_config_combined["files"] = [args.input]
-	plot_config_combined["folders"] = [folder]
+	plot_config_combined["folders"] = [folder+"/runTime"]
 	plot_config_combined["nicks"] = ["nick"]
-	plot_config_combined["x_expressions"] = ["{i}".format(i=index) for index in range(len(processors))]
-	plot_config_combined["y_expressions"] = ["{p}".format(p=processor) for processor in processors]
-	plot_config_combined["weights"] = ["{p} >= 0.0".format(p=processor) for processor in processors]
+	plot_config_combined["x_expressions"] = ["Entry$"]
+	plot_config_combined["y_expressions"] = ["meanRunTime"]
 	plot_config_combined["x_bins"] = ["{l},0,{l}".format(l=len(processors))]
-	#plot_config_combined["y_bins"] = ["500,0,500"]
-	plot_config_combined["tree_draw_options"] = ["profs"]
+	plot_config_combined["tree_draw_options"] = ["prof"]
 	plot_config_combined["x_label"] = "Processor Index"
 	#plot_config_combined["x_tick_labels"] = processors
-	plot_config_combined["y_label"] = "Runtime / us"
+	plot_config_combined["y_label"] = "Mean Runtime / us"
 	plot_config_combined["filename"] = "all"
 	plot_configs.append(plot_config_combined)
 	
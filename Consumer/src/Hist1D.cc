@@ -54,3 +54,7 @@ void Hist1D::Fill(double val, double weight) {
 	m_hist->Fill(val, weight);
 }
 
+void Hist1D::Add(Hist1D const& other) {
+	m_hist->Add(other.m_hist.get());
+}
+
@@ -40,6 +40,12 @@ public:
 	 */
 	virtual std::string GetConsumerId() const = 0;
 
+	/*
+	 * Must return true if the consumer implements Merge. Parallel runs are only started
+	 * if all consumers of the level one pipelines can merge the results of their replicas.
+	 */
+	virtual bool SupportsMerge() const;
+
 protected:
 	// will be implemented by the ConsumerBase class
 	virtual void baseInit(SettingsBase const& settings, MetadataBase& metadata) = 0;
@@ -48,9 +54,10 @@ protected:
 	virtual void baseOnLumi(EventBase const& evt, SettingsBase const& settings, MetadataBase const& metadata) = 0;
 	
 	virtual void baseProcess(SettingsBase const& settings, MetadataBase const& metadata) = 0;
-	virtual void baseProcessEvent(EventBase const& evt, ProductBase const& prod, SettingsBase const& settings, MetadataBase const& metadata, FilterResult& fres) = 0;
+	virtual void baseProcessEvent(EventBase const& evt, ProductBase const& prod, SettingsBase const& settings, MetadataBase const& metadata, FilterResult const& fres) = 0;
 	virtual void baseProcessFilteredEvent(EventBase const& evt, ProductBase const& prod, SettingsBase const& settings, MetadataBase const& metadata) = 0;
 	
+	virtual void baseMerge(ConsumerBaseUntemplated const& replica, SettingsBase const& settings, MetadataBase const& metadata) = 0;
 	virtual void baseFinish(SettingsBase const& settings, MetadataBase const& metadata) = 0;
 };
 
@@ -65,9 +72,10 @@ public:
 	void OnRun(EventBase const& evt, SettingsBase const& settings, MetadataBase const& metadata);
 	
 	void Process(SettingsBase const& settings, MetadataBase const& metadata);
-	void ProcessEvent(EventBase const& evt, ProductBase const& prod, SettingsBase const& settings, MetadataBase const& metadata, FilterResult fres);
+	void ProcessEvent(EventBase const& evt, ProductBase const& prod, SettingsBase const& settings, MetadataBase const& metadata, FilterResult const& fres);
 	void ProcessFilteredEvent(EventBase const& evt, ProductBase const& prod, SettingsBase const& settings, MetadataBase const& metadata);
 	
+	void Merge(ConsumerBaseUntemplated const& replica, SettingsBase const& settings, MetadataBase const& metadata);
 	void Finish(SettingsBase const& settings, MetadataBase const& metadata);
 
 private:
@@ -124,8 +132,19 @@ public:
 	 */
 
 	//add setting_type const& globalSettings here !!
-	virtual void ProcessEvent(event_type const& event, product_type const& product, setting_type const& settings, metadata_type const& metadata, FilterResult& result)
+	virtual void ProcessEvent(event_type const& event, product_type const& product, setting_type const& settings, metadata_type const& metadata, FilterResult const& result)
+	{
+	}
+
+	/*
+	 * Called after a parallel run (PipelineRunner::RunPipelinesParallel) for every replica of this
+	 * consumer, which has processed a different subset of the events. Overwrite this to add the
+	 * results of the replica to the results of this consumer before Finish is called and let
+	 * SupportsMerge return true.
+	 */
+	virtual void Merge(ConsumerBase<TTypes> const& replica, setting_type const& settings, metadata_type const& metadata)
 	{
+		LOG(FATAL) << "Consumer \"" << this->GetConsumerId() << "\" does not support merging the results of parallel runs!";
 	}
 
 	/*
@@ -182,7 +201,7 @@ protected:
 		Process(specSettings, specMetadata);
 	}
 
-	void baseProcessEvent(EventBase const& evt, ProductBase const& prod, SettingsBase const& settings, MetadataBase const& metadata, FilterResult& fres)	override
+	void baseProcessEvent(EventBase const& evt, ProductBase const& prod, SettingsBase const& settings, MetadataBase const& metadata, FilterResult const& fres)	override
 	{
 		event_type const& specEvent = static_cast<event_type const&>(evt);
 		product_type const& specProduct = static_cast<product_type const&>(prod);
@@ -202,6 +221,15 @@ protected:
 		ProcessFilteredEvent(specEvent, specProduct, specSettings, specMetadata);
 	}
 
+	void baseMerge(ConsumerBaseUntemplated const& replica, SettingsBase const& settings, MetadataBase const& metadata) override
+	{
+		ConsumerBase<TTypes> const& specReplica = static_cast<ConsumerBase<TTypes> const&>(replica);
+		setting_type const& specSettings = static_cast<setting_type const&>(settings);
+		metadata_type const& specMetadata = static_cast<metadata_type const&>(metadata);
+
+		this->Merge(specReplica, specSettings, specMetadata);
+	}
+
 	void baseFinish(SettingsBase const& settings, MetadataBase const& metadata) override
 	{
 		setting_type const& specSettings = static_cast<setting_type const&>(settings);
@@ -19,6 +19,9 @@ public:
 	// sum up all passed events per filter
 	void AddFilterResult(FilterResult const& fres);
 
+	// add the counts of another cut flow, e.g. from a parallel run
+	void Merge(CutFlow const& other);
+
 	CutStat * GetCutEntry(std::string const& filterName);
 
 	CutCount const& GetCutCount() const;
@@ -0,0 +1,80 @@
+#pragma once
+
+#include <string>
+#include <vector>
+
+/**
+   \brief Named weights of an event, e.g. the weights which are multiplied into the event weight.
+
+   Every weight name has a fixed index (GetIndex), which is requested once during the initialisation
+   of the producers and consumers, such that setting and reading a weight in the event loop is only
+   an array access. The indices are shared by all weight containers of the process.
+
+   Weights which are not set have the value 1, so that the product of all weights (GetProduct) is a
+   multiplication over a flat array. Copies take over all weights (e.g. the weights of the global
+   product are copied into the products of the pipelines), without allocating once the storage of
+   the copy is large enough.
+*/
+class EventWeights {
+public:
+
+	// index of a weight name, the same name always gets the same index
+	static size_t GetIndex(std::string const& name);
+	static std::string GetName(size_t index);
+
+	bool Contains(size_t index) const
+	{
+		return ((index < m_isSet.size()) && m_isSet[index]);
+	}
+
+	double GetWithDefault(size_t index, double defaultValue) const
+	{
+		return (Contains(index) ? m_values[index] : defaultValue);
+	}
+
+	void Set(size_t index, double value)
+	{
+		if (index >= m_values.size())
+		{
+			m_values.resize(index + 1, 1.0);
+			m_isSet.resize(index + 1, false);
+		}
+		m_values[index] = value;
+		m_isSet[index] = true;
+	}
+
+	// product of all weights which are set
+	double GetProduct() const
+	{
+		double product = 1.0;
+		for (double value : m_values)
+		{
+			product *= value;
+		}
+		return product;
+	}
+
+	// indices of all weights which are set
+	std::vector<size_t> GetIndices() const;
+
+	// access by name, which looks up the index every time
+	bool Contains(std::string const& name) const
+	{
+		return Contains(GetIndex(name));
+	}
+
+	double GetWithDefault(std::string const& name, double defaultValue) const
+	{
+		return GetWithDefault(GetIndex(name), defaultValue);
+	}
+
+	void Set(std::string const& name, double value)
+	{
+		Set(GetIndex(name), value);
+	}
+
+private:
+
+	std::vector<double> m_values;
+	std::vector<bool> m_isSet;
+};
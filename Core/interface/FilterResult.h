@@ -1,11 +1,22 @@
-
 #pragma once
 
-#include <list>
+#include <cstdint>
+#include <memory>
+#include <string>
+#include <unordered_map>
 #include <vector>
 
 #include "Artus/Utility/interface/ArtusLogging.h"
 
+/**
+   \brief Decisions of all filters which have been run on an event.
+
+   The filter names are interned: each name is assigned a fixed index when it is added for the first
+   time, and the decisions are stored as bits at these indices. Copies of a filter result share the
+   (immutable) list of filter names, such that copying a filter result only copies a few integers.
+   The name based methods are convenient but involve a hash lookup, code running for every event
+   should resolve the indices once with GetFilterIndex/AddFilterName and use the index based methods.
+*/
 class FilterResult {
 public:
 
@@ -13,7 +24,6 @@ public:
 	enum class TaggingMode { Tagging, Filtering };
 
 	typedef std::vector <std::string> FilterNames;
-	//typedef std::map<std::string, Decision> FilterDecisions;
 	struct DecisionEntry
 	{
 		std::string filterName;
@@ -23,39 +33,80 @@ public:
 		DecisionEntry(std::string filterName, Decision filterDecision, TaggingMode taggingMode);
 	};
 
-	typedef std::list<DecisionEntry> FilterDecisions;
+	typedef std::vector<DecisionEntry> FilterDecisions;
+
+	// returned by GetFilterIndex for unknown filter names
+	static const size_t NotFound;
 
 	FilterResult();
 	explicit FilterResult(FilterNames const& initialFilterNames);
 	FilterResult(FilterNames const& initialFilterNames, FilterNames const& taggingFilters );
 
-	DecisionEntry * GetDecisionEntry( std::string const& filterName );
-	DecisionEntry const* GetDecisionEntry( std::string const& filterName ) const;
+	// index of a filter name, NotFound if the name is not known
+	size_t GetFilterIndex(std::string const& filterName) const;
+
+	// index of a filter name, the name is added with an undefined decision if it is not known
+	size_t AddFilterName(std::string const& filterName);
 
 	// add a list of filter names
 	// will only add and set the decision to undefined, if the
 	// name is not in the list before
 	void AddFilterNames( FilterNames const& fn);
 	void AddFilterNames( FilterNames const& fn, FilterNames const& taggingFilters);
-	
+
+	// use the filter names of baseFilterResult followed by the given ones and reset all decisions
+	// afterwards, the decisions of baseFilterResult (and of other filter results sharing its
+	// filter names) can be taken over by CopyDecisions
+	void ExtendFilterNames(FilterResult const& baseFilterResult, FilterNames const& fn, FilterNames const& taggingFilters);
+
+	// true, if this filter result has been prepared with ExtendFilterNames for the
+	// filter names of baseFilterResult
+	bool ExtendsFilterNames(FilterResult const& baseFilterResult) const;
+
+	// take over all decisions of baseFilterResult and reset the decisions of the additional filters
+	void CopyDecisions(FilterResult const& baseFilterResult);
+
+	// set all decisions to undefined
+	void ResetDecisions();
+
 	// list of all filter names as a vector of strings
-	FilterNames GetFilterNames() const;
-	
+	FilterNames const& GetFilterNames() const;
+	size_t GetNumberOfFilters() const;
+	std::string const& GetFilterName(size_t filterIndex) const;
+
 	bool HasPassed() const;
 	bool HasPassedIfExcludingFilter(std::string const& excludedFilter) const;
+	bool HasPassedIfExcludingFilter(size_t excludedFilterIndex) const;
 	TaggingMode IsTaggingFilter(std::string const& filterName) const;
+	TaggingMode GetTaggingMode(size_t filterIndex) const;
 	Decision GetFilterDecision(std::string filterName) const;
-	FilterDecisions const& GetFilterDecisions() const;
+	Decision GetFilterDecision(size_t filterIndex) const;
+	FilterDecisions GetFilterDecisions() const;
 	void SetFilterDecision(std::string filterName, bool passed);
+	void SetFilterDecision(size_t filterIndex, bool passed);
 	std::string ToString() const;
 	std::string DecisionToString ( Decision dc ) const;
 
 private:
 
-	// optimize this, without strings
-	FilterNames m_taggingFilters;
-	FilterDecisions m_filterDecisions;
+	typedef std::vector<uint64_t> DecisionBits;
+
+	// interned filter names, shared between all copies of a filter result
+	struct FilterNamesIndex
+	{
+		FilterNames filterNames;
+		std::unordered_map<std::string, size_t> filterIndices;
+		FilterNames taggingFilters;
+		// bit set for all filters in filtering mode
+		DecisionBits filteringMask;
+		// filter names this list has been extended from
+		std::shared_ptr<FilterNamesIndex const> baseFilterNames;
+	};
+
+	static std::shared_ptr<FilterNamesIndex> const& GetEmptyFilterNames();
+	FilterNamesIndex& GetMutableFilterNames();
 
-	mutable bool m_cacheHasPassed;
-	mutable bool m_IsCachedHasPassed;
+	std::shared_ptr<FilterNamesIndex> m_filterNames;
+	DecisionBits m_passed;
+	DecisionBits m_notPassed;
 };
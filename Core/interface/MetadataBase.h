@@ -1,12 +1,16 @@
 #pragma once
 
 #include <functional>
+#include <map>
+#include <string>
+#include <vector>
 
 #include <Math/Vector4D.h>
 #include <Math/Vector4Dfwd.h>
 
 #include "Artus/Core/interface/EventBase.h"
 #include "Artus/Core/interface/ProductBase.h"
+#include "Artus/Core/interface/RunTimeStatistics.h"
 
 
 typedef ROOT::Math::LorentzVector<ROOT::Math::PtEtaPhiM4D<float> > RMFLV;
@@ -48,5 +52,24 @@ public:
 	std::map<std::string, vRMFLV_extractor_lambda_base> m_commonVRMFLVQuantities;
 	std::map<std::string, vString_extractor_lambda_base> m_commonVStringQuantities;
 	std::map<std::string, vInt_extractor_lambda_base> m_commonVIntQuantities;
+
+	// names of the event members read by the quantities (see ProcessNodeBase::GetRequiredEventMembers),
+	// the members are only required by consumers writing out the quantity
+	std::map<std::string, std::vector<std::string> > m_eventMembersOfQuantities;
+
+	// cache the values of the quantities in the product (see QuantityCache),
+	// set from the setting MemoiseQuantities before the processors are initialised
+	bool m_memoiseQuantities = false;
+
+	// run times of the global processors, of the processors of the pipeline and of the processors
+	// of the shared stage the pipeline starts from (if any), only filled if the setting
+	// RunTimeMeasurement is enabled
+	RunTimeStatistics const* m_globalRunTimeStatistics = nullptr;
+	RunTimeStatistics const* m_runTimeStatistics = nullptr;
+	RunTimeStatistics const* m_sharedStageRunTimeStatistics = nullptr;
+
+	// run times of a processor, the local processors are looked up first, since they may shadow
+	// the shared and global ones with the same name
+	RunTimeStatistics::ProcessorStatistics const* GetProcessorRunTimeStatistics(std::string const& processor) const;
 };
 
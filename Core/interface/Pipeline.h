@@ -2,7 +2,10 @@
 #pragma once
 
 #include <vector>
+#include <set>
+#include <string>
 #include <sstream>
+#include <utility>
 #include <time.h>
 
 #include <boost/noncopyable.hpp>
@@ -12,6 +15,7 @@
 #include "FilterBase.h"
 #include "ConsumerBase.h"
 #include "ProducerBase.h"
+#include "RunTimeStatistics.h"
 
 template<class TTypes>
 class Pipeline;
@@ -108,6 +112,13 @@ public:
 
 		m_pipelineSettings = pset;
 		m_metadata = globalMetadata;
+
+		// the run time measurement is decided once, such that it costs only
+		// a single check per processor and event if it is disabled
+		m_measureRunTime = pset.GetRunTimeMeasurement();
+		m_runTimeStatistics = RunTimeStatistics();
+		m_metadata.m_runTimeStatistics = &m_runTimeStatistics;
+		m_metadata.m_sharedStageRunTimeStatistics = ((m_sharedStage != nullptr) ? &(m_sharedStage->m_runTimeStatistics) : nullptr);
 		
 		initializer.InitPipeline(this, pset, m_metadata);
 
@@ -136,6 +147,37 @@ public:
 		// store the filter names for later use in RunEvent
 		m_filterNames = pset.GetFilters();
 		m_taggingFilters = pset.GetTaggingFilters();
+		// the filter names are added to the ones of the global filter result in the first event
+		m_localFilterResult = FilterResult();
+	}
+
+	/// Initialize this pipeline as a shared stage, i.e. a pipeline without consumers, which runs the
+	/// leading processors of several pipelines once per event (see SetSharedStage). Only the filters of
+	/// the stage itself are added to its filter result.
+	virtual void InitSharedStage(setting_type pset, metadata_type globalMetadata)
+	{
+		InitPipeline(pset, globalMetadata, PipelineInitilizerBase<TTypes>());
+
+		m_filterNames.clear();
+		for (ProcessNodeIterator processNode = m_nodes.begin(); processNode != m_nodes.end(); ++processNode)
+		{
+			if (processNode->GetProcessNodeType() == ProcessNodeType::Filter)
+			{
+				m_filterNames.push_back(static_cast<FilterForThisPipeline&>(*processNode).GetFilterId());
+			}
+		}
+	}
+
+	/// Let this pipeline start from the product and filter result of a shared stage instead of the
+	/// global ones. The stage contains the leading processors, which this pipeline has in common with
+	/// others and it must have been run (RunSharedStage) before RunEvent is called for the same event.
+	/// The stage is not owned by this pipeline.
+	virtual void SetSharedStage(Pipeline<TTypes>* sharedStage)
+	{
+		m_sharedStage = sharedStage;
+
+		// the run times of the shared processors are found via the metadata of this pipeline
+		m_metadata.m_sharedStageRunTimeStatistics = ((m_sharedStage != nullptr) ? &(m_sharedStage->m_runTimeStatistics) : nullptr);
 	}
 
 	/// Useful debug output of the Pipeline Content.
@@ -157,6 +199,39 @@ public:
 		return s.str();
 	}
 
+	/// Add the consumer results of a replica of this pipeline, which has been set up with the same
+	/// consumers but has processed a different subset of the events. Called before FinishPipeline.
+	virtual void MergePipeline(Pipeline<TTypes> const& replica)
+	{
+		if (replica.m_consumer.size() != m_consumer.size())
+		{
+			LOG(FATAL) << "Replica of pipeline \"" << GetSettings().GetName() << "\" has a different number of consumers!";
+		}
+
+		m_runTimeStatistics.Merge(replica.m_runTimeStatistics);
+
+		typename ConsumerVector::const_iterator replicaConsumer = replica.m_consumer.begin();
+		for (ConsumerForThisPipeline& consumer : m_consumer)
+		{
+			ConsumerBaseAccess(consumer).Merge(*replicaConsumer, GetSettings(), m_metadata);
+			++replicaConsumer;
+		}
+	}
+
+	/// Ids of the consumers of this pipeline, which cannot merge the results of replicas (see ConsumerBase::Merge).
+	std::vector<std::string> GetConsumersWithoutMerge() const
+	{
+		std::vector<std::string> consumerIds;
+		for (ConsumerForThisPipeline const& consumer : m_consumer)
+		{
+			if (! consumer.SupportsMerge())
+			{
+				consumerIds.push_back(consumer.GetConsumerId());
+			}
+		}
+		return consumerIds;
+	}
+
 	/// Called once all events have been passed to the pipeline.
 	virtual void FinishPipeline()
 	{
@@ -180,73 +255,18 @@ public:
 	/// common for all pipelines and have therefore been created only once.
 	virtual bool RunEvent(event_type const& evt, product_type const& globalProduct, FilterResult const& globalFilterResult)
 	{
-		// make a local copy of the global product/filter result
-		// and allow this one to be modified by local producers/filters.
-		product_type localProduct(globalProduct);
-		FilterResult localFilterResult(globalFilterResult);
-		localFilterResult.AddFilterNames(m_filterNames, m_taggingFilters);
-
-		// run Filters & Producers
-		for (ProcessNodeIterator processNode = m_nodes.begin(); processNode != m_nodes.end(); ++processNode)
+		product_type& localProduct = (m_sharedStage == nullptr) ?
+		                             PrepareLocalProduct(globalProduct, globalFilterResult) :
+		                             PrepareLocalProduct(m_sharedStage->m_localProduct, m_sharedStage->m_localFilterResult);
+		FilterResult& localFilterResult = localProduct.fres;
+		if (m_sharedStage != nullptr)
 		{
-			// variables for runtime measurement
-			timeval tStart, tEnd;
-			int runTime;
-
-			// stop processing as soon as one filter fails
-			// but the consumers will still be processed
-			// this will also stop processing, if a global filter
-			// already failed
-			if (! localFilterResult.HasPassed())
-			{
-				break;
-			}
-
-			if (processNode->GetProcessNodeType () == ProcessNodeType::Producer)
-			{
-				ProducerForThisPipeline& prod = static_cast<ProducerForThisPipeline&>(*processNode);
-				gettimeofday(&tStart, nullptr);
-				
-				if (globalProduct.newRun)
-				{
-					ProducerBaseAccess(prod).OnRun(evt, m_pipelineSettings, m_metadata);
-				}
-				if (globalProduct.newLumisection)
-				{
-						ProducerBaseAccess(prod).OnLumi(evt, m_pipelineSettings, m_metadata);
-				}
-				ProducerBaseAccess(prod).Produce(evt, localProduct, m_pipelineSettings, m_metadata);
-				
-				gettimeofday(&tEnd, nullptr);
-				runTime = static_cast<int>(tEnd.tv_sec * 1000000 + tEnd.tv_usec - tStart.tv_sec * 1000000 - tStart.tv_usec);  // a long int might be needed here but SafeMaps for long ints are not yet working
-				localProduct.processorRunTime[prod.GetProducerId()] = runTime;
-			}
-			else if (processNode->GetProcessNodeType () == ProcessNodeType::Filter)
-			{
-				FilterForThisPipeline& flt = static_cast<FilterForThisPipeline&>(*processNode);
-				gettimeofday(&tStart, nullptr);
-				
-				if(globalProduct.newRun)
-				{
-					FilterBaseAccess(flt).OnRun(evt, m_pipelineSettings, m_metadata);
-				}
-				if(globalProduct.newLumisection)
-				{
-					FilterBaseAccess(flt).OnLumi(evt, m_pipelineSettings, m_metadata);
-				}
-				const bool filterResult = FilterBaseAccess(flt).DoesEventPass(evt, localProduct, m_pipelineSettings, m_metadata);
-				localFilterResult.SetFilterDecision(flt.GetFilterId(), filterResult);
-				
-				gettimeofday(&tEnd, nullptr);
-				runTime = static_cast<int>(tEnd.tv_sec * 1000000 + tEnd.tv_usec - tStart.tv_sec * 1000000 - tStart.tv_usec);  // a long int might be needed here but SafeMaps for long ints are not yet working
-				localProduct.processorRunTime[flt.GetFilterId()] = runTime;
-			}
-			else
-			{
-				LOG(FATAL) << "ProcessNodeType not supported by the pipeline!";
-			}
+			// the results of the previous pipelines are only known after the stage has been run
+			localProduct.PreviousPipelinesResult = globalProduct.PreviousPipelinesResult;
 		}
-		localProduct.fres = localFilterResult;
+
+		RunProcessNodes(evt, globalProduct, localProduct);
+		const bool hasPassed = localFilterResult.HasPassed();
 
 		// run Consumers
 		for (ConsumerVectorIterator consumer = m_consumer.begin(); consumer != m_consumer.end(); ++consumer)
@@ -259,7 +279,7 @@ public:
 			{
 				ConsumerBaseAccess(*consumer).OnLumi(evt, GetSettings(), m_metadata);
 			}
-			if (localFilterResult.HasPassed())
+			if (hasPassed)
 			{
 				ConsumerBaseAccess(*consumer).ProcessFilteredEvent(evt, localProduct, GetSettings(), m_metadata);
 			}
@@ -267,7 +287,18 @@ public:
 			ConsumerBaseAccess(*consumer).ProcessEvent(evt, localProduct, GetSettings(), m_metadata, localFilterResult);
 		}
 
-		return localFilterResult.HasPassed();
+		std::swap(localProduct.fres, m_localFilterResult);
+		return hasPassed;
+	}
+
+	/// Run only the producers and filters of a shared stage (see InitSharedStage). The product and
+	/// the filter result are kept until the next event as starting point for the pipelines
+	/// using this stage.
+	virtual void RunSharedStage(event_type const& evt, product_type const& globalProduct, FilterResult const& globalFilterResult)
+	{
+		product_type& localProduct = PrepareLocalProduct(globalProduct, globalFilterResult);
+		RunProcessNodes(evt, globalProduct, localProduct);
+		std::swap(localProduct.fres, m_localFilterResult);
 	}
 
 	/// Find and return a Filter by it's id in this pipeline.
@@ -327,6 +358,19 @@ public:
 		return m_metadata;
 	}
 
+	/// Collect the event members read by the filters, producers and consumers of this pipeline.
+	void GetRequiredEventMembers(std::set<std::string>& eventMembers) const
+	{
+		for (ProcessNodeBase const& processNode : m_nodes)
+		{
+			processNode.GetRequiredEventMembers(eventMembers);
+		}
+		for (ConsumerForThisPipeline const& consumer : m_consumer)
+		{
+			consumer.GetRequiredEventMembers(eventMembers);
+		}
+	}
+
 	/// Return a list of filters is this pipeline.
 	/*
 	 * disabled for now, if you need this again, contact Thomas
@@ -335,11 +379,147 @@ public:
 	}*/
 
 private:
+	// Make a local copy of the base product/filter result (the global ones or the ones of
+	// the shared stage) and allow this one to be modified by local producers/filters.
+	// The local product is kept between events, such that the memory already
+	// allocated by its containers is reused by the assignment. Large product members
+	// can be wrapped in CopyOnWrite (Utility/interface/CopyOnWrite.h) in order to share
+	// them with the global product as long as no local producer writes to them.
+	product_type& PrepareLocalProduct(product_type const& baseProduct, FilterResult const& baseFilterResult)
+	{
+		m_localProduct = baseProduct;
+
+		// The filter result of this pipeline is the one in the local product (product.fres), the
+		// consumers get a const reference to it. In between the events, it is kept in m_localFilterResult
+		// in order not to be overwritten by the assignment of the base product.
+		std::swap(m_localProduct.fres, m_localFilterResult);
+		FilterResult& localFilterResult = m_localProduct.fres;
+
+		// the filter names of this pipeline are only added once for the filter names of the
+		// base filter result, afterwards only the decisions need to be copied for every event
+		if (! localFilterResult.ExtendsFilterNames(baseFilterResult))
+		{
+			InitNodeIndices(localFilterResult, baseFilterResult);
+		}
+		localFilterResult.CopyDecisions(baseFilterResult);
+
+		return m_localProduct;
+	}
+
+	// run Filters & Producers
+	void RunProcessNodes(event_type const& evt, product_type const& globalProduct, product_type& localProduct)
+	{
+		FilterResult& localFilterResult = localProduct.fres;
+		for (ProcessNodeIterator processNode = m_nodes.begin(); processNode != m_nodes.end(); ++processNode)
+		{
+			// stop processing as soon as one filter fails
+			// but the consumers will still be processed
+			// this will also stop processing, if a global filter
+			// already failed
+			if (! localFilterResult.HasPassed())
+			{
+				break;
+			}
+
+			if (processNode->GetProcessNodeType () == ProcessNodeType::Producer)
+			{
+				ProducerForThisPipeline& prod = static_cast<ProducerForThisPipeline&>(*processNode);
+				RunTimeStatistics::Clock::time_point tStart;
+				if (m_measureRunTime)
+				{
+					tStart = RunTimeStatistics::Clock::now();
+				}
+				
+				if (globalProduct.newRun)
+				{
+					ProducerBaseAccess(prod).OnRun(evt, m_pipelineSettings, m_metadata);
+				}
+				if (globalProduct.newLumisection)
+				{
+						ProducerBaseAccess(prod).OnLumi(evt, m_pipelineSettings, m_metadata);
+				}
+				ProducerBaseAccess(prod).Produce(evt, localProduct, m_pipelineSettings, m_metadata);
+				localProduct.quantityCache.Invalidate();
+				
+				if (m_measureRunTime)
+				{
+					m_runTimeStatistics.AddRunTime(m_nodeRunTimeSlots[processNode - m_nodes.begin()], tStart, RunTimeStatistics::Clock::now());
+				}
+			}
+			else if (processNode->GetProcessNodeType () == ProcessNodeType::Filter)
+			{
+				FilterForThisPipeline& flt = static_cast<FilterForThisPipeline&>(*processNode);
+				RunTimeStatistics::Clock::time_point tStart;
+				if (m_measureRunTime)
+				{
+					tStart = RunTimeStatistics::Clock::now();
+				}
+				
+				if(globalProduct.newRun)
+				{
+					FilterBaseAccess(flt).OnRun(evt, m_pipelineSettings, m_metadata);
+				}
+				if(globalProduct.newLumisection)
+				{
+					FilterBaseAccess(flt).OnLumi(evt, m_pipelineSettings, m_metadata);
+				}
+				const bool filterResult = FilterBaseAccess(flt).DoesEventPass(evt, localProduct, m_pipelineSettings, m_metadata);
+				localFilterResult.SetFilterDecision(m_nodeFilterIndices[processNode - m_nodes.begin()], filterResult);
+				localProduct.quantityCache.Invalidate();
+				
+				if (m_measureRunTime)
+				{
+					m_runTimeStatistics.AddRunTime(m_nodeRunTimeSlots[processNode - m_nodes.begin()], tStart, RunTimeStatistics::Clock::now());
+				}
+			}
+			else
+			{
+				LOG(FATAL) << "ProcessNodeType not supported by the pipeline!";
+			}
+		}
+	}
+
+	// intern the filter names of this pipeline in the local filter result
+	// and resolve the indices of the decisions and run time slots of the nodes
+	void InitNodeIndices(FilterResult& localFilterResult, FilterResult const& globalFilterResult)
+	{
+		localFilterResult.ExtendFilterNames(globalFilterResult, m_filterNames, m_taggingFilters);
+
+		m_nodeFilterIndices.clear();
+		m_nodeRunTimeSlots.clear();
+		for (ProcessNodeIterator processNode = m_nodes.begin(); processNode != m_nodes.end(); ++processNode)
+		{
+			if (processNode->GetProcessNodeType () == ProcessNodeType::Filter)
+			{
+				FilterForThisPipeline& flt = static_cast<FilterForThisPipeline&>(*processNode);
+				m_nodeFilterIndices.push_back(localFilterResult.AddFilterName(flt.GetFilterId()));
+				m_nodeRunTimeSlots.push_back(m_runTimeStatistics.AddProcessor(flt.GetFilterId()));
+			}
+			else if (processNode->GetProcessNodeType () == ProcessNodeType::Producer)
+			{
+				ProducerForThisPipeline& prod = static_cast<ProducerForThisPipeline&>(*processNode);
+				m_nodeFilterIndices.push_back(FilterResult::NotFound);
+				m_nodeRunTimeSlots.push_back(m_runTimeStatistics.AddProcessor(prod.GetProducerId()));
+			}
+			else
+			{
+				LOG(FATAL) << "ProcessNodeType not supported by the pipeline!";
+			}
+		}
+	}
+
 	ConsumerVector m_consumer;
 	ProcessNodeVector m_nodes;
 	setting_type m_pipelineSettings;
 	std::vector<std::string> m_filterNames;
 	std::vector<std::string> m_taggingFilters;
 	metadata_type m_metadata;
+	product_type m_localProduct;
+	FilterResult m_localFilterResult;
+	std::vector<size_t> m_nodeFilterIndices;
+	bool m_measureRunTime = false;
+	RunTimeStatistics m_runTimeStatistics;
+	std::vector<size_t> m_nodeRunTimeSlots;
+	Pipeline<TTypes>* m_sharedStage = nullptr;
 };
 
@@ -2,11 +2,14 @@
 #pragma once
 
 #include <thread>
+#include <atomic>
 #include <vector>
+#include <set>
 #include <algorithm>
 #include <unistd.h>
 #include <map>
-#include <sys/time.h>
+
+#include <TROOT.h>
 
 #include <boost/noncopyable.hpp>
 #include <boost/ptr_container/ptr_list.hpp>
@@ -17,6 +20,7 @@
 #include "Artus/Core/interface/FilterResult.h"
 #include "Artus/Core/interface/OsSignalHandler.h"
 #include "Artus/Core/interface/MetadataBase.h"
+#include "Artus/Core/interface/RunTimeStatistics.h"
 
 /**
  \brief Class to manage all registered Pipelines and to connect them to the event.
@@ -26,6 +30,10 @@
  as an argument. Furthermore, Producers can be registered, which can generate Pipeline-
  independet products of the event. These Producers are run before any pipeline is started
  and the generated data is passed on to the pipelines.
+
+ With PipelineRunner::RunPipelinesParallel, the events are distributed over several threads. Each
+ thread processes its events with an independent replica of the runner (see AddReplica) and the
+ consumer results of all replicas are merged before the pipelines are finished.
  */
 template<typename TPipeline, typename TTypes>
 class PipelineRunner: public boost::noncopyable
@@ -42,6 +50,9 @@ public:
 		// use AddProgressReport / ClearProgressReports to adapt it to your needs
 		AddProgressReport(new ConsoleProgressReport());
 
+		// the consumers find the run times of the global nodes via the metadata
+		m_globalMetadata.m_globalRunTimeStatistics = &m_globalRunTimeStatistics;
+
 		// register on signals to allow for a graceful shutdown if the user
 		// requests it
 		if (m_registerSignalHandler)
@@ -83,6 +94,14 @@ public:
 		m_pipelines.push_back(pline);
 	}
 
+	/// Add a shared stage, which runs the leading processors common to several level one pipelines
+	/// once per event (see Pipeline::SetSharedStage). The stages are run in the order they are added,
+	/// before the pipelines. The object is destroyed in the destructor of the PipelineRunner.
+	void AddSharedStage(TPipeline* stage)
+	{
+		m_sharedStages.push_back(stage);
+	}
+
 	/// Add a filter. The object is destroyed in the destructor of the PipelineRunner.
 	// the execution order of AddGlobalFilter and AddGlobalProducer is defined by the order
 	// this methods are called
@@ -108,6 +127,15 @@ public:
 		}
 	}
 
+	/// Add a replica of this runner, which is only used by RunPipelinesParallel. The replica must
+	/// contain the same global nodes and pipelines in the same order, e.g. by calling
+	/// ArtusConfig::LoadConfiguration a second time. Its consumers should write to a separate
+	/// output file. The object is destroyed in the destructor of the PipelineRunner.
+	void AddReplica(PipelineRunner<TPipeline, TTypes>* replica)
+	{
+		m_replicas.push_back(replica);
+	}
+
 	/// Run the Producers and all pipelines. Give any pipeline setting here: only the
 	/// producer will read from the settings ...
 	template<class TEventProvider>
@@ -120,24 +148,11 @@ public:
 		{
 			nEvents = processNEvents;
 		}
-		const std::vector<std::string> globlalFilterIds = settings.GetFilters();
-		const std::vector<std::string> taggingFilters = settings.GetTaggingFilters();
 
-		// initialize pline filter decision
-		FilterResult::FilterNames pipelineResultNames(m_pipelines.size());
-		std::transform(m_pipelines.begin(), m_pipelines.end(), pipelineResultNames.begin(),
-		               [](pipeline_type const& p) -> std::string { return p.GetSettings().GetName(); });
+		// initialize global and pipeline filter decisions
+		InitFilterResults(settings);
+		InitRunTimeMeasurement(settings);
 
-		std::vector<std::string> pipelineResultNamesSorted = pipelineResultNames;
-		// must be sorted to perform the unique option
-		// but don't use the sorted strings later on
-		std::sort(pipelineResultNamesSorted.begin(), pipelineResultNamesSorted.end());
-		std::vector<std::string>::iterator itUnq = std::unique(pipelineResultNamesSorted.begin(), pipelineResultNamesSorted.end());
-		if (itUnq != pipelineResultNamesSorted.end())
-		{
-			LOG(FATAL)<< "Pipeline name '" << *itUnq << "' is not unique, but pipeline names must be unique";
-		}
-		
 		// apparently evtProvider.GetEntries() is not reliable. Therefore, if 'ProcessNEvents' is not set (=-1), the loop condition
 		// always evaluates to true (processNEvents<0) = (-1<0) and is terminated via the 'if (!evtProvider.GetEntry(i)) break' statement
 		for (long long iEvent = firstEvent; (iEvent < (firstEvent + nEvents)); ++iEvent)
@@ -159,91 +174,381 @@ public:
 				report->update(iEvent-firstEvent, nEvents);
 			}
 
-			product_type productGlobal;
-			// use the lit of filters to bootstrap the filter list names
-			FilterResult globalFilterResult(globlalFilterIds, taggingFilters);
+			RunEvent(evtProvider, settings);
+		}
+
+		for (ProgressReportIterator report = m_progressReport.begin(); report != m_progressReport.end(); ++report)
+		{
+			report->finish();
+		}
+
+		FinishPipelines();
+	}
 
-			for (ProcessNodesIterator processNode = m_globalNodes.begin(); processNode != m_globalNodes.end(); ++processNode)
+	/// Run the Producers and all pipelines on several threads. This runner and each replica added
+	/// by AddReplica are driven by one worker thread, which reads the events from its own event
+	/// provider (evtProviders[0] for this runner, evtProviders[i] for the i-th replica). The workers
+	/// take blocks of eventBlockSize consecutive events from a shared counter until all events are
+	/// processed. Afterwards, the consumer results of the replicas are merged into the level-1
+	/// pipelines of this runner, before these are finished as in RunPipelines. All consumers of the
+	/// level-1 pipelines must support merging (see ConsumerBase::Merge), which is checked before the
+	/// events are processed.
+	template<class TEventProvider>
+	void RunPipelinesParallel(std::vector<TEventProvider*> const& evtProviders, setting_type const& settings,
+	                          long long eventBlockSize = 1000)
+	{
+		if (evtProviders.size() != m_replicas.size() + 1)
+		{
+			LOG(FATAL) << "Parallel run with " << (m_replicas.size() + 1) << " pipeline runners requires as many event providers, but "
+			           << evtProviders.size() << " are given!";
+		}
+		for (PipelineRunner<TPipeline, TTypes> const& replica : m_replicas)
+		{
+			if ((replica.m_pipelines.size() != m_pipelines.size()) || (replica.m_globalNodes.size() != m_globalNodes.size()) ||
+			    (replica.m_sharedStages.size() != m_sharedStages.size()))
 			{
-				// variables for runtime measurement
-				timeval tStart, tEnd;
-				int runTime;
+				LOG(FATAL) << "Replicas of the pipeline runner must contain the same pipelines and global nodes!";
+			}
+		}
+		for (TPipeline const& pipeline : m_pipelines)
+		{
+			std::vector<std::string> consumersWithoutMerge = pipeline.GetConsumersWithoutMerge();
+			if ((pipeline.GetSettings().GetLevel() == 1) && (! consumersWithoutMerge.empty()))
+			{
+				LOG(FATAL) << "Consumer \"" << consumersWithoutMerge.front() << "\" of pipeline \"" << pipeline.GetSettings().GetName()
+				           << "\" does not support merging the results of parallel runs!";
+			}
+		}
 
-				// stop processing as soon as one filter fails
-				// but the consumers will still be processed
-				if (! globalFilterResult.HasPassed())
-				{
-					break;
-				}
+		// the ROOT objects (e.g. the output trees) are handled by several threads
+		ROOT::EnableThreadSafety();
 
-				event_type currentEvent = evtProvider.GetCurrentEvent();
-				productGlobal.newRun = evtProvider.NewRun();
-				productGlobal.newLumisection = evtProvider.NewLumisection();
-				
-				if (processNode->GetProcessNodeType() == ProcessNodeType::Producer)
+		long long firstEvent = settings.GetFirstEvent();
+		long long nEvents = evtProviders.front()->GetEntries();
+		long long processNEvents = settings.GetProcessNEvents();
+		if (processNEvents > 0)
+		{
+			nEvents = processNEvents;
+		}
+		const long long lastEvent = firstEvent + nEvents;
+
+		std::atomic<long long> nextBlockStart(firstEvent);
+		std::atomic<long long> nProcessedEvents(0);
+		std::atomic<bool> endOfInput(false);
+
+		// the first worker runs this runner and is the only one reporting the progress
+		auto worker = [&](PipelineRunner<TPipeline, TTypes>& runner, TEventProvider& evtProvider, bool reportProgress)
+		{
+			// the settings cache their values on first access and can therefore not be shared
+			setting_type const workerSettings(settings);
+			runner.InitFilterResults(workerSettings);
+			runner.InitRunTimeMeasurement(workerSettings);
+
+			while (! endOfInput.load())
+			{
+				const long long blockStart = nextBlockStart.fetch_add(eventBlockSize);
+				const long long blockEnd = std::min(blockStart + eventBlockSize, lastEvent);
+
+				for (long long iEvent = blockStart; iEvent < blockEnd; ++iEvent)
 				{
-					producer_base_type& prod = static_cast<producer_base_type&>(*processNode);
-					gettimeofday(&tStart, nullptr);
-					
-					if (productGlobal.newRun)
+					if (osHasSIGINT() || (! evtProvider.GetEntry(iEvent)))
 					{
-						ProducerBaseAccess(prod).OnRun(currentEvent, settings, m_globalMetadata);
+						endOfInput.store(true);
+						break;
 					}
-					if (productGlobal.newLumisection)
+
+					runner.RunEvent(evtProvider, workerSettings);
+
+					const long long iProcessedEvent = nProcessedEvents.fetch_add(1);
+					if (reportProgress)
 					{
-						ProducerBaseAccess(prod).OnLumi(currentEvent, settings, m_globalMetadata);
+						for (ProgressReportIterator report = m_progressReport.begin(); report != m_progressReport.end(); ++report)
+						{
+							report->update(iProcessedEvent, nEvents);
+						}
 					}
-					ProducerBaseAccess(prod).Produce(currentEvent, productGlobal, settings, m_globalMetadata);
-					
-					gettimeofday(&tEnd, nullptr);
-					runTime = static_cast<int>(tEnd.tv_sec * 1000000 + tEnd.tv_usec - tStart.tv_sec * 1000000 - tStart.tv_usec);
-					productGlobal.processorRunTime[prod.GetProducerId()] = runTime;
 				}
-				else if ( processNode->GetProcessNodeType () == ProcessNodeType::Filter )
+
+				if (blockEnd >= lastEvent)
 				{
-					filter_base_type& flt = static_cast<filter_base_type&>(*processNode);
-					gettimeofday(&tStart, nullptr);
-					
-					if (productGlobal.newRun)
-					{
-						FilterBaseAccess(flt).OnRun(currentEvent, settings, m_globalMetadata);
-					}
-					if (productGlobal.newLumisection)
-					{
-						FilterBaseAccess(flt).OnLumi(currentEvent, settings, m_globalMetadata);
-					}
-					const bool filterResult = FilterBaseAccess(flt).DoesEventPass(evtProvider.GetCurrentEvent(), productGlobal, settings, m_globalMetadata);
-					globalFilterResult.SetFilterDecision(flt.GetFilterId(), filterResult);
-					
-					gettimeofday(&tEnd, nullptr);
-					runTime = static_cast<int>(tEnd.tv_sec * 1000000 + tEnd.tv_usec - tStart.tv_sec * 1000000 - tStart.tv_usec);
-					productGlobal.processorRunTime[flt.GetFilterId()] = runTime;
+					endOfInput.store(true);
 				}
-				else
+			}
+		};
+
+		std::vector<std::thread> workerThreads;
+		typename boost::ptr_list<PipelineRunner<TPipeline, TTypes> >::iterator replica = m_replicas.begin();
+		for (size_t iReplica = 1; iReplica < evtProviders.size(); ++iReplica, ++replica)
+		{
+			workerThreads.push_back(std::thread(worker, std::ref(*replica), std::ref(*(evtProviders[iReplica])), false));
+		}
+		worker(*this, *(evtProviders.front()), true);
+		for (std::thread& workerThread : workerThreads)
+		{
+			workerThread.join();
+		}
+
+		if (osHasSIGINT())
+		{
+			LOG(INFO)<< "Terminating processing due to received SIGTERM";
+		}
+
+		for (ProgressReportIterator report = m_progressReport.begin(); report != m_progressReport.end(); ++report)
+		{
+			report->finish();
+		}
+
+		// collect the results of all replicas in the level one pipelines of this runner
+		for (PipelineRunner<TPipeline, TTypes> const& replicaRunner : m_replicas)
+		{
+			m_globalRunTimeStatistics.Merge(replicaRunner.m_globalRunTimeStatistics);
+
+			// the shared stages have no consumers, only their run times are merged
+			typename Pipelines::const_iterator replicaStage = replicaRunner.m_sharedStages.begin();
+			for (PipelinesIterator stage = m_sharedStages.begin(); stage != m_sharedStages.end(); ++stage, ++replicaStage)
+			{
+				stage->MergePipeline(*replicaStage);
+			}
+
+			typename Pipelines::const_iterator replicaPipeline = replicaRunner.m_pipelines.begin();
+			for (PipelinesIterator pipeline = m_pipelines.begin(); pipeline != m_pipelines.end(); ++pipeline, ++replicaPipeline)
+			{
+				if (pipeline->GetSettings().GetLevel() == 1)
 				{
-					LOG(FATAL) << "ProcessNodeType not supported by the pipeline runner!";
+					pipeline->MergePipeline(*replicaPipeline);
 				}
 			}
+		}
+
+		FinishPipelines();
+	}
 
-			// run the pipelines
-			FilterResult pipelineFilterRes(pipelineResultNames, taggingFilters);
+	void AddProgressReport(ProgressReportBase* p)
+	{
+		m_progressReport.push_back(p);
+	}
 
-			for (PipelinesIterator pipeline = m_pipelines.begin(); pipeline != m_pipelines.end(); ++pipeline)
+	void ClearProgressReports()
+	{
+		m_progressReport.clear();
+	}
+
+	Pipelines& GetPipelines()
+	{
+		return m_pipelines;
+	}
+
+	ProcessNodes& GetNodes()
+	{
+		return m_globalNodes;
+	}
+	
+	metadata_type& GetGlobalMetadata()
+	{
+		return m_globalMetadata;
+	}
+
+	/// Names of the event members read by any of the global nodes, shared stages and pipelines
+	/// (see ProcessNodeBase::GetRequiredEventMembers). Can be used by the event provider after
+	/// the configuration has been loaded, in order to skip reading all other members.
+	std::set<std::string> GetRequiredEventMembers() const
+	{
+		std::set<std::string> eventMembers;
+		for (ProcessNodeBase const& processNode : m_globalNodes)
+		{
+			processNode.GetRequiredEventMembers(eventMembers);
+		}
+		for (TPipeline const& stage : m_sharedStages)
+		{
+			stage.GetRequiredEventMembers(eventMembers);
+		}
+		for (TPipeline const& pipeline : m_pipelines)
+		{
+			pipeline.GetRequiredEventMembers(eventMembers);
+		}
+		return eventMembers;
+	}
+
+private:
+
+	// names of all pipelines, which are used for the PreviousPipelinesResult
+	FilterResult::FilterNames GetPipelineResultNames() const
+	{
+		FilterResult::FilterNames pipelineResultNames(m_pipelines.size());
+		std::transform(m_pipelines.begin(), m_pipelines.end(), pipelineResultNames.begin(),
+		               [](pipeline_type const& p) -> std::string { return p.GetSettings().GetName(); });
+
+		std::vector<std::string> pipelineResultNamesSorted = pipelineResultNames;
+		// must be sorted to perform the unique option
+		// but don't use the sorted strings later on
+		std::sort(pipelineResultNamesSorted.begin(), pipelineResultNamesSorted.end());
+		std::vector<std::string>::iterator itUnq = std::unique(pipelineResultNamesSorted.begin(), pipelineResultNamesSorted.end());
+		if (itUnq != pipelineResultNamesSorted.end())
+		{
+			LOG(FATAL)<< "Pipeline name '" << *itUnq << "' is not unique, but pipeline names must be unique";
+		}
+		return pipelineResultNames;
+	}
+
+	// prepare the filter results of the global filters and of the level one pipelines
+	// such that only the decisions need to be reset for every event
+	void InitFilterResults(setting_type const& settings)
+	{
+		// use the lit of filters to bootstrap the filter list names
+		m_globalFilterResult = FilterResult(settings.GetFilters(), settings.GetTaggingFilters());
+		m_globalNodeFilterIndices.clear();
+		for (ProcessNodesIterator processNode = m_globalNodes.begin(); processNode != m_globalNodes.end(); ++processNode)
+		{
+			if (processNode->GetProcessNodeType() == ProcessNodeType::Filter)
 			{
-				if (pipeline->GetSettings().GetLevel() == 1)
+				filter_base_type& flt = static_cast<filter_base_type&>(*processNode);
+				m_globalNodeFilterIndices.push_back(m_globalFilterResult.AddFilterName(flt.GetFilterId()));
+			}
+			else
+			{
+				m_globalNodeFilterIndices.push_back(FilterResult::NotFound);
+			}
+		}
+
+		m_pipelineFilterResult = FilterResult(GetPipelineResultNames(), settings.GetTaggingFilters());
+		m_pipelineResultIndices.clear();
+		for (PipelinesIterator pipeline = m_pipelines.begin(); pipeline != m_pipelines.end(); ++pipeline)
+		{
+			m_pipelineResultIndices.push_back(m_pipelineFilterResult.GetFilterIndex(pipeline->GetSettings().GetName()));
+		}
+	}
+
+	// decide once whether the run times of the global nodes are measured and resolve their slots
+	void InitRunTimeMeasurement(setting_type const& settings)
+	{
+		m_measureRunTime = settings.GetRunTimeMeasurement();
+		m_globalNodeRunTimeSlots.clear();
+		for (ProcessNodesIterator processNode = m_globalNodes.begin(); processNode != m_globalNodes.end(); ++processNode)
+		{
+			if (processNode->GetProcessNodeType() == ProcessNodeType::Producer)
+			{
+				producer_base_type& prod = static_cast<producer_base_type&>(*processNode);
+				m_globalNodeRunTimeSlots.push_back(m_globalRunTimeStatistics.AddProcessor(prod.GetProducerId()));
+			}
+			else if (processNode->GetProcessNodeType() == ProcessNodeType::Filter)
+			{
+				filter_base_type& flt = static_cast<filter_base_type&>(*processNode);
+				m_globalNodeRunTimeSlots.push_back(m_globalRunTimeStatistics.AddProcessor(flt.GetFilterId()));
+			}
+			else
+			{
+				LOG(FATAL) << "ProcessNodeType not supported by the pipeline runner!";
+			}
+		}
+	}
+
+	// run the global nodes and the level one pipelines on the current event of the provider
+	template<class TEventProvider>
+	void RunEvent(TEventProvider& evtProvider, setting_type const& settings)
+	{
+		product_type productGlobal;
+		FilterResult& globalFilterResult = m_globalFilterResult;
+		globalFilterResult.ResetDecisions();
+
+		// the event is only accessed by reference, copying it would be
+		// a considerable overhead for large event contents
+		event_type const& currentEvent = evtProvider.GetCurrentEvent();
+		productGlobal.newRun = evtProvider.NewRun();
+		productGlobal.newLumisection = evtProvider.NewLumisection();
+
+		std::vector<size_t>::const_iterator globalFilterIndex = m_globalNodeFilterIndices.begin();
+		std::vector<size_t>::const_iterator runTimeSlot = m_globalNodeRunTimeSlots.begin();
+		for (ProcessNodesIterator processNode = m_globalNodes.begin(); processNode != m_globalNodes.end(); ++processNode, ++globalFilterIndex, ++runTimeSlot)
+		{
+			// stop processing as soon as one filter fails
+			// but the consumers will still be processed
+			if (! globalFilterResult.HasPassed())
+			{
+				break;
+			}
+
+			if (processNode->GetProcessNodeType() == ProcessNodeType::Producer)
+			{
+				producer_base_type& prod = static_cast<producer_base_type&>(*processNode);
+				RunTimeStatistics::Clock::time_point tStart;
+				if (m_measureRunTime)
+				{
+					tStart = RunTimeStatistics::Clock::now();
+				}
+				
+				if (productGlobal.newRun)
+				{
+					ProducerBaseAccess(prod).OnRun(currentEvent, settings, m_globalMetadata);
+				}
+				if (productGlobal.newLumisection)
+				{
+					ProducerBaseAccess(prod).OnLumi(currentEvent, settings, m_globalMetadata);
+				}
+				ProducerBaseAccess(prod).Produce(currentEvent, productGlobal, settings, m_globalMetadata);
+				productGlobal.quantityCache.Invalidate();
+				
+				if (m_measureRunTime)
 				{
-					productGlobal.PreviousPipelinesResult = pipelineFilterRes;
-					bool result = pipeline->RunEvent(evtProvider.GetCurrentEvent(), productGlobal, globalFilterResult);
-					pipelineFilterRes.SetFilterDecision(pipeline->GetSettings().GetName(), result);
+					m_globalRunTimeStatistics.AddRunTime(*runTimeSlot, tStart, RunTimeStatistics::Clock::now());
 				}
 			}
+			else if ( processNode->GetProcessNodeType () == ProcessNodeType::Filter )
+			{
+				filter_base_type& flt = static_cast<filter_base_type&>(*processNode);
+				RunTimeStatistics::Clock::time_point tStart;
+				if (m_measureRunTime)
+				{
+					tStart = RunTimeStatistics::Clock::now();
+				}
+				
+				if (productGlobal.newRun)
+				{
+					FilterBaseAccess(flt).OnRun(currentEvent, settings, m_globalMetadata);
+				}
+				if (productGlobal.newLumisection)
+				{
+					FilterBaseAccess(flt).OnLumi(currentEvent, settings, m_globalMetadata);
+				}
+				const bool filterResult = FilterBaseAccess(flt).DoesEventPass(currentEvent, productGlobal, settings, m_globalMetadata);
+				globalFilterResult.SetFilterDecision(*globalFilterIndex, filterResult);
+				productGlobal.quantityCache.Invalidate();
+				
+				if (m_measureRunTime)
+				{
+					m_globalRunTimeStatistics.AddRunTime(*runTimeSlot, tStart, RunTimeStatistics::Clock::now());
+				}
+			}
+			else
+			{
+				LOG(FATAL) << "ProcessNodeType not supported by the pipeline runner!";
+			}
 		}
 
-		for (ProgressReportIterator report = m_progressReport.begin(); report != m_progressReport.end(); ++report)
+		// run the pipelines
+		// the results of the pipelines are directly stored in the global product, such that
+		// every pipeline sees the results of all previous pipelines
+		productGlobal.PreviousPipelinesResult = m_pipelineFilterResult;
+
+		// the processors shared by several pipelines are run only once
+		for (PipelinesIterator stage = m_sharedStages.begin(); stage != m_sharedStages.end(); ++stage)
 		{
-			report->finish();
+			stage->RunSharedStage(currentEvent, productGlobal, globalFilterResult);
+		}
+
+		std::vector<size_t>::const_iterator pipelineResultIndex = m_pipelineResultIndices.begin();
+		for (PipelinesIterator pipeline = m_pipelines.begin(); pipeline != m_pipelines.end(); ++pipeline, ++pipelineResultIndex)
+		{
+			if (pipeline->GetSettings().GetLevel() == 1)
+			{
+				bool result = pipeline->RunEvent(currentEvent, productGlobal, globalFilterResult);
+				productGlobal.PreviousPipelinesResult.SetFilterDecision(*pipelineResultIndex, result);
+			}
 		}
+	}
 
+	// finish the level one pipelines and run the pipelines of higher levels
+	void FinishPipelines()
+	{
 		// first safe the results ( > plots ) from all level one pipelines
 		for (PipelinesIterator pipeline = m_pipelines.begin(); pipeline != m_pipelines.end(); ++pipeline)
 		{
@@ -282,37 +587,24 @@ public:
 		}
 	}
 
-	void AddProgressReport(ProgressReportBase* p)
-	{
-		m_progressReport.push_back(p);
-	}
-
-	void ClearProgressReports()
-	{
-		m_progressReport.clear();
-	}
-
-	Pipelines& GetPipelines()
-	{
-		return m_pipelines;
-	}
-
-	ProcessNodes& GetNodes()
-	{
-		return m_globalNodes;
-	}
-	
-	metadata_type& GetGlobalMetadata()
-	{
-		return m_globalMetadata;
-	}
-
-private:
-
 	Pipelines m_pipelines;
+	Pipelines m_sharedStages;
 	ProcessNodes m_globalNodes;
 	ProgressReportList m_progressReport;
 	bool m_registerSignalHandler;
 	metadata_type m_globalMetadata;
+	boost::ptr_list<PipelineRunner<TPipeline, TTypes> > m_replicas;
+
+	// reused for every event, see InitFilterResults
+	// (the pipeline filter result only provides the filter names for PreviousPipelinesResult)
+	FilterResult m_globalFilterResult;
+	FilterResult m_pipelineFilterResult;
+	std::vector<size_t> m_globalNodeFilterIndices;
+	std::vector<size_t> m_pipelineResultIndices;
+
+	// see InitRunTimeMeasurement
+	bool m_measureRunTime = false;
+	RunTimeStatistics m_globalRunTimeStatistics;
+	std::vector<size_t> m_globalNodeRunTimeSlots;
 };
 
@@ -1,5 +1,7 @@
-
 #pragma once
+#include <set>
+#include <string>
+
 #include <boost/noncopyable.hpp>
 
 enum class ProcessNodeType {
@@ -14,4 +16,13 @@ public:
 	virtual ~ProcessNodeBase();
 
 	virtual  ProcessNodeType GetProcessNodeType () const = 0;
+
+	/// Add the names of the event members, which are read by this node, to eventMembers.
+	/// This is called after Init. The names are defined by the event provider (e.g. the names
+	/// of the settings configuring the input collections), which can skip reading all members
+	/// not required by any node.
+	virtual void GetRequiredEventMembers(std::set<std::string>& eventMembers) const
+	{
+	}
 };
+
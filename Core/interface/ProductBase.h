@@ -2,14 +2,17 @@
 
 #include <map>
 #include "FilterResult.h"
+#include "QuantityCache.h"
 
 struct ProductBase
 {
 	// TODO: Is PreviousPipelinesResult really necessary?
 	FilterResult PreviousPipelinesResult;
 	FilterResult fres;
-	std::map<std::string, int> processorRunTime;
 	bool newLumisection;
 	bool newRun;
+
+	// values of the lambda quantities evaluated for the current state of this product
+	mutable QuantityCache quantityCache;
 };
 
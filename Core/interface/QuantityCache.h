@@ -0,0 +1,142 @@
+#pragma once
+
+#include <memory>
+#include <new>
+#include <string>
+#include <type_traits>
+#include <typeinfo>
+#include <utility>
+#include <vector>
+
+/**
+   \brief Values of quantities which have already been evaluated for the current state of a product.
+
+   The quantities registered by LambdaNtupleConsumer::Add*Quantity are evaluated at most once per
+   product state, no matter how many consumers or MVA readers ask for them. Every quantity has a
+   fixed slot (GetSlot), such that a lookup is only an index and a generation comparison.
+
+   The cache is invalidated by Invalidate(), which is called by the pipelines (runner) after every
+   producer and filter, since they modify the product (or its filter result). Producers and MVA
+   readers therefore share the values with the following processors and consumers, as long as no
+   other producer runs in between. A producer, which evaluates a quantity after having modified the
+   product in the same call of Produce, has to call product.quantityCache.Invalidate() after the
+   modification, otherwise it gets the value cached before. Assigning a product (new event)
+   invalidates the cache as well: copies of a cache never share or copy the values, each product
+   keeps its own storage, which is reused in the next event.
+*/
+class QuantityCache {
+public:
+
+	QuantityCache() {}
+
+	QuantityCache(QuantityCache const&) :
+		QuantityCache()
+	{
+	}
+
+	QuantityCache& operator=(QuantityCache const&)
+	{
+		Invalidate();
+		return *this;
+	}
+
+	// slot of a quantity, slots are shared by all caches
+	// (quantities with the same name, but different types get different slots)
+	template<class TValue>
+	static size_t GetSlot(std::string const& quantity)
+	{
+		return GetSlot(quantity, typeid(TValue));
+	}
+
+	void Invalidate()
+	{
+		++m_generation;
+	}
+
+	// pointer to the cached value, nullptr if the value is not cached for the current state
+	template<class TValue>
+	TValue const* Get(size_t slot) const
+	{
+		if ((slot < m_generations.size()) && (m_generations[slot] == m_generation))
+		{
+			return ValueStorage<TValue>::Get(*this, slot);
+		}
+		return nullptr;
+	}
+
+	template<class TValue>
+	TValue const& Set(size_t slot, TValue value)
+	{
+		if (slot >= m_generations.size())
+		{
+			m_generations.resize(slot + 1, 0);
+			m_inlineValues.resize(slot + 1);
+			m_values.resize(slot + 1);
+		}
+		m_generations[slot] = m_generation;
+		return ValueStorage<TValue>::Set(*this, slot, std::move(value));
+	}
+
+private:
+
+	// small, trivially copyable values (numbers, Lorentz vectors) are stored in a flat array,
+	// all others in separately allocated objects, which are reused for all events
+	struct InlineValue
+	{
+		typename std::aligned_storage<32, 8>::type data;
+	};
+
+	struct CachedValueBase
+	{
+		virtual ~CachedValueBase() {}
+	};
+
+	template<class TValue>
+	struct CachedValue : public CachedValueBase
+	{
+		TValue value;
+	};
+
+	template<class TValue, bool inlineValue = (std::is_trivially_copyable<TValue>::value &&
+	                                            (sizeof(TValue) <= sizeof(InlineValue)) && (alignof(TValue) <= 8))>
+	struct ValueStorage
+	{
+		static TValue const* Get(QuantityCache const& cache, size_t slot)
+		{
+			return reinterpret_cast<TValue const*>(&(cache.m_inlineValues[slot].data));
+		}
+
+		static TValue const& Set(QuantityCache& cache, size_t slot, TValue value)
+		{
+			return *(new (&(cache.m_inlineValues[slot].data)) TValue(value));
+		}
+	};
+
+	template<class TValue>
+	struct ValueStorage<TValue, false>
+	{
+		static TValue const* Get(QuantityCache const& cache, size_t slot)
+		{
+			return &(static_cast<CachedValue<TValue> const*>(cache.m_values[slot].get())->value);
+		}
+
+		static TValue const& Set(QuantityCache& cache, size_t slot, TValue value)
+		{
+			if (! cache.m_values[slot])
+			{
+				cache.m_values[slot].reset(new CachedValue<TValue>());
+			}
+			CachedValue<TValue>* cachedValue = static_cast<CachedValue<TValue>*>(cache.m_values[slot].get());
+			cachedValue->value = std::move(value);
+			return cachedValue->value;
+		}
+	};
+
+	static size_t GetSlot(std::string const& quantity, std::type_info const& type);
+
+	// starts above the generation of slots that have never been set
+	unsigned long long m_generation = 1;
+	std::vector<unsigned long long> m_generations;
+	std::vector<InlineValue> m_inlineValues;
+	std::vector<std::unique_ptr<CachedValueBase> > m_values;
+};
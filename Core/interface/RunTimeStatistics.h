@@ -0,0 +1,70 @@
+#pragma once
+
+#include <array>
+#include <chrono>
+#include <cstdint>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+/**
+   \brief Run times of the processors (producers and filters) aggregated over all events.
+
+   Every processor is registered once with AddProcessor, which returns the index of its slot. The
+   measurements are then added to the slots by index, such that nothing but a few integers is
+   updated per processor and event. Processors registered with the same name share one slot.
+
+   The run times are measured in nanoseconds with a monotonic clock (std::chrono::steady_clock)
+   and are aggregated into the number of measurements, their sum, minimum and maximum and a
+   histogram with logarithmic bins: bin i counts the run times in [2^i, 2^(i+1)) ns (bin 0 starts at 0 ns
+   and the last bin also contains all longer run times).
+*/
+class RunTimeStatistics {
+public:
+
+	typedef std::chrono::steady_clock Clock;
+
+	static const size_t NumberOfHistogramBins = 40;
+
+	struct ProcessorStatistics
+	{
+		std::string processorName;
+		uint64_t count;
+		uint64_t sum;
+		uint64_t min;
+		uint64_t max;
+		std::array<uint64_t, NumberOfHistogramBins> histogram;
+
+		explicit ProcessorStatistics(std::string const& processorName);
+
+		void Add(uint64_t runTime);
+		void Merge(ProcessorStatistics const& other);
+
+		// mean run time in ns, 0 if nothing has been measured
+		double GetMean() const;
+	};
+
+	// lower edge of a histogram bin in ns
+	static uint64_t GetHistogramBinLowEdge(size_t bin);
+
+	// index of the slot of a processor, the slot is created if the name is not known yet
+	size_t AddProcessor(std::string const& processorName);
+
+	// nullptr if the processor has not been registered
+	ProcessorStatistics const* GetProcessorStatistics(std::string const& processorName) const;
+	std::vector<ProcessorStatistics> const& GetProcessorStatistics() const;
+
+	void AddRunTime(size_t slot, Clock::time_point start, Clock::time_point end)
+	{
+		m_processorStatistics[slot].Add(std::chrono::duration_cast<std::chrono::nanoseconds>(end - start).count());
+	}
+
+	// add the measurements of a replica (processors are matched by name)
+	void Merge(RunTimeStatistics const& other);
+
+	std::string ToString() const;
+
+private:
+	std::vector<ProcessorStatistics> m_processorStatistics;
+	std::unordered_map<std::string, size_t> m_slots;
+};
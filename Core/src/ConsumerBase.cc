@@ -6,6 +6,11 @@ ConsumerBaseUntemplated::~ConsumerBaseUntemplated()
 {
 }
 
+bool ConsumerBaseUntemplated::SupportsMerge() const
+{
+	return false;
+}
+
 
 ConsumerBaseAccess::ConsumerBaseAccess(ConsumerBaseUntemplated& consumer) :
 	m_consumer(consumer)
@@ -32,7 +37,7 @@ void ConsumerBaseAccess::Process(SettingsBase const& settings, MetadataBase cons
 	m_consumer.baseProcess(settings, metadata);
 }
 
-void ConsumerBaseAccess::ProcessEvent(EventBase const& evt, ProductBase const& prod, SettingsBase const& settings, MetadataBase const& metadata, FilterResult fres)
+void ConsumerBaseAccess::ProcessEvent(EventBase const& evt, ProductBase const& prod, SettingsBase const& settings, MetadataBase const& metadata, FilterResult const& fres)
 {
 	m_consumer.baseProcessEvent(evt, prod, settings, metadata, fres);
 }
@@ -42,6 +47,11 @@ void ConsumerBaseAccess::ProcessFilteredEvent(EventBase const& evt, ProductBase
 	m_consumer.baseProcessFilteredEvent(evt, prod, settings, metadata);
 }
 
+void ConsumerBaseAccess::Merge(ConsumerBaseUntemplated const& replica, SettingsBase const& settings, MetadataBase const& metadata)
+{
+	m_consumer.baseMerge(replica, settings, metadata);
+}
+
 void ConsumerBaseAccess::Finish(SettingsBase const& settings, MetadataBase const& metadata)
 {
 	m_consumer.baseFinish(settings, metadata);
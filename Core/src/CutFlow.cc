@@ -15,26 +15,54 @@ void CutFlow::AddFilterResult(FilterResult const& fres)
 {
 	++m_overallEventCount;
 
-	auto const& dec = fres.GetFilterDecisions();
-	for (FilterResult::FilterDecisions::const_iterator it = dec.begin();
-	     it != dec.end(); ++it)
+	CutFlow::CutCount::iterator cutEntry = m_cutCount.begin();
+	for (size_t filterIndex = 0; filterIndex < fres.GetNumberOfFilters(); ++filterIndex)
 	{
 		// only store, if passed
 		long addVal = 0;
-		if (it->filterDecision == FilterResult::Decision::Passed &&
-		    it->taggingMode == FilterResult::TaggingMode::Filtering) {
+		if (fres.GetFilterDecision(filterIndex) == FilterResult::Decision::Passed &&
+		    fres.GetTaggingMode(filterIndex) == FilterResult::TaggingMode::Filtering) {
 			addVal = 1;
 		}
 
-		CutFlow::CutStat * stat = CutFlow::GetCutEntry(it->filterName);
+		// the filters usually come in the same order for every event
+		std::string const& filterName = fres.GetFilterName(filterIndex);
+		if ((cutEntry != m_cutCount.end()) && (cutEntry->first == filterName))
+		{
+			cutEntry->second += addVal;
+			++cutEntry;
+			continue;
+		}
+
+		CutFlow::CutStat * stat = CutFlow::GetCutEntry(filterName);
 		if (stat == nullptr)
 		{
-			m_cutCount.push_back(std::make_pair(it->filterName, addVal));
+			m_cutCount.push_back(std::make_pair(filterName, addVal));
 		}
 		else
 		{
 			stat->second += addVal;
 		}
+		cutEntry = m_cutCount.end();
+	}
+}
+
+void CutFlow::Merge(CutFlow const& other)
+{
+	m_overallEventCount += other.m_overallEventCount;
+
+	for (CutFlow::CutCount::const_iterator it = other.m_cutCount.begin();
+	     it != other.m_cutCount.end(); ++it)
+	{
+		CutFlow::CutStat * stat = CutFlow::GetCutEntry(it->first);
+		if (stat == nullptr)
+		{
+			m_cutCount.push_back(*it);
+		}
+		else
+		{
+			stat->second += it->second;
+		}
 	}
 }
 
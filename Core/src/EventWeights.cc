@@ -0,0 +1,58 @@
+#include <map>
+#include <mutex>
+
+#include "Artus/Core/interface/EventWeights.h"
+
+
+namespace
+{
+	// the indices are only requested during the initialisation, but possibly by several
+	// pipeline runners at the same time
+	std::mutex& GetIndicesMutex()
+	{
+		static std::mutex indicesMutex;
+		return indicesMutex;
+	}
+
+	std::map<std::string, size_t>& GetIndicesByName()
+	{
+		static std::map<std::string, size_t> indicesByName;
+		return indicesByName;
+	}
+
+	std::vector<std::string>& GetNames()
+	{
+		static std::vector<std::string> names;
+		return names;
+	}
+}
+
+size_t EventWeights::GetIndex(std::string const& name)
+{
+	std::lock_guard<std::mutex> lock(GetIndicesMutex());
+	std::pair<std::map<std::string, size_t>::iterator, bool> index = GetIndicesByName().emplace(name, GetNames().size());
+	if (index.second)
+	{
+		GetNames().push_back(name);
+	}
+	return index.first->second;
+}
+
+std::string EventWeights::GetName(size_t index)
+{
+	std::lock_guard<std::mutex> lock(GetIndicesMutex());
+	return GetNames().at(index);
+}
+
+std::vector<size_t> EventWeights::GetIndices() const
+{
+	std::vector<size_t> indices;
+	for (size_t index = 0; index < m_isSet.size(); ++index)
+	{
+		if (m_isSet[index])
+		{
+			indices.push_back(index);
+		}
+	}
+	return indices;
+}
@@ -1,10 +1,24 @@
-
 #include <algorithm>
 #include <sstream>
 
 #include "Artus/Core/interface/FilterResult.h"
 
 
+namespace
+{
+	inline size_t DecisionWord(size_t filterIndex)
+	{
+		return filterIndex / 64;
+	}
+
+	inline uint64_t DecisionBit(size_t filterIndex)
+	{
+		return (uint64_t(1) << (filterIndex % 64));
+	}
+}
+
+const size_t FilterResult::NotFound = std::string::npos;
+
 FilterResult::DecisionEntry::DecisionEntry() :
 		filterName(""),
 		filterDecision(Decision::Undefined),
@@ -21,142 +35,224 @@ FilterResult::DecisionEntry::DecisionEntry(std::string filterName, Decision filt
 
 FilterResult::FilterResult() :
 		// has passed by default
-		m_cacheHasPassed(true), m_IsCachedHasPassed(false) {
+		m_filterNames(GetEmptyFilterNames()) {
 }
 
 FilterResult::FilterResult(FilterNames const& initialFilterNames ) :
 		// has passed by default
-		m_cacheHasPassed(true), m_IsCachedHasPassed(false) {
+		m_filterNames(GetEmptyFilterNames()) {
 
 	AddFilterNames ( initialFilterNames );
 }
 
 FilterResult::FilterResult(FilterNames const& initialFilterNames, FilterNames const& taggingFilters ) :
 		// has passed by default
-		m_taggingFilters(taggingFilters), m_cacheHasPassed(true), m_IsCachedHasPassed(false) {
-	AddFilterNames ( initialFilterNames );
+		m_filterNames(GetEmptyFilterNames()) {
+	AddFilterNames ( initialFilterNames, taggingFilters );
 }
 
-FilterResult::DecisionEntry * FilterResult::GetDecisionEntry( std::string const& filterName ) {
-	for ( FilterResult::FilterDecisions::iterator it = m_filterDecisions.begin();
-			it != m_filterDecisions.end(); ++it) {
-		if ( filterName == it->filterName )
-			return & ( *it );
+// all default constructed filter results (e.g. in every product) share the same empty list of names
+std::shared_ptr<FilterResult::FilterNamesIndex> const& FilterResult::GetEmptyFilterNames() {
+	static std::shared_ptr<FilterNamesIndex> const emptyFilterNames = std::make_shared<FilterNamesIndex>();
+	return emptyFilterNames;
+}
+
+// the filter names are shared between copies and need to be copied before modifications
+FilterResult::FilterNamesIndex& FilterResult::GetMutableFilterNames() {
+	if (m_filterNames.use_count() > 1)
+	{
+		m_filterNames = std::make_shared<FilterNamesIndex>(*m_filterNames);
 	}
+	return *m_filterNames;
+}
 
-	return nullptr;
+size_t FilterResult::GetFilterIndex( std::string const& filterName ) const {
+	std::unordered_map<std::string, size_t>::const_iterator it = m_filterNames->filterIndices.find(filterName);
+	return ((it == m_filterNames->filterIndices.end()) ? NotFound : it->second);
 }
 
-FilterResult::DecisionEntry const* FilterResult::GetDecisionEntry( std::string const& filterName ) const {
-	for ( FilterResult::FilterDecisions::const_iterator it = m_filterDecisions.begin();
-			it != m_filterDecisions.end(); ++it) {
-		if ( filterName == it->filterName )
-			return & ( *it );
+size_t FilterResult::AddFilterName( std::string const& filterName ) {
+	size_t filterIndex = GetFilterIndex(filterName);
+	if (filterIndex != NotFound)
+	{
+		return filterIndex;
+	}
+
+	TaggingMode taggingMode = IsTaggingFilter(filterName);
+	FilterNamesIndex& filterNames = GetMutableFilterNames();
+
+	filterIndex = filterNames.filterNames.size();
+	filterNames.filterNames.push_back(filterName);
+	filterNames.filterIndices[filterName] = filterIndex;
+
+	const size_t nWords = DecisionWord(filterIndex) + 1;
+	filterNames.filteringMask.resize(nWords, 0);
+	if (taggingMode == TaggingMode::Filtering)
+	{
+		filterNames.filteringMask[DecisionWord(filterIndex)] |= DecisionBit(filterIndex);
 	}
+	m_passed.resize(nWords, 0);
+	m_notPassed.resize(nWords, 0);
 
-	return nullptr;
+	return filterIndex;
 }
 
 FilterResult::TaggingMode FilterResult::IsTaggingFilter(std::string const& filterName ) const {
-	if (std::find(m_taggingFilters.begin(), m_taggingFilters.end(), filterName) != m_taggingFilters.end())
+	FilterNames const& taggingFilters = m_filterNames->taggingFilters;
+	if (std::find(taggingFilters.begin(), taggingFilters.end(), filterName) != taggingFilters.end())
 	{
 		return TaggingMode::Tagging;
 	}
 	return TaggingMode::Filtering;
 }
 
+FilterResult::TaggingMode FilterResult::GetTaggingMode(size_t filterIndex) const {
+	return ((m_filterNames->filteringMask[DecisionWord(filterIndex)] & DecisionBit(filterIndex)) ? TaggingMode::Filtering : TaggingMode::Tagging);
+}
+
 // add a list of filter names
 // will only add and set the decision to undefined, if the
 // name is not in the list before
 //
 void FilterResult::AddFilterNames( FilterNames const& fn, FilterNames const& taggingFilters){
-	m_taggingFilters.insert(m_taggingFilters.end(), taggingFilters.begin(), taggingFilters.end());
+	if (! taggingFilters.empty())
+	{
+		FilterNames& knownTaggingFilters = GetMutableFilterNames().taggingFilters;
+		knownTaggingFilters.insert(knownTaggingFilters.end(), taggingFilters.begin(), taggingFilters.end());
+	}
 	AddFilterNames(fn);
 }
 
 void FilterResult::AddFilterNames( FilterNames const& fn ){
 	for (FilterResult::FilterNames::const_iterator it = fn.begin(); it != fn.end(); ++it) {
-		FilterResult::DecisionEntry * entr = GetDecisionEntry( * it );
-		if ( entr == nullptr ) {
-			m_filterDecisions.push_back( DecisionEntry(*it, Decision::Undefined, IsTaggingFilter(*it)));
-		}
+		AddFilterName(*it);
 	}
 }
 
-// list of all filter names as a vector of strings
-FilterResult::FilterNames FilterResult::GetFilterNames() const {
-	FilterNames filterNames;
-	filterNames.resize(m_filterDecisions.size());
-	transform(m_filterDecisions.begin(), m_filterDecisions.end(), filterNames.begin(),
-	          [](FilterResult::DecisionEntry decisionEntry) { return decisionEntry.filterName; });
-	return filterNames;
+void FilterResult::ExtendFilterNames(FilterResult const& baseFilterResult, FilterNames const& fn, FilterNames const& taggingFilters) {
+	m_filterNames = baseFilterResult.m_filterNames;
+	GetMutableFilterNames().baseFilterNames = baseFilterResult.m_filterNames;
+	m_passed.assign(m_filterNames->filteringMask.size(), 0);
+	m_notPassed.assign(m_filterNames->filteringMask.size(), 0);
+
+	AddFilterNames(fn, taggingFilters);
 }
 
-bool FilterResult::HasPassed() const {
-	if (m_IsCachedHasPassed)
-		return m_cacheHasPassed;
+bool FilterResult::ExtendsFilterNames(FilterResult const& baseFilterResult) const {
+	return (m_filterNames->baseFilterNames == baseFilterResult.m_filterNames);
+}
 
-	m_cacheHasPassed = true;
-	for (FilterResult::FilterDecisions::const_iterator it = GetFilterDecisions().begin();
-			it != GetFilterDecisions().end(); ++it) {
-		if (it->filterDecision == FilterResult::Decision::NotPassed &&
-		    it->taggingMode == FilterResult::TaggingMode::Filtering)
-			m_cacheHasPassed = false;
+void FilterResult::CopyDecisions(FilterResult const& baseFilterResult) {
+	if (! ExtendsFilterNames(baseFilterResult))
+	{
+		LOG(FATAL) << "Filter decisions can only be copied from the filter result used in ExtendFilterNames!";
 	}
 
-	m_IsCachedHasPassed = true;
-	return m_cacheHasPassed;
+	ResetDecisions();
+	std::copy(baseFilterResult.m_passed.begin(), baseFilterResult.m_passed.end(), m_passed.begin());
+	std::copy(baseFilterResult.m_notPassed.begin(), baseFilterResult.m_notPassed.end(), m_notPassed.begin());
+}
+
+void FilterResult::ResetDecisions() {
+	std::fill(m_passed.begin(), m_passed.end(), 0);
+	std::fill(m_notPassed.begin(), m_notPassed.end(), 0);
+}
+
+// list of all filter names as a vector of strings
+FilterResult::FilterNames const& FilterResult::GetFilterNames() const {
+	return m_filterNames->filterNames;
+}
+
+size_t FilterResult::GetNumberOfFilters() const {
+	return m_filterNames->filterNames.size();
+}
+
+std::string const& FilterResult::GetFilterName(size_t filterIndex) const {
+	return m_filterNames->filterNames[filterIndex];
+}
+
+bool FilterResult::HasPassed() const {
+	DecisionBits const& filteringMask = m_filterNames->filteringMask;
+	for (size_t word = 0; word < m_notPassed.size(); ++word)
+	{
+		if ((m_notPassed[word] & filteringMask[word]) != 0)
+			return false;
+	}
+	return true;
 }
 
 bool FilterResult::HasPassedIfExcludingFilter(std::string const& excludedFilter) const {
-	for (FilterResult::FilterDecisions::const_iterator it = GetFilterDecisions().begin();
-			it != GetFilterDecisions().end(); ++it) {
-		if (it->filterDecision == FilterResult::Decision::NotPassed &&
-		    it->taggingMode == FilterResult::TaggingMode::Filtering)
-		{
-			if (it->filterName != excludedFilter)
-				return false;
-		}
+	const size_t excludedFilterIndex = GetFilterIndex(excludedFilter);
+	return ((excludedFilterIndex == NotFound) ? HasPassed() : HasPassedIfExcludingFilter(excludedFilterIndex));
+}
+
+bool FilterResult::HasPassedIfExcludingFilter(size_t excludedFilterIndex) const {
+	DecisionBits const& filteringMask = m_filterNames->filteringMask;
+	for (size_t word = 0; word < m_notPassed.size(); ++word)
+	{
+		uint64_t mask = filteringMask[word];
+		if (word == DecisionWord(excludedFilterIndex))
+			mask &= ~DecisionBit(excludedFilterIndex);
+
+		if ((m_notPassed[word] & mask) != 0)
+			return false;
 	}
 	return true;
 }
 
 FilterResult::Decision FilterResult::GetFilterDecision(std::string filterName) const {
-	FilterResult::DecisionEntry const* entr = GetDecisionEntry(filterName);
+	const size_t filterIndex = GetFilterIndex(filterName);
 
-	if ( entr == nullptr ){
+	if ( filterIndex == NotFound ){
 		LOG(FATAL) << "Decision entry with name " << filterName << " not found!";
 	}
-	return entr->filterDecision;
+	return GetFilterDecision(filterIndex);
+}
+
+FilterResult::Decision FilterResult::GetFilterDecision(size_t filterIndex) const {
+	if (m_passed[DecisionWord(filterIndex)] & DecisionBit(filterIndex))
+		return Decision::Passed;
+	else if (m_notPassed[DecisionWord(filterIndex)] & DecisionBit(filterIndex))
+		return Decision::NotPassed;
+	else
+		return Decision::Undefined;
 }
 
-FilterResult::FilterDecisions const& FilterResult::GetFilterDecisions() const {
-	return m_filterDecisions;
+FilterResult::FilterDecisions FilterResult::GetFilterDecisions() const {
+	FilterDecisions filterDecisions;
+	filterDecisions.reserve(GetNumberOfFilters());
+	for (size_t filterIndex = 0; filterIndex < GetNumberOfFilters(); ++filterIndex)
+	{
+		filterDecisions.push_back(DecisionEntry(GetFilterName(filterIndex), GetFilterDecision(filterIndex), GetTaggingMode(filterIndex)));
+	}
+	return filterDecisions;
 }
 
 void FilterResult::SetFilterDecision(std::string filterName, bool passed) {
-	FilterResult::Decision desc = passed ? FilterResult::Decision::Passed : FilterResult::Decision::NotPassed;
-	FilterResult::DecisionEntry * entr = GetDecisionEntry(filterName);
+	SetFilterDecision(AddFilterName(filterName), passed);
+}
 
-	if ( entr == nullptr ) {
-		m_filterDecisions.push_back( DecisionEntry(filterName, desc, IsTaggingFilter(filterName)));
-	} else {
-		entr->filterDecision = desc;
+void FilterResult::SetFilterDecision(size_t filterIndex, bool passed) {
+	const size_t word = DecisionWord(filterIndex);
+	const uint64_t bit = DecisionBit(filterIndex);
+	if (passed)
+	{
+		m_passed[word] |= bit;
+		m_notPassed[word] &= ~bit;
+	}
+	else
+	{
+		m_passed[word] &= ~bit;
+		m_notPassed[word] |= bit;
 	}
-	
-	// recompute the cached filter result, if the new filter
-	// decision might change this
-	if (m_IsCachedHasPassed && ( m_cacheHasPassed != passed ))
-		m_IsCachedHasPassed = false;
 }
 
 std::string FilterResult::ToString() const {
 	std::stringstream s;
 	s << "== Filter Decision == " << std::endl;
 
-	for (FilterResult::FilterDecisions::const_iterator it = m_filterDecisions.begin();
-			it != m_filterDecisions.end(); ++it) {
-		s << it->filterName << " : " << FilterResult::DecisionToString( it->filterDecision ) << std::endl;
+	for (size_t filterIndex = 0; filterIndex < GetNumberOfFilters(); ++filterIndex) {
+		s << GetFilterName(filterIndex) << " : " << FilterResult::DecisionToString( GetFilterDecision(filterIndex) ) << std::endl;
 	}
 
 	return s.str();
@@ -10,3 +10,16 @@ MetadataBase::~MetadataBase()
 {
 }
 
+RunTimeStatistics::ProcessorStatistics const* MetadataBase::GetProcessorRunTimeStatistics(std::string const& processor) const
+{
+	for (RunTimeStatistics const* runTimeStatistics : { m_runTimeStatistics, m_sharedStageRunTimeStatistics, m_globalRunTimeStatistics })
+	{
+		RunTimeStatistics::ProcessorStatistics const* statistics = ((runTimeStatistics != nullptr) ? runTimeStatistics->GetProcessorStatistics(processor) : nullptr);
+		if (statistics != nullptr)
+		{
+			return statistics;
+		}
+	}
+	return nullptr;
+}
+
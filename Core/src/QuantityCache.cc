@@ -0,0 +1,16 @@
+#include <map>
+#include <mutex>
+
+#include "Artus/Core/interface/QuantityCache.h"
+
+
+size_t QuantityCache::GetSlot(std::string const& quantity, std::type_info const& type)
+{
+	// the slots are only requested during the initialisation, but possibly by several
+	// pipeline runners at the same time
+	static std::mutex slotsMutex;
+	static std::map<std::pair<std::string, std::string>, size_t> slots;
+
+	std::lock_guard<std::mutex> lock(slotsMutex);
+	return slots.emplace(std::make_pair(quantity, std::string(type.name())), slots.size()).first->second;
+}
@@ -0,0 +1,99 @@
+#include <algorithm>
+#include <iomanip>
+#include <limits>
+#include <sstream>
+
+#include "Artus/Core/interface/RunTimeStatistics.h"
+
+
+RunTimeStatistics::ProcessorStatistics::ProcessorStatistics(std::string const& processorName) :
+	processorName(processorName),
+	count(0),
+	sum(0),
+	min(std::numeric_limits<uint64_t>::max()),
+	max(0)
+{
+	histogram.fill(0);
+}
+
+void RunTimeStatistics::ProcessorStatistics::Add(uint64_t runTime)
+{
+	++count;
+	sum += runTime;
+	min = std::min(min, runTime);
+	max = std::max(max, runTime);
+
+	// position of the highest set bit = floor(log2(runTime))
+	size_t bin = ((runTime > 1) ? (63 - __builtin_clzll(runTime)) : 0);
+	++histogram[std::min(bin, NumberOfHistogramBins - 1)];
+}
+
+void RunTimeStatistics::ProcessorStatistics::Merge(ProcessorStatistics const& other)
+{
+	count += other.count;
+	sum += other.sum;
+	min = std::min(min, other.min);
+	max = std::max(max, other.max);
+	for (size_t bin = 0; bin < NumberOfHistogramBins; ++bin)
+	{
+		histogram[bin] += other.histogram[bin];
+	}
+}
+
+double RunTimeStatistics::ProcessorStatistics::GetMean() const
+{
+	return ((count > 0) ? (static_cast<double>(sum) / count) : 0.0);
+}
+
+uint64_t RunTimeStatistics::GetHistogramBinLowEdge(size_t bin)
+{
+	return ((bin > 0) ? (uint64_t(1) << bin) : 0);
+}
+
+size_t RunTimeStatistics::AddProcessor(std::string const& processorName)
+{
+	std::pair<std::unordered_map<std::string, size_t>::iterator, bool> slot = m_slots.emplace(processorName, m_processorStatistics.size());
+	if (slot.second)
+	{
+		m_processorStatistics.emplace_back(processorName);
+	}
+	return slot.first->second;
+}
+
+RunTimeStatistics::ProcessorStatistics const* RunTimeStatistics::GetProcessorStatistics(std::string const& processorName) const
+{
+	std::unordered_map<std::string, size_t>::const_iterator slot = m_slots.find(processorName);
+	return ((slot != m_slots.end()) ? &(m_processorStatistics[slot->second]) : nullptr);
+}
+
+std::vector<RunTimeStatistics::ProcessorStatistics> const& RunTimeStatistics::GetProcessorStatistics() const
+{
+	return m_processorStatistics;
+}
+
+void RunTimeStatistics::Merge(RunTimeStatistics const& other)
+{
+	for (ProcessorStatistics const& otherStatistics : other.m_processorStatistics)
+	{
+		m_processorStatistics[AddProcessor(otherStatistics.processorName)].Merge(otherStatistics);
+	}
+}
+
+std::string RunTimeStatistics::ToString() const
+{
+	std::stringstream s;
+	s << std::fixed << std::setprecision(3);
+	for (ProcessorStatistics const& statistics : m_processorStatistics)
+	{
+		s << statistics.processorName << ": " << statistics.count << " calls";
+		if (statistics.count > 0)
+		{
+			s << ", mean " << (statistics.GetMean() / 1000.0) << " us"
+			  << ", min " << (statistics.min / 1000.0) << " us"
+			  << ", max " << (statistics.max / 1000.0) << " us"
+			  << ", total " << (statistics.sum / 1.0e9) << " s";
+		}
+		s << std::endl;
+	}
+	return s.str();
+}
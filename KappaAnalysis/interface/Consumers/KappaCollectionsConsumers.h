@@ -38,9 +38,9 @@ public:
 	                             std::vector<TObject*> product_type::*validObjects,
 	                             bool (setting_type::*GetBranchGenMatchedObjects)(void) const,
 	                             TObjectMetaInfo* event_type::*objectMetaInfo = nullptr,
-	                             std::map<TObject*, KGenParticle*> product_type::*genParticleMatchedObjects = nullptr,
-	                             std::map<TObject*, KGenTau*> product_type::*genTauMatchedObjects = nullptr,
-	                             std::map<TObject*, KGenJet*> product_type::*genTauJetMatchedObjects = nullptr) :
+	                             CopyOnWrite<std::map<TObject*, KGenParticle*> > product_type::*genParticleMatchedObjects = nullptr,
+	                             CopyOnWrite<std::map<TObject*, KGenTau*> > product_type::*genTauMatchedObjects = nullptr,
+	                             CopyOnWrite<std::map<TObject*, KGenJet*> > product_type::*genTauJetMatchedObjects = nullptr) :
 		ConsumerBase<KappaTypes>(),
 		m_treeName(treeName),
 		m_validObjects(validObjects),
@@ -116,7 +116,7 @@ public:
 			{
 				if (m_genParticleMatchedObjectsAvailable && settings.GetAddGenMatchedParticles())
 				{
-					KGenParticle* currentGenParticle = SafeMap::GetWithDefault((product.*m_genParticleMatchedObjects), *validObject, static_cast<KGenParticle*>(nullptr));
+					KGenParticle* currentGenParticle = SafeMap::GetWithDefault((product.*m_genParticleMatchedObjects).Get(), *validObject, static_cast<KGenParticle*>(nullptr));
 					m_currentGenParticle = (currentGenParticle != nullptr ? *(static_cast<KGenParticle*>(currentGenParticle)) : KGenParticle());
 					m_currentGenParticleMatched = (currentGenParticle != nullptr);
 					if (currentGenParticle != nullptr)
@@ -131,7 +131,7 @@ public:
 				
 				if (m_genTauMatchedObjectsAvailable && settings.GetAddGenMatchedTaus())
 				{
-					KGenTau* currentGenTau = SafeMap::GetWithDefault((product.*m_genTauMatchedObjects), *validObject, static_cast<KGenTau*>(nullptr));
+					KGenTau* currentGenTau = SafeMap::GetWithDefault((product.*m_genTauMatchedObjects).Get(), *validObject, static_cast<KGenTau*>(nullptr));
 					m_currentGenTau = (currentGenTau != nullptr ? *(static_cast<KGenTau*>(currentGenTau)) : KGenTau());
 					m_currentGenTauMatched = (currentGenTau != nullptr);
 					if (currentGenTau != nullptr)
@@ -146,7 +146,7 @@ public:
 				
 				if (m_genTauJetMatchedObjectsAvailable && settings.GetAddGenMatchedTauJets())
 				{
-					KGenJet* currentGenTauJet = SafeMap::GetWithDefault((product.*m_genTauJetMatchedObjects), *validObject, static_cast<KGenJet*>(nullptr));
+					KGenJet* currentGenTauJet = SafeMap::GetWithDefault((product.*m_genTauJetMatchedObjects).Get(), *validObject, static_cast<KGenJet*>(nullptr));
 					m_currentGenTauJet = (currentGenTauJet != nullptr ? *(static_cast<KGenJet*>(currentGenTauJet)) : KGenJet());
 					m_currentGenTauJetMatched = (currentGenTauJet != nullptr);
 					if (currentGenTauJet != nullptr)
@@ -179,11 +179,11 @@ private:
 	bool (setting_type::*GetBranchGenMatchedObjects)(void) const;
 	TObjectMetaInfo* event_type::*m_objectMetaInfo;
 	bool m_objectMetaInfoAvailable = false;
-	std::map<TObject*, KGenParticle*> product_type::*m_genParticleMatchedObjects;
+	CopyOnWrite<std::map<TObject*, KGenParticle*> > product_type::*m_genParticleMatchedObjects;
 	bool m_genParticleMatchedObjectsAvailable = false;
-	std::map<TObject*, KGenTau*> product_type::*m_genTauMatchedObjects;
+	CopyOnWrite<std::map<TObject*, KGenTau*> > product_type::*m_genTauMatchedObjects;
 	bool m_genTauMatchedObjectsAvailable = false;
-	std::map<TObject*, KGenJet*> product_type::*m_genTauJetMatchedObjects;
+	CopyOnWrite<std::map<TObject*, KGenJet*> > product_type::*m_genTauJetMatchedObjects;
 	bool m_genTauJetMatchedObjectsAvailable = false;
 	
 	TTree* m_tree = nullptr;
@@ -229,6 +229,7 @@ class KappaTausConsumer: public KappaCollectionsConsumerBase<KTau, KTauMetadata>
 public:
 	KappaTausConsumer();
 	std::string GetConsumerId() const override;
+	void GetRequiredEventMembers(std::set<std::string>& eventMembers) const override;
 };
 
 
@@ -249,5 +250,6 @@ class KappaTaggedJetsConsumer: public KappaCollectionsConsumerBase<KBasicJet, KJ
 public:
 	KappaTaggedJetsConsumer();
 	std::string GetConsumerId() const override;
+	void GetRequiredEventMembers(std::set<std::string>& eventMembers) const override;
 };
 
@@ -12,7 +12,7 @@
    - EventWeight, e.g. "eventWeight"
    
    Writes out cutflow histograms, one non-weighted and one weighted.
-   The weight is taken from product.m_weights[settings.GetEventWeight()].
+   The weight settings.GetEventWeight() is taken from product.m_weights.
    If you wish a custom weight, derive from this (or its upper) class and
    fill the memember weightExtractor according to you requirements.
 */
@@ -2,6 +2,7 @@
 
 #include "Kappa/DataFormats/interface/Kappa.h"
 
+#include "Artus/Core/interface/EventWeights.h"
 #include "Artus/Utility/interface/DefaultValues.h"
 #include "Artus/Utility/interface/Utility.h"
 
@@ -117,6 +118,17 @@ public:
 			return (event.m_lheParticles->particles.size() >= 5) ? event.m_lheParticles->particles.at(4).p4 : DefaultValues::UndefinedCartesianRMFLV;
 		});
 
+		// the event, lumi and run infos are always read
+		LambdaNtupleConsumer<TTypes>::SetEventMembersOfQuantity(metadata, "npv", { "VertexSummary" });
+		LambdaNtupleConsumer<TTypes>::SetEventMembersOfQuantity(metadata, "firstPV_X", { "VertexSummary" });
+		LambdaNtupleConsumer<TTypes>::SetEventMembersOfQuantity(metadata, "firstPV_Y", { "VertexSummary" });
+		LambdaNtupleConsumer<TTypes>::SetEventMembersOfQuantity(metadata, "firstPV_Z", { "VertexSummary" });
+		LambdaNtupleConsumer<TTypes>::SetEventMembersOfQuantity(metadata, "rho", { "PileupDensity" });
+		LambdaNtupleConsumer<TTypes>::SetEventMembersOfQuantity(metadata, "PFMet", { "Met" });
+		LambdaNtupleConsumer<TTypes>::SetEventMembersOfQuantity(metadata, "NPFCandidates", { "PackedPFCandidates" });
+		LambdaNtupleConsumer<TTypes>::SetEventMembersOfQuantity(metadata, "LHE_p_1", { "LheParticles" });
+		LambdaNtupleConsumer<TTypes>::SetEventMembersOfQuantity(metadata, "LHE_p_2", { "LheParticles" });
+
 		// loop over all quantities containing "weight" (case-insensitive)
 		// and try to find them in the weights map to write them out
 		for (std::string const& quantity : settings.GetQuantities())
@@ -126,9 +138,10 @@ public:
 			    (metadata.m_commonDoubleQuantities.count(quantity) == 0))
 			{
 				LOG(DEBUG) << "\tQuantity \"" << quantity << "\" is tried to be taken from product.m_weights or product.m_optionalWeights.";
-				LambdaNtupleConsumer<TTypes>::AddFloatQuantity(metadata,  quantity, [quantity](event_type const & event, product_type const & product)
+				size_t weightIndex = EventWeights::GetIndex(quantity);
+				LambdaNtupleConsumer<TTypes>::AddFloatQuantity(metadata,  quantity, [weightIndex](event_type const & event, product_type const & product)
 				{
-					return SafeMap::GetWithDefault(product.m_weights, quantity, SafeMap::GetWithDefault(product.m_optionalWeights, quantity, 1.0));
+					return product.m_weights.GetWithDefault(weightIndex, product.m_optionalWeights.GetWithDefault(weightIndex, 1.0));
 				} );
 			}
 			if ((boost::algorithm::icontains(quantity, "filter") || boost::algorithm::icontains(quantity, "cut")) &&
@@ -137,9 +150,10 @@ public:
 				LOG(DEBUG) << "\tQuantity \"" << quantity << "\" is tried to be taken from product.fres (FilterResult).";
 				LambdaNtupleConsumer<TTypes>::AddIntQuantity(metadata,  quantity, [quantity](event_type const & event, product_type const & product)
 				{
-					if (product.fres.GetDecisionEntry(quantity) != nullptr)
+					size_t filterIndex = product.fres.GetFilterIndex(quantity);
+					if (filterIndex != FilterResult::NotFound)
 					{
-						return (product.fres.GetDecisionEntry(quantity)->filterDecision == FilterResult::Decision::Passed) ? 1 : 0;
+						return (product.fres.GetFilterDecision(filterIndex) == FilterResult::Decision::Passed) ? 1 : 0;
 					}
 					return -1;
 				} );
@@ -19,6 +19,7 @@ public:
 	PrintGenParticleDecayTreeConsumer();
 
 	std::string GetConsumerId() const override;
+	void GetRequiredEventMembers(std::set<std::string>& eventMembers) const override;
 	
 	virtual void Init(setting_type const& settings, metadata_type& metadata);
 
@@ -16,6 +16,7 @@ public:
 	PrintHltConsumer();
 
 	std::string GetConsumerId() const override;
+	void GetRequiredEventMembers(std::set<std::string>& eventMembers) const override;
 
 	void ProcessFilteredEvent(event_type const& event, product_type const& product,
 	                          setting_type const& settings, metadata_type const& metadata) override;
@@ -11,6 +11,7 @@ class BeamScrapingFilter: public FilterBase<KappaTypes>
 {
 public:
 	std::string GetFilterId() const override;
+	void GetRequiredEventMembers(std::set<std::string>& eventMembers) const override;
 	void Init(setting_type const& settings, metadata_type& metadata) override;
 	bool DoesEventPass(event_type const& event, product_type const& product,
 	                   setting_type const& settings, metadata_type const& metadata) const override;
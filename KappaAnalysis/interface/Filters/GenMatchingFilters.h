@@ -17,7 +17,7 @@ class GenMatchingFilterBase: public FilterBase<KappaTypes>
 
 public:
 	
-	GenMatchingFilterBase(std::map<TValidObject*, KGenParticle*> product_type::*genParticleMatchedObjects,
+	GenMatchingFilterBase(CopyOnWrite<std::map<TValidObject*, KGenParticle*> > product_type::*genParticleMatchedObjects,
 	                      std::vector<TValidObject*> product_type::*validObjects) :
 		m_genParticleMatchedObjects(genParticleMatchedObjects),
 		m_validObjects(validObjects)
@@ -27,7 +27,7 @@ public:
 	bool DoesEventPass(event_type const& event, product_type const& product,
 	                   setting_type const& settings, metadata_type const& metadata) const override
 	{
-		if ((product.*m_genParticleMatchedObjects).size() == 0) 
+		if ((product.*m_genParticleMatchedObjects)->size() == 0) 
 		{
 			return false;
 		}
@@ -39,7 +39,7 @@ public:
 
 
 private:
-	std::map<TValidObject*, KGenParticle*> product_type::*m_genParticleMatchedObjects;
+	CopyOnWrite<std::map<TValidObject*, KGenParticle*> > product_type::*m_genParticleMatchedObjects;
 	std::vector<TValidObject*> product_type::*m_validObjects;
 
 };
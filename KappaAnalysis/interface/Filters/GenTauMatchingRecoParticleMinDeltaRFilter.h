@@ -21,7 +21,7 @@ public:
 	typedef typename KappaTypes::product_type product_type;
 	typedef typename KappaTypes::setting_type setting_type;
 
-	GenTauMatchingRecoParticleMinDeltaRFilterBase(std::map<TValidObject*, KGenTau*> product_type::*genTauMatchedObjects,
+	GenTauMatchingRecoParticleMinDeltaRFilterBase(CopyOnWrite<std::map<TValidObject*, KGenTau*> > product_type::*genTauMatchedObjects,
 	                      float (setting_type::*GetMinDeltaRMatchedRecoObjects)(void) const) :
 		m_genTauMatchedObjects(genTauMatchedObjects),
 		GetMinDeltaRMatchedRecoObjects(GetMinDeltaRMatchedRecoObjects)
@@ -31,14 +31,14 @@ public:
 	bool DoesEventPass(event_type const& event, product_type const& product,
 	                   setting_type const& settings, metadata_type const& metadata) const override
 	{
-		if ((product.*m_genTauMatchedObjects).size() >= 2)
+		if ((product.*m_genTauMatchedObjects)->size() >= 2)
 		{
 			float deltaRMatched = 0;
-			for (typename std::map<TValidObject*, KGenTau*>::const_iterator validMatchedObject1 = (product.*m_genTauMatchedObjects).begin();
-			validMatchedObject1 != (product.*m_genTauMatchedObjects).end(); ++validMatchedObject1)
+			for (typename std::map<TValidObject*, KGenTau*>::const_iterator validMatchedObject1 = (product.*m_genTauMatchedObjects)->begin();
+			validMatchedObject1 != (product.*m_genTauMatchedObjects)->end(); ++validMatchedObject1)
 			{
-				for (typename std::map<TValidObject*, KGenTau*>::const_iterator validMatchedObject2 = (product.*m_genTauMatchedObjects).begin();
-						validMatchedObject2 != (product.*m_genTauMatchedObjects).end(); ++validMatchedObject2)
+				for (typename std::map<TValidObject*, KGenTau*>::const_iterator validMatchedObject2 = (product.*m_genTauMatchedObjects)->begin();
+						validMatchedObject2 != (product.*m_genTauMatchedObjects)->end(); ++validMatchedObject2)
 				{
 					//make sure not to match lepton with itself
 					if (validMatchedObject1 != validMatchedObject2)
@@ -57,7 +57,7 @@ public:
 	};
 
 private:
-	std::map<TValidObject*, KGenTau*> product_type::*m_genTauMatchedObjects;
+	CopyOnWrite<std::map<TValidObject*, KGenTau*> > product_type::*m_genTauMatchedObjects;
 	float (setting_type::*GetMinDeltaRMatchedRecoObjects)(void) const;
 };
 
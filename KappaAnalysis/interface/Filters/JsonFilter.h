@@ -28,4 +28,10 @@ public:
 
 private:
 	RunLumiSelector m_runLumiSelector;
+
+	// decision for the last lumi section, which is the same for all consecutive events of this lumi section
+	mutable bool m_hasLastDecision = false;
+	mutable run_id m_lastRun = 0;
+	mutable lumi_id m_lastLumi = 0;
+	mutable bool m_lastDecision = false;
 };
@@ -1,6 +1,8 @@
 
 #pragma once
 
+#include <unordered_set>
+
 #include "Kappa/DataFormats/interface/Kappa.h"
 #include "Artus/KappaTools/interface/RunLumiReader.h"
 
@@ -17,6 +19,11 @@
  *   - EventWhitelist
  *   - EventBlacklist
  *   - MatchRunLumiEventTuples (optional)
+ *   - RunLumiEventWhitelistFile, RunLumiEventBlacklistFile (optional, only with MatchRunLumiEventTuples):
+ *     binary files of consecutive (run, lumi, event) tuples of uint64_t numbers,
+ *     which are added to the tuples of the lists above
+ *
+ *  The lists are converted to hash sets in Init.
  */
 class RunLumiEventFilter: public FilterBase<KappaTypes>
 {
@@ -26,11 +33,53 @@ public:
 
 	std::string GetFilterId() const override;
 
+	void Init(setting_type const& settings, metadata_type& metadata) override;
 	bool DoesEventPass(event_type const& event, product_type const& product,
 	                   setting_type const& settings, metadata_type const& metadata) const override;
 
 
 private:
-	
-	bool MatchWhiteBlackLists(uint64_t item, std::vector<uint64_t> const& whitelist, std::vector<uint64_t> const& blacklist) const;
+
+	struct RunLumiEvent
+	{
+		uint64_t run;
+		uint64_t lumi;
+		uint64_t event;
+
+		bool operator==(RunLumiEvent const& runLumiEvent) const
+		{
+			return ((run == runLumiEvent.run) && (lumi == runLumiEvent.lumi) && (event == runLumiEvent.event));
+		}
+	};
+
+	struct RunLumiEventHash
+	{
+		size_t operator()(RunLumiEvent const& runLumiEvent) const
+		{
+			std::hash<uint64_t> hash;
+			size_t seed = hash(runLumiEvent.run);
+			seed ^= hash(runLumiEvent.lumi) + 0x9e3779b9 + (seed << 6) + (seed >> 2);
+			seed ^= hash(runLumiEvent.event) + 0x9e3779b9 + (seed << 6) + (seed >> 2);
+			return seed;
+		}
+	};
+
+	typedef std::unordered_set<RunLumiEvent, RunLumiEventHash> RunLumiEventSet;
+
+	static void FillRunLumiEventSet(RunLumiEventSet& runLumiEvents, std::vector<uint64_t> const& runs,
+	                                std::vector<uint64_t> const& lumis, std::vector<uint64_t> const& events);
+	static void ReadRunLumiEventSet(RunLumiEventSet& runLumiEvents, std::string const& fileName);
+	bool MatchWhiteBlackLists(uint64_t item, std::unordered_set<uint64_t> const& whitelist, std::unordered_set<uint64_t> const& blacklist) const;
+
+	bool m_matchRunLumiEventTuples = false;
+
+	std::unordered_set<uint64_t> m_runWhitelist;
+	std::unordered_set<uint64_t> m_runBlacklist;
+	std::unordered_set<uint64_t> m_lumiWhitelist;
+	std::unordered_set<uint64_t> m_lumiBlacklist;
+	std::unordered_set<uint64_t> m_eventWhitelist;
+	std::unordered_set<uint64_t> m_eventBlacklist;
+
+	RunLumiEventSet m_runLumiEventWhitelist;
+	RunLumiEventSet m_runLumiEventBlacklist;
 };
@@ -17,100 +17,100 @@ public:
 
 	typedef typename TTypes::setting_type setting_type;
 
-	KappaEventProvider(FileInterface2 & fi, InputTypeEnum inpType, bool batchMode=false) :
-		KappaEventProviderBase<TTypes>(fi, inpType, batchMode)
+	KappaEventProvider(FileInterface2 & fi, InputTypeEnum inpType, bool batchMode=false, size_t nPrefetchedEvents=0) :
+		KappaEventProviderBase<TTypes>(fi, inpType, batchMode, nPrefetchedEvents)
 	{
 	}
 
 	void WireEvent(setting_type const& settings) override {
 		// Electrons
-		if (! settings.GetElectrons().empty())
+		if ((! settings.GetElectrons().empty()) && this->IsRequiredEventMember("Electrons"))
 			this->m_event.m_electrons = this->template SecureFileInterfaceGetEvent<KElectrons>(settings.GetElectrons());
-		if (! settings.GetElectronMetadata().empty())
+		if ((! settings.GetElectronMetadata().empty()) && this->IsRequiredEventMember("ElectronMetadata"))
             this->m_event.m_electronMetadata = this->template SecureFileInterfaceGetLumi<KElectronMetadata>(settings.GetElectronMetadata());
 
 		// Muons
-		if (! settings.GetMuons().empty())
+		if ((! settings.GetMuons().empty()) && this->IsRequiredEventMember("Muons"))
 			this->m_event.m_muons = this->template SecureFileInterfaceGetEvent<KMuons>(settings.GetMuons());
 
 		// Taus
-		if (! settings.GetTaus().empty())
+		if ((! settings.GetTaus().empty()) && this->IsRequiredEventMember("Taus"))
 			this->m_event.m_taus = this->template SecureFileInterfaceGetEvent<KTaus>(settings.GetTaus());
-		if (! settings.GetTauMetadata().empty())
+		if ((! settings.GetTauMetadata().empty()) && this->IsRequiredEventMember("TauMetadata"))
 			this->m_event.m_tauMetadata = this->template SecureFileInterfaceGetLumi<KTauMetadata>(settings.GetTauMetadata());
-		if (! settings.GetGenTaus().empty())
+		if ((! settings.GetGenTaus().empty()) && this->IsRequiredEventMember("GenTaus"))
 			this->m_event.m_genTaus = this->template SecureFileInterfaceGetEvent<KGenTaus>(settings.GetGenTaus());
-		if (! settings.GetGenTauJets().empty())
+		if ((! settings.GetGenTauJets().empty()) && this->IsRequiredEventMember("GenTauJets"))
 			this->m_event.m_genTauJets = this->template SecureFileInterfaceGetEvent<KGenJets>(settings.GetGenTauJets());
 
 		// Jets
-		if (! settings.GetBasicJets().empty())
+		if ((! settings.GetBasicJets().empty()) && this->IsRequiredEventMember("BasicJets"))
 			this->m_event.m_basicJets = this->template SecureFileInterfaceGetEvent<KBasicJets>(settings.GetBasicJets());
-		if (! settings.GetGenJets().empty()){
+		if ((! settings.GetGenJets().empty()) && this->IsRequiredEventMember("GenJets")){
 			if (settings.GetUseKLVGenJets()) this->m_event.m_genJets = (KGenJets*) this->template SecureFileInterfaceGetEvent<KLVs>(settings.GetGenJets());
 			else this->m_event.m_genJets = this->template SecureFileInterfaceGetEvent<KGenJets>(settings.GetGenJets());
 			
 		}
-		if (! settings.GetTaggedJets().empty())
+		if ((! settings.GetTaggedJets().empty()) && this->IsRequiredEventMember("TaggedJets"))
 			this->m_event.m_tjets = this->template SecureFileInterfaceGetEvent<KJets>(settings.GetTaggedJets());
-		if (! settings.GetPileupDensity().empty())
+		if ((! settings.GetPileupDensity().empty()) && this->IsRequiredEventMember("PileupDensity"))
 			this->m_event.m_pileupDensity = this->template SecureFileInterfaceGetEvent<KPileupDensity>(settings.GetPileupDensity());
 
 		// MET info
-		if (! settings.GetMet().empty())
+		if ((! settings.GetMet().empty()) && this->IsRequiredEventMember("Met"))
 			this->m_event.m_met = this->template SecureFileInterfaceGetEvent<KMET>(settings.GetMet(), false);
 
-		if (! settings.GetPuppiMet().empty())
+		if ((! settings.GetPuppiMet().empty()) && this->IsRequiredEventMember("PuppiMet"))
 			this->m_event.m_puppiMet = this->template SecureFileInterfaceGetEvent<KMET>(settings.GetPuppiMet(), false);
 
 		//GenMET info
-		if (! settings.GetGenMet().empty())
+		if ((! settings.GetGenMet().empty()) && this->IsRequiredEventMember("GenMet"))
 			this->m_event.m_genMet = this->template SecureFileInterfaceGetEvent<KMET>(settings.GetGenMet());
 
 		// PF candidates info
-		if (! settings.GetPFChargedHadronsPileUp().empty())
+		if ((! settings.GetPFChargedHadronsPileUp().empty()) && this->IsRequiredEventMember("PFChargedHadronsPileUp"))
 			this->m_event.m_pfChargedHadronsPileUp = this->template SecureFileInterfaceGetEvent<KPFCandidates>(settings.GetPFChargedHadronsPileUp());
-		if (! settings.GetPFChargedHadronsNoPileUp().empty())
+		if ((! settings.GetPFChargedHadronsNoPileUp().empty()) && this->IsRequiredEventMember("PFChargedHadronsNoPileUp"))
 			this->m_event.m_pfChargedHadronsNoPileUp = this->template SecureFileInterfaceGetEvent<KPFCandidates>(settings.GetPFChargedHadronsNoPileUp());
-		if (! settings.GetPFNeutralHadronsNoPileUp().empty())
+		if ((! settings.GetPFNeutralHadronsNoPileUp().empty()) && this->IsRequiredEventMember("PFNeutralHadronsNoPileUp"))
 			this->m_event.m_pfNeutralHadronsNoPileUp = this->template SecureFileInterfaceGetEvent<KPFCandidates>(settings.GetPFNeutralHadronsNoPileUp());
-		if (! settings.GetPFPhotonsNoPileUp().empty())
+		if ((! settings.GetPFPhotonsNoPileUp().empty()) && this->IsRequiredEventMember("PFPhotonsNoPileUp"))
 			this->m_event.m_pfPhotonsNoPileUp = this->template SecureFileInterfaceGetEvent<KPFCandidates>(settings.GetPFPhotonsNoPileUp());
-		if (! settings.GetPFAllChargedParticlesNoPileUp().empty())
+		if ((! settings.GetPFAllChargedParticlesNoPileUp().empty()) && this->IsRequiredEventMember("PFAllChargedParticlesNoPileUp"))
 			this->m_event.m_pfAllChargedParticlesNoPileUp = this->template SecureFileInterfaceGetEvent<KPFCandidates>(settings.GetPFAllChargedParticlesNoPileUp());
-		if (! settings.GetPFAllChargedParticlesPileUp().empty())
+		if ((! settings.GetPFAllChargedParticlesPileUp().empty()) && this->IsRequiredEventMember("PFAllChargedParticlesPileUp"))
 			this->m_event.m_pfAllChargedParticlesPileUp = this->template SecureFileInterfaceGetEvent<KPFCandidates>(settings.GetPFAllChargedParticlesPileUp());
-		if (! settings.GetPackedPFCandidates().empty())
+		if ((! settings.GetPackedPFCandidates().empty()) && this->IsRequiredEventMember("PackedPFCandidates"))
 			this->m_event.m_packedPFCandidates = this->template SecureFileInterfaceGetEvent<KPFCandidates>(settings.GetPackedPFCandidates());
 		
 		// triggers
-		if (! settings.GetTriggerInfos().empty())
+		if ((! settings.GetTriggerInfos().empty()) && this->IsRequiredEventMember("TriggerInfos"))
 			this->m_event.m_triggerObjectMetadata = this->template SecureFileInterfaceGetLumi<KTriggerObjectMetadata>(settings.GetTriggerInfos(), false);
-		if (! settings.GetTriggerObjects().empty())
+		if ((! settings.GetTriggerObjects().empty()) && this->IsRequiredEventMember("TriggerObjects"))
 			this->m_event.m_triggerObjects = this->template SecureFileInterfaceGetEvent<KTriggerObjects>(settings.GetTriggerObjects(), false);
 		
 		// Generator info
-		if (! settings.GetGenParticles().empty())
+		if ((! settings.GetGenParticles().empty()) && this->IsRequiredEventMember("GenParticles"))
 			this->m_event.m_genParticles = this->template SecureFileInterfaceGetEvent<KGenParticles>(settings.GetGenParticles());
-		if (! settings.GetLheParticles().empty())
+		if ((! settings.GetLheParticles().empty()) && this->IsRequiredEventMember("LheParticles"))
 			this->m_event.m_lheParticles = this->template SecureFileInterfaceGetEvent<KLHEParticles>(settings.GetLheParticles(), false);
 	
 		// Vertex info
-		if (! settings.GetBeamSpot().empty())
+		if ((! settings.GetBeamSpot().empty()) && this->IsRequiredEventMember("BeamSpot"))
 			this->m_event.m_beamSpot = this->template SecureFileInterfaceGetEvent<KBeamSpot>(settings.GetBeamSpot());
-		if (! settings.GetVertexSummary().empty())
+		if ((! settings.GetVertexSummary().empty()) && this->IsRequiredEventMember("VertexSummary"))
 			this->m_event.m_vertexSummary = this->template SecureFileInterfaceGetEvent<KVertexSummary>(settings.GetVertexSummary());
-		if (! settings.GetRefitVertices().empty())
+		if ((! settings.GetRefitVertices().empty()) && this->IsRequiredEventMember("RefitVertices"))
 			this->m_event.m_refitVertices = this->template SecureFileInterfaceGetEvent<KRefitVertices>(settings.GetRefitVertices());
-		if (! settings.GetRefitBSVertices().empty())
+		if ((! settings.GetRefitBSVertices().empty()) && this->IsRequiredEventMember("RefitBSVertices"))
 			this->m_event.m_refitBSVertices = this->template SecureFileInterfaceGetEvent<KRefitVertices>(settings.GetRefitBSVertices());
 
 		// Track summary
-		if (! settings.GetTrackSummary().empty())
+		if ((! settings.GetTrackSummary().empty()) && this->IsRequiredEventMember("TrackSummary"))
 			this->m_event.m_trackSummary = this->template SecureFileInterfaceGetEvent<KTrackSummary>(settings.GetTrackSummary());
 
 		// HCAL Noise summary
-		if (! settings.GetHCALNoiseSummary().empty())
+		if ((! settings.GetHCALNoiseSummary().empty()) && this->IsRequiredEventMember("HCALNoiseSummary"))
 			this->m_event.m_hcalNoiseSummary = this->template SecureFileInterfaceGetEvent<KHCALNoiseSummary>(settings.GetHCALNoiseSummary());
 
 		// Meta data
@@ -133,7 +133,7 @@ public:
 		}
 		else
 		{
-			if (! settings.GetGenEventInfoMetadata().empty())
+			if ((! settings.GetGenEventInfoMetadata().empty()) && this->IsRequiredEventMember("GenEventInfoMetadata"))
 				this->m_event.m_genEventInfoMetadata = this->template SecureFileInterfaceGetLumi<KGenEventInfoMetadata>(settings.GetGenEventInfoMetadata());
 			
 			if (! settings.GetEventInfo().empty())
@@ -155,11 +155,11 @@ public:
 			}
 		}
 		
-		if (! settings.GetFilterMetadata().empty())
+		if ((! settings.GetFilterMetadata().empty()) && this->IsRequiredEventMember("FilterMetadata"))
 			this->m_event.m_filterMetadata = this->template SecureFileInterfaceGetLumi<KFilterMetadata>(settings.GetFilterMetadata());
-		if (! settings.GetFilterSummary().empty())
+		if ((! settings.GetFilterSummary().empty()) && this->IsRequiredEventMember("FilterSummary"))
 			this->m_event.m_filterSummary = this->template SecureFileInterfaceGetLumi<KFilterSummary>(settings.GetFilterSummary());
-		if (! settings.GetJetMetadata().empty())
+		if ((! settings.GetJetMetadata().empty()) && this->IsRequiredEventMember("JetMetadata"))
 			this->m_event.m_jetMetadata = this->template SecureFileInterfaceGetLumi<KJetMetadata>(settings.GetJetMetadata());
 
 		KappaEventProviderBase<TTypes>::WireEvent(settings);
@@ -2,13 +2,14 @@
 #pragma once
 
 #include <cassert>
-#include <chrono>
-#include <future>
+#include <set>
+#include <string>
 
 #include "Kappa/DataFormats/interface/Kappa.h"
 #include "Kappa/DataFormats/interface/KDebug.h"
 
 #include "Artus/Core/interface/PipelineRunner.h"
+#include "Artus/KappaTools/interface/EventReader.h"
 #include "Artus/KappaTools/interface/FileInterface2.h"
 #include "Artus/KappaTools/interface/ProgressMonitor.h"
 
@@ -27,9 +28,10 @@ public:
 	typedef typename TTypes::event_type event_type;
 	typedef typename TTypes::setting_type setting_type;
 
-	KappaEventProviderBase(FileInterface2 & fi, InputTypeEnum inpType, bool batchMode=false) :
+	/// nPrefetchedEvents > 0 lets the reader thread read this number of events ahead (see EventReader)
+	KappaEventProviderBase(FileInterface2 & fi, InputTypeEnum inpType, bool batchMode=false, size_t nPrefetchedEvents=0) :
 			EventProviderBase<TTypes>(),
-			m_prevRun(-1), m_prevLumi(-1), m_prevTree(-1), m_inpType(inpType), m_fi(fi), m_batchMode(batchMode), m_mon(nullptr)
+			m_inpType(inpType), m_fi(fi), m_batchMode(batchMode), m_mon(nullptr), m_reader(new EventReader(fi, nPrefetchedEvents))
 	{
 		m_fi.SpeedupTree(128*1024*1024); // in units of bytes
 
@@ -46,6 +48,28 @@ public:
 	{
 	}
 
+	/// Only wire and read the event members required by the configured processors (see
+	/// PipelineRunner::GetRequiredEventMembers), needs to be called before WireEvent.
+	/// The event, lumi and run infos are always read.
+	void SetRequiredEventMembers(std::set<std::string> const& requiredEventMembers)
+	{
+		m_pruneEventMembers = true;
+		m_requiredEventMembers = requiredEventMembers;
+		m_requiredEventMembers.insert({ "EventInfo", "LumiInfo", "RunInfo" });
+
+		std::string eventMembers;
+		for (std::string const& eventMember : m_requiredEventMembers)
+		{
+			eventMembers += " " + eventMember;
+		}
+		LOG(INFO) << "Event members required by the processors:" << eventMembers;
+	}
+
+	bool IsRequiredEventMember(std::string const& eventMember) const
+	{
+		return ((! m_pruneEventMembers) || (m_requiredEventMembers.count(eventMember) > 0));
+	}
+
 	bool GetEntry(long long lEvent) override
 	{
 		assert(m_event.m_runInfo);
@@ -56,79 +80,40 @@ public:
 		{
 			return false;
 		}
-		
-		// lood entries asynchronously and exit the program, if looding the entry takes unreasonably long (dCache, ...)
-		TChain* eventdata = m_fi.eventdata;
-		std::future<long> futureGetEntry = std::async(std::launch::async, [eventdata, lEvent] () -> long
-		{
-			return eventdata->GetEntry(lEvent);
-		});
-		std::chrono::minutes timeout(5);
-		if (futureGetEntry.wait_for(timeout) != std::future_status::ready)
-		{
-			LOG(FATAL) << "Timeout: Could not read entry from Events tree!";
-		}
-		long resultGetEntry = futureGetEntry.get();
-		
-		m_event.m_input = eventdata->GetTreeNumber();
 
-		if (m_prevTree != eventdata->GetTreeNumber())
+		// all event members have been wired (also by derived providers) before the first entry is read
+		if (m_pruneEventMembers && (! m_eventBranchesPruned))
 		{
-			m_prevTree = eventdata->GetTreeNumber();
-			m_prevRun = -1;
-			m_prevLumi = -1;
-			LOG(INFO) << "\nProcessing " << eventdata->GetFile()->GetName() << " ...";
+			m_fi.PruneEventBranches();
+			m_eventBranchesPruned = true;
 		}
-
-		if (m_prevRun != m_event.m_eventInfo->nRun)
+		
+		// the entries are read by the reader thread (together with the run and lumi entries, if they change)
+		// exit the program, if reading the entries takes unreasonably long (dCache, ...)
+		EventReader::EntryInfo const* entryInfo = m_reader->GetEntry(lEvent);
+		if (entryInfo == nullptr)
 		{
-			m_prevRun = m_event.m_eventInfo->nRun;
-			m_prevLumi = -1;
-			
-			// lood entries asynchronously and exit the program, if looding the entry takes unreasonably long (dCache, ...)
-			FileInterface2* fi = &m_fi;
-			std::future<void> futureGetRunEntry = std::async(std::launch::async, [fi] ()
-			{
-				fi->GetRunEntry();
-			});
-			if (futureGetRunEntry.wait_for(timeout) != std::future_status::ready)
-			{
-				LOG(FATAL) << "Timeout: Could not read entry from Runs tree!";
-			}
-			
-			m_newRun = true;
+			LOG(FATAL) << "Timeout: Could not read entry " << lEvent << " from Events tree or the corresponding entries from Runs and Lumis trees!";
 		}
-		else
+		if (entryInfo->nBytes == 0)
 		{
-			m_newRun = false;
+			return false;
 		}
+		
+		m_event.m_input = entryInfo->treeNumber;
 
-		if (m_prevLumi != m_event.m_eventInfo->nLumi)
+		if (entryInfo->newTree)
 		{
-			m_prevLumi = m_event.m_eventInfo->nLumi;
-			
-			// lood entries asynchronously and exit the program, if looding the entry takes unreasonably long (dCache, ...)
-			FileInterface2* fi = &m_fi;
-			std::future<void> futureGetLumiEntry = std::async(std::launch::async, [fi] ()
-			{
-				fi->GetLumiEntry();
-			});
-			if (futureGetLumiEntry.wait_for(timeout) != std::future_status::ready)
-			{
-				LOG(FATAL) << "Timeout: Could not read entry from Lumis tree!";
-			}
-			
-			m_newLumisection = true;
-		}
-		else
-		{
-			m_newLumisection = false;
+			LOG(INFO) << "\nProcessing " << entryInfo->fileName << " ...";
 		}
+
+		m_newRun = entryInfo->newRun;
+		m_newLumisection = entryInfo->newLumisection;
 		
 		assert((m_event.m_eventInfo->nRun == m_event.m_lumiInfo->nRun) && (m_event.m_eventInfo->nRun == m_event.m_runInfo->nRun));
 		assert(m_event.m_eventInfo->nLumi == m_event.m_lumiInfo->nLumi);
 
-		return (resultGetEntry != 0);
+		return true;
 	}
 
 	event_type const& GetCurrentEvent() const override {
@@ -145,8 +130,6 @@ public:
 
 protected:
 	bool m_newLumisection, m_newRun;
-	long m_prevRun, m_prevLumi;
-	int m_prevTree;
 	event_type m_event;
 
 	InputTypeEnum m_inpType;
@@ -154,6 +137,11 @@ protected:
 	FileInterface2& m_fi;
 	bool m_batchMode;
 	boost::scoped_ptr<ProgressMonitor> m_mon;
+	boost::scoped_ptr<EventReader> m_reader;
+
+	bool m_pruneEventMembers = false;
+	bool m_eventBranchesPruned = false;
+	std::set<std::string> m_requiredEventMembers;
 
 	template<typename T>
 	T* SecureFileInterfaceGetEvent(const std::string &name, const bool check = true, const bool def = false)
@@ -166,6 +154,7 @@ protected:
 			{
 				LOG(FATAL) << "Requested branch (" << name << ") not found!";
 			}
+			result = m_reader->AddEventObject(result);
 		}
 		return result;
 	}
@@ -181,6 +170,7 @@ protected:
 			{
 				LOG(FATAL) << "Requested branch (" << name << ") not found!";
 			}
+			result = m_reader->AddLumiObject(result);
 		}
 		return result;
 	}
@@ -196,6 +186,7 @@ protected:
 			{
 				LOG(FATAL) << "Requested branch (" << name << ") not found!";
 			}
+			result = m_reader->AddRunObject(result);
 		}
 		return result;
 	}
@@ -1,10 +1,16 @@
 #pragma once
 
+#include <memory>
+
 #include "Kappa/DataFormats/interface/Kappa.h"
 
 #include "Artus/KappaTools/interface/HLTTools.h"
+#include "Artus/KappaTools/interface/JECBatchResults.h"
 
+#include "Artus/Core/interface/EventWeights.h"
 #include "Artus/Core/interface/ProductBase.h"
+#include "Artus/Utility/interface/CopyOnWrite.h"
+#include "Artus/Utility/interface/ObjectArena.h"
 #include "Artus/KappaAnalysis/interface/KappaEnumTypes.h"
 #include "Artus/KappaAnalysis/interface/Utility/GenParticleDecayTree.h"
 
@@ -21,24 +27,27 @@ public:
 	// settings to be modified (e.g. in the case of run-dependent settings)
 	std::vector<std::string> m_settingsHltPaths;
 
-	std::map<size_t, std::vector<std::string> > m_settingsElectronTriggerFiltersByIndex;
-	std::map<size_t, std::vector<std::string> > m_settingsMuonTriggerFiltersByIndex;
-	std::map<size_t, std::vector<std::string> > m_settingsTauTriggerFiltersByIndex;
-	std::map<size_t, std::vector<std::string> > m_settingsJetTriggerFiltersByIndex;
+	// the trigger filter maps are only shared with the pipelines until they are modified locally
+
+	CopyOnWrite<std::map<size_t, std::vector<std::string> > > m_settingsElectronTriggerFiltersByIndex;
+	CopyOnWrite<std::map<size_t, std::vector<std::string> > > m_settingsMuonTriggerFiltersByIndex;
+	CopyOnWrite<std::map<size_t, std::vector<std::string> > > m_settingsTauTriggerFiltersByIndex;
+	CopyOnWrite<std::map<size_t, std::vector<std::string> > > m_settingsJetTriggerFiltersByIndex;
 
-	std::map<std::string, std::vector<std::string> > m_settingsElectronTriggerFiltersByHltName;
-	std::map<std::string, std::vector<std::string> > m_settingsMuonTriggerFiltersByHltName;
-	std::map<std::string, std::vector<std::string> > m_settingsTauTriggerFiltersByHltName;
-	std::map<std::string, std::vector<std::string> > m_settingsJetTriggerFiltersByHltName;
+	CopyOnWrite<std::map<std::string, std::vector<std::string> > > m_settingsElectronTriggerFiltersByHltName;
+	CopyOnWrite<std::map<std::string, std::vector<std::string> > > m_settingsMuonTriggerFiltersByHltName;
+	CopyOnWrite<std::map<std::string, std::vector<std::string> > > m_settingsTauTriggerFiltersByHltName;
+	CopyOnWrite<std::map<std::string, std::vector<std::string> > > m_settingsJetTriggerFiltersByHltName;
 
 	std::string m_nickname = "";
 
-	// all weights in this map are multiplied into one "eventWeight" by the EventWeightProducer
-	// events in this map can be written out automatically by the KappaLambdaNtupleConsumer
-	std::map<std::string, double> m_weights;
+	// all weights set here are multiplied into one "eventWeight" by the EventWeightProducer
+	// weights set here can be written out automatically by the KappaLambdaNtupleConsumer
+	// (the indices of the weight names are given by EventWeights::GetIndex)
+	EventWeights m_weights;
 
-	// events in this map can be written out automatically by the KappaLambdaNtupleConsumer
-	std::map<std::string, double> m_optionalWeights;
+	// weights set here can be written out automatically by the KappaLambdaNtupleConsumer
+	EventWeights m_optionalWeights;
 
 	// filled by the GenBosonProducers
 	KGenParticle* m_genBosonParticle = nullptr;
@@ -65,20 +74,25 @@ public:
 	std::map<KGenParticle*, std::vector<KGenParticle*> > m_validGenTausNeutralHadronsMap;
 
 	// filled by the GenTauDecayProducer
-	GenParticleDecayTree m_genBosonTree;
-	std::map<KGenParticle*, GenParticleDecayTree*> m_genTauDecayTrees;
+	// (shared with the pipelines until they are modified locally, the decay trees point into m_genBosonTree)
+	CopyOnWrite<GenParticleDecayTree> m_genBosonTree;
+	CopyOnWrite<std::map<KGenParticle*, GenParticleDecayTree*> > m_genTauDecayTrees;
+
+	/// memory of the corrected objects below, which are deleted together with the product
+	/// or when it is overwritten by the product of the next event
+	/// (the vectors of corrected objects and the maps to the original objects are shared
+	/// with the pipelines until they are modified locally)
+	ObjectArena m_correctedObjectsArena;
 
 	/// added by ElectronCorrectionProducer
-	// needs to be a shared_ptr in order to be deleted when the product is deleted
-	std::vector<std::shared_ptr<KElectron> > m_correctedElectrons;
+	CopyOnWrite<std::vector<KElectron*> > m_correctedElectrons;
 
 	/// added by ValidElectronsProducer
 	std::vector<KElectron*> m_validElectrons;
 	std::vector<KElectron*> m_invalidElectrons;
 
 	/// added by MuonCorrectionProducer
-	// needs to be a shared_ptr in order to be deleted when the product is deleted
-	std::vector<std::shared_ptr<KMuon> > m_correctedMuons;
+	CopyOnWrite<std::vector<KMuon*> > m_correctedMuons;
 
 	/// added by ValidMuonsProducer
 	std::vector<KMuon*> m_validMuons;
@@ -89,11 +103,10 @@ public:
 	std::vector<double> m_MuonPt;
 
 	/// added by TauEnergyCorrectionProducer
-	// needs to be a shared_ptr in order to be deleted when the product is deleted
-	std::vector<std::shared_ptr<KTau> > m_correctedTaus;
+	CopyOnWrite<std::vector<KTau*> > m_correctedTaus;
 
 	/// added by <Lepton>CorrectionProducers
-	std::map<const KLepton*, const KLepton*> m_originalLeptons; // key: corrected, value: original
+	CopyOnWrite<std::map<const KLepton*, const KLepton*> > m_originalLeptons; // key: corrected, value: original
 
 	/// added by ValidTausProducer
 	std::vector<KTau*> m_validTaus;
@@ -104,9 +117,10 @@ public:
 	std::vector<KLepton*> m_invalidLeptons;
 
 	/// added by JetEnergyCorrectionProducer
-	std::vector<std::shared_ptr<KBasicJet> > m_correctedJets;
-	std::vector<std::shared_ptr<KJet> > m_correctedTaggedJets;
-	std::map<const KBasicJet*, const KBasicJet*> m_originalJets; // key: corrected, value: original
+	CopyOnWrite<std::vector<KBasicJet*> > m_correctedJets;
+	CopyOnWrite<std::vector<KJet*> > m_correctedTaggedJets;
+	CopyOnWrite<std::map<const KBasicJet*, const KBasicJet*> > m_originalJets; // key: corrected, value: original
+	std::shared_ptr<JECBatchResults> m_jetEnergyCorrectionResults = std::make_shared<JECBatchResults>(); // shared by all pipelines of an event
 
 	/// added by ValidJetsProducer
 	std::vector<KBasicJet*> m_validJets;
@@ -159,34 +173,37 @@ public:
 
 	/// added by TriggerMatchingProducer
 	// m_detailedTriggerMatchedElectrons[reco lepton][HLT name][filter name] = {trigger objects}
-	std::map<KElectron*, std::map<std::string, std::map<std::string, std::vector<KLV*> > > > m_detailedTriggerMatchedElectrons;
-	std::map<KMuon*, std::map<std::string, std::map<std::string, std::vector<KLV*> > > > m_detailedTriggerMatchedMuons;
-	std::map<KTau*, std::map<std::string, std::map<std::string, std::vector<KLV*> > > > m_detailedTriggerMatchedTaus;
-	std::map<KBasicJet*, std::map<std::string, std::map<std::string, std::vector<KLV*> > > > m_detailedTriggerMatchedJets;
-	std::map<KJet*, std::map<std::string, std::map<std::string, std::vector<KLV*> > > > m_detailedTriggerMatchedTaggedJets;
+	// (shared with the pipelines until they are modified locally)
+	CopyOnWrite<std::map<KElectron*, std::map<std::string, std::map<std::string, std::vector<KLV*> > > > > m_detailedTriggerMatchedElectrons;
+	CopyOnWrite<std::map<KMuon*, std::map<std::string, std::map<std::string, std::vector<KLV*> > > > > m_detailedTriggerMatchedMuons;
+	CopyOnWrite<std::map<KTau*, std::map<std::string, std::map<std::string, std::vector<KLV*> > > > > m_detailedTriggerMatchedTaus;
+	CopyOnWrite<std::map<KBasicJet*, std::map<std::string, std::map<std::string, std::vector<KLV*> > > > > m_detailedTriggerMatchedJets;
+	CopyOnWrite<std::map<KJet*, std::map<std::string, std::map<std::string, std::vector<KLV*> > > > > m_detailedTriggerMatchedTaggedJets;
 
-	std::map<KLepton*, std::map<std::string, std::map<std::string, std::vector<KLV*> > >* > m_detailedTriggerMatchedLeptons;
+	// (pointing to the read-only maps above)
+	std::map<KLepton*, std::map<std::string, std::map<std::string, std::vector<KLV*> > > const* > m_detailedTriggerMatchedLeptons;
 
 	/// added by GenMatchingProducer
-	std::map<KElectron*, KGenParticle*> m_genParticleMatchedElectrons;
-	std::map<KMuon*, KGenParticle*> m_genParticleMatchedMuons;
-	std::map<KTau*, KGenParticle*> m_genParticleMatchedTaus;
-	std::map<KBasicJet*, KGenParticle*> m_genParticleMatchedJets;
-	std::map<KLepton*, KGenParticle*> m_genParticleMatchedLeptons;
+	// (the matching maps are shared with the pipelines until they are modified locally)
+	CopyOnWrite<std::map<KElectron*, KGenParticle*> > m_genParticleMatchedElectrons;
+	CopyOnWrite<std::map<KMuon*, KGenParticle*> > m_genParticleMatchedMuons;
+	CopyOnWrite<std::map<KTau*, KGenParticle*> > m_genParticleMatchedTaus;
+	CopyOnWrite<std::map<KBasicJet*, KGenParticle*> > m_genParticleMatchedJets;
+	CopyOnWrite<std::map<KLepton*, KGenParticle*> > m_genParticleMatchedLeptons;
 	float m_genParticleMatchDeltaR;
 
 	/// added by GenTauMatchingProducers
-	std::map<KElectron*, KGenTau*> m_genTauMatchedElectrons;
-	std::map<KMuon*, KGenTau*> m_genTauMatchedMuons;
-	std::map<KTau*, KGenTau*> m_genTauMatchedTaus;
-	std::map<KLepton*, KGenTau*> m_genTauMatchedLeptons;
+	CopyOnWrite<std::map<KElectron*, KGenTau*> > m_genTauMatchedElectrons;
+	CopyOnWrite<std::map<KMuon*, KGenTau*> > m_genTauMatchedMuons;
+	CopyOnWrite<std::map<KTau*, KGenTau*> > m_genTauMatchedTaus;
+	CopyOnWrite<std::map<KLepton*, KGenTau*> > m_genTauMatchedLeptons;
 	float m_ratioGenTauMatched;
 	float m_genTauMatchDeltaR;
 
 	/// added by GenTauJetMatchingProducers
-	std::map<KElectron*, KGenJet*> m_genTauJetMatchedElectrons;
-	std::map<KMuon*, KGenJet*> m_genTauJetMatchedMuons;
-	std::map<KTau*, KGenJet*> m_genTauJetMatchedTaus;
+	CopyOnWrite<std::map<KElectron*, KGenJet*> > m_genTauJetMatchedElectrons;
+	CopyOnWrite<std::map<KMuon*, KGenJet*> > m_genTauJetMatchedMuons;
+	CopyOnWrite<std::map<KTau*, KGenJet*> > m_genTauJetMatchedTaus;
 
 	/// added by ZProducer
 	KLV m_z;
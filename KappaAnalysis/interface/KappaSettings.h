@@ -17,6 +17,12 @@ public:
 
 	IMPL_SETTING_DEFAULT(bool, BatchMode, false);
 
+	/// number of events read ahead by the event provider while the current one is processed (see EventReader)
+	IMPL_SETTING_DEFAULT(size_t, PrefetchedEvents, 0);
+
+	/// only read the input collections required by the configured processors (see ProcessNodeBase::GetRequiredEventMembers)
+	IMPL_SETTING_DEFAULT(bool, PruneInputBranches, false);
+
 	IMPL_SETTING(std::string, Nickname);
 
 	/// name of electron collection in kappa tupl
@@ -113,6 +119,8 @@ public:
 	IMPL_SETTING_STRINGLIST_DEFAULT(JsonFiles, {});
 	IMPL_SETTING_DEFAULT(int, PassRunLow, 0);
 	IMPL_SETTING_DEFAULT(int, PassRunHigh, 0);
+	/// keep the lumi ranges of the JSON files in binary caches next to them (<json>.cache)
+	IMPL_SETTING_DEFAULT(bool, CacheJsonFiles, false);
 
 	// Good Primary Vertex Filter
 	IMPL_SETTING(float, MaxPrimaryVertexZ);
@@ -129,6 +137,9 @@ public:
 	IMPL_SETTING_UINT64LIST_DEFAULT(EventWhitelist, {});
 	IMPL_SETTING_UINT64LIST_DEFAULT(EventBlacklist, {});
 	IMPL_SETTING_DEFAULT(bool, MatchRunLumiEventTuples, false);
+	/// binary files of (run, lumi, event) tuples of uint64_t numbers for the RunLumiEventFilter
+	IMPL_SETTING_DEFAULT(std::string, RunLumiEventWhitelistFile, "");
+	IMPL_SETTING_DEFAULT(std::string, RunLumiEventBlacklistFile, "");
 
 	IMPL_SETTING_STRINGLIST_DEFAULT(HltPaths, {});
 	IMPL_SETTING_DEFAULT(bool, AllowPrescaledTrigger, true);
@@ -248,6 +259,7 @@ public:
 	IMPL_SETTING_DEFAULT(std::string, JetEnergyCorrectionUncertaintyParameters, "");
 	IMPL_SETTING_DEFAULT(std::string, JetEnergyCorrectionUncertaintySource, "");
 	IMPL_SETTING_DEFAULT(float, JetEnergyCorrectionUncertaintyShift, 0.0f);
+	IMPL_SETTING_DEFAULT(bool, JetEnergyCorrectionNativeEvaluation, false);
 
 	IMPL_SETTING_DEFAULT(std::string, ValidJetsInput, "auto");
 	IMPL_SETTING(std::string, JetID);
@@ -358,6 +370,8 @@ public:
 	IMPL_SETTING_STRINGLIST_DEFAULT(TmvaInputQuantities, {});
 	IMPL_SETTING_STRINGLIST_DEFAULT(TmvaMethods, {});
 	IMPL_SETTING_STRINGLIST_DEFAULT(TmvaWeights, {});
+	// evaluate BDT weight files without TMVA where possible (see TmvaBdt), opt-in
+	IMPL_SETTING_DEFAULT(bool, TmvaNativeBdtEvaluation, false);
 
 	// KappaCollectionsConsumer settings
 	IMPL_SETTING_DEFAULT(bool, BranchGenMatchedElectrons, false);
@@ -18,6 +18,7 @@ class ElectronCorrectionsProducer: public KappaProducerBase
 public:
 
 	std::string GetProducerId() const override;
+	void GetRequiredEventMembers(std::set<std::string>& eventMembers) const override;
 	
 	void Init(setting_type const& settings, metadata_type& metadata)  override;
 
@@ -31,5 +32,7 @@ protected:
 	virtual void AdditionalCorrections(KElectron* electron, event_type const& event,
 	                                   product_type& product, setting_type const& settings, metadata_type const& metadata) const;
 
+private:
+	bool m_useUWGenMatching = false;
 };
 
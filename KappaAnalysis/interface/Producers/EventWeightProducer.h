@@ -10,8 +10,8 @@
    Config tags:
    - EventWeight, e.g. "eventWeight"
    
-   Multiplies all entries in the map product.m_weights with m_baseWeight
-   and writes the result to product.m_weights[settings.GetEventWeight()]
+   Multiplies all weights in product.m_weights with settings.GetBaseWeight()
+   and writes the result to the weight settings.GetEventWeight() in product.m_weights
    
    By adding the weight quantity names to the Quantity config setting,
    they will be individually written to the ntuple by the LambdaNtupleConsumer
@@ -32,6 +32,7 @@ public:
 
 private:
 	std::string pipelineName;
+	size_t m_eventWeightIndex = 0;
 	mutable std::vector<std::string> m_weightNames;
 };
 
@@ -15,6 +15,7 @@ class GenBosonFromGenParticlesProducer: public ProducerBase<KappaTypes>
 public:
 
 	std::string GetProducerId() const override;
+	void GetRequiredEventMembers(std::set<std::string>& eventMembers) const override;
 
 	void Init(setting_type const& settings, metadata_type& metadata) override;
 
@@ -26,6 +26,7 @@ class GenMuonFSRProducer: public KappaProducerBase
 public:
 
 	std::string GetProducerId() const override;
+	void GetRequiredEventMembers(std::set<std::string>& eventMembers) const override;
 
 	void Init(setting_type const& settings, metadata_type& metadata) override;
 
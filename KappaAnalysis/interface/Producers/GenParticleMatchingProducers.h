@@ -5,6 +5,7 @@
 #include <boost/algorithm/string/trim.hpp>
 
 #include "Kappa/DataFormats/interface/Kappa.h"
+#include "Artus/KappaTools/interface/Matching.h"
 
 #include "Artus/KappaAnalysis/interface/KappaTypes.h"
 #include "Artus/KappaAnalysis/interface/KappaProducerBase.h"
@@ -34,6 +35,7 @@ public:
 	static JetMatchingAlgorithm ToJetMatchingAlgorithm(std::string const& jetMatchingAlgorithm);
 	
 	std::string GetProducerId() const override;
+	void GetRequiredEventMembers(std::set<std::string>& eventMembers) const override;
 
 	void Init(setting_type const& settings, metadata_type& metadata) override;
 
@@ -42,9 +44,18 @@ public:
 
 	static KGenParticle* Match(event_type const& event, product_type const& product,
                                setting_type const& settings, KLV* const recoJet, JetMatchingAlgorithm jetMatchingAlgorithm);
+	// only considers the gen particles found by genParticlesIndex (built for event.m_genParticles)
+	static KGenParticle* Match(event_type const& event, product_type const& product,
+                               setting_type const& settings, KLV* const recoJet, JetMatchingAlgorithm jetMatchingAlgorithm,
+                               DeltaRIndex const& genParticlesIndex);
 
 private:
+	static KGenParticle* Match(event_type const& event, setting_type const& settings, KLV* const recoJet,
+	                           JetMatchingAlgorithm jetMatchingAlgorithm, std::vector<size_t> const& genParticleIndices);
+
 	JetMatchingAlgorithm m_jetMatchingAlgorithm;
+	// rebuilt for every event, the memory is reused
+	mutable DeltaRIndex m_genParticlesIndex;
 };
 
 
@@ -59,7 +70,7 @@ class RecoLeptonGenParticleMatchingProducerBase: public KappaProducerBase
 
 public:
 
-	RecoLeptonGenParticleMatchingProducerBase(std::map<TLepton*, KGenParticle*> product_type::*genParticleMatchedLeptons,
+	RecoLeptonGenParticleMatchingProducerBase(CopyOnWrite<std::map<TLepton*, KGenParticle*> > product_type::*genParticleMatchedLeptons,
 	                                          std::vector<TLepton>* event_type::*leptons,
 	                                          std::vector<TLepton*> product_type::*validLeptons,
 	                                          std::vector<TLepton*> product_type::*invalidLeptons,
@@ -85,6 +96,8 @@ public:
 	void Init(setting_type const& settings, metadata_type& metadata) override
 	{
 		KappaProducerBase::Init(settings, metadata);
+
+		m_genParticlesIndex = DeltaRIndex(std::max(0.1f, (settings.*GetDeltaRMatchingRecoLeptonsGenParticle)()));
 	}
 
 	void Produce(event_type const& event, product_type& product,
@@ -94,6 +107,10 @@ public:
 
 		if ((settings.*GetDeltaRMatchingRecoLeptonsGenParticle)() > 0.0f)
 		{
+			m_genParticlesIndex.Build(*event.m_genParticles);
+			std::vector<int> const& genParticlePdgIds = (settings.*GetRecoLeptonMatchingGenParticlePdgIds)();
+			int genParticleStatus = (settings.*GetRecoLeptonMatchingGenParticleStatus)();
+
 			// choose valid leptons or all leptons for matching
 			std::vector<TLepton*> leptons;
 			if ((settings.*GetRecoLeptonMatchingGenParticleMatchAllLeptons)())
@@ -122,32 +139,18 @@ public:
 			for (typename std::vector<TLepton*>::iterator lepton = leptons.begin();
 				 lepton != leptons.end();)
 			{
-				bool leptonMatched = false;
-				float deltaR = 0.0f;
-				float deltaRmin = std::numeric_limits<float>::max();
-
-				// loop over all genParticles
-				for (typename std::vector<KGenParticle>::iterator genParticle = event.m_genParticles->begin();
-					genParticle != event.m_genParticles->end(); ++genParticle)
+				// closest genParticle, which will decay into comparable particles and has the required status (if requested)
+				int genParticleIndex = m_genParticlesIndex.FindNearest((*lepton)->p4, *event.m_genParticles,
+				                                                       (settings.*GetDeltaRMatchingRecoLeptonsGenParticle)(),
+				                                                       [&genParticlePdgIds, genParticleStatus](KGenParticle const& genParticle)
+				{
+					return ((genParticlePdgIds.empty() || Utility::Contains(genParticlePdgIds, std::abs(genParticle.pdgId))) &&
+					        ((genParticleStatus == -1) || (genParticleStatus == genParticle.status())));
+				});
+				bool leptonMatched = (genParticleIndex >= 0);
+				if (leptonMatched)
 				{
-					// only use genParticles that will decay into comparable particles
-					if ((settings.*GetRecoLeptonMatchingGenParticlePdgIds)().empty() ||
-					    Utility::Contains((settings.*GetRecoLeptonMatchingGenParticlePdgIds)(), std::abs(genParticle->pdgId)))
-					{
-						// only use genParticles with the required status if requested
-						if ((settings.*GetRecoLeptonMatchingGenParticleStatus)() == -1 ||
-						    (settings.*GetRecoLeptonMatchingGenParticleStatus)() == genParticle->status())
-						{
-							deltaR = ROOT::Math::VectorUtil::DeltaR((*lepton)->p4, genParticle->p4);
-							if(deltaR<(settings.*GetDeltaRMatchingRecoLeptonsGenParticle)() && deltaR<deltaRmin)
-							{
-								(product.*m_genParticleMatchedLeptons)[*lepton] = &(*genParticle);
-								deltaRmin = deltaR;
-								leptonMatched = true;
-								//LOG(INFO) << this->GetProducerId() << " (event " << event.m_eventInfo->nEvent << "): " << (*lepton)->p4 << " --> " << genParticle->p4 << ", pdg=" << genParticle->pdgId << ", status=" << genParticle->status();
-							}
-						}
-					}
+					(product.*m_genParticleMatchedLeptons).GetMutable()[*lepton] = &(event.m_genParticles->at(genParticleIndex));
 				}
 				// invalidate (non) matching lepton if requested
 				if (!(settings.*GetRecoLeptonMatchingGenParticleMatchAllLeptons)() &&
@@ -174,7 +177,7 @@ public:
 
 
 private:
-	std::map<TLepton*, KGenParticle*> product_type::*m_genParticleMatchedLeptons; //changed to KGenParticle from const KDataLV
+	CopyOnWrite<std::map<TLepton*, KGenParticle*> > product_type::*m_genParticleMatchedLeptons; //changed to KGenParticle from const KDataLV
 	std::vector<TLepton>* event_type::*m_leptons;
 	std::vector<TLepton*> product_type::*m_validLeptons;
 	std::vector<TLepton*> product_type::*m_invalidLeptons;
@@ -184,6 +187,9 @@ private:
 	bool (setting_type::*GetInvalidateNonGenParticleMatchingLeptons)(void) const;
 	bool (setting_type::*GetInvalidateGenParticleMatchingLeptons)(void) const;
 	bool (setting_type::*GetRecoLeptonMatchingGenParticleMatchAllLeptons)(void) const;
+
+	// rebuilt for every event, the memory is reused
+	mutable DeltaRIndex m_genParticlesIndex;
 	
 	std::map<size_t, std::vector<std::string> > m_leptonTriggerFiltersByIndex;
 	std::map<std::string, std::vector<std::string> > m_leptonTriggerFiltersByHltName;
@@ -205,6 +211,7 @@ class RecoElectronGenParticleMatchingProducer: public RecoLeptonGenParticleMatch
 public:
 	
 	std::string GetProducerId() const override;
+	void GetRequiredEventMembers(std::set<std::string>& eventMembers) const override;
 
 	RecoElectronGenParticleMatchingProducer();
 
@@ -225,6 +232,7 @@ class RecoMuonGenParticleMatchingProducer: public RecoLeptonGenParticleMatchingP
 public:
 	
 	std::string GetProducerId() const override;
+	void GetRequiredEventMembers(std::set<std::string>& eventMembers) const override;
 	
 	RecoMuonGenParticleMatchingProducer();
 
@@ -245,6 +253,7 @@ class RecoTauGenParticleMatchingProducer: public RecoLeptonGenParticleMatchingPr
 public:
 	
 	std::string GetProducerId() const override;
+	void GetRequiredEventMembers(std::set<std::string>& eventMembers) const override;
 	
 	RecoTauGenParticleMatchingProducer();
 
@@ -20,6 +20,7 @@ class GenPartonCounterProducer: public ProducerBase<KappaTypes>
 public:
 
 	std::string GetProducerId() const override;
+	void GetRequiredEventMembers(std::set<std::string>& eventMembers) const override;
 
 	void Init(setting_type const& settings, metadata_type& metadata) override;
 
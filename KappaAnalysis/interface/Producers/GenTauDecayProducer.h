@@ -27,6 +27,7 @@ class GenTauDecayProducer: public KappaProducerBase
 public:
 
 	std::string GetProducerId() const override;
+	void GetRequiredEventMembers(std::set<std::string>& eventMembers) const override;
 
 	void Init(setting_type const& settings, metadata_type& metadata) override;
 
@@ -28,7 +28,7 @@ public:
 		T   = 2
 	};
 
-	GenTauJetMatchingProducerBase(std::map<TValidObject*, KGenJet*> product_type::*genTauJetMatchedObjects,
+	GenTauJetMatchingProducerBase(CopyOnWrite<std::map<TValidObject*, KGenJet*> > product_type::*genTauJetMatchedObjects,
 	                           std::vector<TValidObject*> product_type::*validObjects,
 	                           std::vector<TValidObject*> product_type::*invalidObjects,
 	                           TauDecayMode tauDecayMode,
@@ -75,7 +75,7 @@ public:
 					deltaR = ROOT::Math::VectorUtil::DeltaR((*validObject)->p4, genTauJet->p4);
 					if(deltaR<(settings.*GetDeltaRMatchingRecoObjectGenTauJet)() && deltaR<deltaRmin)
 					{
-						(product.*m_genTauJetMatchedObjects)[*validObject] = &(*genTauJet);
+						(product.*m_genTauJetMatchedObjects).GetMutable()[*validObject] = &(*genTauJet);
 						deltaRmin = deltaR;
 						objectMatched = true;
 						//LOG(INFO) << this->GetProducerId() << " (event " << event.m_eventInfo->nEvent << "): " << (*validObject)->p4 << " --> " << genTauJet->p4;
@@ -104,7 +104,7 @@ public:
 	}
 	
 private:
-	std::map<TValidObject*, KGenJet*> product_type::*m_genTauJetMatchedObjects; //changed to KGenParticle from const KDataLV
+	CopyOnWrite<std::map<TValidObject*, KGenJet*> > product_type::*m_genTauJetMatchedObjects; //changed to KGenParticle from const KDataLV
 	std::vector<TValidObject*> product_type::*m_validObjects;
 	std::vector<TValidObject*> product_type::*m_invalidObjects;
 	TauDecayMode tauDecayMode;
@@ -130,6 +130,7 @@ class RecoElectronGenTauJetMatchingProducer: public GenTauJetMatchingProducerBas
 public:
 	
 	std::string GetProducerId() const override;
+	void GetRequiredEventMembers(std::set<std::string>& eventMembers) const override;
 
 	RecoElectronGenTauJetMatchingProducer();
 
@@ -148,6 +149,7 @@ class RecoMuonGenTauJetMatchingProducer: public GenTauJetMatchingProducerBase<KM
 public:
 	
 	std::string GetProducerId() const override;
+	void GetRequiredEventMembers(std::set<std::string>& eventMembers) const override;
 	
 	RecoMuonGenTauJetMatchingProducer();
 
@@ -166,6 +168,7 @@ class RecoTauGenTauJetMatchingProducer: public GenTauJetMatchingProducerBase<KTa
 public:
 	
 	std::string GetProducerId() const override;
+	void GetRequiredEventMembers(std::set<std::string>& eventMembers) const override;
 	
 	RecoTauGenTauJetMatchingProducer();
 
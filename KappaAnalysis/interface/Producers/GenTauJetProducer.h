@@ -25,6 +25,7 @@ class GenTauJetProducer: public KappaProducerBase
 public:
 
 	std::string GetProducerId() const override;
+	void GetRequiredEventMembers(std::set<std::string>& eventMembers) const override;
 
 	void Init(setting_type const& settings, metadata_type& metadata) override;
  
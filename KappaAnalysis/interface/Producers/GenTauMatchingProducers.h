@@ -28,7 +28,7 @@ public:
 		T   = 2
 	};
 
-	GenTauMatchingProducerBase(std::map<TValidObject*, KGenTau*> product_type::*genTauMatchedObjects, //changed to KGenParticle from const KDataLV
+	GenTauMatchingProducerBase(CopyOnWrite<std::map<TValidObject*, KGenTau*> > product_type::*genTauMatchedObjects, //changed to KGenParticle from const KDataLV
 	                           std::vector<TValidObject>* event_type::*objects,
 	                           std::vector<TValidObject*> product_type::*validObjects,
 	                           std::vector<TValidObject*> product_type::*invalidObjects,
@@ -115,8 +115,8 @@ public:
 						deltaR = static_cast<float>(ROOT::Math::VectorUtil::DeltaR((*object)->p4, genTau->visible.p4));
 						if(deltaR<(settings.*GetDeltaRMatchingRecoObjectGenTau)() && deltaR<deltaRmin)
 						{
-							(product.*m_genTauMatchedObjects)[*object] = &(*genTau);
-							product.m_genTauMatchedLeptons[*object] = &(*genTau);
+							(product.*m_genTauMatchedObjects).GetMutable()[*object] = &(*genTau);
+							product.m_genTauMatchedLeptons.GetMutable()[*object] = &(*genTau);
 							ratioGenTauMatched += 1.0 / objects.size();
 							product.m_genTauMatchDeltaR = deltaR;
 							deltaRmin = deltaR;
@@ -164,7 +164,7 @@ public:
 	}
 	
 private:
-	std::map<TValidObject*, KGenTau*> product_type::*m_genTauMatchedObjects; //changed to KGenParticle from const KDataLV
+	CopyOnWrite<std::map<TValidObject*, KGenTau*> > product_type::*m_genTauMatchedObjects; //changed to KGenParticle from const KDataLV
 	std::vector<TValidObject>* event_type::*m_objects;
 	std::vector<TValidObject*> product_type::*m_validObjects;
 	std::vector<TValidObject*> product_type::*m_invalidObjects;
@@ -189,6 +189,7 @@ class RecoElectronGenTauMatchingProducer: public GenTauMatchingProducerBase<KEle
 public:
 	
 	std::string GetProducerId() const override;
+	void GetRequiredEventMembers(std::set<std::string>& eventMembers) const override;
 
 	RecoElectronGenTauMatchingProducer();
 
@@ -207,6 +208,7 @@ class RecoMuonGenTauMatchingProducer: public GenTauMatchingProducerBase<KMuon>
 public:
 	
 	std::string GetProducerId() const override;
+	void GetRequiredEventMembers(std::set<std::string>& eventMembers) const override;
 	
 	RecoMuonGenTauMatchingProducer();
 
@@ -225,6 +227,7 @@ class RecoTauGenTauMatchingProducer: public GenTauMatchingProducerBase<KTau>
 public:
 	
 	std::string GetProducerId() const override;
+	void GetRequiredEventMembers(std::set<std::string>& eventMembers) const override;
 	
 	RecoTauGenTauMatchingProducer();
 
@@ -27,6 +27,7 @@ public:
 
 private:
 	mutable HLTTools m_hltInfo;
+	size_t m_hltPrescaleWeightIndex = 0;
 
 };
 
@@ -2,6 +2,8 @@
 #pragma once
 
 #include <algorithm>
+#include <memory>
+#include <string>
 
 #include <boost/algorithm/string.hpp>
 #include <boost/algorithm/string/trim.hpp>
@@ -28,6 +30,11 @@
    - JetEnergyCorrectionUncertaintyParameters (default: empty)
    - JetEnergyCorrectionUncertaintySource (default "")
    - JetEnergyCorrectionUncertaintyShift (default 0.0)
+   - JetEnergyCorrectionNativeEvaluation (default: false, evaluate the corrections from flat tables
+     of the parameters instead of the FactorizedJetCorrector/JetCorrectionUncertainty)
+   
+   The corrections and uncertainties are evaluated once per event for all pipelines correcting the
+   same jets with the same parameters (see JECBatchResults.h).
    
    Required packages (unfortunately, nobody knows a tag):
    git cms-addpkg CondFormats/JetMETObjects
@@ -47,7 +54,7 @@ class JetCorrectionsProducerBase: public KappaProducerBase
 public:
 	
 	JetCorrectionsProducerBase(std::vector<TJet>* event_type::*jets,
-	                           std::vector<std::shared_ptr<TJet> > product_type::*correctedJets) :
+	                           CopyOnWrite<std::vector<TJet*> > product_type::*correctedJets) :
 		KappaProducerBase(),
 		m_basicJetsMember(jets),
 		m_correctedJetsMember(correctedJets)
@@ -78,6 +85,7 @@ public:
 		{
 			LOG(DEBUG) << "\t\t" << *jecParametersFile;
 			jecParameters.push_back(JetCorrectorParameters(*jecParametersFile));
+			m_jecParametersName += (*jecParametersFile + "\n");
 		}
 		if (jecParameters.size() > 0)
 		{
@@ -86,10 +94,10 @@ public:
 		
 		// initialise uncertainty calculation
 		LOG(DEBUG) << "\tLoading JetCorrectionUncertainty from files...";
+		JetCorrectorParameters jecUncertaintyParameters;
 		if ((! settings.GetJetEnergyCorrectionUncertaintyParameters().empty()) &&
 		    (settings.GetJetEnergyCorrectionUncertaintyShift() != 0.0))
 		{
-			JetCorrectorParameters jecUncertaintyParameters;
 			if (!settings.GetJetEnergyCorrectionUncertaintySource().empty()) {
 				LOG(DEBUG) << "\t\t" << settings.GetJetEnergyCorrectionUncertaintyParameters() << " (" << settings.GetJetEnergyCorrectionUncertaintySource() << ")";
 				jecUncertaintyParameters = JetCorrectorParameters(
@@ -108,6 +116,36 @@ public:
 				LOG(FATAL) << "Invalid definition " << settings.GetJetEnergyCorrectionUncertaintySource() 
 				           << " in file " << settings.GetJetEnergyCorrectionUncertaintyParameters();
 			}
+			m_jecUncertaintyName = settings.GetJetEnergyCorrectionUncertaintyParameters() + "\n" + settings.GetJetEnergyCorrectionUncertaintySource();
+		}
+		
+		jecBatchEvaluator.setCorrectors(factorizedJetCorrector, jetCorrectionUncertainty);
+		if (settings.GetJetEnergyCorrectionNativeEvaluation())
+		{
+			std::shared_ptr<const JECCorrectionTables> jecTables;
+			if (factorizedJetCorrector != nullptr)
+			{
+				jecTables = getSharedJECTables<JECCorrectionTables>(m_jecParametersName, jecParameters);
+				if (!jecTables->getUnsupported().empty())
+				{
+					LOG(WARNING) << "JEC tables do not support the " << jecTables->getUnsupported()
+					             << ", the corrections are evaluated by the FactorizedJetCorrector.";
+				}
+			}
+			std::shared_ptr<const JECUncertaintyTable> jecUncertaintyTable;
+			if (jetCorrectionUncertainty != nullptr)
+			{
+				jecUncertaintyTable = getSharedJECTables<JECUncertaintyTable>(m_jecUncertaintyName, jecUncertaintyParameters);
+				if (!jecUncertaintyTable->getUnsupported().empty())
+				{
+					LOG(WARNING) << "JEC tables do not support the " << jecUncertaintyTable->getUnsupported()
+					             << ", the uncertainties are evaluated by the JetCorrectionUncertainty.";
+				}
+			}
+			jecBatchEvaluator.setTables(jecTables, jecUncertaintyTable);
+			
+			// the results of both evaluations are not shared
+			m_jecParametersName = "native\n" + m_jecParametersName;
 		}
 	}
 
@@ -118,47 +156,35 @@ public:
 		assert(event.m_pileupDensity);
 		assert(event.m_vertexSummary);
 		
-		// create a copy of all jets in the event (first temporarily for the JEC)
-		(product.*m_correctedJetsMember).clear();
-		std::vector<TJet> correctJetsForJecTools((event.*m_basicJetsMember)->size());
-		size_t jetIndex = 0;
-		for (typename std::vector<TJet>::const_iterator jet = (event.*m_basicJetsMember)->begin();
-			 jet != (event.*m_basicJetsMember)->end(); ++jet)
+		// create a copy of all jets in the event (deleted at the end of the event)
+		std::vector<TJet> const& jets = *(event.*m_basicJetsMember);
+		std::vector<TJet*>& correctedJets = (product.*m_correctedJetsMember).Reset();
+		std::map<const KBasicJet*, const KBasicJet*>& originalJets = product.m_originalJets.GetMutable();
+		correctedJets.resize(jets.size());
+		for (size_t jetIndex = 0; jetIndex < jets.size(); ++jetIndex)
 		{
-			correctJetsForJecTools[jetIndex] = *jet;
-			++jetIndex;
+			correctedJets[jetIndex] = product.m_correctedObjectsArena.Create<TJet>(jets[jetIndex]);
+			originalJets[correctedJets[jetIndex]] = &(jets[jetIndex]);
 		}
 		
 		// apply jet energy corrections and uncertainty shift (if uncertainties are not to be splitted into individual contributions)
-		correctJets(&correctJetsForJecTools, factorizedJetCorrector, jetCorrectionUncertainty,
-		            event.m_pileupDensity->rho, event.m_vertexSummary->nVertices, -1,
-		            settings.GetJetEnergyCorrectionUncertaintyShift());
-		
-		// create the shared pointers to store in the product
-		(product.*m_correctedJetsMember).clear();
-		(product.*m_correctedJetsMember).resize(correctJetsForJecTools.size());
-		jetIndex = 0;
-		for (typename std::vector<TJet>::const_iterator jet = correctJetsForJecTools.begin();
-			 jet != correctJetsForJecTools.end(); ++jet)
-		{
-			(product.*m_correctedJetsMember)[jetIndex] = std::shared_ptr<TJet>(new TJet(*jet));
-			product.m_originalJets[(product.*m_correctedJetsMember)[jetIndex].get()] = &(*jet);
-			++jetIndex;
-		}
+		// to all jets at once, the results are evaluated only by the first pipeline needing them
+		JECBatchResult& jecResult = product.m_jetEnergyCorrectionResults->get(m_jecParametersName, m_jecUncertaintyName, &jets);
+		jecBatchEvaluator.evaluate(correctedJets, event.m_pileupDensity->rho, event.m_vertexSummary->nVertices, -1, jecResult);
+		jecBatchEvaluator.apply(correctedJets, jecResult, -1, settings.GetJetEnergyCorrectionUncertaintyShift());
 		
 		// perform corrections on copied jets
-		for (typename std::vector<std::shared_ptr<TJet> >::iterator jet = (product.*m_correctedJetsMember).begin();
-			 jet != (product.*m_correctedJetsMember).end(); ++jet)
+		for (typename std::vector<TJet*>::iterator jet = correctedJets.begin(); jet != correctedJets.end(); ++jet)
 		{
 			// No general correction implemented
 			
 			// perform possible analysis-specific corrections
-			AdditionalCorrections(jet->get(), event, product, settings, metadata);
+			AdditionalCorrections(*jet, event, product, settings, metadata);
 		}
 		
 		// sort vectors of corrected jets by pt
-		std::sort((product.*m_correctedJetsMember).begin(), (product.*m_correctedJetsMember).end(),
-		          [](std::shared_ptr<TJet> jet1, std::shared_ptr<TJet> jet2) -> bool
+		std::sort(correctedJets.begin(), correctedJets.end(),
+		          [](TJet const* jet1, TJet const* jet2) -> bool
 		          { return jet1->p4.Pt() > jet2->p4.Pt(); });
 	}
 
@@ -173,10 +199,13 @@ protected:
 
 private:
 	std::vector<TJet>* event_type::*m_basicJetsMember;
-	std::vector<std::shared_ptr<TJet> > product_type::*m_correctedJetsMember;
+	CopyOnWrite<std::vector<TJet*> > product_type::*m_correctedJetsMember;
 
 	FactorizedJetCorrector* factorizedJetCorrector = nullptr;
 	JetCorrectionUncertainty* jetCorrectionUncertainty = nullptr;
+	std::string m_jecParametersName;
+	std::string m_jecUncertaintyName;
+	mutable JECBatchEvaluator jecBatchEvaluator;
 };
 
 
@@ -192,6 +221,7 @@ public:
 	JetCorrectionsProducer();
 
 	std::string GetProducerId() const override;
+	void GetRequiredEventMembers(std::set<std::string>& eventMembers) const override;
 };
 
 
@@ -208,6 +238,7 @@ public:
 	TaggedJetCorrectionsProducer();
 	
 	std::string GetProducerId() const override;
+	void GetRequiredEventMembers(std::set<std::string>& eventMembers) const override;
 };
 
 
@@ -19,6 +19,7 @@ class MuonCorrectionsProducer: public KappaProducerBase
 
 public:
 	std::string GetProducerId() const override;
+	void GetRequiredEventMembers(std::set<std::string>& eventMembers) const override;
 
 	void Init(setting_type const& settings, metadata_type& metadata) override;
 
@@ -41,8 +42,15 @@ protected:
 	virtual void AdditionalCorrections(KMuon* muon, event_type const& event, product_type& product,
 	                                   setting_type const& settings, metadata_type const& metadata) const;
 private:
+	// fills m_rochesterScaleFactors with the 2016 Rochester corrections of all corrected muons
+	void ComputeRochesterCorrections2016(product_type& product, setting_type const& settings) const;
+
+	bool m_useUWGenMatching = false;
 	MuonEnergyCorrection muonEnergyCorrection;
 	rochcor2015 *rmcor2015;
 	RoccoR2016 *rmcor2016;
 	TRandom3 *random;
+
+	mutable std::vector<RocMuon2016> m_rochesterMuons;
+	mutable std::vector<double> m_rochesterScaleFactors;
 };
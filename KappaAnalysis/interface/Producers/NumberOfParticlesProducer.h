@@ -20,6 +20,11 @@ class NumberOfParticlesProducer : public KappaProducerBase
 		{
 			return "NumberOfParticlesProducer";
 		};
+
+		void GetRequiredEventMembers(std::set<std::string>& eventMembers) const override
+		{
+			eventMembers.insert({ "Electrons", "Muons" });
+		}
 		
 		void Produce(event_type const& event, product_type& product,
 		             setting_type const& settings, metadata_type const& metadata) const override;
@@ -20,6 +20,11 @@ public:
 	{
 		return "PFCandidatesProducer";
 	};
+
+	void GetRequiredEventMembers(std::set<std::string>& eventMembers) const override
+	{
+		eventMembers.insert("PackedPFCandidates");
+	}
 	
 	void Produce(event_type const& event, product_type& product, setting_type const& settings, metadata_type const& metadata) const override;
 
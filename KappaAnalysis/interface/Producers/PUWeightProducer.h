@@ -1,6 +1,8 @@
 
 #pragma once
 
+#include <memory>
+
 #include "Artus/KappaAnalysis/interface/KappaTypes.h"
 #include "Artus/KappaAnalysis/interface/KappaProducerBase.h"
 
@@ -14,6 +16,8 @@
    
    This producer needs the following config tags:
     - PileupWeightFile
+
+   The weights of a file are read only once per process and shared by all pipelines.
 */
 
 class PUWeightProducer: public KappaProducerBase
@@ -30,8 +34,16 @@ public:
 
 
 private:
-		std::vector<double> m_pileupWeights;
-		double m_bins;
+		struct PileupWeights
+		{
+			std::vector<double> m_weights;
+			double m_bins;
+		};
+
+		static std::shared_ptr<const PileupWeights> GetPileupWeights(std::string const& pileupWeightFile);
+
+		std::shared_ptr<const PileupWeights> m_pileupWeights;
+		size_t m_puWeightIndex = 0;
 
 };
 
@@ -9,6 +9,7 @@
 class PrintGenParticleDecayTreeProducer : public KappaProducerBase {
 public:
 	std::string GetProducerId() const override;
+	void GetRequiredEventMembers(std::set<std::string>& eventMembers) const override;
 	void Init(setting_type const& settings, metadata_type& metadata) override;
 	void Produce(event_type const& event, product_type& product, setting_type const& settings, metadata_type const& metadata) const override;
 
@@ -31,4 +31,8 @@ private:
 	std::map<std::string, std::vector<double> > stitchingWeightsByName;
 	std::map<std::string, std::vector<double> > stitchingWeightsHighMassByName;
 
+	size_t m_crossSectionPerEventWeightIndex = 0;
+	size_t m_numberGeneratedEventsWeightIndex = 0;
+	size_t m_sampleStitchingWeightIndex = 0;
+
 };
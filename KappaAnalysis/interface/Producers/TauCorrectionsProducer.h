@@ -17,6 +17,7 @@ class TauCorrectionsProducer: public KappaProducerBase
 
 public:
 	std::string GetProducerId() const override;
+	void GetRequiredEventMembers(std::set<std::string>& eventMembers) const override;
 
 	void Init(setting_type const& settings, metadata_type& metadata)  override;
 
@@ -29,5 +30,7 @@ protected:
 	virtual void AdditionalCorrections(KTau* tau, event_type const& event, product_type& product,
 	                                   setting_type const& settings, metadata_type const& metadata) const;
 
+private:
+	bool m_useUWGenMatching = false;
 };
 
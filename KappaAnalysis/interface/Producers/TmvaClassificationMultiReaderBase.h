@@ -1,10 +1,14 @@
 
 #pragma once
 
+#include <cmath>
+#include <map>
+
 #include <boost/algorithm/string/split.hpp>
 #include <boost/algorithm/string/trim.hpp>
 
 #include <TMVA/Reader.h>
+#include <TMVA/MethodBase.h>
 #include "TPluginManager.h"
 #include <TString.h>
 
@@ -12,6 +16,7 @@
 #include "Artus/Core/interface/ProducerBase.h"
 #include "Artus/KappaAnalysis/interface/Consumers/KappaLambdaNtupleConsumer.h"
 #include "Artus/Utility/interface/DefaultValues.h"
+#include "Artus/Utility/interface/TmvaBdt.h"
 #include "Artus/KappaAnalysis/interface/KappaProducerBase.h"
 
 
@@ -57,6 +62,7 @@ public:
 			gPluginMgr->AddHandler("TMVA@@MethodBase", ".*FastBDT.*", "TMVA::MethodFastBDT", "TMVAFastBDT", "MethodFastBDT(TString&,TString&,DataSetInfo&,TString&)");
 		#endif
 		std::vector<float*> tmvaInput;
+		std::map<int, std::vector<std::string>> inputVariables;
 		// construct extractors vector
 		for (std::vector<std::string>::const_iterator quantity_str = (settings.*GetTmvaInputQuantities)().begin();
 			 quantity_str != (settings.*GetTmvaInputQuantities)().end(); ++quantity_str)
@@ -75,6 +81,7 @@ public:
 			boost::algorithm::split(quantities_vec, quantity_number.back(), boost::algorithm::is_any_of(","));
 			transform(quantities_vec.begin(), quantities_vec.end(), quantities_vec.begin(),
 					  [](std::string s) { return boost::algorithm::trim_copy(s); });
+			inputVariables[input_index] = quantities_vec;
 			m_inputExtractors[input_index].clear();
 			tmvaInput.clear();
 			for (std::vector<std::string>::const_iterator quantity = quantities_vec.begin();
@@ -119,7 +126,22 @@ public:
 			std::string tmvaMethod = boost::lexical_cast<std::string>(input_index) + method_split.back() + boost::lexical_cast<std::string>(mvaMethodIndex);
 			std::string tmvaWeights = (settings.*GetTmvaWeights)()[mvaMethodIndex];
 			LOG(DEBUG) << "\t\tmethod: " << tmvaMethod << ", weight file: " << tmvaWeights;
-			tmvaReader[input_index]->BookMVA(tmvaMethod, tmvaWeights);
+			// BDTs are evaluated without TMVA where possible
+			nativeBdts.push_back(TmvaBdt());
+			if (settings.GetTmvaNativeBdtEvaluation() &&
+			    nativeBdts.back().ReadWeightFile(tmvaWeights, inputVariables[input_index]))
+			{
+				LOG(DEBUG) << "\t\t\tevaluated without TMVA";
+				tmvaMethods.push_back(nullptr);
+			}
+			else
+			{
+				tmvaMethods.push_back(dynamic_cast<TMVA::MethodBase*>(tmvaReader[input_index]->BookMVA(tmvaMethod, tmvaWeights)));
+				if (tmvaMethods.back() == nullptr)
+				{
+					LOG(FATAL) << "Could not book TMVA method " << tmvaMethod << " from weight file " << tmvaWeights << "!";
+				}
+			}
 			method_splits.push_back(method_split);
 			input_indices.push_back(boost::lexical_cast<int>(method_split.front()));
 			mvaMethodIndex += 1;
@@ -130,28 +152,41 @@ public:
 	             setting_type const& settings, metadata_type const& metadata) const override
 	{
 		// construct and fill input vector + retrieve outputs
-		(product.*m_mvaOutputsMember) = std::vector<double>((settings.*GetTmvaMethods)().size());
+		std::vector<double>& mvaOutputs = (product.*m_mvaOutputsMember);
+		mvaOutputs.resize(tmvaMethods.size());
+		hasNanInputs.assign(tmvaInputs.size(), false);
 		for(size_t input_index = 0; input_index < tmvaInputs.size(); input_index++)
 		{
-			std::vector<float_extractor_lambda> Extractor_vec = m_inputExtractors[input_index];
-			size_t inputQuantityIndex = 0;
-			for(typename std::vector<float_extractor_lambda>::const_iterator inputExtractor = Extractor_vec.begin();
-				inputExtractor != Extractor_vec.end(); ++inputExtractor)
+			std::vector<float_extractor_lambda> const& Extractor_vec = m_inputExtractors[input_index];
+			for(size_t inputQuantityIndex = 0; inputQuantityIndex < Extractor_vec.size(); ++inputQuantityIndex)
 			{
-				*(tmvaInputs[input_index][inputQuantityIndex]) = (*inputExtractor)(event, product);
-				++inputQuantityIndex;
+				*(tmvaInputs[input_index][inputQuantityIndex]) = Extractor_vec[inputQuantityIndex](event, product);
+				hasNanInputs[input_index] = (hasNanInputs[input_index] || std::isnan(*(tmvaInputs[input_index][inputQuantityIndex])));
 			}
 		}
-		int mvaMethodIndex = 0;
-		for(std::vector<std::string>::const_iterator method_str = (settings.*GetTmvaMethods)().begin();
-			 method_str != (settings.*GetTmvaMethods)().end(); ++method_str)
+		// the methods are evaluated by their handles booked in Init or without TMVA
+		// (inputs with NaN values are not evaluated and give -999 as when evaluating by method name)
+		for(size_t mvaMethodIndex = 0; mvaMethodIndex < tmvaMethods.size(); ++mvaMethodIndex)
 		{
 			int input_index = input_indices[mvaMethodIndex];
-			std::string tmvaMethod = boost::lexical_cast<std::string>(input_index) + boost::lexical_cast<std::string>(method_splits[mvaMethodIndex].back()) + boost::lexical_cast<std::string>(mvaMethodIndex);
-			const TString const_Method = TString(tmvaMethod.c_str());
-			//const std::vector<double> const_tmvaInputs = tmvaInputs;
-			(product.*m_mvaOutputsMember)[mvaMethodIndex] = tmvaReader[input_index]->EvaluateMVA(const_Method);
-			mvaMethodIndex += 1;
+			if (hasNanInputs[input_index])
+			{
+				mvaOutputs[mvaMethodIndex] = -999.0;
+			}
+			else if (tmvaMethods[mvaMethodIndex] == nullptr)
+			{
+				std::vector<float*> const& inputs = tmvaInputs[input_index];
+				nativeBdtInputs.resize(inputs.size());
+				for (size_t inputQuantityIndex = 0; inputQuantityIndex < inputs.size(); ++inputQuantityIndex)
+				{
+					nativeBdtInputs[inputQuantityIndex] = *(inputs[inputQuantityIndex]);
+				}
+				mvaOutputs[mvaMethodIndex] = nativeBdts[mvaMethodIndex].Evaluate(nativeBdtInputs.data());
+			}
+			else
+			{
+				mvaOutputs[mvaMethodIndex] = tmvaReader[input_index]->EvaluateMVA(tmvaMethods[mvaMethodIndex]);
+			}
 		}
 	}
 	
@@ -162,9 +197,13 @@ private:
 	std::vector<double> product_type::*m_mvaOutputsMember;
 	std::vector<std::vector<float_extractor_lambda>> m_inputExtractors;
 	std::vector<std::shared_ptr<TMVA::Reader>> tmvaReader;
+	std::vector<TMVA::MethodBase*> tmvaMethods; // nullptr for BDTs evaluated without TMVA
+	std::vector<TmvaBdt> nativeBdts;
+	mutable std::vector<float> nativeBdtInputs;
 	std::vector<std::vector<std::string>> method_splits;
 	std::vector<int> input_indices;
 	std::vector<std::vector<float*>> tmvaInputs;
+	mutable std::vector<bool> hasNanInputs;
 
 };
 
@@ -175,6 +214,9 @@ private:
    - TmvaInputQuantities
    - TmvaMethods
    - TmvaWeights (same length as for TmvaMethods required)
+
+   Optional config tags:
+   - TmvaNativeBdtEvaluation (default: false)
 */
 class MultiTmvaClassificationReader: public TmvaClassificationMultiReaderBase<KappaTypes>
 {
@@ -1,15 +1,19 @@
 
 #pragma once
 
+#include <cmath>
+
 #include <boost/algorithm/string/split.hpp>
 #include <boost/algorithm/string/trim.hpp>
 
 #include <TMVA/Reader.h>
+#include <TMVA/MethodBase.h>
 
 #include "Artus/KappaAnalysis/interface/KappaTypes.h"
 #include "Artus/Core/interface/ProducerBase.h"
 #include "Artus/KappaAnalysis/interface/Consumers/KappaLambdaNtupleConsumer.h"
 #include "Artus/Utility/interface/DefaultValues.h"
+#include "Artus/Utility/interface/TmvaBdt.h"
 #include "Artus/KappaAnalysis/interface/KappaProducerBase.h"
 
 
@@ -74,44 +78,74 @@ public:
 			}
 		}
 		
-		// register TMVA input variables
+		// register TMVA input variables, which are read from the input buffer for every evaluation
+		// (the buffer must not be resized afterwards)
+		m_tmvaInputs.assign(m_inputExtractors.size(), 0.0f);
+		size_t inputQuantityIndex = 0;
 		for (std::vector<std::string>::const_iterator quantity = (settings.*GetTmvaInputQuantities)().begin();
 			 quantity != (settings.*GetTmvaInputQuantities)().end(); ++quantity)
 		{
-			tmvaReader.AddVariable(*quantity, static_cast<float*>(nullptr));
+			tmvaReader.AddVariable(*quantity, &(m_tmvaInputs[inputQuantityIndex]));
+			++inputQuantityIndex;
 		}
 		
 		// loading TMVA weight files
 		assert((settings.*GetTmvaMethods)().size() == (settings.*GetTmvaWeights)().size());
 		LOG(INFO) << "\tLoading TMVA weight files...";
+		m_tmvaMethods.clear();
+		m_nativeBdts.assign((settings.*GetTmvaMethods)().size(), TmvaBdt());
 		for (size_t mvaMethodIndex = 0; mvaMethodIndex < (settings.*GetTmvaMethods)().size(); ++mvaMethodIndex)
 		{
 			std::string tmvaMethod = (settings.*GetTmvaMethods)()[mvaMethodIndex]+ boost::lexical_cast<std::string>(mvaMethodIndex);
 			std::string tmvaWeights = (settings.*GetTmvaWeights)()[mvaMethodIndex];
+			
+			// BDTs are evaluated without TMVA where possible
+			if (settings.GetTmvaNativeBdtEvaluation() &&
+			    m_nativeBdts[mvaMethodIndex].ReadWeightFile(tmvaWeights, (settings.*GetTmvaInputQuantities)()))
+			{
+				LOG(INFO) << "\t\tmethod: " << tmvaMethod << ", weight file: " << tmvaWeights << " (evaluated without TMVA)";
+				m_tmvaMethods.push_back(nullptr);
+				continue;
+			}
+			
 			LOG(INFO) << "\t\tmethod: " << tmvaMethod << ", weight file: " << tmvaWeights;
-			tmvaReader.BookMVA(tmvaMethod, tmvaWeights);
+			m_tmvaMethods.push_back(dynamic_cast<TMVA::MethodBase*>(tmvaReader.BookMVA(tmvaMethod, tmvaWeights)));
+			if (m_tmvaMethods.back() == nullptr)
+			{
+				LOG(FATAL) << "Could not book TMVA method " << tmvaMethod << " from weight file " << tmvaWeights << "!";
+			}
 		}
 	}
 
 	void Produce(event_type const& event, product_type& product,
 	             setting_type const& settings, metadata_type const& metadata) const override
 	{
-		// construct and fill input vector
-		std::vector<double> tmvaInputs(m_inputExtractors.size());
-		size_t inputQuantityIndex = 0;
-		for(typename std::vector<float_extractor_lambda>::const_iterator inputExtractor = m_inputExtractors.begin();
-			inputExtractor != m_inputExtractors.end(); ++inputExtractor)
+		// fill input buffer registered to the TMVA reader
+		bool hasNanInput = false;
+		for (size_t inputQuantityIndex = 0; inputQuantityIndex < m_inputExtractors.size(); ++inputQuantityIndex)
 		{
-			tmvaInputs[inputQuantityIndex] = (*inputExtractor)(event, product);
-			++inputQuantityIndex;
+			m_tmvaInputs[inputQuantityIndex] = m_inputExtractors[inputQuantityIndex](event, product);
+			hasNanInput = (hasNanInput || std::isnan(m_tmvaInputs[inputQuantityIndex]));
 		}
 		
-		// retrieve MVA outputs
-		(product.*m_mvaOutputsMember) = std::vector<double>((settings.*GetTmvaMethods)().size());
-		for (size_t mvaMethodIndex = 0; mvaMethodIndex < (settings.*GetTmvaMethods)().size(); ++mvaMethodIndex)
+		// retrieve MVA outputs, the methods are evaluated by their handles or without TMVA
+		// (inputs with NaN values are not evaluated and give -999 as when evaluating by method name)
+		std::vector<double>& mvaOutputs = (product.*m_mvaOutputsMember);
+		mvaOutputs.resize(m_tmvaMethods.size());
+		for (size_t mvaMethodIndex = 0; mvaMethodIndex < m_tmvaMethods.size(); ++mvaMethodIndex)
 		{
-			std::string tmvaMethod = (settings.*GetTmvaMethods)()[mvaMethodIndex]+ boost::lexical_cast<std::string>(mvaMethodIndex);
-			(product.*m_mvaOutputsMember)[mvaMethodIndex] = tmvaReader.EvaluateMVA(tmvaInputs, tmvaMethod.c_str());
+			if (hasNanInput)
+			{
+				mvaOutputs[mvaMethodIndex] = -999.0;
+			}
+			else if (m_tmvaMethods[mvaMethodIndex] == nullptr)
+			{
+				mvaOutputs[mvaMethodIndex] = m_nativeBdts[mvaMethodIndex].Evaluate(m_tmvaInputs.data());
+			}
+			else
+			{
+				mvaOutputs[mvaMethodIndex] = tmvaReader.EvaluateMVA(m_tmvaMethods[mvaMethodIndex]);
+			}
 		}
 	}
 
@@ -124,6 +158,9 @@ private:
 	
 	std::vector<float_extractor_lambda> m_inputExtractors;
 	mutable TMVA::Reader tmvaReader;
+	std::vector<TMVA::MethodBase*> m_tmvaMethods; // nullptr for BDTs evaluated without TMVA
+	std::vector<TmvaBdt> m_nativeBdts;
+	mutable std::vector<float> m_tmvaInputs;
 
 };
 
@@ -135,6 +172,9 @@ private:
    - TmvaInputQuantities
    - TmvaMethods
    - TmvaWeights (same length as for TmvaMethods required)
+   
+   Optional config tags:
+   - TmvaNativeBdtEvaluation (default: false)
 */
 class GeneralTmvaClassificationReader: public TmvaClassificationReaderBase<KappaTypes>
 {
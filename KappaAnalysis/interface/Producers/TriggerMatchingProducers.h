@@ -47,11 +47,11 @@ public:
 	}
 	
 	TriggerMatchingProducerBase(std::map<TValidObject*, KLV*> product_type::*triggerMatchedObjects,
-	                            std::map<TValidObject*, std::map<std::string, std::map<std::string, std::vector<KLV*> > > > product_type::*detailedTriggerMatchedObjects,
+	                            CopyOnWrite<std::map<TValidObject*, std::map<std::string, std::map<std::string, std::vector<KLV*> > > > > product_type::*detailedTriggerMatchedObjects,
 	                            std::vector<TValidObject*> product_type::*validObjects,
 	                            std::vector<TValidObject*> product_type::*invalidObjects,
-	                            std::map<size_t, std::vector<std::string> > product_type::*settingsObjectTriggerFiltersByIndex,
-	                            std::map<std::string, std::vector<std::string> > product_type::*settingsObjectTriggerFiltersByHltName,
+	                            CopyOnWrite<std::map<size_t, std::vector<std::string> > > product_type::*settingsObjectTriggerFiltersByIndex,
+	                            CopyOnWrite<std::map<std::string, std::vector<std::string> > > product_type::*settingsObjectTriggerFiltersByHltName,
 	                            std::vector<std::string>& (setting_type::*GetObjectTriggerFilterNames)(void) const,
 	                            float (setting_type::*GetDeltaRTriggerMatchingObjects)(void) const,
 	                            bool (setting_type::*GetInvalidateNonMatchingObjects)(void) const) :
@@ -72,48 +72,72 @@ public:
 		KappaProducerBase::Init(settings, metadata);
 		
 		m_objectTriggerFiltersByIndexFromSettings = Utility::ParseMapTypes<size_t, std::string>(Utility::ParseVectorToMap((settings.*GetObjectTriggerFilterNames)()), m_objectTriggerFiltersByHltNameFromSettings);
+		
+		// compile the configured patterns once, patterns set by other producers are compiled on first use
+		for (std::pair<std::string, std::vector<std::string> > const& objectTriggerFilterByHltName : m_objectTriggerFiltersByHltNameFromSettings)
+		{
+			GetTriggerPattern(m_hltPatterns, objectTriggerFilterByHltName.first);
+			for (std::string const& filterName : objectTriggerFilterByHltName.second)
+			{
+				GetTriggerPattern(m_filterPatterns, filterName);
+			}
+		}
 	}
 
 	void Produce(event_type const& event, product_type& product,
 	             setting_type const& settings, metadata_type const& metadata) const override
 	{
+		assert(event.m_eventInfo);
 		assert(event.m_triggerObjects);
 		assert(event.m_triggerObjectMetadata);
 		
-		if ((product.*m_settingsObjectTriggerFiltersByIndex).empty())
+		// HLT and filter names only change with the lumi section
+		if ((event.m_eventInfo->nLumi != m_currentNLumi) || (event.m_eventInfo->nRun != m_currentNRun) ||
+		    (event.m_triggerObjectMetadata != m_currentTriggerObjectMetadata))
 		{
-			(product.*m_settingsObjectTriggerFiltersByIndex).insert(m_objectTriggerFiltersByIndexFromSettings.begin(),
-			                                                        m_objectTriggerFiltersByIndexFromSettings.end());
+			ResetTriggerPatternMatches(m_hltPatterns);
+			ResetTriggerPatternMatches(m_filterPatterns);
+			m_currentNLumi = event.m_eventInfo->nLumi;
+			m_currentNRun = event.m_eventInfo->nRun;
+			m_currentTriggerObjectMetadata = event.m_triggerObjectMetadata;
 		}
-		if ((product.*m_settingsObjectTriggerFiltersByHltName).empty())
+		
+		if ((product.*m_settingsObjectTriggerFiltersByIndex)->empty())
+		{
+			(product.*m_settingsObjectTriggerFiltersByIndex).GetMutable().insert(m_objectTriggerFiltersByIndexFromSettings.begin(),
+			                                                                     m_objectTriggerFiltersByIndexFromSettings.end());
+		}
+		if ((product.*m_settingsObjectTriggerFiltersByHltName)->empty())
 		{
-			(product.*m_settingsObjectTriggerFiltersByHltName).insert(m_objectTriggerFiltersByHltNameFromSettings.begin(),
-			                                                          m_objectTriggerFiltersByHltNameFromSettings.end());
+			(product.*m_settingsObjectTriggerFiltersByHltName).GetMutable().insert(m_objectTriggerFiltersByHltNameFromSettings.begin(),
+			                                                                       m_objectTriggerFiltersByHltNameFromSettings.end());
 		}
+		std::map<std::string, std::vector<std::string> > const& settingsObjectTriggerFiltersByHltName = (product.*m_settingsObjectTriggerFiltersByHltName).Get();
 		
 		(product.*m_triggerMatchedObjects).clear();
-		(product.*m_detailedTriggerMatchedObjects).clear();
+		std::map<TValidObject*, std::map<std::string, std::map<std::string, std::vector<KLV*> > > >& detailedTriggerMatchedObjects = (product.*m_detailedTriggerMatchedObjects).Reset();
 		if ((! product.m_selectedHltNames.empty()) && ((settings.*GetDeltaRTriggerMatchingObjects)() > 0.0))
 		{
 			bool hasAllHltMatches = true;
 			bool hasHltAndFilterMatch = false;
 			
 			// loop over the hlt names given in the config file
-			for (std::map<std::string, std::vector<std::string>>::const_iterator objectTriggerFilterByHltName = (product.*m_settingsObjectTriggerFiltersByHltName).begin();
-			     objectTriggerFilterByHltName != (product.*m_settingsObjectTriggerFiltersByHltName).end();
+			for (std::map<std::string, std::vector<std::string>>::const_iterator objectTriggerFilterByHltName = settingsObjectTriggerFiltersByHltName.begin();
+			     objectTriggerFilterByHltName != settingsObjectTriggerFiltersByHltName.end();
 			     ++objectTriggerFilterByHltName)
 			{
 				//LOG(DEBUG) << "objectTriggerFilterByHltName->first = " << objectTriggerFilterByHltName->first;
+				TriggerPattern& hltPattern = GetTriggerPattern(m_hltPatterns, objectTriggerFilterByHltName->first);
 				
 				// loop over all fired HLT paths
 				for (unsigned int firedHltIndex = 0; firedHltIndex < product.m_selectedHltNames.size(); ++firedHltIndex)
 				{
-					std::string firedHltName = product.m_selectedHltNames.at(firedHltIndex);
+					std::string const& firedHltName = product.m_selectedHltNames.at(firedHltIndex);
 					int firedHltPosition = product.m_selectedHltPositions.at(firedHltIndex);
 					//LOG(DEBUG) << "\tfiredHltIndex, firedHltName, firedHltPosition = " << firedHltIndex << ", " << firedHltName << ", " << firedHltPosition;
 					
 					// check that the hlt name given in the config matches the hlt which fired in the event
-					if (boost::regex_search(firedHltName, boost::regex(objectTriggerFilterByHltName->first, boost::regex::icase | boost::regex::extended)))
+					if (hltPattern.Matches(static_cast<size_t>(firedHltPosition), firedHltName))
 					{
 						//LOG(DEBUG) << "\t\thltMatched";
 						
@@ -123,17 +147,18 @@ public:
 						     ++filterName)
 						{
 							//LOG(DEBUG) << "\t\t\tfilterName = " << *filterName;
+							TriggerPattern& filterPattern = GetTriggerPattern(m_filterPatterns, *filterName);
 							
 							// loop over all filters for the fired HLT
 							for (size_t firedFilterIndex = event.m_triggerObjectMetadata->getMinFilterIndex(firedHltPosition);
 							     firedFilterIndex < event.m_triggerObjectMetadata->getMaxFilterIndex(firedHltPosition);
 							     ++firedFilterIndex)
 							{
-								std::string firedFilterName = event.m_triggerObjectMetadata->toFilter.at(firedFilterIndex);
+								std::string const& firedFilterName = event.m_triggerObjectMetadata->toFilter.at(firedFilterIndex);
 								//LOG(DEBUG) << "\t\t\t\tfiredFilterIndex, firedFilterName = " << firedFilterIndex << ", " << firedFilterName;
 								
 								// check that the filter regexp given in the config matches the fired filter
-								if (boost::regex_search(firedFilterName, boost::regex(*filterName, boost::regex::icase | boost::regex::extended)))
+								if (filterPattern.Matches(firedFilterIndex, firedFilterName))
 								{
 									hasHltAndFilterMatch = true;
 									//LOG(DEBUG) << "\t\t\t\t\tfilterMatched";
@@ -169,7 +194,7 @@ public:
 											LOG(FATAL) << "No trigger objects found! This points to a problematic Kappa skim.";
 										}
 										
-										(product.*m_detailedTriggerMatchedObjects)[*validObject][firedHltName][firedFilterName] = matchedTriggerObjects;
+										detailedTriggerMatchedObjects[*validObject][firedHltName][firedFilterName] = matchedTriggerObjects;
 									}
 								}
 							}
@@ -182,7 +207,7 @@ public:
 				}
 			}
 			
-			for (typename std::pair<TValidObject*, std::map<std::string, std::map<std::string, std::vector<KLV*> > > > triggerMatchingResult : (product.*m_detailedTriggerMatchedObjects))
+			for (typename std::pair<TValidObject*, std::map<std::string, std::map<std::string, std::vector<KLV*> > > > triggerMatchingResult : detailedTriggerMatchedObjects)
 			{
 				// check matching results for having passed all configured filters
 				std::vector<std::string> hltNamesWhereAllFiltersMatched = TriggerMatchingProducerBase::GetHltNamesWhereAllFiltersMatched(triggerMatchingResult.second);
@@ -207,7 +232,7 @@ public:
 			/*
 			// debug output
 			LOG(INFO) << "Result of trigger matching (Run: " << event.m_eventInfo->nRun << ", Lumi: " << event.m_eventInfo->nLumi << ", Event: " << event.m_eventInfo->nEvent << "):";
-			for (typename std::pair<TValidObject*, std::map<std::string, std::map<std::string, std::vector<KLV*> > > > validObject : (product.*m_detailedTriggerMatchedObjects))
+			for (typename std::pair<TValidObject*, std::map<std::string, std::map<std::string, std::vector<KLV*> > > > validObject : detailedTriggerMatchedObjects)
 			{
 				LOG(INFO) << "Reco object: (pt = " << validObject.first->p4.Pt() << ", eta = " << validObject.first->p4.Eta() << ", phi = " << validObject.first->p4.Phi() << ", mass = " << validObject.first->p4.mass() << ")";
 				for (std::pair<std::string, std::map<std::string, std::vector<KLV*> > > hltName : validObject.second)
@@ -230,18 +255,72 @@ public:
 
 
 private:
+	
+	// compiled HLT or filter name pattern together with the match results for the current lumi section,
+	// indexed by the HLT position or filter index
+	struct TriggerPattern
+	{
+		explicit TriggerPattern(std::string const& pattern) :
+			regex(pattern, boost::regex::icase | boost::regex::extended)
+		{
+		}
+		
+		bool Matches(size_t index, std::string const& name)
+		{
+			if (index >= matches.size())
+			{
+				matches.resize(index + 1, UNKNOWN);
+			}
+			if (matches[index] == UNKNOWN)
+			{
+				matches[index] = (boost::regex_search(name, regex) ? MATCH : NO_MATCH);
+			}
+			return (matches[index] == MATCH);
+		}
+		
+		enum MatchResult : char { UNKNOWN, NO_MATCH, MATCH };
+		
+		boost::regex regex;
+		std::vector<MatchResult> matches;
+	};
+	
+	static TriggerPattern& GetTriggerPattern(std::map<std::string, TriggerPattern>& patterns, std::string const& pattern)
+	{
+		typename std::map<std::string, TriggerPattern>::iterator triggerPattern = patterns.find(pattern);
+		if (triggerPattern == patterns.end())
+		{
+			triggerPattern = patterns.emplace(pattern, TriggerPattern(pattern)).first;
+		}
+		return triggerPattern->second;
+	}
+	
+	static void ResetTriggerPatternMatches(std::map<std::string, TriggerPattern>& patterns)
+	{
+		for (std::pair<std::string const, TriggerPattern>& triggerPattern : patterns)
+		{
+			triggerPattern.second.matches.clear();
+		}
+	}
+	
 	std::map<TValidObject*, KLV*> product_type::*m_triggerMatchedObjects;
-	std::map<TValidObject*, std::map<std::string, std::map<std::string, std::vector<KLV*> > > > product_type::*m_detailedTriggerMatchedObjects;
+	CopyOnWrite<std::map<TValidObject*, std::map<std::string, std::map<std::string, std::vector<KLV*> > > > > product_type::*m_detailedTriggerMatchedObjects;
 	std::vector<TValidObject*> product_type::*m_validObjects;
 	std::vector<TValidObject*> product_type::*m_invalidObjects;
-	std::map<size_t, std::vector<std::string> > product_type::*m_settingsObjectTriggerFiltersByIndex;
-	std::map<std::string, std::vector<std::string> > product_type::*m_settingsObjectTriggerFiltersByHltName;
+	CopyOnWrite<std::map<size_t, std::vector<std::string> > > product_type::*m_settingsObjectTriggerFiltersByIndex;
+	CopyOnWrite<std::map<std::string, std::vector<std::string> > > product_type::*m_settingsObjectTriggerFiltersByHltName;
 	std::vector<std::string>& (setting_type::*GetObjectTriggerFilterNames)(void) const;
 	float (setting_type::*GetDeltaRTriggerMatchingObjects)(void) const;
 	bool (setting_type::*GetInvalidateNonMatchingObjects)(void) const;
 	
 	std::map<size_t, std::vector<std::string> > m_objectTriggerFiltersByIndexFromSettings;
 	std::map<std::string, std::vector<std::string> > m_objectTriggerFiltersByHltNameFromSettings;
+	
+	// patterns and their results are cached, such that no regex is evaluated twice in the same lumi section
+	mutable std::map<std::string, TriggerPattern> m_hltPatterns;
+	mutable std::map<std::string, TriggerPattern> m_filterPatterns;
+	mutable unsigned int m_currentNLumi = 0;
+	mutable unsigned int m_currentNRun = 0;
+	mutable KTriggerObjectMetadata const* m_currentTriggerObjectMetadata = nullptr;
 
 };
 
@@ -258,6 +337,7 @@ class ElectronTriggerMatchingProducer: public TriggerMatchingProducerBase<KElect
 public:
 	
 	std::string GetProducerId() const override;
+	void GetRequiredEventMembers(std::set<std::string>& eventMembers) const override;
 	
 	ElectronTriggerMatchingProducer();
 	
@@ -279,6 +359,7 @@ class MuonTriggerMatchingProducer: public TriggerMatchingProducerBase<KMuon>
 public:
 	
 	std::string GetProducerId() const override;
+	void GetRequiredEventMembers(std::set<std::string>& eventMembers) const override;
 	
 	MuonTriggerMatchingProducer();
 	
@@ -300,6 +381,7 @@ class TauTriggerMatchingProducer: public TriggerMatchingProducerBase<KTau>
 public:
 	
 	std::string GetProducerId() const override;
+	void GetRequiredEventMembers(std::set<std::string>& eventMembers) const override;
 	
 	TauTriggerMatchingProducer();
 	
@@ -321,6 +403,7 @@ class JetTriggerMatchingProducer: public TriggerMatchingProducerBase<KBasicJet>
 public:
 	
 	std::string GetProducerId() const override;
+	void GetRequiredEventMembers(std::set<std::string>& eventMembers) const override;
 	
 	JetTriggerMatchingProducer();
 
@@ -12,6 +12,7 @@
 #include "Artus/KappaAnalysis/interface/KappaProducerBase.h"
 #include "Artus/KappaAnalysis/interface/Consumers/KappaLambdaNtupleConsumer.h"
 #include "Artus/KappaAnalysis/interface/Utility/BTagSF.h"
+#include "Artus/KappaAnalysis/interface/Utility/MetadataIndices.h"
 
 
 /**
@@ -25,6 +26,7 @@ class ValidBTaggedJetsProducer: public KappaProducerBase
 public:
 
 	std::string GetProducerId() const override;
+	void GetRequiredEventMembers(std::set<std::string>& eventMembers) const override;
 
 	void Init(setting_type const& settings, metadata_type& metadata) override;
 
@@ -43,4 +45,14 @@ private:
 	std::map<std::string, float> m_bTagWorkingPoints;
 	std::map<std::string, BTagSF> m_bTagSfMap;
 
+	// inputs and scale factors of the promotion/demotion of all jets of an event
+	mutable std::vector<double> m_jetPts;
+	mutable std::vector<float> m_jetEtas;
+	mutable std::vector<int> m_jetFlavours;
+	mutable std::vector<BTagSF::ScaleFactor> m_bTagScaleFactors;
+
+	// resolved in Produce for every lumi section
+	mutable MetadataLumiSection m_metadataLumiSection;
+	mutable MetadataIndex m_combinedSecondaryVertexIndex;
+
 };
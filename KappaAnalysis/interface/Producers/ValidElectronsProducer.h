@@ -13,6 +13,7 @@
 #include "Artus/KappaAnalysis/interface/KappaTypes.h"
 #include "Artus/KappaAnalysis/interface/KappaProducerBase.h"
 #include "Artus/KappaAnalysis/interface/Utility/ValidPhysicsObjectTools.h"
+#include "Artus/KappaAnalysis/interface/Utility/MetadataIndices.h"
 #include "Artus/Consumer/interface/LambdaNtupleConsumer.h"
 #include "Artus/Utility/interface/Utility.h"
 #include "Artus/Utility/interface/DefaultValues.h"
@@ -145,12 +146,16 @@ public:
 		return "ValidElectronsProducer";
 	}
 
+	void GetRequiredEventMembers(std::set<std::string>& eventMembers) const override {
+		eventMembers.insert({ "Electrons", "ElectronMetadata", "VertexSummary" });
+	}
+
 	ValidElectronsProducer(std::vector<KElectron*> product_type::*validElectrons=&product_type::m_validElectrons,
 	                       std::vector<KElectron*> product_type::*invalidElectrons=&product_type::m_invalidElectrons,
-	                       std::string (setting_type::*GetElectronID)(void) const=&setting_type::GetElectronID,
-	                       std::string (setting_type::*GetElectronIsoType)(void) const=&setting_type::GetElectronIsoType,
-	                       std::string (setting_type::*GetElectronIso)(void) const=&setting_type::GetElectronIso,
-	                       std::string (setting_type::*GetElectronReco)(void) const=&setting_type::GetElectronReco,
+	                       std::string const& (setting_type::*GetElectronID)(void) const=&setting_type::GetElectronID,
+	                       std::string const& (setting_type::*GetElectronIsoType)(void) const=&setting_type::GetElectronIsoType,
+	                       std::string const& (setting_type::*GetElectronIso)(void) const=&setting_type::GetElectronIso,
+	                       std::string const& (setting_type::*GetElectronReco)(void) const=&setting_type::GetElectronReco,
 	                       std::vector<std::string>& (setting_type::*GetLowerPtCuts)(void) const=&setting_type::GetElectronLowerPtCuts,
 	                       std::vector<std::string>& (setting_type::*GetUpperAbsEtaCuts)(void) const=&setting_type::GetElectronUpperAbsEtaCuts) :
 		ProducerBase<TTypes>(),
@@ -175,6 +180,11 @@ public:
 		electronIso = ToElectronIso(boost::algorithm::to_lower_copy(boost::algorithm::trim_copy((settings.*GetElectronIso)())));
 		electronReco = ToElectronReco(boost::algorithm::to_lower_copy(boost::algorithm::trim_copy((settings.*GetElectronReco)())));
 
+		if (electronID == ElectronID::MVANONTRIG)
+			mvaIdIndex = MetadataIndex("idMvaNonTrigV0");
+		else if (electronID == ElectronID::MVATRIG)
+			mvaIdIndex = MetadataIndex("idMvaTrigV0");
+
 		if ((boost::algorithm::contains((settings.*GetElectronID)(), "vbft95")) && (electronIso==ElectronIso::NONE))
 		{
 			LOG(WARNING) << "ValidElectronsProducer: using cutbased vbft95 ID, but isolation is not set!";
@@ -198,18 +208,18 @@ public:
 		assert(event.m_electrons);
 		assert(event.m_vertexSummary);
 		assert(event.m_electronMetadata);
+		assert(event.m_eventInfo);
+
+		if (metadataLumiSection.Update(event.m_eventInfo->nRun, event.m_eventInfo->nLumi))
+		{
+			mvaIdIndex.Resolve(event.m_electronMetadata->idNames);
+		}
+
 		// select input source
 		std::vector<KElectron*> electrons;
-		if ((validElectronsInput == ValidElectronsInput::AUTO && (product.m_correctedElectrons.size() > 0)) || (validElectronsInput == ValidElectronsInput::CORRECTED))
+		if ((validElectronsInput == ValidElectronsInput::AUTO && (product.m_correctedElectrons->size() > 0)) || (validElectronsInput == ValidElectronsInput::CORRECTED))
 		{
-			electrons.resize(product.m_correctedElectrons.size());
-			size_t electronIndex = 0;
-			for (std::vector<std::shared_ptr<KElectron> >::iterator electron = product.m_correctedElectrons.begin();
-			     electron != product.m_correctedElectrons.end(); ++electron)
-			{
-				electrons[electronIndex] = electron->get();
-				++electronIndex;
-			}
+			electrons = product.m_correctedElectrons.Get();
 		}
 		else
 		{
@@ -232,9 +242,9 @@ public:
 
 			// Electron IDs
 			if (electronID == ElectronID::MVANONTRIG)
-				valid = valid && IsMVANonTrigElectron(*electron, event.m_electronMetadata);
+				valid = valid && IsMVANonTrigElectron(*electron, GetMvaId(*electron, event.m_electronMetadata));
 			else if (electronID == ElectronID::MVATRIG)
-				valid = valid && IsMVATrigElectron(*electron, event.m_electronMetadata);
+				valid = valid && IsMVATrigElectron(*electron, GetMvaId(*electron, event.m_electronMetadata));
 			else if (electronID == ElectronID::VBTF95_VETO)
 				valid = valid && IsVetoVbtf95Electron(*electron, event, product);
 			else if (electronID == ElectronID::VBTF95_LOOSE)
@@ -302,6 +312,11 @@ public:
 	}
 
 	static bool IsMVANonTrigElectron(const KElectron* electron, const KElectronMetadata* electronMeta)
+	{
+		return IsMVANonTrigElectron(electron, electron->getId("idMvaNonTrigV0", electronMeta));
+	}
+
+	static bool IsMVANonTrigElectron(const KElectron* electron, float mvaId)
 	{
 		// Electron ID mva non trig (run 1)
 		// https://twiki.cern.ch/twiki/bin/viewauth/CMS/MultivariateElectronIdentification#Non_triggering_MVA
@@ -309,21 +324,26 @@ public:
 		if (electron->p4.Pt() < 10.0f)
 		{
 			return (
-				(std::abs(electron->p4.Eta()) < 0.8f && electron->getId("idMvaNonTrigV0", electronMeta) > 0.47f) ||
-				(std::abs(electron->p4.Eta()) > 0.8f && std::abs(electron->p4.Eta()) < DefaultValues::EtaBorderEB && electron->getId("idMvaNonTrigV0", electronMeta) > 0.004f) ||
-				(std::abs(electron->p4.Eta()) > DefaultValues::EtaBorderEB && std::abs(electron->p4.Eta()) < 2.5f && electron->getId("idMvaNonTrigV0", electronMeta) > 0.295f));
+				(std::abs(electron->p4.Eta()) < 0.8f && mvaId > 0.47f) ||
+				(std::abs(electron->p4.Eta()) > 0.8f && std::abs(electron->p4.Eta()) < DefaultValues::EtaBorderEB && mvaId > 0.004f) ||
+				(std::abs(electron->p4.Eta()) > DefaultValues::EtaBorderEB && std::abs(electron->p4.Eta()) < 2.5f && mvaId > 0.295f));
 		}
 		else if (electron->p4.Pt() >= 10.0f)
 		{
 			return (
-				(std::abs(electron->p4.Eta()) < 0.8f && electron->getId("idMvaNonTrigV0", electronMeta) > -0.34f) ||
-				(std::abs(electron->p4.Eta()) > 0.8f && std::abs(electron->p4.Eta()) < DefaultValues::EtaBorderEB && electron->getId("idMvaNonTrigV0", electronMeta) > -0.65f) ||
-				(std::abs(electron->p4.Eta()) > DefaultValues::EtaBorderEB && std::abs(electron->p4.Eta()) < 2.5f && electron->getId("idMvaNonTrigV0", electronMeta) > 0.6f));
+				(std::abs(electron->p4.Eta()) < 0.8f && mvaId > -0.34f) ||
+				(std::abs(electron->p4.Eta()) > 0.8f && std::abs(electron->p4.Eta()) < DefaultValues::EtaBorderEB && mvaId > -0.65f) ||
+				(std::abs(electron->p4.Eta()) > DefaultValues::EtaBorderEB && std::abs(electron->p4.Eta()) < 2.5f && mvaId > 0.6f));
 		}
 		return false;
 	}
 
 	static bool IsMVATrigElectron(const KElectron* electron, const KElectronMetadata* electronMeta)
+	{
+		return IsMVATrigElectron(electron, electron->getId("idMvaTrigV0", electronMeta));
+	}
+
+	static bool IsMVATrigElectron(const KElectron* electron, float mvaId)
 	{
 		// Electron ID mva trig (run 1)
 		// https://twiki.cern.ch/twiki/bin/viewauth/CMS/MultivariateElectronIdentification#Triggering_MVA
@@ -331,16 +351,16 @@ public:
 		if (electron->p4.Pt() >= 10.0f && electron->p4.Pt() < 20.0f)
 		{
 			return (
-				(std::abs(electron->p4.Eta()) <= 0.8f && electron->getId("idMvaTrigV0", electronMeta) > 0.0f) ||
-				(std::abs(electron->p4.Eta()) > 0.8f && std::abs(electron->p4.Eta()) <= DefaultValues::EtaBorderEB && electron->getId("idMvaTrigV0", electronMeta) > 0.1f) ||
-				(std::abs(electron->p4.Eta()) > DefaultValues::EtaBorderEB && std::abs(electron->p4.Eta()) <= 2.5f && electron->getId("idMvaTrigV0", electronMeta) > 0.62f));
+				(std::abs(electron->p4.Eta()) <= 0.8f && mvaId > 0.0f) ||
+				(std::abs(electron->p4.Eta()) > 0.8f && std::abs(electron->p4.Eta()) <= DefaultValues::EtaBorderEB && mvaId > 0.1f) ||
+				(std::abs(electron->p4.Eta()) > DefaultValues::EtaBorderEB && std::abs(electron->p4.Eta()) <= 2.5f && mvaId > 0.62f));
 		}
 		else if (electron->p4.Pt() >= 20.0f)
 		{
 			return (
-				(std::abs(electron->p4.Eta()) < 0.8f && electron->getId("idMvaTrigV0", electronMeta) > 0.94f) ||
-				(std::abs(electron->p4.Eta()) > 0.8f && std::abs(electron->p4.Eta()) < DefaultValues::EtaBorderEB && electron->getId("idMvaTrigV0", electronMeta) > 0.85f) ||
-				(std::abs(electron->p4.Eta()) > DefaultValues::EtaBorderEB && std::abs(electron->p4.Eta()) < 2.5f && electron->getId("idMvaTrigV0", electronMeta) > 0.92f));
+				(std::abs(electron->p4.Eta()) < 0.8f && mvaId > 0.94f) ||
+				(std::abs(electron->p4.Eta()) > 0.8f && std::abs(electron->p4.Eta()) < DefaultValues::EtaBorderEB && mvaId > 0.85f) ||
+				(std::abs(electron->p4.Eta()) > DefaultValues::EtaBorderEB && std::abs(electron->p4.Eta()) < 2.5f && mvaId > 0.92f));
 		}
 		return false;
 	}
@@ -493,13 +513,23 @@ protected:
 private:
 	std::vector<KElectron*> product_type::*m_validElectronsMember;
 	std::vector<KElectron*> product_type::*m_invalidElectronsMember;
-	std::string (setting_type::*GetElectronID)(void) const;
-	std::string (setting_type::*GetElectronIsoType)(void) const;
-	std::string (setting_type::*GetElectronIso)(void) const;
-	std::string (setting_type::*GetElectronReco)(void) const;
+	std::string const& (setting_type::*GetElectronID)(void) const;
+	std::string const& (setting_type::*GetElectronIsoType)(void) const;
+	std::string const& (setting_type::*GetElectronIso)(void) const;
+	std::string const& (setting_type::*GetElectronReco)(void) const;
 
 	ValidElectronsInput validElectronsInput;
 
+	// MVA ID of the configured electron ID, resolved in Produce for every lumi section
+	mutable MetadataLumiSection metadataLumiSection;
+	mutable MetadataIndex mvaIdIndex;
+
+	float GetMvaId(KElectron* electron, const KElectronMetadata* electronMeta) const
+	{
+		return (mvaIdIndex.IsResolvedFor(electron->electronIds) ? electron->electronIds[mvaIdIndex.GetIndex()]
+		                                                        : electron->getId(mvaIdIndex.GetName(), electronMeta));
+	}
+
 	bool IsFakeableElectron(KElectron* electron, event_type const& event, product_type& product) const
 	{
 		if (std::abs(electron->p4.Eta()) < DefaultValues::EtaBorderEB)
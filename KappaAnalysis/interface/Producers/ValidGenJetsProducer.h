@@ -16,6 +16,7 @@ public:
 	ValidGenJetsProducer();
 	
 	virtual std::string GetProducerId() const override;
+	void GetRequiredEventMembers(std::set<std::string>& eventMembers) const override;
 	virtual void Init(KappaTypes::setting_type const& settings, KappaTypes::metadata_type& metadata) override;
 	virtual void Produce(KappaTypes::event_type const& event, KappaTypes::product_type& product,
 	                     KappaTypes::setting_type const& settings, KappaTypes::metadata_type const& metadata) const override;
@@ -72,6 +72,7 @@ public:
 	ValidGenTausProducer();
 
 	std::string GetProducerId() const override;
+	void GetRequiredEventMembers(std::set<std::string>& eventMembers) const override;
 
 	void Init(KappaTypes::setting_type const& settings, KappaTypes::metadata_type& metadata) override;
 	
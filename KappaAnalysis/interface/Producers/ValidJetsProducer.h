@@ -14,6 +14,7 @@
 #include "Artus/KappaAnalysis/interface/KappaTypes.h"
 #include "Artus/KappaAnalysis/interface/KappaProducerBase.h"
 #include "Artus/KappaAnalysis/interface/Utility/ValidPhysicsObjectTools.h"
+#include "Artus/KappaAnalysis/interface/Utility/MetadataIndices.h"
 #include "Artus/KappaAnalysis/interface/Consumers/KappaLambdaNtupleConsumer.h"
 #include "Artus/Utility/interface/Utility.h"
 
@@ -40,7 +41,7 @@ class ValidJetsProducerBase: public KappaProducerBase, public ValidPhysicsObject
 public:
 
 	ValidJetsProducerBase(std::vector<TJet>* KappaTypes::event_type::*jets,
-	                      std::vector<std::shared_ptr<TJet> > KappaTypes::product_type::*correctJets,
+	                      CopyOnWrite<std::vector<TJet*> > KappaTypes::product_type::*correctJets,
 	                      std::vector<TValidJet*> KappaTypes::product_type::*validJets) :
 		KappaProducerBase(),
 		ValidPhysicsObjectTools<KappaTypes, TValidJet>(&KappaTypes::setting_type::GetJetLowerPtCuts,
@@ -195,16 +196,9 @@ public:
 
 		// select input source
 		std::vector<TJet*> jets;
-		if ((validJetsInput == KappaEnumTypes::ValidJetsInput::AUTO && ((product.*m_correctedJetsMember).size() > 0)) || (validJetsInput == KappaEnumTypes::ValidJetsInput::CORRECTED))
+		if ((validJetsInput == KappaEnumTypes::ValidJetsInput::AUTO && ((product.*m_correctedJetsMember)->size() > 0)) || (validJetsInput == KappaEnumTypes::ValidJetsInput::CORRECTED))
 		{
-			jets.resize((product.*m_correctedJetsMember).size());
-			size_t jetIndex = 0;
-			for (typename std::vector<std::shared_ptr<TJet> >::iterator jet = (product.*m_correctedJetsMember).begin();
-			     jet != (product.*m_correctedJetsMember).end(); ++jet)
-			{
-				jets[jetIndex] = jet->get();
-				++jetIndex;
-			}
+			jets = (product.*m_correctedJetsMember).Get();
 		}
 		else
 		{
@@ -339,7 +333,7 @@ protected:
 
 private:
 	std::vector<TJet>* KappaTypes::event_type::*m_basicJetsMember;
-	std::vector<std::shared_ptr<TJet> > KappaTypes::product_type::*m_correctedJetsMember;
+	CopyOnWrite<std::vector<TJet*> > KappaTypes::product_type::*m_correctedJetsMember;
 
 	KappaEnumTypes::ValidJetsInput validJetsInput;
 	KappaEnumTypes::JetIDVersion jetIDVersion;
@@ -359,6 +353,7 @@ public:
 	ValidJetsProducer();
 
 	std::string GetProducerId() const override;
+	void GetRequiredEventMembers(std::set<std::string>& eventMembers) const override;
 };
 
 
@@ -377,7 +372,10 @@ class ValidTaggedJetsProducer: public ValidJetsProducerBase<KJet, KBasicJet>
 public:
 	ValidTaggedJetsProducer();
 	std::string GetProducerId() const override;
+	void GetRequiredEventMembers(std::set<std::string>& eventMembers) const override;
 	void Init(KappaTypes::setting_type const& settings, KappaTypes::metadata_type& metadata) override;
+	void Produce(KappaTypes::event_type const& event, KappaTypes::product_type& product,
+	             KappaTypes::setting_type const& settings, KappaTypes::metadata_type const& metadata) const override;
 	
 	static bool AdditionalCriteriaStatic(KJet* jet,
 	                                     std::map<size_t, std::vector<std::string> > const& puJetIdsByIndex,
@@ -397,6 +395,16 @@ protected:
 	std::map<std::string, std::vector<float> > jetTaggerLowerCutsByTaggerName;
 	std::map<std::string, std::vector<float> > jetTaggerUpperCutsByTaggerName;
 
+	// tags with the tightest cut, resolved in Produce for every lumi section
+	mutable MetadataLumiSection metadataLumiSection;
+	mutable std::vector<std::pair<MetadataIndex, float> > jetTaggerLowerCuts;
+	mutable std::vector<std::pair<MetadataIndex, float> > jetTaggerUpperCuts;
+
 private:
+	void ResolveMetadata(KappaTypes::event_type const& event) const;
+
 	static bool PassPuJetIds(KJet* jet, std::vector<std::string> const& puJetIds, KJetMetadata* taggerMetadata);
+	static bool PassPuJetIds(KJet* jet, std::map<size_t, std::vector<std::string> > const& puJetIdsByIndex,
+	                         std::map<std::string, std::vector<std::string> > const& puJetIdsByHltName,
+	                         KappaTypes::event_type const& event, KappaTypes::product_type const& product);
 };
@@ -119,11 +119,15 @@ public:
 		return "ValidMuonsProducer";
 	}
 
+	void GetRequiredEventMembers(std::set<std::string>& eventMembers) const override {
+		eventMembers.insert("Muons");
+	}
+
 	ValidMuonsProducer(std::vector<KMuon*> product_type::*validMuons=&product_type::m_validMuons,
 	                   std::vector<KMuon*> product_type::*invalidMuons=&product_type::m_invalidMuons,
-	                   std::string (setting_type::*GetMuonID)(void) const=&setting_type::GetMuonID,
-	                   std::string (setting_type::*GetMuonIsoType)(void) const=&setting_type::GetMuonIsoType,
-	                   std::string (setting_type::*GetMuonIso)(void) const=&setting_type::GetMuonIso,
+	                   std::string const& (setting_type::*GetMuonID)(void) const=&setting_type::GetMuonID,
+	                   std::string const& (setting_type::*GetMuonIsoType)(void) const=&setting_type::GetMuonIsoType,
+	                   std::string const& (setting_type::*GetMuonIso)(void) const=&setting_type::GetMuonIso,
 	                   std::vector<std::string>& (setting_type::*GetLowerPtCuts)(void) const=&setting_type::GetMuonLowerPtCuts,
 	                   std::vector<std::string>& (setting_type::*GetUpperAbsEtaCuts)(void) const=&setting_type::GetMuonUpperAbsEtaCuts) :
 		ProducerBase<TTypes>(),
@@ -211,16 +215,9 @@ public:
 
 		// select input source
 		std::vector<KMuon*> muons;
-		if ((validMuonsInput == ValidMuonsInput::AUTO && (product.m_correctedMuons.size() > 0)) || (validMuonsInput == ValidMuonsInput::CORRECTED))
+		if ((validMuonsInput == ValidMuonsInput::AUTO && (product.m_correctedMuons->size() > 0)) || (validMuonsInput == ValidMuonsInput::CORRECTED))
 		{
-			muons.resize(product.m_correctedMuons.size());
-			size_t muonIndex = 0;
-			for (std::vector<std::shared_ptr<KMuon> >::iterator muon = product.m_correctedMuons.begin();
-			     muon != product.m_correctedMuons.end(); ++muon)
-			{
-				muons[muonIndex] = muon->get();
-				++muonIndex;
-			}
+			muons = product.m_correctedMuons.Get();
 		}
 		else
 		{
@@ -353,9 +350,9 @@ protected:
 private:
 	std::vector<KMuon*> product_type::*m_validMuonsMember;
 	std::vector<KMuon*> product_type::*m_invalidMuonsMember;
-	std::string (setting_type::*GetMuonID)(void) const;
-	std::string (setting_type::*GetMuonIsoType)(void) const;
-	std::string (setting_type::*GetMuonIso)(void) const;
+	std::string const& (setting_type::*GetMuonID)(void) const;
+	std::string const& (setting_type::*GetMuonIsoType)(void) const;
+	std::string const& (setting_type::*GetMuonIso)(void) const;
 
 	ValidMuonsInput validMuonsInput;
 
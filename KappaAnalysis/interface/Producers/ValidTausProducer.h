@@ -12,6 +12,7 @@
 #include "Artus/KappaAnalysis/interface/KappaTypes.h"
 #include "Artus/KappaAnalysis/interface/KappaProducerBase.h"
 #include "Artus/KappaAnalysis/interface/Utility/ValidPhysicsObjectTools.h"
+#include "Artus/KappaAnalysis/interface/Utility/MetadataIndices.h"
 #include "Artus/KappaAnalysis/interface/Consumers/KappaLambdaNtupleConsumer.h"
 #include "Artus/Utility/interface/SafeMap.h"
 #include "Artus/Utility/interface/Utility.h"
@@ -62,6 +63,10 @@ public:
 	std::string GetProducerId() const override {
 		return "ValidTausProducer";
 	}
+
+	void GetRequiredEventMembers(std::set<std::string>& eventMembers) const override {
+		eventMembers.insert({ "Taus", "TauMetadata", "VertexSummary" });
+	}
 	
 	ValidTausProducer() :
 		KappaProducerBase(),
@@ -82,8 +87,19 @@ public:
 		// parse additional config tags
 		discriminatorsByIndex = Utility::ParseMapTypes<size_t, std::string>(Utility::ParseVectorToMap(settings.GetTauDiscriminators()),
 		                                                                    discriminatorsByHltName);
+		for (std::map<size_t, std::vector<std::string> >::const_iterator discriminatorByIndex = discriminatorsByIndex.begin();
+		     discriminatorByIndex != discriminatorsByIndex.end(); ++discriminatorByIndex)
+		{
+			discriminatorMasksByIndex[discriminatorByIndex->first] = MetadataBitMask(discriminatorByIndex->second);
+		}
+		for (std::map<std::string, std::vector<std::string> >::const_iterator discriminatorByHltName = discriminatorsByHltName.begin();
+		     discriminatorByHltName != discriminatorsByHltName.end(); ++discriminatorByHltName)
+		{
+			discriminatorMasksByHltName[discriminatorByHltName->first] = MetadataBitMask(discriminatorByHltName->second);
+		}
 		tauID = ToTauID(settings.GetTauID());
 		oldTauDMs = settings.GetTauUseOldDMs();
+		decayModeDiscriminatorIndex = MetadataIndex(oldTauDMs ? "decayModeFinding" : "decayModeFindingNewDMs");
 
 		// add possible quantities for the lambda ntuples consumers
 		LambdaNtupleConsumer<KappaTypes>::AddIntQuantity(metadata, "nTaus", [](KappaTypes::event_type const& event, KappaTypes::product_type const& product) {
@@ -209,19 +225,18 @@ public:
 	{
 		assert(event.m_taus);
 		assert(event.m_tauMetadata);
+		assert(event.m_eventInfo);
+
+		if (metadataLumiSection.Update(event.m_eventInfo->nRun, event.m_eventInfo->nLumi))
+		{
+			ResolveMetadata(event);
+		}
 	
 		// select input source
 		std::vector<KTau*> taus;
-		if ((validTausInput == ValidTausInput::AUTO && (product.m_correctedTaus.size() > 0)) || (validTausInput == ValidTausInput::CORRECTED))
+		if ((validTausInput == ValidTausInput::AUTO && (product.m_correctedTaus->size() > 0)) || (validTausInput == ValidTausInput::CORRECTED))
 		{
-			taus.resize(product.m_correctedTaus.size());
-			size_t tauIndex = 0;
-			for (std::vector<std::shared_ptr<KTau> >::iterator tau = product.m_correctedTaus.begin();
-			     tau != product.m_correctedTaus.end(); ++tau)
-			{
-				taus[tauIndex] = tau->get();
-				++tauIndex;
-			}
+			taus = product.m_correctedTaus.Get();
 		}
 		else
 		{
@@ -239,8 +254,8 @@ public:
 			bool validTau = true;
 			
 			// check discriminators
-			for (std::map<size_t, std::vector<std::string> >::const_iterator discriminatorByIndex = discriminatorsByIndex.begin();
-				 validTau && (discriminatorByIndex != discriminatorsByIndex.end()); ++discriminatorByIndex)
+			for (std::map<size_t, MetadataBitMask>::const_iterator discriminatorByIndex = discriminatorMasksByIndex.begin();
+				 validTau && (discriminatorByIndex != discriminatorMasksByIndex.end()); ++discriminatorByIndex)
 			{
 				if (discriminatorByIndex->first == product.m_validTaus.size())
 				{
@@ -248,8 +263,8 @@ public:
 				}
 			}
 			
-			for (std::map<std::string, std::vector<std::string> >::const_iterator discriminatorByHltName = discriminatorsByHltName.begin();
-				 validTau && (discriminatorByHltName != discriminatorsByHltName.end()); ++discriminatorByHltName)
+			for (std::map<std::string, MetadataBitMask>::const_iterator discriminatorByHltName = discriminatorMasksByHltName.begin();
+				 validTau && (discriminatorByHltName != discriminatorMasksByHltName.end()); ++discriminatorByHltName)
 			{
 				bool hasMatch = false;
 				for (unsigned int iHlt = 0; iHlt < product.m_selectedHltNames.size(); ++iHlt)
@@ -262,9 +277,9 @@ public:
 			}
 			
 			if(tauID == TauID::RECOMMENDATION13TEV)
-					validTau = validTau && IsTauIDRecommendation13TeV(*tau, event, oldTauDMs);
+					validTau = validTau && IsTauIDRecommendation13TeV(*tau, event);
 			if(tauID == TauID::RECOMMENDATION13TEVAOD)
-					validTau = validTau && IsTauIDRecommendation13TeV(*tau, event, oldTauDMs, true);
+					validTau = validTau && IsTauIDRecommendation13TeV(*tau, event, true);
 			// kinematic cuts
 			validTau = validTau && this->PassKinematicCuts(*tau, event, product);
 			
@@ -299,14 +314,36 @@ private:
 	
 	std::map<size_t, std::vector<std::string> > discriminatorsByIndex;
 	std::map<std::string, std::vector<std::string> > discriminatorsByHltName;
+
+	// resolved in Produce for every lumi section
+	mutable MetadataLumiSection metadataLumiSection;
+	mutable std::map<size_t, MetadataBitMask> discriminatorMasksByIndex;
+	mutable std::map<std::string, MetadataBitMask> discriminatorMasksByHltName;
+	mutable MetadataIndex decayModeDiscriminatorIndex;
+
+	void ResolveMetadata(KappaTypes::event_type const& event) const
+	{
+		// the binary discriminators are stored in the bits of an unsigned long long
+		for (std::map<size_t, MetadataBitMask>::iterator discriminatorMask = discriminatorMasksByIndex.begin();
+		     discriminatorMask != discriminatorMasksByIndex.end(); ++discriminatorMask)
+		{
+			discriminatorMask->second.Resolve(event.m_tauMetadata->binaryDiscriminatorNames, 64);
+		}
+		for (std::map<std::string, MetadataBitMask>::iterator discriminatorMask = discriminatorMasksByHltName.begin();
+		     discriminatorMask != discriminatorMasksByHltName.end(); ++discriminatorMask)
+		{
+			discriminatorMask->second.Resolve(event.m_tauMetadata->binaryDiscriminatorNames, 64);
+		}
+		decayModeDiscriminatorIndex.Resolve(event.m_tauMetadata->floatDiscriminatorNames);
+	}
 	
-	bool ApplyDiscriminators(KTau* tau, std::vector<std::string> const& discriminators,
+	bool ApplyDiscriminators(KTau* tau, MetadataBitMask const& discriminators,
 	                         KappaTypes::event_type const& event) const
 	{
-		bool validTau = true;
+		bool validTau = discriminators.PassesBits(tau->binaryDiscriminators);
 		
-		for (std::vector<std::string>::const_iterator discriminator = discriminators.begin();
-		     validTau && (discriminator != discriminators.end()); ++discriminator)
+		for (std::vector<std::string>::const_iterator discriminator = discriminators.GetUnresolvedNames().begin();
+		     validTau && (discriminator != discriminators.GetUnresolvedNames().end()); ++discriminator)
 		{
 			validTau = validTau && tau->getId(*discriminator, event.m_tauMetadata);
 		}
@@ -317,11 +354,11 @@ private:
 	TauID tauID;
 	bool oldTauDMs;
 
-	bool IsTauIDRecommendation13TeV(KTau* tau, KappaTypes::event_type const& event, bool const& oldTauDMs, bool const& isAOD=false) const
+	bool IsTauIDRecommendation13TeV(KTau* tau, KappaTypes::event_type const& event, bool const& isAOD=false) const
 	{
 		const KVertex* vertex = new KVertex(event.m_vertexSummary->pv);
-		float decayModeDiscriminator = (oldTauDMs ? tau->getDiscriminator("decayModeFinding", event.m_tauMetadata)
-							  : tau->getDiscriminator("decayModeFindingNewDMs", event.m_tauMetadata));
+		float decayModeDiscriminator = (decayModeDiscriminatorIndex.IsResolvedFor(tau->floatDiscriminators) ? tau->floatDiscriminators[decayModeDiscriminatorIndex.GetIndex()]
+		                                                                                                    : tau->getDiscriminator(decayModeDiscriminatorIndex.GetName(), event.m_tauMetadata));
 		if(isAOD)
 		{
 			return ( decayModeDiscriminator > 0.5
@@ -136,6 +136,58 @@ protected:
 #endif  // BTagCalibration_H
 
 
+#ifndef BTagFormula_H
+#define BTagFormula_H
+
+/**
+ * BTagFormula
+ *
+ * 1D-function of a BTagEntry, evaluated without the formula interpreter.
+ *
+ * The formulas of the calibration files (numbers, x, + - * /, parentheses
+ * and the usual functions like log, exp, sqrt, pow, min, max) are compiled
+ * into a small stack program when the reader is set up. Formulas using
+ * anything else are evaluated by a TF1 as before.
+ *
+ ************************************************************/
+
+#include <string>
+#include <vector>
+#include <TF1.h>
+
+
+class BTagFormula
+{
+public:
+	BTagFormula() {}
+	BTagFormula(const std::string &formula, double xMin, double xMax);
+
+	double Eval(double x) const;
+
+	bool isCompiled() const {return (! program_.empty());}
+
+private:
+	enum OpCode {
+		OP_CONSTANT, OP_X,
+		OP_ADD, OP_SUBTRACT, OP_MULTIPLY, OP_DIVIDE, OP_NEGATE,
+		OP_LOG, OP_LOG10, OP_EXP, OP_SQRT, OP_ABS, OP_POW, OP_MIN, OP_MAX,
+	};
+	struct Instruction {
+		OpCode opCode;
+		double constant;
+	};
+	static const size_t maxStackSize = 32;
+	class Parser;
+
+	bool compile(const std::string &formula);
+
+	std::vector<Instruction> program_;
+	TF1 func_;
+};
+
+#endif  // BTagFormula_H
+
+
 #ifndef BTagCalibrationReader_H
 #define BTagCalibrationReader_H
 
@@ -143,14 +195,18 @@ protected:
  * BTagCalibrationReader
  *
  * Helper class to pull out a specific set of BTagEntry's out of a
- * BTagCalibration. TF1 functions are set up at initialization time.
+ * BTagCalibration. The functions are set up at initialization time.
+ *
+ * The entries of every jet flavor are indexed by the eta and pt bin edges
+ * of all entries, such that the evaluation finds the entries of a jet with
+ * two binary searches. The entries of a bin keep the order of the
+ * calibration, the first matching entry is evaluated.
  *
  ************************************************************/
 
 #include <map>
 #include <string>
 #include <vector>
-#include <TF1.h>
 
 
 class BTagCalibrationReader
@@ -176,14 +232,23 @@ protected:
 		float ptMax;
 		float discrMin;
 		float discrMax;
-		TF1 func;
+		BTagFormula func;
+	};
+	struct TmpData {
+		std::vector<TmpEntry> entries;
+		// bin (iEta, iPt) covers [etaEdges[iEta], etaEdges[iEta+1]) x [ptEdges[iPt], ptEdges[iPt+1])
+		std::vector<float> etaEdges;
+		std::vector<float> ptEdges;
+		// entries of the bin iEta * (ptEdges.size() - 1) + iPt in binEntries[binOffsets[bin]...binOffsets[bin+1]]
+		std::vector<size_t> binOffsets;
+		std::vector<unsigned int> binEntries;
 	};
 	void setupTmpData(const BTagCalibration* c);
+	static void setupBins(TmpData &data);
 
 	BTagEntry::Parameters params;
-	std::map<BTagEntry::JetFlavor, std::vector<TmpEntry> > tmpData_;
+	std::map<BTagEntry::JetFlavor, TmpData> tmpData_;
 	std::vector<bool> useAbsEta;
 };
 
 #endif  // BTagCalibrationReader_H
-
@@ -6,6 +6,8 @@
 #include <TString.h>
 #include <TMath.h>
 #include <iostream>
+#include <limits>
+#include <vector>
 
 #include "Artus/KappaAnalysis/interface/Utility/BTagCalibrationStandalone.h"
 
@@ -30,10 +32,40 @@ public:
 
 	enum { kNo, kDown, kUp }; // systematic variations
 
+	// up and down are the b-tag variations for b and c jets and the mistag variations for light jets
+	struct ScaleFactor
+	{
+		double central = 0.0;
+		double up = 0.0;
+		double down = 0.0;
+
+		double get(unsigned int sys) const { return ((sys == kUp) ? up : ((sys == kDown) ? down : central)); }
+	};
+
+	// scale factors of all jets of an event, identical to getSFb, getSFc and getSFl of the single jets
+	void getScaleFactors(std::vector<double> const& pts, std::vector<float> const& etas, std::vector<int> const& jetflavors,
+	                     int year, std::vector<ScaleFactor>& scaleFactors) const;
+
+	// promotion/demotion of a jet with a scale factor from getScaleFactors
+	bool isbtaggedWithSF(double pt, float eta, float csv, Int_t jetflavor, double sf, int year, float btagWP) const;
+
 private:
+	// evaluates only the requested systematic (and the central value, if the uncertainty is doubled)
+	static double evalScaleFactor(BTagCalibrationReader const& reader, BTagCalibrationReader const& readerUp,
+	                              BTagCalibrationReader const& readerDown, BTagEntry::JetFlavor flavour,
+	                              double pt, float eta, float minPt, float maxPt, unsigned int sys);
+	static ScaleFactor evalScaleFactors(BTagCalibrationReader const& reader, BTagCalibrationReader const& readerUp,
+	                                    BTagCalibrationReader const& readerDown, BTagEntry::JetFlavor flavour,
+	                                    double pt, float eta, float minPt, float maxPt);
+
+	// random number of a jet for the promotion/demotion, seeded by the jet to be reproducible
+	double getRandom(float eta) const;
+
 	mutable TRandom3 randm;
 	BTagCalibration calib;
 	TFile* effFile = nullptr;
+	// histograms of the efficiency file for b, c and other jets
+	TH2D* effHistos[3] = {nullptr, nullptr, nullptr};
 	BTagCalibrationReader reader_mujets;
 	BTagCalibrationReader reader_mujets_up;
 	BTagCalibrationReader reader_mujets_do;
@@ -0,0 +1,100 @@
+#pragma once
+
+#include <string>
+#include <vector>
+
+/**
+   \brief Positions of named IDs, tags and discriminators in the names of the Kappa lumi metadata
+
+   The Kappa accessors (KTau::getId, KJet::getTag, KElectron::getId, ...) search the names in the
+   metadata for every call. The metadata only change with the lumi section, so the producers resolve
+   the configured names once per lumi section (see MetadataLumiSection) and read the values of the
+   objects by index during the selection.
+
+   Names which are not listed in the metadata stay unresolved. They are still evaluated with the
+   Kappa accessors, such that their behaviour for unknown names is kept. The same holds for objects
+   with fewer values than the metadata has names.
+*/
+class MetadataIndex {
+
+public:
+	explicit MetadataIndex(std::string const& name = "");
+
+	void Resolve(std::vector<std::string> const& metadataNames);
+
+	bool IsResolved() const
+	{
+		return m_resolved;
+	}
+
+	// true if the value can be read by index from the values of an object
+	template<class TValues>
+	bool IsResolvedFor(TValues const& values) const
+	{
+		return (m_resolved && (m_index < values.size()));
+	}
+
+	size_t GetIndex() const
+	{
+		return m_index;
+	}
+
+	std::string const& GetName() const
+	{
+		return m_name;
+	}
+
+private:
+	std::string m_name;
+	size_t m_index = 0;
+	bool m_resolved = false;
+};
+
+
+/**
+   \brief Bit mask of several binary IDs, which all need to be passed (e.g. a list of tau discriminators)
+*/
+class MetadataBitMask {
+
+public:
+	explicit MetadataBitMask(std::vector<std::string> const& names = std::vector<std::string>());
+
+	// only the first nBits names of the metadata can be stored in the bits of the objects
+	void Resolve(std::vector<std::string> const& metadataNames, size_t nBits);
+
+	// true if all resolved IDs are set in the bits of an object
+	bool PassesBits(unsigned long long bits) const
+	{
+		return ((bits & m_mask) == m_mask);
+	}
+
+	// names, which need to be checked with the Kappa accessors
+	std::vector<std::string> const& GetUnresolvedNames() const
+	{
+		return m_unresolvedNames;
+	}
+
+private:
+	std::vector<std::string> m_names;
+	unsigned long long m_mask = 0;
+	std::vector<std::string> m_unresolvedNames;
+};
+
+
+/**
+   \brief Run and lumi section, for which the metadata indices of a producer are resolved
+
+   OnLumi is not called for the processors behind a failing filter. The producers therefore check in
+   every call of Produce, whether the lumi section has changed (as HLTTools::setLumiInfo does).
+*/
+class MetadataLumiSection {
+
+public:
+	// returns true if the indices need to be resolved for this lumi section, which becomes the current one
+	bool Update(unsigned int run, unsigned int lumi);
+
+private:
+	unsigned int m_run = 0;
+	unsigned int m_lumi = 0;
+	bool m_valid = false;
+};
@@ -53,6 +53,11 @@ std::string KappaTausConsumer::GetConsumerId() const
 	return "KappaTausConsumer";
 }
 
+void KappaTausConsumer::GetRequiredEventMembers(std::set<std::string>& eventMembers) const
+{
+	eventMembers.insert("TauMetadata");
+}
+
 
 
 KappaJetsConsumer::KappaJetsConsumer() :
@@ -88,3 +93,8 @@ std::string KappaTaggedJetsConsumer::GetConsumerId() const
 {
 	return "KappaTaggedJetsConsumer";
 }
+
+void KappaTaggedJetsConsumer::GetRequiredEventMembers(std::set<std::string>& eventMembers) const
+{
+	eventMembers.insert("JetMetadata");
+}
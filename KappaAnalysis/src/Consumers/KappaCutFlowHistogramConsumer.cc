@@ -6,8 +6,9 @@ void KappaCutFlowHistogramConsumer::Init(setting_type const& settings, metadata_
 {
 	CutFlowHistogramConsumer<KappaTypes>::Init(settings, metadata);
 
-	this->weightExtractor = [](event_type const& event, product_type const& product, setting_type const& setting) -> double {
-		return SafeMap::GetWithDefault(product.m_weights, setting.GetEventWeight(), 1.0);
+	size_t eventWeightIndex = EventWeights::GetIndex(settings.GetEventWeight());
+	this->weightExtractor = [eventWeightIndex](event_type const& event, product_type const& product, setting_type const& setting) -> double {
+		return product.m_weights.GetWithDefault(eventWeightIndex, 1.0);
 	};
 
 	this->m_addWeightedCutFlow = true;
@@ -11,7 +11,7 @@ std::string PrintEventsConsumer::GetConsumerId() const
 }
 
 void PrintEventsConsumer::ProcessEvent(event_type const& event, product_type const& product,
-                                       setting_type const& settings, metadata_type const& metadata, FilterResult& result)
+                                       setting_type const& settings, metadata_type const& metadata, FilterResult const& result)
 {
 	// LOG(INFO) << "Processed event: run = " << event.m_eventInfo->nRun << "/" << event.m_lumiInfo->nRun << "/" << event.m_runInfo->nRun << ", lumi = " << event.m_eventInfo->nLumi << "/" << event.m_lumiInfo->nLumi << ", event = " << event.m_eventInfo->nEvent << ", pipeline = " << settings.GetName();
 	LOG(INFO) << "Processed event: run = " << event.m_eventInfo->nRun << ", lumi = " << event.m_eventInfo->nLumi << ", event = " << event.m_eventInfo->nEvent << ", pipeline = " << settings.GetName();
@@ -15,6 +15,11 @@ std::string PrintGenParticleDecayTreeConsumer::GetConsumerId() const
 	return "PrintGenParticleDecayTreeConsumer";
 }
 
+void PrintGenParticleDecayTreeConsumer::GetRequiredEventMembers(std::set<std::string>& eventMembers) const
+{
+	eventMembers.insert({ "GenParticles", "LheParticles" });
+}
+
 void PrintGenParticleDecayTreeConsumer::Init(setting_type const& settings, metadata_type& metadata)
 {
 	ConsumerBase<KappaTypes>::Init(settings, metadata);
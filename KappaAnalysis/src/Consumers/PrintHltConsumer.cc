@@ -10,6 +10,11 @@ std::string PrintHltConsumer::GetConsumerId() const
 	return "PrintHltConsumer";
 }
 
+void PrintHltConsumer::GetRequiredEventMembers(std::set<std::string>& eventMembers) const
+{
+	eventMembers.insert({ "TriggerInfos", "TriggerObjects" });
+}
+
 void PrintHltConsumer::ProcessFilteredEvent(event_type const& event, product_type const& product,
                                             setting_type const& settings, metadata_type const& metadata)
 {
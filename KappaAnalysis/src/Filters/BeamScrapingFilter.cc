@@ -9,6 +9,11 @@ std::string BeamScrapingFilter::GetFilterId() const {
 	return "BeamScrapingFilter";
 }
 
+void BeamScrapingFilter::GetRequiredEventMembers(std::set<std::string>& eventMembers) const
+{
+	eventMembers.insert("TrackSummary");
+}
+
 void BeamScrapingFilter::Init(setting_type const& settings, metadata_type& metadata)
 {
 	FilterBase<KappaTypes>::Init(settings, metadata);
@@ -9,6 +9,11 @@ std::string GoodPrimaryVertexFilter::GetFilterId() const {
 	return "GoodPrimaryVertexFilter";
 }
 
+void GoodPrimaryVertexFilter::GetRequiredEventMembers(std::set<std::string>& eventMembers) const
+{
+	eventMembers.insert("VertexSummary");
+}
+
 void GoodPrimaryVertexFilter::Init(setting_type const& settings, metadata_type& metadata)
 {
 	FilterBase<KappaTypes>::Init(settings, metadata);
@@ -9,6 +9,11 @@ std::string HCALNoiseFilter::GetFilterId() const {
 	return "HCALNoiseFilter";
 }
 
+void HCALNoiseFilter::GetRequiredEventMembers(std::set<std::string>& eventMembers) const
+{
+	eventMembers.insert("HCALNoiseSummary");
+}
+
 void HCALNoiseFilter::Init(setting_type const& settings, metadata_type& metadata)
 {
 	FilterBase<KappaTypes>::Init(settings, metadata);
@@ -17,7 +17,9 @@
 		
 		m_runLumiSelector = RunLumiSelector(settings.GetJsonFiles(),
 		                                    settings.GetPassRunLow(),
-		                                    settings.GetPassRunHigh());
+		                                    settings.GetPassRunHigh(),
+		                                    settings.GetCacheJsonFiles());
+		m_hasLastDecision = false;
 	}
 
 	bool JsonFilter::DoesEventPass(event_type const& event, product_type const& product,
@@ -25,5 +27,14 @@
 	{
 		assert(event.m_eventInfo);
 		
-		return m_runLumiSelector.accept(event.m_eventInfo->nRun, (event.m_eventInfo->nLumi & 0x0000FFFF));
+		const run_id run = event.m_eventInfo->nRun;
+		const lumi_id lumi = (event.m_eventInfo->nLumi & 0x0000FFFF);
+		if ((! m_hasLastDecision) || (run != m_lastRun) || (lumi != m_lastLumi))
+		{
+			m_lastDecision = m_runLumiSelector.accept(run, lumi);
+			m_lastRun = run;
+			m_lastLumi = lumi;
+			m_hasLastDecision = true;
+		}
+		return m_lastDecision;
 	}
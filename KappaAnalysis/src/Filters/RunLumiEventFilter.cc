@@ -1,9 +1,56 @@
+#include <fstream>
+
 #include "Artus/KappaAnalysis/interface/Filters/RunLumiEventFilter.h"
 
 std::string RunLumiEventFilter::GetFilterId() const {
 	return "RunLumiEventFilter";
 }
 
+void RunLumiEventFilter::Init(setting_type const& settings, metadata_type& metadata)
+{
+	FilterBase<KappaTypes>::Init(settings, metadata);
+
+	m_matchRunLumiEventTuples = settings.GetMatchRunLumiEventTuples();
+
+	m_runWhitelist.clear();
+	m_runBlacklist.clear();
+	m_lumiWhitelist.clear();
+	m_lumiBlacklist.clear();
+	m_eventWhitelist.clear();
+	m_eventBlacklist.clear();
+	m_runLumiEventWhitelist.clear();
+	m_runLumiEventBlacklist.clear();
+
+	if (m_matchRunLumiEventTuples)
+	{
+		FillRunLumiEventSet(m_runLumiEventWhitelist, settings.GetRunWhitelist(), settings.GetLumiWhitelist(), settings.GetEventWhitelist());
+		FillRunLumiEventSet(m_runLumiEventBlacklist, settings.GetRunBlacklist(), settings.GetLumiBlacklist(), settings.GetEventBlacklist());
+		if (! settings.GetRunLumiEventWhitelistFile().empty())
+		{
+			ReadRunLumiEventSet(m_runLumiEventWhitelist, settings.GetRunLumiEventWhitelistFile());
+		}
+		if (! settings.GetRunLumiEventBlacklistFile().empty())
+		{
+			ReadRunLumiEventSet(m_runLumiEventBlacklist, settings.GetRunLumiEventBlacklistFile());
+		}
+		LOG(DEBUG) << "RunLumiEventFilter: " << m_runLumiEventWhitelist.size() << " whitelisted and "
+		           << m_runLumiEventBlacklist.size() << " blacklisted (run, lumi, event) tuples.";
+	}
+	else
+	{
+		if ((! settings.GetRunLumiEventWhitelistFile().empty()) || (! settings.GetRunLumiEventBlacklistFile().empty()))
+		{
+			LOG(FATAL) << "The settings RunLumiEventWhitelistFile and RunLumiEventBlacklistFile require MatchRunLumiEventTuples = true!";
+		}
+		m_runWhitelist.insert(settings.GetRunWhitelist().begin(), settings.GetRunWhitelist().end());
+		m_runBlacklist.insert(settings.GetRunBlacklist().begin(), settings.GetRunBlacklist().end());
+		m_lumiWhitelist.insert(settings.GetLumiWhitelist().begin(), settings.GetLumiWhitelist().end());
+		m_lumiBlacklist.insert(settings.GetLumiBlacklist().begin(), settings.GetLumiBlacklist().end());
+		m_eventWhitelist.insert(settings.GetEventWhitelist().begin(), settings.GetEventWhitelist().end());
+		m_eventBlacklist.insert(settings.GetEventBlacklist().begin(), settings.GetEventBlacklist().end());
+	}
+}
+
 bool RunLumiEventFilter::DoesEventPass(event_type const& event, product_type const& product,
                                        setting_type const& settings, metadata_type const& metadata) const 
 {
@@ -11,43 +58,20 @@ bool RunLumiEventFilter::DoesEventPass(event_type const& event, product_type con
 	
 	bool match = false;
 	
-	if (settings.GetMatchRunLumiEventTuples())
+	if (m_matchRunLumiEventTuples)
 	{
-		match = true;
-		for (size_t index = 0; index < std::min(std::min(settings.GetRunBlacklist().size(),
-		                                                 settings.GetLumiBlacklist().size()),
-		                                        settings.GetEventBlacklist().size()); ++index)
-		{
-			if ((event.m_eventInfo->nRun == settings.GetRunBlacklist()[index]) &&
-			    (event.m_eventInfo->nLumi == settings.GetLumiBlacklist()[index]) &&
-			    (event.m_eventInfo->nEvent == settings.GetEventBlacklist()[index]))
-			{
-				match = false;
-				break;
-			}
-		}
-		if (match)
-		{
-			match = false;
-			for (size_t index = 0; index < std::min(std::min(settings.GetRunWhitelist().size(),
-			                                                 settings.GetLumiWhitelist().size()),
-			                                        settings.GetEventWhitelist().size()); ++index)
-			{
-				if ((event.m_eventInfo->nRun == settings.GetRunWhitelist()[index]) &&
-					(event.m_eventInfo->nLumi == settings.GetLumiWhitelist()[index]) &&
-					(event.m_eventInfo->nEvent == settings.GetEventWhitelist()[index]))
-				{
-					match = true;
-					break;
-				}
-			}
-		}
+		RunLumiEvent runLumiEvent;
+		runLumiEvent.run = event.m_eventInfo->nRun;
+		runLumiEvent.lumi = event.m_eventInfo->nLumi;
+		runLumiEvent.event = event.m_eventInfo->nEvent;
+		match = ((m_runLumiEventBlacklist.count(runLumiEvent) == 0) &&
+		         (m_runLumiEventWhitelist.count(runLumiEvent) > 0));
 	}
 	else
 	{
-		match = (MatchWhiteBlackLists(event.m_eventInfo->nRun, settings.GetRunWhitelist(), settings.GetRunBlacklist()) &&
-		         MatchWhiteBlackLists(event.m_eventInfo->nLumi, settings.GetLumiWhitelist(), settings.GetLumiBlacklist()) &&
-		         MatchWhiteBlackLists(event.m_eventInfo->nEvent, settings.GetEventWhitelist(), settings.GetEventBlacklist()));
+		match = (MatchWhiteBlackLists(event.m_eventInfo->nRun, m_runWhitelist, m_runBlacklist) &&
+		         MatchWhiteBlackLists(event.m_eventInfo->nLumi, m_lumiWhitelist, m_lumiBlacklist) &&
+		         MatchWhiteBlackLists(event.m_eventInfo->nEvent, m_eventWhitelist, m_eventBlacklist));
 	}
 	if (match)
 	{
@@ -59,13 +83,61 @@ bool RunLumiEventFilter::DoesEventPass(event_type const& event, product_type con
 	return match;
 }
 
-bool RunLumiEventFilter::MatchWhiteBlackLists(uint64_t item, std::vector<uint64_t> const& whitelist, std::vector<uint64_t> const& blacklist) const
+// only complete tuples are used, if the lists have different lengths
+void RunLumiEventFilter::FillRunLumiEventSet(RunLumiEventSet& runLumiEvents, std::vector<uint64_t> const& runs,
+                                             std::vector<uint64_t> const& lumis, std::vector<uint64_t> const& events)
+{
+	size_t nTuples = std::min(std::min(runs.size(), lumis.size()), events.size());
+	runLumiEvents.reserve(runLumiEvents.size() + nTuples);
+	for (size_t index = 0; index < nTuples; ++index)
+	{
+		RunLumiEvent runLumiEvent;
+		runLumiEvent.run = runs[index];
+		runLumiEvent.lumi = lumis[index];
+		runLumiEvent.event = events[index];
+		runLumiEvents.insert(runLumiEvent);
+	}
+}
+
+void RunLumiEventFilter::ReadRunLumiEventSet(RunLumiEventSet& runLumiEvents, std::string const& fileName)
+{
+	std::ifstream inStream(fileName, std::ios::in | std::ios::binary);
+	if (! inStream)
+	{
+		LOG(FATAL) << "Cannot open the run/lumi/event list \"" << fileName << "\"!";
+	}
+	inStream.seekg(0, std::ios::end);
+	size_t nBytes = inStream.tellg();
+	inStream.seekg(0, std::ios::beg);
+	if ((nBytes % (3 * sizeof(uint64_t))) != 0)
+	{
+		LOG(FATAL) << "The run/lumi/event list \"" << fileName << "\" does not only contain (run, lumi, event) tuples of uint64_t numbers!";
+	}
+
+	std::vector<uint64_t> numbers(nBytes / sizeof(uint64_t));
+	if (! inStream.read(reinterpret_cast<char*>(numbers.data()), nBytes))
+	{
+		LOG(FATAL) << "Cannot read the run/lumi/event list \"" << fileName << "\"!";
+	}
+	runLumiEvents.reserve(runLumiEvents.size() + (numbers.size() / 3));
+	for (size_t index = 0; index + 2 < numbers.size(); index += 3)
+	{
+		RunLumiEvent runLumiEvent;
+		runLumiEvent.run = numbers[index];
+		runLumiEvent.lumi = numbers[index + 1];
+		runLumiEvent.event = numbers[index + 2];
+		runLumiEvents.insert(runLumiEvent);
+	}
+	LOG(DEBUG) << "Read " << (numbers.size() / 3) << " (run, lumi, event) tuples from \"" << fileName << "\".";
+}
+
+bool RunLumiEventFilter::MatchWhiteBlackLists(uint64_t item, std::unordered_set<uint64_t> const& whitelist, std::unordered_set<uint64_t> const& blacklist) const
 {
-	if ((whitelist.size() > 0) && (std::find(whitelist.begin(), whitelist.end(), item) == whitelist.end()))
+	if ((whitelist.size() > 0) && (whitelist.count(item) == 0))
 	{
 		return false;
 	}
-	if ((blacklist.size() > 0) && (std::find(blacklist.begin(), blacklist.end(), item) != blacklist.end()))
+	if ((blacklist.size() > 0) && (blacklist.count(item) > 0))
 	{
 		return false;
 	}
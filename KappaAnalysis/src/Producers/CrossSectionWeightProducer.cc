@@ -6,17 +6,24 @@ std::string CrossSectionWeightProducer::GetProducerId() const
 	return "CrossSectionWeightProducer";
 }
 
+void CrossSectionWeightProducer::Init(setting_type const& settings, metadata_type& metadata)
+{
+	KappaProducerBase::Init(settings, metadata);
+
+	m_crossSectionPerEventWeightIndex = EventWeights::GetIndex("crossSectionPerEventWeight");
+}
+
 void CrossSectionWeightProducer::Produce(event_type const& event, product_type & product,
                                          setting_type const& settings, metadata_type const& metadata) const
 {
 	assert(event.m_genRunInfo);
 	
 	if (static_cast<double>(settings.GetCrossSection()) > 0.0)
-		product.m_weights["crossSectionPerEventWeight"] = settings.GetCrossSection();
+		product.m_weights.Set(m_crossSectionPerEventWeightIndex, settings.GetCrossSection());
 	else if (event.m_genRunInfo->xSectionExt > 0.)
-		product.m_weights["crossSectionPerEventWeight"] = event.m_genRunInfo->xSectionExt;
+		product.m_weights.Set(m_crossSectionPerEventWeightIndex, event.m_genRunInfo->xSectionExt);
 	else if (event.m_genRunInfo->xSectionInt > 0.)
-		product.m_weights["crossSectionPerEventWeight"] = event.m_genRunInfo->xSectionInt;
+		product.m_weights.Set(m_crossSectionPerEventWeightIndex, event.m_genRunInfo->xSectionInt);
 	else
 		LOG(ERROR) << "No CrossSection information found.";
 }
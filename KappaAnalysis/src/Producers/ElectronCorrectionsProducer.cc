@@ -6,9 +6,19 @@ std::string ElectronCorrectionsProducer::GetProducerId() const {
 	return "ElectronCorrectionsProducer";
 }
 
+void ElectronCorrectionsProducer::GetRequiredEventMembers(std::set<std::string>& eventMembers) const
+{
+	eventMembers.insert("Electrons");
+	if (m_useUWGenMatching)
+	{
+		eventMembers.insert("GenParticles");
+	}
+}
+
 void ElectronCorrectionsProducer::Init(setting_type const& settings, metadata_type& metadata)
 {
 	KappaProducerBase::Init(settings, metadata);
+	m_useUWGenMatching = (settings.GetCorrectOnlyRealElectrons() && settings.GetUseUWGenMatching());
 }
 
 void ElectronCorrectionsProducer::Produce(event_type const& event, product_type& product,
@@ -16,21 +26,22 @@ void ElectronCorrectionsProducer::Produce(event_type const& event, product_type&
 {
 	assert(event.m_electrons);
 
-	// create a copy of all electrons in the event
-	product.m_correctedElectrons.clear();
-	product.m_correctedElectrons.resize(event.m_electrons->size());
+	// create a copy of all electrons in the event (deleted at the end of the event)
+	std::vector<KElectron*>& correctedElectrons = product.m_correctedElectrons.Reset();
+	std::map<const KLepton*, const KLepton*>& originalLeptons = product.m_originalLeptons.GetMutable();
+	correctedElectrons.resize(event.m_electrons->size());
 	size_t electronIndex = 0;
 	for (KElectrons::const_iterator electron = event.m_electrons->begin();
 		 electron != event.m_electrons->end(); ++electron)
 	{
-		product.m_correctedElectrons[electronIndex] = std::shared_ptr<KElectron>(new KElectron(*electron));
-		product.m_originalLeptons[product.m_correctedElectrons[electronIndex].get()] = &(*electron);
+		correctedElectrons[electronIndex] = product.m_correctedObjectsArena.Create<KElectron>(*electron);
+		originalLeptons[correctedElectrons[electronIndex]] = &(*electron);
 		++electronIndex;
 	}
 	
 	// perform corrections on copied electrons
-	for (std::vector<std::shared_ptr<KElectron> >::iterator electron = product.m_correctedElectrons.begin();
-		 electron != product.m_correctedElectrons.end(); ++electron)
+	for (std::vector<KElectron*>::iterator electron = correctedElectrons.begin();
+		 electron != correctedElectrons.end(); ++electron)
 	{
 		// Check whether corrections should be applied at all
 		bool isRealElectron = false;
@@ -39,11 +50,11 @@ void ElectronCorrectionsProducer::Produce(event_type const& event, product_type&
 			KappaEnumTypes::GenMatchingCode genMatchingCode = KappaEnumTypes::GenMatchingCode::NONE;
 			if (settings.GetUseUWGenMatching())
 			{
-				genMatchingCode = GeneratorInfo::GetGenMatchingCodeUW(event, const_cast<KLepton*>(product.m_originalLeptons[electron->get()]));
+				genMatchingCode = GeneratorInfo::GetGenMatchingCodeUW(event, const_cast<KLepton*>(originalLeptons[*electron]));
 			}
 			else
 			{
-				KGenParticle* genParticle = GeneratorInfo::GetGenMatchedParticle(const_cast<KLepton*>(product.m_originalLeptons[electron->get()]), product.m_genParticleMatchedLeptons, product.m_genTauMatchedLeptons);
+				KGenParticle* genParticle = GeneratorInfo::GetGenMatchedParticle(const_cast<KLepton*>(originalLeptons[*electron]), product.m_genParticleMatchedLeptons.Get(), product.m_genTauMatchedLeptons.Get());
 				if (genParticle)
 				{
 					genMatchingCode = GeneratorInfo::GetGenMatchingCode(genParticle);
@@ -60,26 +71,30 @@ void ElectronCorrectionsProducer::Produce(event_type const& event, product_type&
 		// perform possible analysis-specific corrections
 		if (!settings.GetCorrectOnlyRealElectrons() || (settings.GetCorrectOnlyRealElectrons() && isRealElectron))
 		{
-			AdditionalCorrections(electron->get(), event, product, settings, metadata);
+			AdditionalCorrections(*electron, event, product, settings, metadata);
 		}
 
 		// make sure to also save the corrected lepton and the matched genParticle in the map
 		// if we match genParticles to all leptons
 		if (settings.GetRecoElectronMatchingGenParticleMatchAllElectrons())
 		{
-			product.m_genParticleMatchedElectrons[electron->get()] =  &(*product.m_genParticleMatchedElectrons[static_cast<KElectron*>(const_cast<KLepton*>(product.m_originalLeptons[electron->get()]))]);
-			product.m_genParticleMatchedLeptons[electron->get()] = &(*product.m_genParticleMatchedLeptons[const_cast<KLepton*>(product.m_originalLeptons[electron->get()])]);
+			std::map<KElectron*, KGenParticle*>& genParticleMatchedElectrons = product.m_genParticleMatchedElectrons.GetMutable();
+			std::map<KLepton*, KGenParticle*>& genParticleMatchedLeptons = product.m_genParticleMatchedLeptons.GetMutable();
+			genParticleMatchedElectrons[*electron] = genParticleMatchedElectrons[static_cast<KElectron*>(const_cast<KLepton*>(originalLeptons[*electron]))];
+			genParticleMatchedLeptons[*electron] = genParticleMatchedLeptons[const_cast<KLepton*>(originalLeptons[*electron])];
 		}
 		if (settings.GetMatchAllElectronsGenTau())
 		{
-			product.m_genTauMatchedElectrons[electron->get()] = &(*product.m_genTauMatchedElectrons[static_cast<KElectron*>(const_cast<KLepton*>(product.m_originalLeptons[electron->get()]))]);
-			product.m_genTauMatchedLeptons[electron->get()] = &(*product.m_genTauMatchedLeptons[const_cast<KLepton*>(product.m_originalLeptons[electron->get()])]);
+			std::map<KElectron*, KGenTau*>& genTauMatchedElectrons = product.m_genTauMatchedElectrons.GetMutable();
+			std::map<KLepton*, KGenTau*>& genTauMatchedLeptons = product.m_genTauMatchedLeptons.GetMutable();
+			genTauMatchedElectrons[*electron] = genTauMatchedElectrons[static_cast<KElectron*>(const_cast<KLepton*>(originalLeptons[*electron]))];
+			genTauMatchedLeptons[*electron] = genTauMatchedLeptons[const_cast<KLepton*>(originalLeptons[*electron])];
 		}
 	}
 	
 	// sort vectors of corrected electrons by pt
-	std::sort(product.m_correctedElectrons.begin(), product.m_correctedElectrons.end(),
-	          [](std::shared_ptr<KElectron> electron1, std::shared_ptr<KElectron> electron2) -> bool
+	std::sort(correctedElectrons.begin(), correctedElectrons.end(),
+	          [](KElectron const* electron1, KElectron const* electron2) -> bool
 	          { return electron1->p4.Pt() > electron2->p4.Pt(); });
 }
 
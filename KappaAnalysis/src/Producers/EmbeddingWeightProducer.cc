@@ -6,11 +6,18 @@ std::string EmbeddingWeightProducer::GetProducerId() const {
 	return "EmbeddingWeightProducer";
 }
 
+void EmbeddingWeightProducer::Init(setting_type const& settings, metadata_type& metadata)
+{
+	KappaProducerBase::Init(settings, metadata);
+
+	m_embeddingWeightIndex = EventWeights::GetIndex("embeddingWeight");
+}
+
 void EmbeddingWeightProducer::Produce(event_type const& event, product_type& product,
                                       setting_type const& settings, metadata_type const& metadata) const
 {
 	assert(event.m_eventInfo);
 
-	product.m_weights["embeddingWeight"] = event.m_eventInfo->minVisPtFilterWeight;
+	product.m_weights.Set(m_embeddingWeightIndex, event.m_eventInfo->minVisPtFilterWeight);
 }
 
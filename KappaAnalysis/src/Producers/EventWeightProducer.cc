@@ -23,27 +23,24 @@ void EventWeightProducer::Init(setting_type const& settings, metadata_type& meta
 {
 	ProducerBase<KappaTypes>::Init(settings, metadata);
 	pipelineName = settings.GetName();
+	m_eventWeightIndex = EventWeights::GetIndex(settings.GetEventWeight());
 }
 
 void EventWeightProducer::Produce(event_type const& event, product_type& product,
                                   setting_type const& settings, metadata_type const& metadata) const
 {
-	double eventWeight = settings.GetBaseWeight();
-	bool firstRun = m_weightNames.empty();
+	// multiply all previously calculated weights
+	double eventWeight = settings.GetBaseWeight() * product.m_weights.GetProduct();
 
-	// loop over all previously calculated weights and multiply them
-	for(std::map<std::string, double>::const_iterator weight = product.m_weights.begin();
-		weight != product.m_weights.end(); ++weight)
+	if (m_weightNames.empty())
 	{
-		eventWeight *= weight->second;
-		
-		if (firstRun)
+		for (size_t weightIndex : product.m_weights.GetIndices())
 		{
-			m_weightNames.push_back(weight->first);
+			m_weightNames.push_back(EventWeights::GetName(weightIndex));
 		}
 	}
 
-	product.m_weights[settings.GetEventWeight()] = eventWeight;
+	product.m_weights.Set(m_eventWeightIndex, eventWeight);
 }
 
 
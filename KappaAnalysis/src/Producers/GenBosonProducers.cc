@@ -9,6 +9,11 @@ std::string GenBosonFromGenParticlesProducer::GetProducerId() const {
 	return "GenBosonFromGenParticlesProducer";
 }
 
+void GenBosonFromGenParticlesProducer::GetRequiredEventMembers(std::set<std::string>& eventMembers) const
+{
+	eventMembers.insert("GenParticles");
+}
+
 void GenBosonFromGenParticlesProducer::Init(setting_type const& settings, metadata_type& metadata)
 {
 	ProducerBase<KappaTypes>::Init(settings, metadata);
@@ -6,6 +6,11 @@ std::string GenMuonFSRProducer::GetProducerId() const{
 	return "GenMuonFSRProducer";
 }
 
+void GenMuonFSRProducer::GetRequiredEventMembers(std::set<std::string>& eventMembers) const
+{
+	eventMembers.insert("GenParticles");
+}
+
 void GenMuonFSRProducer::Init(setting_type const& settings, metadata_type& metadata)
 {
 	KappaProducerBase::Init(settings, metadata);
@@ -31,7 +36,7 @@ void GenMuonFSRProducer::Produce(event_type const& event, product_type& product,
 	     validMuon != product.m_validMuons.end(); ++validMuon)
 	{
 		//Look for matched genMuon
-		KGenParticle* currentGenParticle = SafeMap::GetWithDefault((product.m_genParticleMatchedMuons), *validMuon, (KGenParticle*)(0));
+		KGenParticle* currentGenParticle = SafeMap::GetWithDefault(product.m_genParticleMatchedMuons.Get(), *validMuon, (KGenParticle*)(0));
 		float sumMuonFSRPt = 0;
 		//for ordered readout
 		if (currentGenParticle != 0)
@@ -12,11 +12,17 @@ std::string RecoJetGenParticleMatchingProducer::GetProducerId() const {
 	return "RecoJetGenParticleMatchingProducer";
 }
 
+void RecoJetGenParticleMatchingProducer::GetRequiredEventMembers(std::set<std::string>& eventMembers) const
+{
+	eventMembers.insert("GenParticles");
+}
+
 void RecoJetGenParticleMatchingProducer::Init(setting_type const& settings, metadata_type& metadata)
 {
 	KappaProducerBase::Init(settings, metadata);
 
 	m_jetMatchingAlgorithm = ToJetMatchingAlgorithm(boost::algorithm::to_lower_copy(boost::algorithm::trim_copy(settings.GetJetMatchingAlgorithm())));
+	m_genParticlesIndex = DeltaRIndex(std::max(0.1f, settings.GetDeltaRMatchingRecoJetGenParticle()));
 }
 
 void RecoJetGenParticleMatchingProducer::Produce(event_type const& event, product_type& product,
@@ -26,14 +32,16 @@ void RecoJetGenParticleMatchingProducer::Produce(event_type const& event, produc
 
 	if (settings.GetDeltaRMatchingRecoJetGenParticle() > 0.0f)
 	{
+		m_genParticlesIndex.Build(*event.m_genParticles);
+
 		// loop over all valid objects (jets) to check
 		for (std::vector<KBasicJet*>::iterator validJet = product.m_validJets.begin();
 			 validJet != product.m_validJets.end();)
 		{
-			KGenParticle* matchedParticle = RecoJetGenParticleMatchingProducer::Match(event, product, settings, static_cast<KLV*>(*validJet), m_jetMatchingAlgorithm);
+			KGenParticle* matchedParticle = RecoJetGenParticleMatchingProducer::Match(event, product, settings, static_cast<KLV*>(*validJet), m_jetMatchingAlgorithm, m_genParticlesIndex);
 			if (matchedParticle != nullptr)
 			{
-				product.m_genParticleMatchedJets[*validJet] = matchedParticle;
+				product.m_genParticleMatchedJets.GetMutable()[*validJet] = matchedParticle;
 			}
 
 			// invalidate (non) matching jets if requested
@@ -59,9 +67,32 @@ void RecoJetGenParticleMatchingProducer::Produce(event_type const& event, produc
 	}
 }
 
-// This is the actual reco jet gen particle matcher
 KGenParticle* RecoJetGenParticleMatchingProducer::Match(event_type const& event, product_type const& product,
                                                         setting_type const& settings, KLV* const recoJet, JetMatchingAlgorithm jetMatchingAlgorithm)
+{
+	std::vector<size_t> genParticleIndices(event.m_genParticles->size());
+	for (size_t genParticleIndex = 0; genParticleIndex < genParticleIndices.size(); ++genParticleIndex)
+	{
+		genParticleIndices[genParticleIndex] = genParticleIndex;
+	}
+	return Match(event, settings, recoJet, jetMatchingAlgorithm, genParticleIndices);
+}
+
+KGenParticle* RecoJetGenParticleMatchingProducer::Match(event_type const& event, product_type const& product,
+                                                        setting_type const& settings, KLV* const recoJet, JetMatchingAlgorithm jetMatchingAlgorithm,
+                                                        DeltaRIndex const& genParticlesIndex)
+{
+	// the candidates are processed in the order of the collection, as in the loop over all gen particles
+	std::vector<size_t> genParticleIndices;
+	genParticlesIndex.ForEachCandidate(recoJet->p4.Eta(), recoJet->p4.Phi(), settings.GetDeltaRMatchingRecoJetGenParticle(),
+	                                   [&genParticleIndices](size_t genParticleIndex) { genParticleIndices.push_back(genParticleIndex); });
+	std::sort(genParticleIndices.begin(), genParticleIndices.end());
+	return Match(event, settings, recoJet, jetMatchingAlgorithm, genParticleIndices);
+}
+
+// This is the actual reco jet gen particle matcher
+KGenParticle* RecoJetGenParticleMatchingProducer::Match(event_type const& event, setting_type const& settings, KLV* const recoJet,
+                                                        JetMatchingAlgorithm jetMatchingAlgorithm, std::vector<size_t> const& genParticleIndices)
 {
 	float deltaR = 0.0;
 	size_t nMatchingAlgoPartons = 0;
@@ -71,10 +102,10 @@ KGenParticle* RecoJetGenParticleMatchingProducer::Match(event_type const& event,
 	KGenParticle* hardestBQuark = nullptr;
 	KGenParticle* hardestCQuark = nullptr;
 
-	// loop over all genParticles 
-	for (std::vector<KGenParticle>::iterator genParticle = event.m_genParticles->begin();
-	     genParticle != event.m_genParticles->end(); ++genParticle)
+	// loop over all (candidate) genParticles
+	for (size_t genParticleIndex : genParticleIndices)
 	{
+		std::vector<KGenParticle>::iterator genParticle = event.m_genParticles->begin() + genParticleIndex;
 		// only use genParticles with id 21, 1, -1, 2, -2, 3, -3, 4, -4, 5, -5
 		if ((std::abs(genParticle->pdgId) == 1) ||
 		    (std::abs(genParticle->pdgId) == 2) ||
@@ -191,6 +222,11 @@ std::string RecoElectronGenParticleMatchingProducer::GetProducerId() const {
 	return "RecoElectronGenParticleMatchingProducer";
 }
 
+void RecoElectronGenParticleMatchingProducer::GetRequiredEventMembers(std::set<std::string>& eventMembers) const
+{
+	eventMembers.insert({ "Electrons", "GenParticles" });
+}
+
 RecoElectronGenParticleMatchingProducer::RecoElectronGenParticleMatchingProducer() :
 	RecoLeptonGenParticleMatchingProducerBase<KElectron>(&product_type::m_genParticleMatchedElectrons,
 	                                                     &event_type::m_electrons,
@@ -210,6 +246,11 @@ std::string RecoMuonGenParticleMatchingProducer::GetProducerId() const {
 	return "RecoMuonGenParticleMatchingProducer";
 }
 
+void RecoMuonGenParticleMatchingProducer::GetRequiredEventMembers(std::set<std::string>& eventMembers) const
+{
+	eventMembers.insert({ "Muons", "GenParticles" });
+}
+
 RecoMuonGenParticleMatchingProducer::RecoMuonGenParticleMatchingProducer() :
 	RecoLeptonGenParticleMatchingProducerBase<KMuon>(&product_type::m_genParticleMatchedMuons,
 	                                                 &event_type::m_muons,
@@ -229,6 +270,11 @@ std::string RecoTauGenParticleMatchingProducer::GetProducerId() const {
 	return "RecoTauGenParticleMatchingProducer";
 }
 
+void RecoTauGenParticleMatchingProducer::GetRequiredEventMembers(std::set<std::string>& eventMembers) const
+{
+	eventMembers.insert({ "Taus", "GenParticles" });
+}
+
 RecoTauGenParticleMatchingProducer::RecoTauGenParticleMatchingProducer() :
 	RecoLeptonGenParticleMatchingProducerBase<KTau>(&product_type::m_genParticleMatchedTaus,
 	                                                &event_type::m_taus,
@@ -6,6 +6,11 @@ std::string GenParticleProducer::GetProducerId() const{
 	return "GenParticleProducer";
 }
 
+void GenParticleProducer::GetRequiredEventMembers(std::set<std::string>& eventMembers) const
+{
+	eventMembers.insert("GenParticles");
+}
+
 void GenParticleProducer::Init(setting_type const& settings, metadata_type& metadata)
 {
 	KappaProducerBase::Init(settings, metadata);
@@ -7,6 +7,11 @@ std::string GenPartonCounterProducer::GetProducerId() const {
 	return "GenPartonCounterProducer";
 }
 
+void GenPartonCounterProducer::GetRequiredEventMembers(std::set<std::string>& eventMembers) const
+{
+	eventMembers.insert("GenParticles");
+}
+
 void GenPartonCounterProducer::Init(setting_type const& settings, metadata_type& metadata)
 {
 	ProducerBase<KappaTypes>::Init(settings, metadata);
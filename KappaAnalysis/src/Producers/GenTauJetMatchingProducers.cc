@@ -6,6 +6,11 @@ std::string RecoElectronGenTauJetMatchingProducer::GetProducerId() const {
 	return "RecoElectronGenTauJetMatchingProducer";
 }
 
+void RecoElectronGenTauJetMatchingProducer::GetRequiredEventMembers(std::set<std::string>& eventMembers) const
+{
+	eventMembers.insert("GenTauJets");
+}
+
 RecoElectronGenTauJetMatchingProducer::RecoElectronGenTauJetMatchingProducer() :
 	GenTauJetMatchingProducerBase<KElectron>(&product_type::m_genTauJetMatchedElectrons,
 	                                         &product_type::m_validElectrons,
@@ -22,6 +27,11 @@ std::string RecoMuonGenTauJetMatchingProducer::GetProducerId() const {
 	return "RecoMuonGenTauJetMatchingProducer";
 }
 
+void RecoMuonGenTauJetMatchingProducer::GetRequiredEventMembers(std::set<std::string>& eventMembers) const
+{
+	eventMembers.insert("GenTauJets");
+}
+
 RecoMuonGenTauJetMatchingProducer::RecoMuonGenTauJetMatchingProducer() :
 	GenTauJetMatchingProducerBase<KMuon>(&product_type::m_genTauJetMatchedMuons,
 	                                     &product_type::m_validMuons,
@@ -38,6 +48,11 @@ std::string RecoTauGenTauJetMatchingProducer::GetProducerId() const {
 	return "RecoTauGenTauJetMatchingProducer";
 }
 
+void RecoTauGenTauJetMatchingProducer::GetRequiredEventMembers(std::set<std::string>& eventMembers) const
+{
+	eventMembers.insert("GenTauJets");
+}
+
 RecoTauGenTauJetMatchingProducer::RecoTauGenTauJetMatchingProducer() :
 	GenTauJetMatchingProducerBase<KTau>(&product_type::m_genTauJetMatchedTaus,
 	                                    &product_type::m_validTaus,
@@ -5,6 +5,11 @@ std::string GenTauJetProducer::GetProducerId() const{
 	return "GenTauJetProducer";
 }
 
+void GenTauJetProducer::GetRequiredEventMembers(std::set<std::string>& eventMembers) const
+{
+	eventMembers.insert("GenTauJets");
+}
+
 void GenTauJetProducer::Init(setting_type const& settings, metadata_type& metadata)
 {
 	KappaProducerBase::Init(settings, metadata);
@@ -6,6 +6,11 @@ std::string RecoElectronGenTauMatchingProducer::GetProducerId() const {
 	return "RecoElectronGenTauMatchingProducer";
 }
 
+void RecoElectronGenTauMatchingProducer::GetRequiredEventMembers(std::set<std::string>& eventMembers) const
+{
+	eventMembers.insert({ "Electrons", "GenTaus" });
+}
+
 RecoElectronGenTauMatchingProducer::RecoElectronGenTauMatchingProducer() :
 	GenTauMatchingProducerBase<KElectron>(&product_type::m_genTauMatchedElectrons,
 	                                      &event_type::m_electrons,
@@ -25,6 +30,11 @@ std::string RecoMuonGenTauMatchingProducer::GetProducerId() const {
 	return "RecoMuonGenTauMatchingProducer";
 }
 
+void RecoMuonGenTauMatchingProducer::GetRequiredEventMembers(std::set<std::string>& eventMembers) const
+{
+	eventMembers.insert({ "Muons", "GenTaus" });
+}
+
 RecoMuonGenTauMatchingProducer::RecoMuonGenTauMatchingProducer() :
 	GenTauMatchingProducerBase<KMuon>(&product_type::m_genTauMatchedMuons,
 	                                  &event_type::m_muons,
@@ -44,6 +54,11 @@ std::string RecoTauGenTauMatchingProducer::GetProducerId() const {
 	return "RecoTauGenTauMatchingProducer";
 }
 
+void RecoTauGenTauMatchingProducer::GetRequiredEventMembers(std::set<std::string>& eventMembers) const
+{
+	eventMembers.insert({ "Taus", "GenTaus" });
+}
+
 RecoTauGenTauMatchingProducer::RecoTauGenTauMatchingProducer() :
 	GenTauMatchingProducerBase<KTau>(&product_type::m_genTauMatchedTaus,
 	                                 &event_type::m_taus,
@@ -6,6 +6,13 @@ std::string GeneratorWeightProducer::GetProducerId() const {
 	return "GeneratorWeightProducer";
 }
 
+void GeneratorWeightProducer::Init(setting_type const& settings, metadata_type& metadata)
+{
+	KappaProducerBase::Init(settings, metadata);
+
+	m_generatorWeightIndex = EventWeights::GetIndex("generatorWeight");
+}
+
 void GeneratorWeightProducer::Produce(event_type const& event, product_type& product,
                                       setting_type const& settings, metadata_type const& metadata) const
 {
@@ -19,12 +26,12 @@ void GeneratorWeightProducer::Produce(event_type const& event, product_type& pro
 
 		// store this weight, normalizing it to the sum of weights (positive and negative) 
 		// computed before any selection is applied
-		product.m_weights["generatorWeight"] = (weight / settings.GetGeneratorWeight());
+		product.m_weights.Set(m_generatorWeightIndex, (weight / settings.GetGeneratorWeight()));
 	}
 	// otherwise retrieve it, on an event-basis, from the input file
 	else
 	{
-		product.m_weights["generatorWeight"] = event.m_genEventInfo->weight;
+		product.m_weights.Set(m_generatorWeightIndex, event.m_genEventInfo->weight);
 	}
 }
 
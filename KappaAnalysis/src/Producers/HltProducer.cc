@@ -10,6 +10,8 @@ void HltProducer::Init(setting_type const& settings, metadata_type& metadata)
 {
 	KappaProducerBase::Init(settings, metadata);
 	
+	m_hltPrescaleWeightIndex = EventWeights::GetIndex("hltPrescaleWeight");
+
 	// add possible quantities for the lambda ntuples consumers
 	LambdaNtupleConsumer<KappaTypes>::AddIntQuantity(metadata, "nSelectedHltPaths", [](event_type const& event, product_type const& product)
 	{
@@ -65,12 +67,12 @@ void HltProducer::Produce(event_type const& event, product_type& product,
 			}
 			
 			// look for (unprescaled if requested) fired trigger
-			if (event.m_eventInfo->hltFired(hltName, event.m_lumiInfo) && (settings.GetAllowPrescaledTrigger() || (prescale <= 1)))
+			// do not use hltName here as a parameter because *hltPath is already cached.
+			size_t hltPosition = m_hltInfo.getHLTPosition(*hltPath);
+			if (event.m_eventInfo->hltFired(hltPosition) && (settings.GetAllowPrescaledTrigger() || (prescale <= 1)))
 			{
 				product.m_selectedHltNames.push_back(hltName);
-				
-				// do not use hltName here as a parameter because *hltPath is already cached.
-				product.m_selectedHltPositions.push_back(static_cast<int>(m_hltInfo.getHLTPosition(*hltPath)));
+				product.m_selectedHltPositions.push_back(static_cast<int>(hltPosition));
 				
 				product.m_selectedHltPrescales.push_back(prescale);
 				if ((prescale < lowestSelectedPrescale) && (prescale > 0))
@@ -98,5 +100,5 @@ void HltProducer::Produce(event_type const& event, product_type& product,
 	}
 
 	// TODO: how to define the HLT prescale eventweight when more than one HLT fires? The product of them? The min. or max. value? Maybe overwrite it later?
-	product.m_weights["hltPrescaleWeight"] = lowestSelectedPrescale;
+	product.m_weights.Set(m_hltPrescaleWeightIndex, lowestSelectedPrescale);
 }
@@ -12,6 +12,11 @@ std::string JetCorrectionsProducer::GetProducerId() const {
 	return "JetCorrectionsProducer";
 }
 
+void JetCorrectionsProducer::GetRequiredEventMembers(std::set<std::string>& eventMembers) const
+{
+	eventMembers.insert({ "BasicJets", "PileupDensity", "VertexSummary" });
+}
+
 
 TaggedJetCorrectionsProducer::TaggedJetCorrectionsProducer() :
 	JetCorrectionsProducerBase<KJet>(&event_type::m_tjets,
@@ -23,3 +28,8 @@ std::string TaggedJetCorrectionsProducer::GetProducerId() const {
 	return "TaggedJetCorrectionsProducer";
 }
 
+void TaggedJetCorrectionsProducer::GetRequiredEventMembers(std::set<std::string>& eventMembers) const
+{
+	eventMembers.insert({ "TaggedJets", "PileupDensity", "VertexSummary" });
+}
+
@@ -11,6 +11,11 @@ std::string LHEParticlesProducer::GetProducerId() const {
 	return "LHEParticlesProducer";
 }
 
+void LHEParticlesProducer::GetRequiredEventMembers(std::set<std::string>& eventMembers) const
+{
+	eventMembers.insert("LheParticles");
+}
+
 void LHEParticlesProducer::Init(setting_type const& settings, metadata_type& metadata)
 {
 	ProducerBase<KappaTypes>::Init(settings, metadata);
@@ -6,9 +6,16 @@ std::string LuminosityWeightProducer::GetProducerId() const {
 	return "LuminosityWeightProducer";
 }
 
+void LuminosityWeightProducer::Init(setting_type const& settings, metadata_type& metadata)
+{
+	KappaProducerBase::Init(settings, metadata);
+
+	m_luminosityWeightIndex = EventWeights::GetIndex("luminosityWeight");
+}
+
 void LuminosityWeightProducer::Produce(event_type const& event, product_type& product,
                                        setting_type const& settings, metadata_type const& metadata) const
 {
-	product.m_weights["luminosityWeight"] = (1.0 / static_cast<double>(settings.GetIntLuminosity()));
+	product.m_weights.Set(m_luminosityWeightIndex, (1.0 / static_cast<double>(settings.GetIntLuminosity())));
 }
 
@@ -9,13 +9,13 @@ void MatchedLeptonsProducer::Produce(event_type const& event, product_type& prod
                                      setting_type const& settings, metadata_type const& metadata) const
 {
 	// start with empty vectors
-	product.m_genParticleMatchedLeptons.clear();
+	std::map<KLepton*, KGenParticle*>& genParticleMatchedLeptons = product.m_genParticleMatchedLeptons.Reset();
 
-	product.m_genParticleMatchedLeptons.insert(product.m_genParticleMatchedElectrons.begin(), product.m_genParticleMatchedElectrons.end());
+	genParticleMatchedLeptons.insert(product.m_genParticleMatchedElectrons->begin(), product.m_genParticleMatchedElectrons->end());
 
-	product.m_genParticleMatchedLeptons.insert(product.m_genParticleMatchedMuons.begin(), product.m_genParticleMatchedMuons.end());
+	genParticleMatchedLeptons.insert(product.m_genParticleMatchedMuons->begin(), product.m_genParticleMatchedMuons->end());
 
-	product.m_genParticleMatchedLeptons.insert(product.m_genParticleMatchedTaus.begin(), product.m_genParticleMatchedTaus.end());
+	genParticleMatchedLeptons.insert(product.m_genParticleMatchedTaus->begin(), product.m_genParticleMatchedTaus->end());
 
 
 	//Maybe create inverse map 
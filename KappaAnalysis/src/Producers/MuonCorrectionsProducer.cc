@@ -20,9 +20,19 @@ std::string MuonCorrectionsProducer::GetProducerId() const {
 	return "MuonCorrectionsProducer";
 }
 
+void MuonCorrectionsProducer::GetRequiredEventMembers(std::set<std::string>& eventMembers) const
+{
+	eventMembers.insert("Muons");
+	if (m_useUWGenMatching)
+	{
+		eventMembers.insert("GenParticles");
+	}
+}
+
 void MuonCorrectionsProducer::Init(setting_type const& settings, metadata_type& metadata) 
 {
 	KappaProducerBase::Init(settings, metadata);
+	m_useUWGenMatching = (settings.GetCorrectOnlyRealMuons() && settings.GetUseUWGenMatching());
 	muonEnergyCorrection = ToMuonEnergyCorrection(boost::algorithm::to_lower_copy(boost::algorithm::trim_copy(settings.GetMuonEnergyCorrection())));
 	if (muonEnergyCorrection == MuonEnergyCorrection::ROCHCORR2015)
 	{
@@ -41,21 +51,28 @@ void MuonCorrectionsProducer::Produce(event_type const& event, product_type& pro
 {
 	assert(event.m_muons);
 
-	// create a copy of all muons in the event
-	product.m_correctedMuons.clear();
-	product.m_correctedMuons.resize(event.m_muons->size());
+	// create a copy of all muons in the event (deleted at the end of the event)
+	std::vector<KMuon*>& correctedMuons = product.m_correctedMuons.Reset();
+	std::map<const KLepton*, const KLepton*>& originalLeptons = product.m_originalLeptons.GetMutable();
+	correctedMuons.resize(event.m_muons->size());
 	size_t muonIndex = 0;
 	for (KMuons::const_iterator muon = event.m_muons->begin();
 		 muon != event.m_muons->end(); ++muon)
 	{
-		product.m_correctedMuons[muonIndex] = std::shared_ptr<KMuon>(new KMuon(*muon));
-		product.m_originalLeptons[product.m_correctedMuons[muonIndex].get()] = &(*muon);
+		correctedMuons[muonIndex] = product.m_correctedObjectsArena.Create<KMuon>(*muon);
+		originalLeptons[correctedMuons[muonIndex]] = &(*muon);
 		++muonIndex;
 	}
 	
+	// the Rochester corrections are evaluated for all muons at once
+	if (muonEnergyCorrection == MuonEnergyCorrection::ROCHCORR2016)
+	{
+		ComputeRochesterCorrections2016(product, settings);
+	}
+
 	// perform corrections on copied muons
-	for (std::vector<std::shared_ptr<KMuon> >::iterator muon = product.m_correctedMuons.begin();
-		 muon != product.m_correctedMuons.end(); ++muon)
+	for (std::vector<KMuon*>::iterator muon = correctedMuons.begin();
+		 muon != correctedMuons.end(); ++muon)
 	{
 		// Check whether corrections should be applied at all
 		bool isRealMuon = false;
@@ -64,11 +81,11 @@ void MuonCorrectionsProducer::Produce(event_type const& event, product_type& pro
 			KappaEnumTypes::GenMatchingCode genMatchingCode = KappaEnumTypes::GenMatchingCode::NONE;
 			if (settings.GetUseUWGenMatching())
 			{
-				genMatchingCode = GeneratorInfo::GetGenMatchingCodeUW(event, const_cast<KLepton*>(product.m_originalLeptons[muon->get()]));
+				genMatchingCode = GeneratorInfo::GetGenMatchingCodeUW(event, const_cast<KLepton*>(originalLeptons[*muon]));
 			}
 			else
 			{
-				KGenParticle* genParticle = GeneratorInfo::GetGenMatchedParticle(const_cast<KLepton*>(product.m_originalLeptons[muon->get()]), product.m_genParticleMatchedLeptons, product.m_genTauMatchedLeptons);
+				KGenParticle* genParticle = GeneratorInfo::GetGenMatchedParticle(const_cast<KLepton*>(originalLeptons[*muon]), product.m_genParticleMatchedLeptons.Get(), product.m_genTauMatchedLeptons.Get());
 				if (genParticle)
 				{
 					genMatchingCode = GeneratorInfo::GetGenMatchingCode(genParticle);
@@ -85,70 +102,41 @@ void MuonCorrectionsProducer::Produce(event_type const& event, product_type& pro
 		// perform possible analysis-specific corrections
 		if (muonEnergyCorrection == MuonEnergyCorrection::FALL2015)
 		{
-		muon->get()->p4 = muon->get()->p4 * (1.0);
+		(*muon)->p4 = (*muon)->p4 * (1.0);
 		}
 		else if (muonEnergyCorrection == MuonEnergyCorrection::ROCHCORR2015)
 		{
 			TLorentzVector mu;
-			mu.SetPtEtaPhiM(muon->get()->p4.Pt(),muon->get()->p4.Eta(),muon->get()->p4.Phi(),muon->get()->p4.mass());
+			mu.SetPtEtaPhiM((*muon)->p4.Pt(),(*muon)->p4.Eta(),(*muon)->p4.Phi(),(*muon)->p4.mass());
 	
-			int q = muon->get()->charge();
+			int q = (*muon)->charge();
 			float qter = 1.0;
 	
 			if (settings.GetInputIsData())
 			{
 				rmcor2015->momcor_data(mu, q, 0, qter);
-				muon->get()->p4.SetPxPyPzE(mu.Px(),mu.Py(),mu.Pz(),mu.E());
+				(*muon)->p4.SetPxPyPzE(mu.Px(),mu.Py(),mu.Pz(),mu.E());
 			}
 			else
 			{
-			int ntrk = muon->get()->track.nPixelLayers + muon->get()->track.nStripLayers; // TODO: this corresponds to reco::HitPattern::trackerLayersWithMeasurementOld(). update to "new" impleme	ntation also in Kappa
+			int ntrk = (*muon)->track.nPixelLayers + (*muon)->track.nStripLayers; // TODO: this corresponds to reco::HitPattern::trackerLayersWithMeasurementOld(). update to "new" impleme	ntation also in Kappa
 				rmcor2015->momcor_mc(mu, q, ntrk, qter);
-				muon->get()->p4.SetPxPyPzE(mu.Px(),mu.Py(),mu.Pz(),mu.E());
+				(*muon)->p4.SetPxPyPzE(mu.Px(),mu.Py(),mu.Pz(),mu.E());
 			}
 		}
 		else if (muonEnergyCorrection == MuonEnergyCorrection::ROCHCORR2016)
 		{
-			int q = muon->get()->charge();
-			float pt = muon->get()->p4.Pt();
-			float eta = muon->get()->p4.Eta();
-			float phi = muon->get()->p4.Phi();
-
-			float scaleFactor = 1.0;
-
-			if (settings.GetInputIsData())
-			{
-				scaleFactor = rmcor2016->kScaleDT(q, pt, eta, phi);
-			}
-			else
-			{
-				int ntrk = muon->get()->track.nPixelLayers + muon->get()->track.nStripLayers; // TODO: this corresponds to reco::HitPattern::trackerLayersWithMeasurementOld(). update to "new" implementation also in Kappa
-				if (settings.GetRecoMuonMatchingGenParticleMatchAllMuons() &&
-					&(*product.m_genParticleMatchedMuons[static_cast<KMuon*>(const_cast<KLepton*>(product.m_originalLeptons[muon->get()]))]) != nullptr
-					)
-				{
-					KGenParticle* genMuon = &(*product.m_genParticleMatchedMuons[static_cast<KMuon*>(const_cast<KLepton*>(product.m_originalLeptons[muon->get()]))]);
-					float genPt = genMuon->p4.Pt();
-					double u1 = random->Rndm();
-					scaleFactor = rmcor2016->kScaleFromGenMC(q, pt, eta, phi, ntrk, genPt, u1);
-				}
-				else
-				{
-					double u1 = random->Rndm();
-					double u2 = random->Rndm();
-					scaleFactor = rmcor2016->kScaleAndSmearMC(q, pt, eta, phi, ntrk, u1, u2);
-				}
-			}
+			float scaleFactor = m_rochesterScaleFactors[muon - correctedMuons.begin()];
 
 			// scale only three dimensional momentum
 			// -> need to manually calculate energy
 			float muonMass = 0.105658;
-			float scaledPx = muon->get()->p4.Px() * scaleFactor;
-			float scaledPy = muon->get()->p4.Py() * scaleFactor;
-			float scaledPz = muon->get()->p4.Pz() * scaleFactor;
+			float scaledPx = (*muon)->p4.Px() * scaleFactor;
+			float scaledPy = (*muon)->p4.Py() * scaleFactor;
+			float scaledPz = (*muon)->p4.Pz() * scaleFactor;
 			float scaledE = TMath::Sqrt(TMath::Power(scaledPx,2) + TMath::Power(scaledPy,2) + TMath::Power(scaledPz,2) + TMath::Power(muonMass,2));
 
-			muon->get()->p4.SetPxPyPzE(scaledPx, scaledPy, scaledPz, scaledE);
+			(*muon)->p4.SetPxPyPzE(scaledPx, scaledPy, scaledPz, scaledE);
 		}
 		else if (muonEnergyCorrection != MuonEnergyCorrection::NONE)
 		{
@@ -157,30 +145,87 @@ void MuonCorrectionsProducer::Produce(event_type const& event, product_type& pro
 
 		if (!settings.GetCorrectOnlyRealMuons() || (settings.GetCorrectOnlyRealMuons() && isRealMuon))
 		{
-			AdditionalCorrections(muon->get(), event, product, settings, metadata);
+			AdditionalCorrections(*muon, event, product, settings, metadata);
 		}
 		
 		// make sure to also save the corrected lepton and the matched genParticle in the map
 		// if we match genParticles to all leptons
 		if (settings.GetRecoMuonMatchingGenParticleMatchAllMuons())
 		{
-			product.m_genParticleMatchedMuons[muon->get()] =  &(*product.m_genParticleMatchedMuons[static_cast<KMuon*>(const_cast<KLepton*>(product.m_originalLeptons[muon->get()]))]);
-			product.m_genParticleMatchedLeptons[muon->get()] = &(*product.m_genParticleMatchedLeptons[const_cast<KLepton*>(product.m_originalLeptons[muon->get()])]);
+			std::map<KMuon*, KGenParticle*>& genParticleMatchedMuons = product.m_genParticleMatchedMuons.GetMutable();
+			std::map<KLepton*, KGenParticle*>& genParticleMatchedLeptons = product.m_genParticleMatchedLeptons.GetMutable();
+			genParticleMatchedMuons[*muon] = genParticleMatchedMuons[static_cast<KMuon*>(const_cast<KLepton*>(originalLeptons[*muon]))];
+			genParticleMatchedLeptons[*muon] = genParticleMatchedLeptons[const_cast<KLepton*>(originalLeptons[*muon])];
 		}
 		if (settings.GetMatchAllMuonsGenTau())
 		{
-			product.m_genTauMatchedMuons[muon->get()] = &(*product.m_genTauMatchedMuons[static_cast<KMuon*>(const_cast<KLepton*>(product.m_originalLeptons[muon->get()]))]);
-			product.m_genTauMatchedLeptons[muon->get()] = &(*product.m_genTauMatchedLeptons[const_cast<KLepton*>(product.m_originalLeptons[muon->get()])]);
+			std::map<KMuon*, KGenTau*>& genTauMatchedMuons = product.m_genTauMatchedMuons.GetMutable();
+			std::map<KLepton*, KGenTau*>& genTauMatchedLeptons = product.m_genTauMatchedLeptons.GetMutable();
+			genTauMatchedMuons[*muon] = genTauMatchedMuons[static_cast<KMuon*>(const_cast<KLepton*>(originalLeptons[*muon]))];
+			genTauMatchedLeptons[*muon] = genTauMatchedLeptons[const_cast<KLepton*>(originalLeptons[*muon])];
 		}
 	}
 	
 	// sort vectors of corrected muons by pt
-	std::sort(product.m_correctedMuons.begin(), product.m_correctedMuons.end(),
-	          [](std::shared_ptr<KMuon> muon1, std::shared_ptr<KMuon> muon2) -> bool
+	std::sort(correctedMuons.begin(), correctedMuons.end(),
+	          [](KMuon const* muon1, KMuon const* muon2) -> bool
 	          { return muon1->p4.Pt() > muon2->p4.Pt(); });
 }
 
 
+void MuonCorrectionsProducer::ComputeRochesterCorrections2016(product_type& product, setting_type const& settings) const
+{
+	std::vector<KMuon*> const& correctedMuons = product.m_correctedMuons.Get();
+	m_rochesterMuons.resize(correctedMuons.size());
+	for (size_t muonIndex = 0; muonIndex < correctedMuons.size(); ++muonIndex)
+	{
+		KMuon* muon = correctedMuons[muonIndex];
+		RocMuon2016& rochesterMuon = m_rochesterMuons[muonIndex];
+		rochesterMuon.Q = muon->charge();
+		rochesterMuon.pt = static_cast<float>(muon->p4.Pt());
+		rochesterMuon.eta = static_cast<float>(muon->p4.Eta());
+		rochesterMuon.phi = static_cast<float>(muon->p4.Phi());
+		rochesterMuon.n = 0;
+		rochesterMuon.genMatched = false;
+		rochesterMuon.gt = 0.0;
+		rochesterMuon.u = 0.0;
+		rochesterMuon.w = 0.0;
+
+		if (! settings.GetInputIsData())
+		{
+			rochesterMuon.n = muon->track.nPixelLayers + muon->track.nStripLayers; // TODO: this corresponds to reco::HitPattern::trackerLayersWithMeasurementOld(). update to "new" implementation also in Kappa
+
+			// the random numbers are drawn in the order of the muons, as for the correction of single muons
+			KGenParticle* genMuon = nullptr;
+			if (settings.GetRecoMuonMatchingGenParticleMatchAllMuons())
+			{
+				KMuon* originalMuon = static_cast<KMuon*>(const_cast<KLepton*>(SafeMap::Get(product.m_originalLeptons.Get(), static_cast<const KLepton*>(muon))));
+				genMuon = SafeMap::GetWithDefault(product.m_genParticleMatchedMuons.Get(), originalMuon, static_cast<KGenParticle*>(nullptr));
+			}
+			if (genMuon != nullptr)
+			{
+				rochesterMuon.genMatched = true;
+				rochesterMuon.gt = static_cast<float>(genMuon->p4.Pt());
+				rochesterMuon.w = random->Rndm();
+			}
+			else
+			{
+				rochesterMuon.u = random->Rndm();
+				rochesterMuon.w = random->Rndm();
+			}
+		}
+	}
+
+	if (settings.GetInputIsData())
+	{
+		rmcor2016->kScaleDT(m_rochesterMuons, m_rochesterScaleFactors);
+	}
+	else
+	{
+		rmcor2016->kScaleAndSmearMC(m_rochesterMuons, m_rochesterScaleFactors);
+	}
+}
+
 // Can be overwritten for analysis-specific use cases
 void MuonCorrectionsProducer::AdditionalCorrections(KMuon* muon, event_type const& event, product_type& product,
                                                     setting_type const& settings, metadata_type const& metadata) const
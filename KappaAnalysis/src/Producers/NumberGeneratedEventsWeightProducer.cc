@@ -6,9 +6,16 @@ std::string NumberGeneratedEventsWeightProducer::GetProducerId() const {
 	return "NumberGeneratedEventsWeightProducer";
 }
 
+void NumberGeneratedEventsWeightProducer::Init(setting_type const& settings, metadata_type& metadata)
+{
+	KappaProducerBase::Init(settings, metadata);
+
+	m_numberGeneratedEventsWeightIndex = EventWeights::GetIndex("numberGeneratedEventsWeight");
+}
+
 void NumberGeneratedEventsWeightProducer::Produce(event_type const& event, product_type & product,
                                                   setting_type const& settings, metadata_type const& metadata) const
 {
-	product.m_weights["numberGeneratedEventsWeight"] = (1.0 / settings.GetNumberGeneratedEvents());
+	product.m_weights.Set(m_numberGeneratedEventsWeightIndex, (1.0 / settings.GetNumberGeneratedEvents()));
 }
 
@@ -1,4 +1,7 @@
 
+#include <map>
+#include <mutex>
+
 #include "TH1.h"
 
 #include "Artus/KappaAnalysis/interface/Producers/PUWeightProducer.h"
@@ -11,31 +14,51 @@ std::string PUWeightProducer::GetProducerId() const {
 void PUWeightProducer::Init(setting_type const& settings, metadata_type& metadata) {
 	KappaProducerBase::Init(settings, metadata);
 
+	m_pileupWeights = GetPileupWeights(settings.GetPileupWeightFile());
+	m_puWeightIndex = EventWeights::GetIndex("puWeight");
+}
+
+void PUWeightProducer::Produce(event_type const& event, product_type& product,
+                               setting_type const& settings, metadata_type const& metadata) const
+{
+	assert(event.m_genEventInfo != nullptr);
+
+	unsigned int puBin = static_cast<unsigned int>(static_cast<double>(event.m_genEventInfo->nPUMean) * m_pileupWeights->m_bins);
+	if (puBin < m_pileupWeights->m_weights.size())
+		product.m_weights.Set(m_puWeightIndex, m_pileupWeights->m_weights[puBin]);
+	else
+		product.m_weights.Set(m_puWeightIndex, 1.0);
+}
+
+std::shared_ptr<const PUWeightProducer::PileupWeights> PUWeightProducer::GetPileupWeights(std::string const& pileupWeightFile)
+{
+	// the producers of all pipelines (and pipeline runners) are initialised with the same file
+	static std::mutex pileupWeightsMutex;
+	static std::map<std::string, std::weak_ptr<const PileupWeights> > pileupWeightsByFile;
+
+	std::lock_guard<std::mutex> lock(pileupWeightsMutex);
+	std::shared_ptr<const PileupWeights> pileupWeights = pileupWeightsByFile[pileupWeightFile].lock();
+	if (pileupWeights)
+	{
+		return pileupWeights;
+	}
+
 	const std::string histogramName = "pileup";
 	LOG(DEBUG) << "\tLoading pile-up weights from files...";
-	LOG(DEBUG) << "\t\t" << settings.GetPileupWeightFile() << "/" << histogramName;
-	TFile file(settings.GetPileupWeightFile().c_str(), "READONLY");
+	LOG(DEBUG) << "\t\t" << pileupWeightFile << "/" << histogramName;
+	TFile file(pileupWeightFile.c_str(), "READONLY");
 	TH1D* pileupHistogram = dynamic_cast<TH1D*>(file.Get(histogramName.c_str()));
 
-	m_pileupWeights.clear();
+	std::shared_ptr<PileupWeights> newPileupWeights = std::make_shared<PileupWeights>();
+	newPileupWeights->m_weights.reserve(pileupHistogram->GetNbinsX());
 	for (int i = 1; i <= pileupHistogram->GetNbinsX(); ++i)
 	{
-		m_pileupWeights.push_back(pileupHistogram->GetBinContent(i));
+		newPileupWeights->m_weights.push_back(pileupHistogram->GetBinContent(i));
 	}
-	m_bins = 1.0 / pileupHistogram->GetBinWidth(1);
+	newPileupWeights->m_bins = 1.0 / pileupHistogram->GetBinWidth(1);
 	delete pileupHistogram;
 	file.Close();
-}
-
-void PUWeightProducer::Produce(event_type const& event, product_type& product,
-                               setting_type const& settings, metadata_type const& metadata) const
-{
-	assert(event.m_genEventInfo != nullptr);
 
-	unsigned int puBin = static_cast<unsigned int>(static_cast<double>(event.m_genEventInfo->nPUMean) * m_bins);
-	if (puBin < m_pileupWeights.size())
-		product.m_weights["puWeight"] = m_pileupWeights.at(puBin);
-	else
-		product.m_weights["puWeight"] = 1.0;
+	pileupWeightsByFile[pileupWeightFile] = newPileupWeights;
+	return newPileupWeights;
 }
-
@@ -10,6 +10,11 @@ std::string PrintGenParticleDecayTreeProducer::GetProducerId() const
 	return "PrintGenParticleDecayTreeProducer";
 }
 
+void PrintGenParticleDecayTreeProducer::GetRequiredEventMembers(std::set<std::string>& eventMembers) const
+{
+	eventMembers.insert({ "GenParticles", "LheParticles" });
+}
+
 void PrintGenParticleDecayTreeProducer::Init(setting_type const& settings, metadata_type& metadata)
 {
 	KappaProducerBase::Init(settings, metadata);
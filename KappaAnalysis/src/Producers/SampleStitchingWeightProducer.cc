@@ -22,6 +22,10 @@ void SampleStitchingWeightProducer::Init(setting_type const& settings, metadata_
 			Utility::ParseVectorToMap(settings.GetStitchingWeightsHighMass()),
 			stitchingWeightsHighMassByName
 	);
+
+	m_crossSectionPerEventWeightIndex = EventWeights::GetIndex("crossSectionPerEventWeight");
+	m_numberGeneratedEventsWeightIndex = EventWeights::GetIndex("numberGeneratedEventsWeight");
+	m_sampleStitchingWeightIndex = EventWeights::GetIndex("sampleStitchingWeight");
 }
 
 void SampleStitchingWeightProducer::Produce(event_type const& event, product_type & product,
@@ -29,34 +33,38 @@ void SampleStitchingWeightProducer::Produce(event_type const& event, product_typ
 {
 	assert(event.m_genEventInfo != nullptr);
 	
-	if (! Utility::Contains(product.m_weights, std::string("crossSectionPerEventWeight")))
+	if (! product.m_weights.Contains(m_crossSectionPerEventWeightIndex))
 	{
 		LOG(FATAL) << "Cross section not available or 0. Make sure that CrossSectionWeightProducer is run before SampleStitchingWeightProducer!";
 	}
-	if (! Utility::Contains(product.m_weights, std::string("numberGeneratedEventsWeight")))
+	if (! product.m_weights.Contains(m_numberGeneratedEventsWeightIndex))
 	{
 		LOG(FATAL) << "Number of generated events not available or 0. Make sure that NumberGeneratedEventsWeightProducer is run before SampleStitchingWeightProducer!";
 	}
 	
 	size_t nPartons = event.m_genEventInfo->lheNOutPartons >= 5 ? 0 : event.m_genEventInfo->lheNOutPartons;
 
+	double sampleStitchingWeight = 1.0;
+
 	// take overlap of phase space into account for DY samples with M50 & M150
 	if ((product.m_genBosonLV.mass() >= 150.0) && (stitchingWeightsHighMassByIndex.size() > 0))
 	{
 		// DYJetsToLL_M150 currently only simulated with Z->tautau
 		if (fabs(product.m_genLeptonsFromBosonDecay.at(0)->pdgId) == 15 && fabs(product.m_genLeptonsFromBosonDecay.at(1)->pdgId) == 15)
 		{
-			product.m_weights["sampleStitchingWeight"] = SafeMap::Get(stitchingWeightsHighMassByIndex, nPartons).at(0);
+			sampleStitchingWeight = SafeMap::Get(stitchingWeightsHighMassByIndex, nPartons).at(0);
 		}
 		else
 		{
-			product.m_weights["sampleStitchingWeight"] = SafeMap::Get(stitchingWeightsByIndex, nPartons).at(0);
+			sampleStitchingWeight = SafeMap::Get(stitchingWeightsByIndex, nPartons).at(0);
 		}
 	}
 	else
 	{
-		product.m_weights["sampleStitchingWeight"] = SafeMap::Get(stitchingWeightsByIndex, nPartons).at(0);
+		sampleStitchingWeight = SafeMap::Get(stitchingWeightsByIndex, nPartons).at(0);
 	}
 	
-	product.m_weights["sampleStitchingWeight"] /= (product.m_weights["numberGeneratedEventsWeight"] * product.m_weights["crossSectionPerEventWeight"]);
+	sampleStitchingWeight /= (product.m_weights.GetWithDefault(m_numberGeneratedEventsWeightIndex, 1.0) *
+	                          product.m_weights.GetWithDefault(m_crossSectionPerEventWeightIndex, 1.0));
+	product.m_weights.Set(m_sampleStitchingWeightIndex, sampleStitchingWeight);
 }
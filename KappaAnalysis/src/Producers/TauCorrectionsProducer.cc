@@ -7,9 +7,19 @@ std::string TauCorrectionsProducer::GetProducerId() const {
 	return "TauCorrectionsProducer";
 }
 
+void TauCorrectionsProducer::GetRequiredEventMembers(std::set<std::string>& eventMembers) const
+{
+	eventMembers.insert("Taus");
+	if (m_useUWGenMatching)
+	{
+		eventMembers.insert("GenParticles");
+	}
+}
+
 void TauCorrectionsProducer::Init(setting_type const& settings, metadata_type& metadata)
 {
 	KappaProducerBase::Init(settings, metadata);
+	m_useUWGenMatching = (settings.GetCorrectOnlyRealTaus() && settings.GetUseUWGenMatching());
 }
 
 void TauCorrectionsProducer::Produce(event_type const& event, product_type& product,
@@ -17,21 +27,22 @@ void TauCorrectionsProducer::Produce(event_type const& event, product_type& prod
 {
 	assert(event.m_taus);
 	
-	// create a copy of all taus in the event
-	product.m_correctedTaus.clear();
-	product.m_correctedTaus.resize(event.m_taus->size());
+	// create a copy of all taus in the event (deleted at the end of the event)
+	std::vector<KTau*>& correctedTaus = product.m_correctedTaus.Reset();
+	std::map<const KLepton*, const KLepton*>& originalLeptons = product.m_originalLeptons.GetMutable();
+	correctedTaus.resize(event.m_taus->size());
 	size_t tauIndex = 0;
 	for (KTaus::const_iterator tau = event.m_taus->begin();
 		 tau != event.m_taus->end(); ++tau)
 	{
-		product.m_correctedTaus[tauIndex] = std::shared_ptr<KTau>(new KTau(*tau));
-		product.m_originalLeptons[product.m_correctedTaus[tauIndex].get()] = &(*tau);
+		correctedTaus[tauIndex] = product.m_correctedObjectsArena.Create<KTau>(*tau);
+		originalLeptons[correctedTaus[tauIndex]] = &(*tau);
 		++tauIndex;
 	}
 	
 	// perform corrections on copied taus
-	for (std::vector<std::shared_ptr<KTau> >::iterator tau = product.m_correctedTaus.begin();
-		 tau != product.m_correctedTaus.end(); ++tau)
+	for (std::vector<KTau*>::iterator tau = correctedTaus.begin();
+		 tau != correctedTaus.end(); ++tau)
 	{
 		// Check whether corrections should be applied at all
 		bool isRealTau = false;
@@ -40,11 +51,11 @@ void TauCorrectionsProducer::Produce(event_type const& event, product_type& prod
 			KappaEnumTypes::GenMatchingCode genMatchingCode = KappaEnumTypes::GenMatchingCode::NONE;
 			if (settings.GetUseUWGenMatching())
 			{
-				genMatchingCode = GeneratorInfo::GetGenMatchingCodeUW(event, const_cast<KLepton*>(product.m_originalLeptons[tau->get()]));
+				genMatchingCode = GeneratorInfo::GetGenMatchingCodeUW(event, const_cast<KLepton*>(originalLeptons[*tau]));
 			}
 			else
 			{
-				KGenParticle* genParticle = GeneratorInfo::GetGenMatchedParticle(const_cast<KLepton*>(product.m_originalLeptons[tau->get()]), product.m_genParticleMatchedLeptons, product.m_genTauMatchedLeptons);
+				KGenParticle* genParticle = GeneratorInfo::GetGenMatchedParticle(const_cast<KLepton*>(originalLeptons[*tau]), product.m_genParticleMatchedLeptons.Get(), product.m_genTauMatchedLeptons.Get());
 				if (genParticle)
 				{
 					genMatchingCode = GeneratorInfo::GetGenMatchingCode(genParticle);
@@ -62,26 +73,30 @@ void TauCorrectionsProducer::Produce(event_type const& event, product_type& prod
 		// perform possible analysis-specific corrections
 		if (!settings.GetCorrectOnlyRealTaus() || (settings.GetCorrectOnlyRealTaus() && isRealTau))
 		{
-			AdditionalCorrections(tau->get(), event, product, settings, metadata);
+			AdditionalCorrections(*tau, event, product, settings, metadata);
 		}
 
 		// make sure to also save the corrected lepton and the matched genParticle in the map
 		// if we match genParticles to all leptons
 		if (settings.GetRecoTauMatchingGenParticleMatchAllTaus())
 		{
-			product.m_genParticleMatchedTaus[tau->get()] =  &(*product.m_genParticleMatchedTaus[static_cast<KTau*>(const_cast<KLepton*>(product.m_originalLeptons[tau->get()]))]);
-			product.m_genParticleMatchedLeptons[tau->get()] = &(*product.m_genParticleMatchedLeptons[const_cast<KLepton*>(product.m_originalLeptons[tau->get()])]);
+			std::map<KTau*, KGenParticle*>& genParticleMatchedTaus = product.m_genParticleMatchedTaus.GetMutable();
+			std::map<KLepton*, KGenParticle*>& genParticleMatchedLeptons = product.m_genParticleMatchedLeptons.GetMutable();
+			genParticleMatchedTaus[*tau] = genParticleMatchedTaus[static_cast<KTau*>(const_cast<KLepton*>(originalLeptons[*tau]))];
+			genParticleMatchedLeptons[*tau] = genParticleMatchedLeptons[const_cast<KLepton*>(originalLeptons[*tau])];
 		}
 		if (settings.GetMatchAllTausGenTau())
 		{
-			product.m_genTauMatchedTaus[tau->get()] = &(*product.m_genTauMatchedTaus[static_cast<KTau*>(const_cast<KLepton*>(product.m_originalLeptons[tau->get()]))]);
-			product.m_genTauMatchedLeptons[tau->get()] = &(*product.m_genTauMatchedLeptons[const_cast<KLepton*>(product.m_originalLeptons[tau->get()])]);
+			std::map<KTau*, KGenTau*>& genTauMatchedTaus = product.m_genTauMatchedTaus.GetMutable();
+			std::map<KLepton*, KGenTau*>& genTauMatchedLeptons = product.m_genTauMatchedLeptons.GetMutable();
+			genTauMatchedTaus[*tau] = genTauMatchedTaus[static_cast<KTau*>(const_cast<KLepton*>(originalLeptons[*tau]))];
+			genTauMatchedLeptons[*tau] = genTauMatchedLeptons[const_cast<KLepton*>(originalLeptons[*tau])];
 		}
 	}
 	
 	// sort vectors of corrected taus by pt
-	std::sort(product.m_correctedTaus.begin(), product.m_correctedTaus.end(),
-	          [](std::shared_ptr<KTau> tau1, std::shared_ptr<KTau> tau2) -> bool
+	std::sort(correctedTaus.begin(), correctedTaus.end(),
+	          [](KTau const* tau1, KTau const* tau2) -> bool
 	          { return tau1->p4.Pt() > tau2->p4.Pt(); });
 }
 
@@ -7,6 +7,11 @@ std::string ElectronTriggerMatchingProducer::GetProducerId() const
 	return "ElectronTriggerMatchingProducer";
 }
 
+void ElectronTriggerMatchingProducer::GetRequiredEventMembers(std::set<std::string>& eventMembers) const
+{
+	eventMembers.insert({ "TriggerInfos", "TriggerObjects" });
+}
+
 ElectronTriggerMatchingProducer::ElectronTriggerMatchingProducer() :
 	TriggerMatchingProducerBase<KElectron>(&product_type::m_triggerMatchedElectrons,
 	                                       &product_type::m_detailedTriggerMatchedElectrons,
@@ -31,8 +36,8 @@ void ElectronTriggerMatchingProducer::Produce(event_type const& event, product_t
 		product.m_triggerMatchedLeptons[&(*(it->first))] = &(*(it->second));
 	}
 	
-	for (std::map<KElectron*, std::map<std::string, std::map<std::string, std::vector<KLV*> > > >::iterator it = product.m_detailedTriggerMatchedElectrons.begin();
-	     it != product.m_detailedTriggerMatchedElectrons.end(); ++it)
+	for (std::map<KElectron*, std::map<std::string, std::map<std::string, std::vector<KLV*> > > >::const_iterator it = product.m_detailedTriggerMatchedElectrons.Get().begin();
+	     it != product.m_detailedTriggerMatchedElectrons.Get().end(); ++it)
 	{
 		product.m_detailedTriggerMatchedLeptons[&(*(it->first))] = &(it->second);
 	}
@@ -44,6 +49,11 @@ std::string MuonTriggerMatchingProducer::GetProducerId() const
 	return "MuonTriggerMatchingProducer";
 }
 
+void MuonTriggerMatchingProducer::GetRequiredEventMembers(std::set<std::string>& eventMembers) const
+{
+	eventMembers.insert({ "TriggerInfos", "TriggerObjects" });
+}
+
 MuonTriggerMatchingProducer::MuonTriggerMatchingProducer() :
 	TriggerMatchingProducerBase<KMuon>(&product_type::m_triggerMatchedMuons,
 	                                   &product_type::m_detailedTriggerMatchedMuons,
@@ -68,8 +78,8 @@ void MuonTriggerMatchingProducer::Produce(event_type const& event, product_type&
 		product.m_triggerMatchedLeptons[&(*(it->first))] = &(*(it->second));
 	}
 	
-	for (std::map<KMuon*, std::map<std::string, std::map<std::string, std::vector<KLV*> > > >::iterator it = product.m_detailedTriggerMatchedMuons.begin();
-	     it != product.m_detailedTriggerMatchedMuons.end(); ++it)
+	for (std::map<KMuon*, std::map<std::string, std::map<std::string, std::vector<KLV*> > > >::const_iterator it = product.m_detailedTriggerMatchedMuons.Get().begin();
+	     it != product.m_detailedTriggerMatchedMuons.Get().end(); ++it)
 	{
 		product.m_detailedTriggerMatchedLeptons[&(*(it->first))] = &(it->second);
 	}
@@ -81,6 +91,11 @@ std::string TauTriggerMatchingProducer::GetProducerId() const
 	return "TauTriggerMatchingProducer";
 }
 
+void TauTriggerMatchingProducer::GetRequiredEventMembers(std::set<std::string>& eventMembers) const
+{
+	eventMembers.insert({ "TriggerInfos", "TriggerObjects" });
+}
+
 TauTriggerMatchingProducer::TauTriggerMatchingProducer() :
 	TriggerMatchingProducerBase<KTau>(&product_type::m_triggerMatchedTaus,
 	                                  &product_type::m_detailedTriggerMatchedTaus,
@@ -105,8 +120,8 @@ void TauTriggerMatchingProducer::Produce(event_type const& event, product_type&
 		product.m_triggerMatchedLeptons[&(*(it->first))] = &(*(it->second));
 	}
 	
-	for (std::map<KTau*, std::map<std::string, std::map<std::string, std::vector<KLV*> > > >::iterator it = product.m_detailedTriggerMatchedTaus.begin();
-	     it != product.m_detailedTriggerMatchedTaus.end(); ++it)
+	for (std::map<KTau*, std::map<std::string, std::map<std::string, std::vector<KLV*> > > >::const_iterator it = product.m_detailedTriggerMatchedTaus.Get().begin();
+	     it != product.m_detailedTriggerMatchedTaus.Get().end(); ++it)
 	{
 		product.m_detailedTriggerMatchedLeptons[&(*(it->first))] = &(it->second);
 	}
@@ -117,6 +132,11 @@ std::string JetTriggerMatchingProducer::GetProducerId() const {
 	return "JetTriggerMatchingProducer";
 }
 
+void JetTriggerMatchingProducer::GetRequiredEventMembers(std::set<std::string>& eventMembers) const
+{
+	eventMembers.insert({ "TriggerInfos", "TriggerObjects" });
+}
+
 JetTriggerMatchingProducer::JetTriggerMatchingProducer() :
 	TriggerMatchingProducerBase<KBasicJet>(&product_type::m_triggerMatchedJets,
 	                                       &product_type::m_detailedTriggerMatchedJets,
@@ -7,9 +7,16 @@ std::string ValidBTaggedJetsProducer::GetProducerId() const {
 	return "ValidBTaggedJetsProducer";
 }
 
+void ValidBTaggedJetsProducer::GetRequiredEventMembers(std::set<std::string>& eventMembers) const
+{
+	eventMembers.insert("JetMetadata");
+}
+
 void ValidBTaggedJetsProducer::Init(setting_type const& settings, metadata_type& metadata)
 {
 	KappaProducerBase::Init(settings, metadata);
+	m_combinedSecondaryVertexIndex = MetadataIndex(settings.GetBTaggedJetCombinedSecondaryVertexName());
+
 	std::map<std::string, std::vector<float> > bTagWorkingPointsTmp = Utility::ParseMapTypes<std::string, float>(
 			Utility::ParseVectorToMap(settings.GetBTaggerWorkingPoints())
 	);
@@ -82,19 +89,65 @@ void ValidBTaggedJetsProducer::Produce(event_type const& event, product_type& pr
                                        setting_type const& settings, metadata_type const& metadata) const
 {
 	assert(event.m_jetMetadata);
+	assert(event.m_eventInfo);
 	assert(settings.GetBTagWPs().size() > 0);
 
+	if (m_metadataLumiSection.Update(event.m_eventInfo->nRun, event.m_eventInfo->nLumi))
+	{
+		m_combinedSecondaryVertexIndex.Resolve(event.m_jetMetadata->tagNames);
+	}
+
+	//entry point for Scale Factor (SF) of btagged jets
+	//https://twiki.cern.ch/twiki/bin/view/CMS/BTagSFMethods#2a_Jet_by_jet_updating_of_the_b
+	const bool promoteDemote = (settings.GetApplyBTagSF() && !settings.GetInputIsData() &&
+	                            (m_bTagSFMethod == KappaEnumTypes::BTagScaleFactorMethod::PROMOTIONDEMOTION));
+	unsigned int btagSys = BTagSF::kNo;
+	unsigned int bmistagSys = BTagSF::kNo;
+	if (promoteDemote)
+	{
+		if (settings.GetBTagShift()<0)
+			btagSys = BTagSF::kDown;
+		if (settings.GetBTagShift()>0)
+			btagSys = BTagSF::kUp;
+		if (settings.GetBMistagShift()<0)
+			bmistagSys = BTagSF::kDown;
+		if (settings.GetBMistagShift()>0)
+			bmistagSys = BTagSF::kUp;
+
+		LOG_N_TIMES(1, DEBUG) << "Btagging shifts tag/mistag : " << settings.GetBTagShift() << " " << settings.GetBMistagShift();
+
+		// the scale factors of all jets are evaluated at once for every working point
+		m_jetPts.resize(product.m_validJets.size());
+		m_jetEtas.resize(product.m_validJets.size());
+		m_jetFlavours.resize(product.m_validJets.size());
+		for (size_t jetIndex = 0; jetIndex < product.m_validJets.size(); ++jetIndex)
+		{
+			KJet* tjet = static_cast<KJet*>(product.m_validJets[jetIndex]);
+			m_jetPts[jetIndex] = tjet->p4.pt();
+			m_jetEtas[jetIndex] = tjet->p4.eta();
+			m_jetFlavours[jetIndex] = tjet->flavour;
+		}
+	}
+
 	for (std::vector<std::string>::const_iterator workingPoint = settings.GetBTagWPs().begin();
 	     workingPoint != settings.GetBTagWPs().end(); ++workingPoint)
 	{
-		for (std::vector<KBasicJet*>::iterator jet = product.m_validJets.begin();
-			jet != product.m_validJets.end(); ++jet)
+		float bTagWorkingPoint = SafeMap::Get(m_bTagWorkingPoints, *workingPoint);
+
+		BTagSF const* bTagSF = nullptr;
+		if (promoteDemote)
+		{
+			bTagSF = &(m_bTagSfMap.at(*workingPoint));
+			bTagSF->getScaleFactors(m_jetPts, m_jetEtas, m_jetFlavours, settings.GetYear(), m_bTagScaleFactors);
+		}
+
+		for (size_t jetIndex = 0; jetIndex < product.m_validJets.size(); ++jetIndex)
 		{
 			bool validBJet = true;
-			KJet* tjet = static_cast<KJet*>(*jet);
+			KJet* tjet = static_cast<KJet*>(product.m_validJets[jetIndex]);
 
-			float combinedSecondaryVertex = tjet->getTag(settings.GetBTaggedJetCombinedSecondaryVertexName(), event.m_jetMetadata);
-			float bTagWorkingPoint = SafeMap::Get(m_bTagWorkingPoints, *workingPoint);
+			float combinedSecondaryVertex = (m_combinedSecondaryVertexIndex.IsResolvedFor(tjet->tags) ? tjet->tags[m_combinedSecondaryVertexIndex.GetIndex()]
+			                                                                                          : tjet->getTag(m_combinedSecondaryVertexIndex.GetName(), event.m_jetMetadata));
 
 			if (combinedSecondaryVertex < bTagWorkingPoint ||
 				std::abs(tjet->p4.eta()) > settings.GetBTaggedJetAbsEtaCut()) {
@@ -103,46 +156,25 @@ void ValidBTaggedJetsProducer::Produce(event_type const& event, product_type& pr
 
 			validBJet = validBJet && AdditionalCriteria(tjet, event, product, settings, metadata);
 			
-			//entry point for Scale Factor (SF) of btagged jets
-			if (settings.GetApplyBTagSF() && !settings.GetInputIsData())
+			if (promoteDemote)
 			{
-				//https://twiki.cern.ch/twiki/bin/view/CMS/BTagSFMethods#2a_Jet_by_jet_updating_of_the_b
-				if (m_bTagSFMethod == KappaEnumTypes::BTagScaleFactorMethod::PROMOTIONDEMOTION) {
-				
-					int jetflavor = tjet->flavour;
-					unsigned int btagSys = BTagSF::kNo;
-					unsigned int bmistagSys = BTagSF::kNo;
-					
-					if (settings.GetBTagShift()<0)
-						btagSys = BTagSF::kDown;
-					if (settings.GetBTagShift()>0)
-						btagSys = BTagSF::kUp;
-					if (settings.GetBMistagShift()<0)
-						bmistagSys = BTagSF::kDown;
-					if (settings.GetBMistagShift()>0)
-						bmistagSys = BTagSF::kUp;
-
-					LOG_N_TIMES(1, DEBUG) << "Btagging shifts tag/mistag : " << settings.GetBTagShift() << " " << settings.GetBMistagShift(); 
-					
-					bool taggedBefore = validBJet;
-					validBJet = m_bTagSfMap.at(*workingPoint).isbtagged(
-							tjet->p4.pt(),
-							tjet->p4.eta(),
-							combinedSecondaryVertex,
-							jetflavor,
-							btagSys,
-							bmistagSys,
-							settings.GetYear(),
-							bTagWorkingPoint
-					);
-					
-					if (taggedBefore != validBJet)
-						LOG_N_TIMES(20, DEBUG) << "Promoted/demoted : " << validBJet;
-				}
+				// b-tag variations for b and c jets, mistag variations for light jets
+				int jetflavor = m_jetFlavours[jetIndex];
+				unsigned int sys = (((std::abs(jetflavor) == 5) || (std::abs(jetflavor) == 4)) ? btagSys : bmistagSys);
+
+				bool taggedBefore = validBJet;
+				validBJet = bTagSF->isbtaggedWithSF(
+						m_jetPts[jetIndex],
+						m_jetEtas[jetIndex],
+						combinedSecondaryVertex,
+						jetflavor,
+						m_bTagScaleFactors[jetIndex].get(sys),
+						settings.GetYear(),
+						bTagWorkingPoint
+				);
 				
-				else if (m_bTagSFMethod == KappaEnumTypes::BTagScaleFactorMethod::OTHER) {
-					//todo
-				}
+				if (taggedBefore != validBJet)
+					LOG_N_TIMES(20, DEBUG) << "Promoted/demoted : " << validBJet;
 			}
 
 			if (validBJet)
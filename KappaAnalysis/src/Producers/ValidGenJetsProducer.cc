@@ -19,6 +19,11 @@ std::string ValidGenJetsProducer::GetProducerId() const {
 	return "ValidGenJetsProducer";
 }
 
+void ValidGenJetsProducer::GetRequiredEventMembers(std::set<std::string>& eventMembers) const
+{
+	eventMembers.insert("GenJets");
+}
+
 void ValidGenJetsProducer::Init(KappaTypes::setting_type const& settings, KappaTypes::metadata_type& metadata)
 {
 	KappaProducerBase::Init(settings, metadata);
@@ -167,6 +167,11 @@ std::string ValidGenTausProducer::GetProducerId() const {
 	return "ValidGenTausProducer";
 }
 
+void ValidGenTausProducer::GetRequiredEventMembers(std::set<std::string>& eventMembers) const
+{
+	eventMembers.insert({ "GenTaus", "GenParticles" });
+}
+
 void ValidGenTausProducer::Init(KappaTypes::KappaTypes::setting_type const& settings, KappaTypes::KappaTypes::metadata_type& metadata)
 {
 	ValidGenParticlesProducer::Init(settings, metadata);
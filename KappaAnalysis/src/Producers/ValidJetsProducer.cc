@@ -12,6 +12,11 @@ std::string ValidJetsProducer::GetProducerId() const {
 	return "ValidJetsProducer";
 }
 
+void ValidJetsProducer::GetRequiredEventMembers(std::set<std::string>& eventMembers) const
+{
+	eventMembers.insert("BasicJets");
+}
+
 ValidTaggedJetsProducer::ValidTaggedJetsProducer() : ValidJetsProducerBase<KJet, KBasicJet>(&KappaTypes::event_type::m_tjets,
                                                                                             &KappaTypes::product_type::m_correctedTaggedJets,
                                                                                             &KappaTypes::product_type::m_validJets)
@@ -22,6 +27,11 @@ std::string ValidTaggedJetsProducer::GetProducerId() const {
 	return "ValidTaggedJetsProducer";
 }
 
+void ValidTaggedJetsProducer::GetRequiredEventMembers(std::set<std::string>& eventMembers) const
+{
+	eventMembers.insert({ "TaggedJets", "JetMetadata" });
+}
+
 void ValidTaggedJetsProducer::Init(KappaTypes::setting_type const& settings, KappaTypes::metadata_type& metadata)
 {
 	ValidJetsProducerBase<KJet, KBasicJet>::Init(settings, metadata);
@@ -41,6 +51,19 @@ void ValidTaggedJetsProducer::Init(KappaTypes::setting_type const& settings, Kap
 			jetTaggerUpperCutsByTaggerName
 	);
 	
+	for (std::map<std::string, std::vector<float> >::const_iterator jetTaggerLowerCut = jetTaggerLowerCutsByTaggerName.begin();
+	     jetTaggerLowerCut != jetTaggerLowerCutsByTaggerName.end(); ++jetTaggerLowerCut)
+	{
+		float maxLowerCut = *std::max_element(jetTaggerLowerCut->second.begin(), jetTaggerLowerCut->second.end());
+		jetTaggerLowerCuts.push_back(std::make_pair(MetadataIndex(jetTaggerLowerCut->first), maxLowerCut));
+	}
+	for (std::map<std::string, std::vector<float> >::const_iterator jetTaggerUpperCut = jetTaggerUpperCutsByTaggerName.begin();
+	     jetTaggerUpperCut != jetTaggerUpperCutsByTaggerName.end(); ++jetTaggerUpperCut)
+	{
+		float minUpperCut = *std::min_element(jetTaggerUpperCut->second.begin(), jetTaggerUpperCut->second.end());
+		jetTaggerUpperCuts.push_back(std::make_pair(MetadataIndex(jetTaggerUpperCut->first), minUpperCut));
+	}
+	
 	// add possible quantities for the lambda ntuples consumers
 	std::string bTaggedJetCSVName = settings.GetBTaggedJetCombinedSecondaryVertexName();
 	std::string bTaggedJetTCHEName = settings.GetBTaggedJetTrackCountingHighEffName();
@@ -80,14 +103,59 @@ void ValidTaggedJetsProducer::Init(KappaTypes::setting_type const& settings, Kap
 	});
 }
 
+void ValidTaggedJetsProducer::Produce(KappaTypes::event_type const& event, KappaTypes::product_type& product,
+                                      KappaTypes::setting_type const& settings, KappaTypes::metadata_type const& metadata) const
+{
+	assert(event.m_jetMetadata);
+	assert(event.m_eventInfo);
+
+	if (metadataLumiSection.Update(event.m_eventInfo->nRun, event.m_eventInfo->nLumi))
+	{
+		ResolveMetadata(event);
+	}
+
+	ValidJetsProducerBase<KJet, KBasicJet>::Produce(event, product, settings, metadata);
+}
+
+void ValidTaggedJetsProducer::ResolveMetadata(KappaTypes::event_type const& event) const
+{
+	for (std::vector<std::pair<MetadataIndex, float> >::iterator jetTaggerLowerCut = jetTaggerLowerCuts.begin();
+	     jetTaggerLowerCut != jetTaggerLowerCuts.end(); ++jetTaggerLowerCut)
+	{
+		jetTaggerLowerCut->first.Resolve(event.m_jetMetadata->tagNames);
+	}
+	for (std::vector<std::pair<MetadataIndex, float> >::iterator jetTaggerUpperCut = jetTaggerUpperCuts.begin();
+	     jetTaggerUpperCut != jetTaggerUpperCuts.end(); ++jetTaggerUpperCut)
+	{
+		jetTaggerUpperCut->first.Resolve(event.m_jetMetadata->tagNames);
+	}
+}
+
 // Can be overwritten for analysis-specific use cases
 bool ValidTaggedJetsProducer::AdditionalCriteria(KJet* jet, KappaTypes::event_type const& event, KappaTypes::product_type& product,
                                                  KappaTypes::setting_type const& settings, KappaTypes::metadata_type const& metadata) const
 {
-	return ValidTaggedJetsProducer::AdditionalCriteriaStatic(jet,
-	                                                         puJetIdsByIndex, puJetIdsByHltName,
-	                                                         jetTaggerLowerCutsByTaggerName, jetTaggerUpperCutsByTaggerName,
-	                                                         event, product, settings, metadata);
+	assert(event.m_jetMetadata);
+	
+	bool validJet = ValidJetsProducerBase<KJet, KBasicJet>::AdditionalCriteriaStatic(jet, event, product, settings, metadata);
+	validJet = validJet && ValidTaggedJetsProducer::PassPuJetIds(jet, puJetIdsByIndex, puJetIdsByHltName, event, product);
+	
+	// Jet taggers, the tags are read by the indices resolved for this lumi section
+	for (std::vector<std::pair<MetadataIndex, float> >::const_iterator jetTaggerLowerCut = jetTaggerLowerCuts.begin();
+	     jetTaggerLowerCut != jetTaggerLowerCuts.end() && validJet; ++jetTaggerLowerCut)
+	{
+		MetadataIndex const& tag = jetTaggerLowerCut->first;
+		validJet = validJet && (tag.IsResolvedFor(jet->tags) ? jet->tags[tag.GetIndex()] : jet->getTag(tag.GetName(), event.m_jetMetadata)) > jetTaggerLowerCut->second;
+	}
+	
+	for (std::vector<std::pair<MetadataIndex, float> >::const_iterator jetTaggerUpperCut = jetTaggerUpperCuts.begin();
+	     jetTaggerUpperCut != jetTaggerUpperCuts.end() && validJet; ++jetTaggerUpperCut)
+	{
+		MetadataIndex const& tag = jetTaggerUpperCut->first;
+		validJet = validJet && (tag.IsResolvedFor(jet->tags) ? jet->tags[tag.GetIndex()] : jet->getTag(tag.GetName(), event.m_jetMetadata)) < jetTaggerUpperCut->second;
+	}
+	
+	return validJet;
 }
 
 bool ValidTaggedJetsProducer::AdditionalCriteriaStatic(KJet* jet,
@@ -101,6 +169,31 @@ bool ValidTaggedJetsProducer::AdditionalCriteriaStatic(KJet* jet,
 	assert(event.m_jetMetadata);
 	
 	bool validJet = ValidJetsProducerBase<KJet, KBasicJet>::AdditionalCriteriaStatic(jet, event, product, settings, metadata);
+	validJet = validJet && ValidTaggedJetsProducer::PassPuJetIds(jet, puJetIdsByIndex, puJetIdsByHltName, event, product);
+	
+	// Jet taggers
+	for (std::map<std::string, std::vector<float> >::const_iterator jetTaggerLowerCut = jetTaggerLowerCutsByTaggerName.begin();
+	     jetTaggerLowerCut != jetTaggerLowerCutsByTaggerName.end() && validJet; ++jetTaggerLowerCut)
+	{
+		float maxLowerCut = *std::max_element(jetTaggerLowerCut->second.begin(), jetTaggerLowerCut->second.end());
+		validJet = validJet && jet->getTag(jetTaggerLowerCut->first, event.m_jetMetadata) > maxLowerCut;
+	}
+	
+	for (std::map<std::string, std::vector<float> >::const_iterator jetTaggerUpperCut = jetTaggerUpperCutsByTaggerName.begin();
+	     jetTaggerUpperCut != jetTaggerUpperCutsByTaggerName.end() && validJet; ++jetTaggerUpperCut)
+	{
+		float minUpperCut = *std::min_element(jetTaggerUpperCut->second.begin(), jetTaggerUpperCut->second.end());
+		validJet = validJet && jet->getTag(jetTaggerUpperCut->first, event.m_jetMetadata) < minUpperCut;
+	}
+	
+	return validJet;
+}
+
+bool ValidTaggedJetsProducer::PassPuJetIds(KJet* jet, std::map<size_t, std::vector<std::string> > const& puJetIdsByIndex,
+                                           std::map<std::string, std::vector<std::string> > const& puJetIdsByHltName,
+                                           KappaTypes::event_type const& event, KappaTypes::product_type const& product)
+{
+	bool validJet = true;
 	
 	// PU Jet ID
 	for (std::map<size_t, std::vector<std::string> >::const_iterator puJetIdByIndex = puJetIdsByIndex.begin();
@@ -125,21 +218,6 @@ bool ValidTaggedJetsProducer::AdditionalCriteriaStatic(KJet* jet,
 		}
 	}
 	
-	// Jet taggers
-	for (std::map<std::string, std::vector<float> >::const_iterator jetTaggerLowerCut = jetTaggerLowerCutsByTaggerName.begin();
-	     jetTaggerLowerCut != jetTaggerLowerCutsByTaggerName.end() && validJet; ++jetTaggerLowerCut)
-	{
-		float maxLowerCut = *std::max_element(jetTaggerLowerCut->second.begin(), jetTaggerLowerCut->second.end());
-		validJet = validJet && jet->getTag(jetTaggerLowerCut->first, event.m_jetMetadata) > maxLowerCut;
-	}
-	
-	for (std::map<std::string, std::vector<float> >::const_iterator jetTaggerUpperCut = jetTaggerUpperCutsByTaggerName.begin();
-	     jetTaggerUpperCut != jetTaggerUpperCutsByTaggerName.end() && validJet; ++jetTaggerUpperCut)
-	{
-		float minUpperCut = *std::min_element(jetTaggerUpperCut->second.begin(), jetTaggerUpperCut->second.end());
-		validJet = validJet && jet->getTag(jetTaggerUpperCut->first, event.m_jetMetadata) < minUpperCut;
-	}
-	
 	return validJet;
 }
 
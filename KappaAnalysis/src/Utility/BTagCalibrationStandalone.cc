@@ -2,6 +2,9 @@
 #include <iostream>
 #include <exception>
 #include <algorithm>
+#include <cctype>
+#include <cmath>
+#include <cstdlib>
 #include <sstream>
 
 
@@ -362,6 +365,228 @@ std::string BTagCalibration::token(const BTagEntry::Parameters &par)
 
 
 
+class BTagFormula::Parser
+{
+public:
+	Parser(const std::string &formula, std::vector<BTagFormula::Instruction> &program):
+		formula_(formula),
+		program_(program)
+	{}
+
+	// true if the complete formula is compiled
+	bool parse()
+	{
+		if (! parseSum()) {
+			return false;
+		}
+		skipSpaces();
+		return (pos_ == formula_.size() && stackSize_ == 1);
+	}
+
+private:
+	void skipSpaces()
+	{
+		while (pos_ < formula_.size() && std::isspace(static_cast<unsigned char>(formula_[pos_]))) {
+			++pos_;
+		}
+	}
+
+	bool consume(char c)
+	{
+		skipSpaces();
+		if (pos_ < formula_.size() && formula_[pos_] == c) {
+			++pos_;
+			return true;
+		}
+		return false;
+	}
+
+	// nArguments values are taken from the stack, the result is pushed
+	bool emit(BTagFormula::OpCode opCode, size_t nArguments, double constant=0.)
+	{
+		if (stackSize_ < nArguments) {
+			return false;
+		}
+		stackSize_ = stackSize_ - nArguments + 1;
+		if (stackSize_ > BTagFormula::maxStackSize) {
+			return false;
+		}
+		BTagFormula::Instruction instruction;
+		instruction.opCode = opCode;
+		instruction.constant = constant;
+		program_.push_back(instruction);
+		return true;
+	}
+
+	bool parseSum()
+	{
+		if (! parseProduct()) {
+			return false;
+		}
+		while (true) {
+			if (consume('+')) {
+				if (! (parseProduct() && emit(BTagFormula::OP_ADD, 2))) return false;
+			} else if (consume('-')) {
+				if (! (parseProduct() && emit(BTagFormula::OP_SUBTRACT, 2))) return false;
+			} else {
+				return true;
+			}
+		}
+	}
+
+	bool parseProduct()
+	{
+		if (! parseUnary()) {
+			return false;
+		}
+		while (true) {
+			if (consume('*')) {
+				if (! (parseUnary() && emit(BTagFormula::OP_MULTIPLY, 2))) return false;
+			} else if (consume('/')) {
+				if (! (parseUnary() && emit(BTagFormula::OP_DIVIDE, 2))) return false;
+			} else {
+				return true;
+			}
+		}
+	}
+
+	bool parseUnary()
+	{
+		if (consume('-')) {
+			return (parseUnary() && emit(BTagFormula::OP_NEGATE, 1));
+		}
+		if (consume('+')) {
+			return parseUnary();
+		}
+		return parsePrimary();
+	}
+
+	bool parsePrimary()
+	{
+		skipSpaces();
+		if (pos_ >= formula_.size()) {
+			return false;
+		}
+		if (consume('(')) {
+			return (parseSum() && consume(')'));
+		}
+
+		const char c = formula_[pos_];
+		if (std::isdigit(static_cast<unsigned char>(c)) || c == '.') {
+			const char *begin = formula_.c_str() + pos_;
+			char *end = nullptr;
+			double value = std::strtod(begin, &end);
+			if (end == begin) {
+				return false;
+			}
+			pos_ += (end - begin);
+			return emit(BTagFormula::OP_CONSTANT, 0, value);
+		}
+
+		size_t nameEnd = pos_;
+		while (nameEnd < formula_.size() &&
+		       (std::isalnum(static_cast<unsigned char>(formula_[nameEnd])) || formula_[nameEnd] == '_' || formula_[nameEnd] == ':')) {
+			++nameEnd;
+		}
+		const std::string name = formula_.substr(pos_, nameEnd - pos_);
+		pos_ = nameEnd;
+		if (name == "x") {
+			return emit(BTagFormula::OP_X, 0);
+		}
+
+		BTagFormula::OpCode opCode;
+		size_t nArguments = 1;
+		if (name == "log" || name == "TMath::Log") {
+			opCode = BTagFormula::OP_LOG;
+		} else if (name == "log10" || name == "TMath::Log10") {
+			opCode = BTagFormula::OP_LOG10;
+		} else if (name == "exp" || name == "TMath::Exp") {
+			opCode = BTagFormula::OP_EXP;
+		} else if (name == "sqrt" || name == "TMath::Sqrt") {
+			opCode = BTagFormula::OP_SQRT;
+		} else if (name == "abs" || name == "fabs" || name == "TMath::Abs") {
+			opCode = BTagFormula::OP_ABS;
+		} else if (name == "pow" || name == "TMath::Power") {
+			opCode = BTagFormula::OP_POW;
+			nArguments = 2;
+		} else if (name == "min" || name == "TMath::Min") {
+			opCode = BTagFormula::OP_MIN;
+			nArguments = 2;
+		} else if (name == "max" || name == "TMath::Max") {
+			opCode = BTagFormula::OP_MAX;
+			nArguments = 2;
+		} else {
+			return false;  // unknown name, left to TF1
+		}
+
+		if (! consume('(')) {
+			return false;
+		}
+		for (size_t argument = 0; argument < nArguments; ++argument) {
+			if ((argument > 0 && ! consume(',')) || ! parseSum()) {
+				return false;
+			}
+		}
+		return (consume(')') && emit(opCode, nArguments));
+	}
+
+	const std::string &formula_;
+	std::vector<BTagFormula::Instruction> &program_;
+	size_t pos_ = 0;
+	size_t stackSize_ = 0;
+};
+
+BTagFormula::BTagFormula(const std::string &formula, double xMin, double xMax)
+{
+	if (! compile(formula)) {
+		func_ = TF1("", formula.c_str(), xMin, xMax);
+	}
+}
+
+bool BTagFormula::compile(const std::string &formula)
+{
+	program_.clear();
+	if (! Parser(formula, program_).parse()) {
+		program_.clear();
+		return false;
+	}
+	return true;
+}
+
+double BTagFormula::Eval(double x) const
+{
+	if (program_.empty()) {
+		return func_.Eval(x);
+	}
+
+	double stack[maxStackSize];
+	size_t size = 0;
+	for (std::vector<Instruction>::const_iterator instruction = program_.begin();
+	     instruction != program_.end(); ++instruction)
+	{
+		switch (instruction->opCode) {
+			case OP_CONSTANT: stack[size++] = instruction->constant; break;
+			case OP_X:        stack[size++] = x; break;
+			case OP_ADD:      --size; stack[size-1] += stack[size]; break;
+			case OP_SUBTRACT: --size; stack[size-1] -= stack[size]; break;
+			case OP_MULTIPLY: --size; stack[size-1] *= stack[size]; break;
+			case OP_DIVIDE:   --size; stack[size-1] /= stack[size]; break;
+			case OP_NEGATE:   stack[size-1] = -stack[size-1]; break;
+			case OP_LOG:      stack[size-1] = std::log(stack[size-1]); break;
+			case OP_LOG10:    stack[size-1] = std::log10(stack[size-1]); break;
+			case OP_EXP:      stack[size-1] = std::exp(stack[size-1]); break;
+			case OP_SQRT:     stack[size-1] = std::sqrt(stack[size-1]); break;
+			case OP_ABS:      stack[size-1] = std::abs(stack[size-1]); break;
+			case OP_POW:      --size; stack[size-1] = std::pow(stack[size-1], stack[size]); break;
+			case OP_MIN:      --size; stack[size-1] = std::min(stack[size-1], stack[size]); break;
+			case OP_MAX:      --size; stack[size-1] = std::max(stack[size-1], stack[size]); break;
+		}
+	}
+	return stack[0];
+}
+
+
+
 BTagCalibrationReader::BTagCalibrationReader(const BTagCalibration* c,
 	                                           BTagEntry::OperatingPoint op,
 	                                           std::string measurementType,
@@ -382,22 +607,23 @@ double BTagCalibrationReader::eval(BTagEntry::JetFlavor jf,
 		eta = -eta;
 	}
 
-	// search linearly through eta, pt and discr ranges and eval
-	// future: find some clever data structure based on intervals
-	const std::vector<TmpEntry> &entries = tmpData_.at(jf);
-	for (unsigned i=0; i<entries.size(); ++i) {
-		const BTagCalibrationReader::TmpEntry &e = entries.at(i);
-		if (
-			e.etaMin <= eta && eta < e.etaMax                   // find eta
-			&& e.ptMin <= pt && pt < e.ptMax                    // check pt
-		){
-			if (use_discr) {                                    // discr. reshaping?
-				if (e.discrMin <= discr && discr < e.discrMax) {  // check discr
-					return e.func.Eval(discr);
-				}
-			} else {
-				return e.func.Eval(pt);
+	// find the eta and pt bin, values outside of all entries (or NaN) end up behind the last edge
+	const TmpData &data = tmpData_.at(jf);
+	const size_t iEta = std::upper_bound(data.etaEdges.begin(), data.etaEdges.end(), eta) - data.etaEdges.begin();
+	const size_t iPt = std::upper_bound(data.ptEdges.begin(), data.ptEdges.end(), pt) - data.ptEdges.begin();
+	if (iEta == 0 || iEta >= data.etaEdges.size() || iPt == 0 || iPt >= data.ptEdges.size()) {
+		return 0.;  // default value
+	}
+
+	const size_t bin = (iEta - 1) * (data.ptEdges.size() - 1) + (iPt - 1);
+	for (size_t i = data.binOffsets[bin]; i < data.binOffsets[bin + 1]; ++i) {
+		const BTagCalibrationReader::TmpEntry &e = data.entries[data.binEntries[i]];
+		if (use_discr) {                                    // discr. reshaping?
+			if (e.discrMin <= discr && discr < e.discrMax) {  // check discr
+				return e.func.Eval(discr);
 			}
+		} else {
+			return e.func.Eval(pt);
 		}
 	}
 
@@ -419,16 +645,71 @@ void BTagCalibrationReader::setupTmpData(const BTagCalibration* c)
 		te.discrMax = be.params.discrMax;
 
 		if (params.operatingPoint == BTagEntry::OP_RESHAPING) {
-			te.func = TF1("", be.formula.c_str(),
-			              be.params.discrMin, be.params.discrMax);
+			te.func = BTagFormula(be.formula, be.params.discrMin, be.params.discrMax);
 		} else {
-			te.func = TF1("", be.formula.c_str(),
-			              be.params.ptMin, be.params.ptMax);
+			te.func = BTagFormula(be.formula, be.params.ptMin, be.params.ptMax);
 		}
 
-		tmpData_[be.params.jetFlavor].push_back(te);
+		tmpData_[be.params.jetFlavor].entries.push_back(te);
 		if (te.etaMin < 0) {
 			useAbsEta[be.params.jetFlavor] = false;
 		}
 	}
+
+	for (std::map<BTagEntry::JetFlavor, TmpData>::iterator data = tmpData_.begin(); data != tmpData_.end(); ++data) {
+		setupBins(data->second);
+	}
+}
+
+void BTagCalibrationReader::setupBins(TmpData &data)
+{
+	// entries with NaN ranges never match
+	std::vector<unsigned int> validEntries;
+	for (unsigned int i = 0; i < data.entries.size(); ++i) {
+		const TmpEntry &e = data.entries[i];
+		if (e.etaMin == e.etaMin && e.etaMax == e.etaMax && e.ptMin == e.ptMin && e.ptMax == e.ptMax) {
+			validEntries.push_back(i);
+			data.etaEdges.push_back(e.etaMin);
+			data.etaEdges.push_back(e.etaMax);
+			data.ptEdges.push_back(e.ptMin);
+			data.ptEdges.push_back(e.ptMax);
+		}
+	}
+	std::sort(data.etaEdges.begin(), data.etaEdges.end());
+	data.etaEdges.erase(std::unique(data.etaEdges.begin(), data.etaEdges.end()), data.etaEdges.end());
+	std::sort(data.ptEdges.begin(), data.ptEdges.end());
+	data.ptEdges.erase(std::unique(data.ptEdges.begin(), data.ptEdges.end()), data.ptEdges.end());
+
+	const size_t nEtaBins = (data.etaEdges.empty() ? 0 : data.etaEdges.size() - 1);
+	const size_t nPtBins = (data.ptEdges.empty() ? 0 : data.ptEdges.size() - 1);
+	data.binOffsets.assign(nEtaBins * nPtBins + 1, 0);
+	data.binEntries.clear();
+
+	// an entry covers all bins between its edges, the bins are filled in the order of the entries
+	for (int pass = 0; pass < 2; ++pass) {
+		std::vector<size_t> binPositions(data.binOffsets.begin(), data.binOffsets.end() - 1);
+		for (std::vector<unsigned int>::const_iterator i = validEntries.begin(); i != validEntries.end(); ++i) {
+			const TmpEntry &e = data.entries[*i];
+			const size_t etaBegin = std::lower_bound(data.etaEdges.begin(), data.etaEdges.end(), e.etaMin) - data.etaEdges.begin();
+			const size_t etaEnd = std::lower_bound(data.etaEdges.begin(), data.etaEdges.end(), e.etaMax) - data.etaEdges.begin();
+			const size_t ptBegin = std::lower_bound(data.ptEdges.begin(), data.ptEdges.end(), e.ptMin) - data.ptEdges.begin();
+			const size_t ptEnd = std::lower_bound(data.ptEdges.begin(), data.ptEdges.end(), e.ptMax) - data.ptEdges.begin();
+			for (size_t iEta = etaBegin; iEta < etaEnd; ++iEta) {
+				for (size_t iPt = ptBegin; iPt < ptEnd; ++iPt) {
+					const size_t bin = iEta * nPtBins + iPt;
+					if (pass == 0) {
+						++data.binOffsets[bin + 1];
+					} else {
+						data.binEntries[binPositions[bin]++] = *i;
+					}
+				}
+			}
+		}
+		if (pass == 0) {
+			for (size_t bin = 0; bin < nEtaBins * nPtBins; ++bin) {
+				data.binOffsets[bin + 1] += data.binOffsets[bin];
+			}
+			data.binEntries.resize(data.binOffsets.back());
+		}
+	}
 }
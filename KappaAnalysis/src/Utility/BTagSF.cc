@@ -17,6 +17,9 @@ BTagSF::BTagSF(std::string csvfile, std::string efficiencyfile) :
 		std::cout << "BTagSF: file " << efficiencyfile << " is not found...   quitting " << std::endl;
 		exit(-1);
 	}
+	effHistos[0] = (TH2D*) effFile->Get("btag_eff_b");
+	effHistos[1] = (TH2D*) effFile->Get("btag_eff_c");
+	effHistos[2] = (TH2D*) effFile->Get("btag_eff_oth");
 
 	gDirectory = savedir;
 	gFile = savefile;
@@ -124,19 +127,7 @@ void BTagSF::initBtagwp(std::string btagwp)
 bool BTagSF::isbtagged(double pt, float eta, float csv, Int_t jetflavor,
 	                     unsigned int btagsys, unsigned int mistagsys, int year, float btagWP) const
 {
-	randm.SetSeed(static_cast<int>((eta + 5) * 100000.));
-	double randval = randm.Uniform();
-
-	float csv_WP = 0.679;
-	if(year == 2015 || year == 2016)
-		csv_WP = btagWP;
-
-	bool btagged = false;
 	double sf  = 0.0;
-	double eff = 0.0;
-
-	double promoteProb_btag = 0.0;  // ~probability to promote to tagged
-	double demoteProb_btag  = 0.0;  // ~probability to demote from tagged
 
 	// https://twiki.cern.ch/twiki/bin/view/CMSPublic/SWGuideBTagMCTools#Hadron_parton_based_jet_flavour
 	// real b-jet
@@ -151,6 +142,20 @@ bool BTagSF::isbtagged(double pt, float eta, float csv, Int_t jetflavor,
 	else
 		sf = getSFl(pt, eta, mistagsys, year);
 
+	return isbtaggedWithSF(pt, eta, csv, jetflavor, sf, year, btagWP);
+}
+
+bool BTagSF::isbtaggedWithSF(double pt, float eta, float csv, Int_t jetflavor, double sf, int year, float btagWP) const
+{
+	float csv_WP = 0.679;
+	if(year == 2015 || year == 2016)
+		csv_WP = btagWP;
+
+	bool btagged = false;
+	double eff = 0.0;
+
+	double promoteProb_btag = 0.0;  // ~probability to promote to tagged
+	double demoteProb_btag  = 0.0;  // ~probability to demote from tagged
 
 	if (sf < 1)
 	{
@@ -176,16 +181,17 @@ bool BTagSF::isbtagged(double pt, float eta, float csv, Int_t jetflavor,
 		promoteProb_btag = std::abs(sf - 1.0) / ((1.0 / eff) - 1.0);
 	}
 
+	// the random number only depends on the jet and is only drawn, if it is needed
 	if (csv > csv_WP) // if tagged
 	{
-		if (demoteProb_btag > 0. && randval < demoteProb_btag)
+		if (demoteProb_btag > 0. && getRandom(eta) < demoteProb_btag)
 			btagged = false;  // demote jet
 		else
 			btagged = true;   // remains tagged
 	}
 	else
 	{
-		if (promoteProb_btag > 0. && randval < promoteProb_btag)
+		if (promoteProb_btag > 0. && getRandom(eta) < promoteProb_btag)
 			btagged = true;   // promote jet
 		else
 			btagged = false;  // remains untagged
@@ -198,31 +204,7 @@ double BTagSF::getSFb(double pt, float eta, unsigned int btagsys, int year) cons
 {
 	if(year == 2015 || year == 2016){
 
-		float MaxBJetPt = 670.;
-		float MinBJetPt = 20.;
-		bool DoubleUncertainty = false;
-
-		if ((pt > MaxBJetPt) || (pt < MinBJetPt))
-		{
-		  DoubleUncertainty = true;
-		  if (pt > MaxBJetPt)
-				  pt = MaxBJetPt;
-		  else
-				  pt = MinBJetPt;
-		}
-
-		double jet_scalefactor = reader_mujets.eval(BTagEntry::FLAV_B, std::abs(eta), pt);
-		double jet_scalefactor_up = reader_mujets_up.eval(BTagEntry::FLAV_B, std::abs(eta), pt);
-		double jet_scalefactor_do = reader_mujets_do.eval(BTagEntry::FLAV_B, std::abs(eta), pt);
-
-		if (DoubleUncertainty) {
-		  jet_scalefactor_up = 2*(jet_scalefactor_up - jet_scalefactor) + jet_scalefactor;
-		  jet_scalefactor_do = 2*(jet_scalefactor_do - jet_scalefactor) + jet_scalefactor;
-		}
-
-		if (btagsys == kDown) return jet_scalefactor_do;
-		else if (btagsys == kUp) return jet_scalefactor_up;
-		else return jet_scalefactor;
+		return evalScaleFactor(reader_mujets, reader_mujets_up, reader_mujets_do, BTagEntry::FLAV_B, pt, eta, 20., 670., btagsys);
 	}
 	else{
 
@@ -317,31 +299,7 @@ double BTagSF::getSFc(double pt, float eta, unsigned int btagsys, int year) cons
 {
 	if(year == 2015 || year == 2016){
 
-	float MaxBJetPt = 670.;
-	float MinBJetPt = 20.;
-	bool DoubleUncertainty = false;
-
-	if ((pt > MaxBJetPt) || (pt < MinBJetPt))
-	{
-	  DoubleUncertainty = true;
-	  if (pt > MaxBJetPt)
-	          pt = MaxBJetPt;
-	  else
-	          pt = MinBJetPt;
-	}
-
-	double jet_scalefactor = reader_mujets.eval(BTagEntry::FLAV_C, std::abs(eta), pt);
-	double jet_scalefactor_up = reader_mujets_up.eval(BTagEntry::FLAV_C, std::abs(eta), pt);
-	double jet_scalefactor_do = reader_mujets_do.eval(BTagEntry::FLAV_C, std::abs(eta), pt);
-
-	if (DoubleUncertainty) {
-	  jet_scalefactor_up = 2*(jet_scalefactor_up - jet_scalefactor) + jet_scalefactor;
-	  jet_scalefactor_do = 2*(jet_scalefactor_do - jet_scalefactor) + jet_scalefactor;
-	}
-
-	if (btagsys == kDown) return jet_scalefactor_do;
-	else if (btagsys == kUp) return jet_scalefactor_up;
-	else return jet_scalefactor;
+	return evalScaleFactor(reader_mujets, reader_mujets_up, reader_mujets_do, BTagEntry::FLAV_C, pt, eta, 20., 670., btagsys);
 	}
 	else{
 
@@ -428,27 +386,8 @@ double BTagSF::getSFl(double pt, float eta, unsigned int mistagsys, int year) co
 {
 	if(year == 2015 || year == 2016){
 
-	float MaxLJetPt = 1000.;
-	bool DoubleUncertainty = false;
-
-	if (pt>MaxLJetPt)
-	{
-	  DoubleUncertainty = true;
-	  pt = MaxLJetPt;
-	}
-
-	double jet_scalefactor = reader_incl.eval(BTagEntry::FLAV_UDSG, std::abs(eta), pt);
-	double jet_scalefactor_up = reader_incl_up.eval(BTagEntry::FLAV_UDSG, std::abs(eta), pt);
-	double jet_scalefactor_do = reader_incl_do.eval(BTagEntry::FLAV_UDSG, std::abs(eta), pt);
-
-	if (DoubleUncertainty) {
-	  jet_scalefactor_up = 2*(jet_scalefactor_up - jet_scalefactor) + jet_scalefactor;
-	  jet_scalefactor_do = 2*(jet_scalefactor_do - jet_scalefactor) + jet_scalefactor;
-	}
-
-	if (mistagsys == kDown) return jet_scalefactor_do;
-	else if (mistagsys == kUp) return jet_scalefactor_up;
-	else return jet_scalefactor;
+	// no lower pt limit for light jets
+	return evalScaleFactor(reader_incl, reader_incl_up, reader_incl_do, BTagEntry::FLAV_UDSG, pt, eta, -std::numeric_limits<float>::infinity(), 1000., mistagsys);
 	}
 	else{
 
@@ -541,15 +480,15 @@ double BTagSF::getEfficiencyFromFile(int flavour, double pt, float eta) const
 
 	if (flavour == 5)
 	{
-		effHisto = (TH2D*) effFile->Get("btag_eff_b");
+		effHisto = effHistos[0];
 	}
 	else if (flavour == 4)
 	{
-		effHisto = (TH2D*) effFile->Get("btag_eff_c");
+		effHisto = effHistos[1];
 	}
 	else
 	{
-		effHisto = (TH2D*) effFile->Get("btag_eff_oth");
+		effHisto = effHistos[2];
 	}
 
 	if (pt > effHisto->GetXaxis()->GetBinLowEdge(effHisto->GetNbinsX()+1))
@@ -559,3 +498,87 @@ double BTagSF::getEfficiencyFromFile(int flavour, double pt, float eta) const
 
 	return eff;
 }
+
+void BTagSF::getScaleFactors(std::vector<double> const& pts, std::vector<float> const& etas, std::vector<int> const& jetflavors,
+                             int year, std::vector<ScaleFactor>& scaleFactors) const
+{
+	scaleFactors.resize(pts.size());
+	for (size_t jet = 0; jet < pts.size(); ++jet)
+	{
+		ScaleFactor& scaleFactor = scaleFactors[jet];
+		if (year == 2015 || year == 2016)
+		{
+			// the readers of all variations are evaluated at the same (clamped) pt
+			if (std::abs(jetflavors[jet]) == 5)
+				scaleFactor = evalScaleFactors(reader_mujets, reader_mujets_up, reader_mujets_do, BTagEntry::FLAV_B, pts[jet], etas[jet], 20., 670.);
+			else if (std::abs(jetflavors[jet]) == 4)
+				scaleFactor = evalScaleFactors(reader_mujets, reader_mujets_up, reader_mujets_do, BTagEntry::FLAV_C, pts[jet], etas[jet], 20., 670.);
+			else
+				scaleFactor = evalScaleFactors(reader_incl, reader_incl_up, reader_incl_do, BTagEntry::FLAV_UDSG, pts[jet], etas[jet], -std::numeric_limits<float>::infinity(), 1000.);
+		}
+		else
+		{
+			double (BTagSF::*getSF)(double, float, unsigned int, int) const = &BTagSF::getSFl;
+			if (std::abs(jetflavors[jet]) == 5)
+				getSF = &BTagSF::getSFb;
+			else if (std::abs(jetflavors[jet]) == 4)
+				getSF = &BTagSF::getSFc;
+
+			scaleFactor.central = (this->*getSF)(pts[jet], etas[jet], kNo, year);
+			scaleFactor.up = (this->*getSF)(pts[jet], etas[jet], kUp, year);
+			scaleFactor.down = (this->*getSF)(pts[jet], etas[jet], kDown, year);
+		}
+	}
+}
+
+double BTagSF::evalScaleFactor(BTagCalibrationReader const& reader, BTagCalibrationReader const& readerUp,
+                               BTagCalibrationReader const& readerDown, BTagEntry::JetFlavor flavour,
+                               double pt, float eta, float minPt, float maxPt, unsigned int sys)
+{
+	// outside of the calibrated pt range, the values at the limits are taken with twice the uncertainty
+	bool doubleUncertainty = ((pt > maxPt) || (pt < minPt));
+	if (pt > maxPt)
+		pt = maxPt;
+	else if (pt < minPt)
+		pt = minPt;
+
+	if ((sys != kUp) && (sys != kDown))
+		return reader.eval(flavour, std::abs(eta), pt);
+
+	double scaleFactor = ((sys == kUp) ? readerUp : readerDown).eval(flavour, std::abs(eta), pt);
+	if (doubleUncertainty)
+	{
+		double centralScaleFactor = reader.eval(flavour, std::abs(eta), pt);
+		scaleFactor = 2*(scaleFactor - centralScaleFactor) + centralScaleFactor;
+	}
+	return scaleFactor;
+}
+
+BTagSF::ScaleFactor BTagSF::evalScaleFactors(BTagCalibrationReader const& reader, BTagCalibrationReader const& readerUp,
+                                             BTagCalibrationReader const& readerDown, BTagEntry::JetFlavor flavour,
+                                             double pt, float eta, float minPt, float maxPt)
+{
+	// same treatment of the pt range as in evalScaleFactor
+	bool doubleUncertainty = ((pt > maxPt) || (pt < minPt));
+	if (pt > maxPt)
+		pt = maxPt;
+	else if (pt < minPt)
+		pt = minPt;
+
+	ScaleFactor scaleFactor;
+	scaleFactor.central = reader.eval(flavour, std::abs(eta), pt);
+	scaleFactor.up = readerUp.eval(flavour, std::abs(eta), pt);
+	scaleFactor.down = readerDown.eval(flavour, std::abs(eta), pt);
+	if (doubleUncertainty)
+	{
+		scaleFactor.up = 2*(scaleFactor.up - scaleFactor.central) + scaleFactor.central;
+		scaleFactor.down = 2*(scaleFactor.down - scaleFactor.central) + scaleFactor.central;
+	}
+	return scaleFactor;
+}
+
+double BTagSF::getRandom(float eta) const
+{
+	randm.SetSeed(static_cast<int>((eta + 5) * 100000.));
+	return randm.Uniform();
+}
@@ -0,0 +1,55 @@
+#include <algorithm>
+
+#include "Artus/KappaAnalysis/interface/Utility/MetadataIndices.h"
+
+
+MetadataIndex::MetadataIndex(std::string const& name) :
+	m_name(name)
+{
+}
+
+void MetadataIndex::Resolve(std::vector<std::string> const& metadataNames)
+{
+	std::vector<std::string>::const_iterator metadataName = std::find(metadataNames.begin(), metadataNames.end(), m_name);
+	m_resolved = (metadataName != metadataNames.end());
+	m_index = (m_resolved ? (metadataName - metadataNames.begin()) : 0);
+}
+
+
+MetadataBitMask::MetadataBitMask(std::vector<std::string> const& names) :
+	m_names(names),
+	m_unresolvedNames(names)
+{
+}
+
+void MetadataBitMask::Resolve(std::vector<std::string> const& metadataNames, size_t nBits)
+{
+	m_mask = 0;
+	m_unresolvedNames.clear();
+	for (std::vector<std::string>::const_iterator name = m_names.begin(); name != m_names.end(); ++name)
+	{
+		// the Kappa accessors take the first matching name
+		size_t index = std::find(metadataNames.begin(), metadataNames.end(), *name) - metadataNames.begin();
+		if (index < std::min(metadataNames.size(), nBits))
+		{
+			m_mask |= (1ull << index);
+		}
+		else
+		{
+			m_unresolvedNames.push_back(*name);
+		}
+	}
+}
+
+
+bool MetadataLumiSection::Update(unsigned int run, unsigned int lumi)
+{
+	if (m_valid && (run == m_run) && (lumi == m_lumi))
+	{
+		return false;
+	}
+	m_run = run;
+	m_lumi = lumi;
+	m_valid = true;
+	return true;
+}
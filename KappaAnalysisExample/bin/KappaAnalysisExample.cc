@@ -1,4 +1,8 @@
 
+#include <boost/ptr_container/ptr_vector.hpp>
+
+#include <TROOT.h>
+
 #include "Artus/Utility/interface/ArtusDefineLogging.h"
 
 #include "Artus/Configuration/interface/ArtusConfig.h"
@@ -18,13 +22,18 @@ int main(int argc, char** argv) {
 	// load the global settings from the config file
 	KappaExampleSettings settings = config.GetSettings<KappaExampleSettings>();
 
+	// ROOT needs to be prepared for several threads before the first objects are created
+	if (settings.GetNThreads() > 1)
+	{
+		ROOT::EnableThreadSafety();
+	}
+
 	// create the output root environment (which automatically saves the config into the root file)
 	RootEnvironment rootEnvironment(config);
 
 	// prepare reading the input trees
 	FileInterface2 fileInterface(config.GetInputFiles());
-	KappaEventProvider<KappaExampleTypes> eventProvider(fileInterface, (settings.GetInputIsData() ? DataInput : McInput), settings.GetBatchMode());
-	eventProvider.WireEvent(settings);
+	KappaEventProvider<KappaExampleTypes> eventProvider(fileInterface, (settings.GetInputIsData() ? DataInput : McInput), settings.GetBatchMode(), settings.GetPrefetchedEvents());
 
 	// the pipeline initializer will setup the pipeline, with
 	// all the attached Producer, Filer and Consumer
@@ -39,8 +48,40 @@ int main(int argc, char** argv) {
 	// load the pipeline with their configuration from the config file
 	config.LoadConfiguration(pipelineInitializer, pipelineRunner, factory, rootEnvironment.GetRootFile());
 
+	// every additional thread reads the input with its own event provider and runs its own replica of the pipelines
+	std::vector<KappaEventProvider<KappaExampleTypes>*> eventProviders(1, &eventProvider);
+	boost::ptr_vector<FileInterface2> replicaFileInterfaces;
+	boost::ptr_vector<KappaEventProvider<KappaExampleTypes> > replicaEventProviders;
+	for (size_t thread = 1; thread < settings.GetNThreads(); ++thread)
+	{
+		KappaExamplePipelineRunner* replicaPipelineRunner = new KappaExamplePipelineRunner(false);
+		config.LoadConfiguration(pipelineInitializer, *replicaPipelineRunner, factory, rootEnvironment.CreateReplicaFile());
+		pipelineRunner.AddReplica(replicaPipelineRunner);
+
+		replicaFileInterfaces.push_back(new FileInterface2(config.GetInputFiles()));
+		replicaEventProviders.push_back(new KappaEventProvider<KappaExampleTypes>(replicaFileInterfaces.back(), (settings.GetInputIsData() ? DataInput : McInput), settings.GetBatchMode(), settings.GetPrefetchedEvents()));
+		eventProviders.push_back(&(replicaEventProviders.back()));
+	}
+
+	// connect the input collections to the event, optionally only the ones required by the processors
+	for (KappaEventProvider<KappaExampleTypes>* provider : eventProviders)
+	{
+		if (settings.GetPruneInputBranches())
+		{
+			provider->SetRequiredEventMembers(pipelineRunner.GetRequiredEventMembers());
+		}
+		provider->WireEvent(settings);
+	}
+
 	// run all the configured pipelines
-	pipelineRunner.RunPipelines(eventProvider, settings);
+	if (eventProviders.size() > 1)
+	{
+		pipelineRunner.RunPipelinesParallel(eventProviders, settings);
+	}
+	else
+	{
+		pipelineRunner.RunPipelines(eventProvider, settings);
+	}
 
 	// save and close output root file
 	rootEnvironment.Close();
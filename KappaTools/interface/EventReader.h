@@ -0,0 +1,168 @@
+#ifndef KAPPA_EVENTREADER_H
+#define KAPPA_EVENTREADER_H
+
+#include <chrono>
+#include <condition_variable>
+#include <cstdlib>
+#include <iostream>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <typeinfo>
+#include <utility>
+#include <vector>
+
+#include <Kappa/DataFormats/interface/Kappa.h>
+
+#include "Artus/KappaTools/interface/FileInterface2.h"
+
+/*
+Reads the entries of the Events tree of a FileInterface2 (and the entries of the Lumis and Runs
+trees, whenever the lumi section or the run changes) in one long-lived thread. GetEntry waits at
+most for the given timeout, such that entries, which cannot be read (dCache, ...), are detected
+without starting a new thread for every entry.
+
+Without prefetching, an entry is read only when it is requested and the objects of the branches
+are directly used by the analysis.
+
+With nPrefetchedEvents > 0, up to this number of events are read ahead into a ring of buffers,
+while the current event is processed. The branch objects are then only used by the reader: the
+analysis gets separate objects from AddEventObject/AddLumiObject/AddRunObject, whose contents are
+swapped with the buffered ones, when the event is requested. Events are expected to be requested
+in increasing order, any other request discards the buffered events.
+*/
+class EventReader
+{
+public:
+	struct EntryInfo
+	{
+		long nBytes = 0; // result of TChain::GetEntry, 0 if the entry does not exist
+		int treeNumber = -1;
+		bool newTree = false;
+		std::string fileName; // only set for the first entry of a tree
+		bool newRun = false;
+		bool newLumisection = false;
+	};
+
+	EventReader(FileInterface2 &fileInterface, size_t nPrefetchedEvents = 0,
+	            std::chrono::minutes timeout = std::chrono::minutes(5));
+	~EventReader();
+
+	// register the object of an event, lumi or run branch (as returned by FileInterface2)
+	// and return the object to be used by the analysis
+	template<typename T>
+	T *AddEventObject(T *branchObject)
+	{
+		return AddObject(branchObject, eventObjects);
+	}
+	template<typename T>
+	T *AddLumiObject(T *branchObject)
+	{
+		return AddObject(branchObject, lumiObjects);
+	}
+	template<typename T>
+	T *AddRunObject(T *branchObject)
+	{
+		return AddObject(branchObject, runObjects);
+	}
+
+	// read an entry into the registered objects,
+	// returns nullptr if the entry could not be read within the timeout
+	EntryInfo const *GetEntry(long long entry);
+
+private:
+	struct BufferedObjectBase
+	{
+		virtual ~BufferedObjectBase() {}
+		virtual void const *GetBranchObject() const = 0;
+		virtual void *GetEventObject() = 0;
+		// branch object -> buffer of a slot
+		virtual void Store(size_t slot) = 0;
+		// buffer of a slot -> object used by the analysis
+		virtual void Load(size_t slot) = 0;
+	};
+
+	// the contents are swapped, which is cheap for the Kappa collections
+	template<typename T>
+	struct BufferedObject : public BufferedObjectBase
+	{
+		BufferedObject(T *branchObject, size_t nSlots) : branchObject(branchObject), slotObjects(nSlots) {}
+		void const *GetBranchObject() const override { return branchObject; }
+		void *GetEventObject() override { return &eventObject; }
+		void Store(size_t slot) override { std::swap(*branchObject, slotObjects[slot]); }
+		void Load(size_t slot) override { std::swap(slotObjects[slot], eventObject); }
+
+		T *branchObject;
+		std::vector<T> slotObjects;
+		T eventObject;
+	};
+
+	// tree, run and lumi section of the last entry read
+	struct Position
+	{
+		int tree = -1;
+		long run = -1;
+		long lumi = -1;
+	};
+
+	template<typename T>
+	T *AddObject(T *branchObject, std::vector<std::unique_ptr<BufferedObjectBase> > &objects)
+	{
+		if ((nPrefetchedEvents == 0) || (branchObject == nullptr))
+			return branchObject;
+
+		// the same branch may be requested several times
+		for (std::unique_ptr<BufferedObjectBase> &object : objects)
+			if (object->GetBranchObject() == branchObject)
+				return static_cast<T*>(object->GetEventObject());
+
+		// only the registered type would be buffered
+		if (typeid(*branchObject) != typeid(T))
+		{
+			std::cerr << "Branch object of type " << typeid(*branchObject).name() << " cannot be prefetched as "
+			          << typeid(T).name() << "!" << std::endl;
+			exit(1);
+		}
+
+		BufferedObject<T> *object = new BufferedObject<T>(branchObject, slotInfos.size());
+		objects.push_back(std::unique_ptr<BufferedObjectBase>(object));
+		return &(object->eventObject);
+	}
+
+	void Run();
+	bool CanReadEntry() const;
+	EntryInfo ReadEntry(long long entry, size_t slot, Position &position);
+
+	FileInterface2 &fileInterface;
+	KEventInfo *eventInfo; // branch object used by FileInterface2 to find the lumi and run entries
+	const size_t nPrefetchedEvents;
+	const std::chrono::minutes timeout;
+
+	std::vector<std::unique_ptr<BufferedObjectBase> > eventObjects;
+	std::vector<std::unique_ptr<BufferedObjectBase> > lumiObjects;
+	std::vector<std::unique_ptr<BufferedObjectBase> > runObjects;
+
+	// all members below are protected by the mutex
+	std::mutex mutex;
+	std::condition_variable condition;
+	bool stop = false;
+
+	// ring of the entries read so far: nReadSlots consecutive entries starting in firstSlot
+	std::vector<EntryInfo> slotInfos;
+	std::vector<Position> slotPositions;
+	size_t firstSlot = 0;
+	size_t nReadSlots = 0;
+	long long nextEntry = 0;
+	long long requestedEntry = -1;
+	bool endOfInput = false;
+	// incremented whenever the read entries are discarded
+	unsigned long long generation = 0;
+	Position readPosition;
+	Position currentPosition;
+	EntryInfo currentInfo;
+
+	std::thread thread;
+};
+
+#endif
@@ -27,6 +27,8 @@ public:
 	void Init(TChain* _eventdata, DataType _lumiInfoType);
 
 	void SpeedupTree(long cache = 0);
+	// Only read the branches of the event tree with an address (requested with GetEvent)
+	void PruneEventBranches();
 
 	inline long long GetEntries()
 	{
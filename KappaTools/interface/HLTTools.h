@@ -4,10 +4,13 @@
 
 #include <Kappa/DataFormats/interface/Kappa.h>
 
+#include <boost/regex.hpp>
+
 class HLTTools
 {
 private:
-	mutable std::map<std::string, std::string> nameCache;
+	mutable std::map<std::string, std::string> nameCache; // also contains the names not found in the current lumi section
+	mutable std::map<std::string, boost::regex> patternCache; // compiled patterns, independent of the lumi section
 	mutable std::map<std::string, size_t> posCache;
 	KLumiInfo * lumiInfo;
 	unsigned int currentNLumi; // trigger will not change in the same lumi section
@@ -0,0 +1,76 @@
+#ifndef KAPPA_JECBATCHRESULTS_H
+#define KAPPA_JECBATCHRESULTS_H
+
+#include <deque>
+#include <string>
+#include <vector>
+
+/*
+Corrections and uncertainties of all jets of an event, evaluated by the JECBatchEvaluator (JECTools.h).
+
+The results of an event are stored in one JECBatchResults object, which is shared by all pipelines
+processing the event (see KappaProduct::m_jetEnergyCorrectionResults). The pipelines correcting the
+same jets with the same parameters, e.g. the nominal pipeline and the pipelines shifted up and down
+by the uncertainties, therefore evaluate the corrections and the uncertainties only once per event.
+*/
+
+struct JECBatchResult
+{
+	// one entry per jet in the order of the uncorrected jets
+	std::vector<float> correction;
+	std::vector<float> uncertaintyUp;
+	std::vector<float> uncertaintyDown;
+	bool correctionsEvaluated = false;
+	bool uncertaintiesEvaluated = false;
+};
+
+class JECBatchResults
+{
+public:
+	// results for the jets with the correction and uncertainty parameters of the given names,
+	// new results take over the corrections evaluated for other uncertainty parameters
+	JECBatchResult &get(const std::string &corrections, const std::string &uncertainties, const void *jets)
+	{
+		const JECBatchResult *evaluatedCorrections = nullptr;
+		for (Entry &entry : entries)
+		{
+			if ((entry.jets == jets) && (entry.corrections == corrections))
+			{
+				if (entry.uncertainties == uncertainties)
+				{
+					return entry.result;
+				}
+				if (entry.result.correctionsEvaluated)
+				{
+					evaluatedCorrections = &(entry.result);
+				}
+			}
+		}
+
+		entries.push_back(Entry());
+		Entry &entry = entries.back();
+		entry.corrections = corrections;
+		entry.uncertainties = uncertainties;
+		entry.jets = jets;
+		if (evaluatedCorrections != nullptr)
+		{
+			entry.result.correction = evaluatedCorrections->correction;
+			entry.result.correctionsEvaluated = true;
+		}
+		return entry.result;
+	}
+
+private:
+	struct Entry
+	{
+		std::string corrections;
+		std::string uncertainties;
+		const void *jets = nullptr;
+		JECBatchResult result;
+	};
+
+	// references to the results stay valid when new results are added
+	std::deque<Entry> entries;
+};
+
+#endif
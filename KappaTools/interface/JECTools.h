@@ -6,10 +6,21 @@
 #ifndef KAPPA_JECTOOLS_H
 #define KAPPA_JECTOOLS_H
 
+#include <algorithm>
+#include <cctype>
+#include <cmath>
+#include <cstdlib>
+#include <map>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <utility>
+#include <vector>
 #include <CondFormats/JetMETObjects/interface/FactorizedJetCorrector.h>
 #include <CondFormats/JetMETObjects/interface/JetCorrectionUncertainty.h>
 #include <CondFormats/JetMETObjects/interface/JetCorrectorParameters.h>
 #include <Kappa/DataFormats/interface/Kappa.h>
+#include "Artus/KappaTools/interface/JECBatchResults.h"
 #include "Artus/KappaTools/interface/SortTools.h"
 #include "Artus/KappaTools/interface/IOHelper.h"
 #include "Artus/KappaTools/interface/Math.h"
@@ -107,6 +118,1041 @@ inline void correctJets(std::vector<T> *jets,
 	correctJets(jets, jec, unc, rho, npv, area, shift, sort);
 }
 
+// Batched correction of all jets of an event
+//
+// The JECBatchEvaluator evaluates the corrections and the uncertainties in both directions of all
+// jets of an event at once. The results are stored in a JECBatchResult, which can be shared by all
+// evaluators with the same parameters (see JECBatchResults.h), and applied to the jets in the same
+// way as by correctJets.
+//
+// With JEC tables, the binned JetCorrectorParameters are converted into flat arrays (structure of
+// arrays) and the jets pass through the correction levels together: the bins of all jets are looked
+// up, the parameters of their bins are gathered and the formula of the level is evaluated for all
+// jets at once. Without tables, or for parameters not supported by them, the corrections are
+// evaluated jet by jet by the FactorizedJetCorrector and the JetCorrectionUncertainty.
+
+// variables of the corrections and uncertainties supported by the JEC tables
+enum JECVariable { jec_eta, jec_pt, jec_energy, jec_phi, jec_area, jec_rho, jec_npv, jec_unsupported };
+
+inline JECVariable getJECVariable(const std::string &name)
+{
+	if (name == "JetEta")
+		return jec_eta;
+	else if (name == "JetPt")
+		return jec_pt;
+	else if (name == "JetE")
+		return jec_energy;
+	else if (name == "JetPhi")
+		return jec_phi;
+	else if (name == "JetA")
+		return jec_area;
+	else if (name == "Rho")
+		return jec_rho;
+	else if (name == "NPV")
+		return jec_npv;
+	return jec_unsupported;
+}
+
+// Formula of JetCorrectorParameters compiled for the evaluation of many jets at once
+//
+// The formula is translated into the program of a stack machine. Each operation is applied to the
+// values of all jets before the next one is executed. The arithmetic is done in double precision in
+// the order given by the formula, as by the FactorizedJetCorrector. Formulas with functions or
+// operators not listed in getFunction (or chained powers) are not valid.
+
+class JECFormula
+{
+public:
+	JECFormula() {}
+
+	explicit JECFormula(const std::string &formula)
+	{
+		size_t position = 0;
+		valid = parseSum(formula, position) && (skipSpaces(formula, position) == formula.size());
+		if (!valid)
+		{
+			program.clear();
+		}
+	}
+
+	bool isValid() const
+	{
+		return valid;
+	}
+
+	unsigned int getNParameters() const
+	{
+		return nParameters;
+	}
+
+	// variables[i][j] and parameters[i][j] are the values of the variable (x, y, z, t) or parameter i
+	// of jet j, missing variables are zero
+	void evaluate(const size_t nJets, const std::vector<std::vector<double> > &variables,
+		const std::vector<std::vector<double> > &parameters, std::vector<double> &stack, std::vector<double> &result) const
+	{
+		stack.resize(maxDepth * nJets);
+		size_t depth = 0;
+		for (const Instruction &instruction : program)
+		{
+			double *top = stack.data() + depth * nJets;
+			if (instruction.operation == op_constant)
+			{
+				std::fill(top, top + nJets, instruction.value);
+				++depth;
+			}
+			else if (instruction.operation == op_variable)
+			{
+				if (instruction.index < variables.size())
+					std::copy(variables[instruction.index].begin(), variables[instruction.index].begin() + nJets, top);
+				else
+					std::fill(top, top + nJets, 0.0);
+				++depth;
+			}
+			else if (instruction.operation == op_parameter)
+			{
+				std::copy(parameters[instruction.index].begin(), parameters[instruction.index].begin() + nJets, top);
+				++depth;
+			}
+			else if (instruction.operation < op_add)
+			{
+				applyUnary(instruction.operation, top - nJets, nJets);
+			}
+			else
+			{
+				applyBinary(instruction.operation, top - 2 * nJets, top - nJets, nJets);
+				--depth;
+			}
+		}
+		result.assign(stack.begin(), stack.begin() + nJets);
+	}
+
+private:
+	// values, unary operations, binary operations
+	enum Operation { op_constant, op_variable, op_parameter,
+		op_negate, op_exp, op_log, op_log10, op_sqrt, op_abs,
+		op_add, op_subtract, op_multiply, op_divide, op_power, op_max, op_min };
+
+	struct Instruction
+	{
+		Operation operation;
+		unsigned int index;
+		double value;
+	};
+
+	static void applyUnary(const Operation operation, double *values, const size_t nJets)
+	{
+		switch (operation)
+		{
+		case op_negate:
+			for (size_t jet = 0; jet < nJets; ++jet)
+				values[jet] = -values[jet];
+			break;
+		case op_exp:
+			for (size_t jet = 0; jet < nJets; ++jet)
+				values[jet] = std::exp(values[jet]);
+			break;
+		case op_log:
+			for (size_t jet = 0; jet < nJets; ++jet)
+				values[jet] = std::log(values[jet]);
+			break;
+		case op_log10:
+			for (size_t jet = 0; jet < nJets; ++jet)
+				values[jet] = std::log10(values[jet]);
+			break;
+		case op_sqrt:
+			for (size_t jet = 0; jet < nJets; ++jet)
+				values[jet] = std::sqrt(values[jet]);
+			break;
+		case op_abs:
+			for (size_t jet = 0; jet < nJets; ++jet)
+				values[jet] = std::abs(values[jet]);
+			break;
+		case op_constant:
+		case op_variable:
+		case op_parameter:
+		case op_add:
+		case op_subtract:
+		case op_multiply:
+		case op_divide:
+		case op_power:
+		case op_max:
+		case op_min:
+		default:
+			break;
+		}
+	}
+
+	static void applyBinary(const Operation operation, double *left, const double *right, const size_t nJets)
+	{
+		switch (operation)
+		{
+		case op_add:
+			for (size_t jet = 0; jet < nJets; ++jet)
+				left[jet] = left[jet] + right[jet];
+			break;
+		case op_subtract:
+			for (size_t jet = 0; jet < nJets; ++jet)
+				left[jet] = left[jet] - right[jet];
+			break;
+		case op_multiply:
+			for (size_t jet = 0; jet < nJets; ++jet)
+				left[jet] = left[jet] * right[jet];
+			break;
+		case op_divide:
+			for (size_t jet = 0; jet < nJets; ++jet)
+				left[jet] = left[jet] / right[jet];
+			break;
+		case op_power:
+			for (size_t jet = 0; jet < nJets; ++jet)
+				left[jet] = std::pow(left[jet], right[jet]);
+			break;
+		case op_max:
+			for (size_t jet = 0; jet < nJets; ++jet)
+				left[jet] = std::max(left[jet], right[jet]);
+			break;
+		case op_min:
+			for (size_t jet = 0; jet < nJets; ++jet)
+				left[jet] = std::min(left[jet], right[jet]);
+			break;
+		case op_constant:
+		case op_variable:
+		case op_parameter:
+		case op_negate:
+		case op_exp:
+		case op_log:
+		case op_log10:
+		case op_sqrt:
+		case op_abs:
+		default:
+			break;
+		}
+	}
+
+	static bool getFunction(const std::string &name, Operation &operation, size_t &nArguments)
+	{
+		static const std::map<std::string, std::pair<Operation, size_t> > functions = {
+			{ "exp", { op_exp, 1 } }, { "TMath::Exp", { op_exp, 1 } },
+			{ "log", { op_log, 1 } }, { "TMath::Log", { op_log, 1 } },
+			{ "log10", { op_log10, 1 } }, { "TMath::Log10", { op_log10, 1 } },
+			{ "sqrt", { op_sqrt, 1 } }, { "TMath::Sqrt", { op_sqrt, 1 } },
+			{ "abs", { op_abs, 1 } }, { "fabs", { op_abs, 1 } }, { "TMath::Abs", { op_abs, 1 } },
+			{ "pow", { op_power, 2 } }, { "TMath::Power", { op_power, 2 } },
+			{ "max", { op_max, 2 } }, { "TMath::Max", { op_max, 2 } },
+			{ "min", { op_min, 2 } }, { "TMath::Min", { op_min, 2 } }
+		};
+		std::map<std::string, std::pair<Operation, size_t> >::const_iterator function = functions.find(name);
+		if (function == functions.end())
+		{
+			return false;
+		}
+		operation = function->second.first;
+		nArguments = function->second.second;
+		return true;
+	}
+
+	static size_t skipSpaces(const std::string &formula, size_t &position)
+	{
+		while ((position < formula.size()) && std::isspace(static_cast<unsigned char>(formula[position])))
+		{
+			++position;
+		}
+		return position;
+	}
+
+	static bool expect(const std::string &formula, size_t &position, const char character)
+	{
+		if ((skipSpaces(formula, position) < formula.size()) && (formula[position] == character))
+		{
+			++position;
+			return true;
+		}
+		return false;
+	}
+
+	void add(const Operation operation, const unsigned int index = 0, const double value = 0.0)
+	{
+		Instruction instruction = { operation, index, value };
+		program.push_back(instruction);
+		if (operation <= op_parameter)
+		{
+			++programDepth;
+			maxDepth = std::max(maxDepth, programDepth);
+		}
+		else if (operation >= op_add)
+		{
+			--programDepth;
+		}
+	}
+
+	// sum := product (('+' | '-') product)*
+	bool parseSum(const std::string &formula, size_t &position)
+	{
+		if (!parseProduct(formula, position))
+		{
+			return false;
+		}
+		while ((skipSpaces(formula, position) < formula.size()) && ((formula[position] == '+') || (formula[position] == '-')))
+		{
+			const Operation operation = ((formula[position] == '+') ? op_add : op_subtract);
+			++position;
+			if (!parseProduct(formula, position))
+			{
+				return false;
+			}
+			add(operation);
+		}
+		return true;
+	}
+
+	// product := unary (('*' | '/') unary)*
+	bool parseProduct(const std::string &formula, size_t &position)
+	{
+		if (!parseUnary(formula, position))
+		{
+			return false;
+		}
+		while ((skipSpaces(formula, position) < formula.size()) && ((formula[position] == '*') || (formula[position] == '/')))
+		{
+			const Operation operation = ((formula[position] == '*') ? op_multiply : op_divide);
+			++position;
+			if (!parseUnary(formula, position))
+			{
+				return false;
+			}
+			add(operation);
+		}
+		return true;
+	}
+
+	// unary := ('-' | '+') unary | power
+	bool parseUnary(const std::string &formula, size_t &position)
+	{
+		if ((skipSpaces(formula, position) < formula.size()) && ((formula[position] == '-') || (formula[position] == '+')))
+		{
+			const bool negate = (formula[position] == '-');
+			++position;
+			if (!parseUnary(formula, position))
+			{
+				return false;
+			}
+			if (negate)
+			{
+				add(op_negate);
+			}
+			return true;
+		}
+		return parsePower(formula, position);
+	}
+
+	// power := primary ('^' exponent)?, exponent := ('-' | '+') exponent | primary
+	bool parsePower(const std::string &formula, size_t &position)
+	{
+		if (!parsePrimary(formula, position))
+		{
+			return false;
+		}
+		if ((skipSpaces(formula, position) < formula.size()) && (formula[position] == '^'))
+		{
+			++position;
+			if (!parseExponent(formula, position))
+			{
+				return false;
+			}
+			add(op_power);
+			// the associativity of a^b^c differs between the formula implementations
+			return ((skipSpaces(formula, position) == formula.size()) || (formula[position] != '^'));
+		}
+		return true;
+	}
+
+	bool parseExponent(const std::string &formula, size_t &position)
+	{
+		if ((skipSpaces(formula, position) < formula.size()) && ((formula[position] == '-') || (formula[position] == '+')))
+		{
+			const bool negate = (formula[position] == '-');
+			++position;
+			if (!parseExponent(formula, position))
+			{
+				return false;
+			}
+			if (negate)
+			{
+				add(op_negate);
+			}
+			return true;
+		}
+		return parsePrimary(formula, position);
+	}
+
+	// primary := number | x | y | z | t | '[' index ']' | function '(' arguments ')' | '(' sum ')'
+	bool parsePrimary(const std::string &formula, size_t &position)
+	{
+		if (skipSpaces(formula, position) == formula.size())
+		{
+			return false;
+		}
+		const unsigned char character = static_cast<unsigned char>(formula[position]);
+		if (std::isdigit(character) || (character == '.'))
+		{
+			const char *begin = formula.c_str() + position;
+			char *end = nullptr;
+			const double value = std::strtod(begin, &end);
+			if (end == begin)
+			{
+				return false;
+			}
+			position += static_cast<size_t>(end - begin);
+			add(op_constant, 0, value);
+			return true;
+		}
+		else if (character == '(')
+		{
+			++position;
+			return (parseSum(formula, position) && expect(formula, position, ')'));
+		}
+		else if (character == '[')
+		{
+			const size_t end = formula.find(']', position);
+			if ((end == std::string::npos) || (end == position + 1) || (end > position + 4) ||
+			    (formula.find_first_not_of("0123456789", position + 1) != end))
+			{
+				return false;
+			}
+			const unsigned int parameter = static_cast<unsigned int>(std::atoi(formula.substr(position + 1, end - position - 1).c_str()));
+			nParameters = std::max(nParameters, parameter + 1);
+			position = end + 1;
+			add(op_parameter, parameter);
+			return true;
+		}
+		else if (std::isalpha(character) || (character == '_'))
+		{
+			size_t end = position;
+			while ((end < formula.size()) && (std::isalnum(static_cast<unsigned char>(formula[end])) || (formula[end] == '_') || (formula[end] == ':')))
+			{
+				++end;
+			}
+			const std::string name = formula.substr(position, end - position);
+			position = end;
+
+			const std::string variables = "xyzt";
+			if ((name.size() == 1) && (variables.find(name[0]) != std::string::npos))
+			{
+				add(op_variable, static_cast<unsigned int>(variables.find(name[0])));
+				return true;
+			}
+
+			Operation operation = op_constant;
+			size_t nArguments = 0;
+			if ((!getFunction(name, operation, nArguments)) || (!expect(formula, position, '(')))
+			{
+				return false;
+			}
+			for (size_t argument = 0; argument < nArguments; ++argument)
+			{
+				if (((argument > 0) && (!expect(formula, position, ','))) || (!parseSum(formula, position)))
+				{
+					return false;
+				}
+			}
+			if (!expect(formula, position, ')'))
+			{
+				return false;
+			}
+			add(operation);
+			return true;
+		}
+		return false;
+	}
+
+	std::vector<Instruction> program;
+	bool valid = false;
+	unsigned int nParameters = 0;
+	size_t programDepth = 0; // depth of the stack after the last instruction
+	size_t maxDepth = 0;
+};
+
+// Bins of JetCorrectorParameters in structure-of-arrays form
+//
+// The bins are found as by JetCorrectorParameters::binIndex (first bin containing the jet). Bins of
+// a single variable in ascending order without overlaps are found by a binary search.
+
+struct JECBinning
+{
+	std::vector<JECVariable> variables;
+	size_t nBins = 0;
+	std::vector<float> min, max; // [variable * nBins + bin]
+	bool ordered = false;
+
+	void load(const JetCorrectorParameters &parameters, const std::vector<JECVariable> &binVariables)
+	{
+		variables = binVariables;
+		nBins = parameters.size();
+		min.resize(variables.size() * nBins);
+		max.resize(variables.size() * nBins);
+		for (size_t bin = 0; bin < nBins; ++bin)
+		{
+			for (size_t variable = 0; variable < variables.size(); ++variable)
+			{
+				min[variable * nBins + bin] = parameters.record(static_cast<unsigned int>(bin)).xMin(static_cast<unsigned int>(variable));
+				max[variable * nBins + bin] = parameters.record(static_cast<unsigned int>(bin)).xMax(static_cast<unsigned int>(variable));
+			}
+		}
+
+		ordered = (variables.size() == 1);
+		for (size_t bin = 0; ordered && (bin < nBins); ++bin)
+		{
+			ordered = ((min[bin] <= max[bin]) && ((bin == 0) || (max[bin - 1] <= min[bin])));
+		}
+	}
+
+	// bins of all jets (-1 for jets outside of all bins), values[variable][jet]
+	void findBins(const size_t nJets, const std::vector<std::vector<float> > &values, std::vector<int> &bins) const
+	{
+		bins.assign(nJets, -1);
+		if (ordered)
+		{
+			const std::vector<float> &x = values[variables[0]];
+			for (size_t jet = 0; jet < nJets; ++jet)
+			{
+				const size_t bin = static_cast<size_t>(std::upper_bound(min.begin(), min.end(), x[jet]) - min.begin());
+				if ((bin > 0) && (x[jet] < max[bin - 1]))
+				{
+					bins[jet] = static_cast<int>(bin - 1);
+				}
+			}
+			return;
+		}
+
+		for (size_t jet = 0; jet < nJets; ++jet)
+		{
+			for (size_t bin = 0; bin < nBins; ++bin)
+			{
+				bool inside = true;
+				for (size_t variable = 0; inside && (variable < variables.size()); ++variable)
+				{
+					const float x = values[variables[variable]][jet];
+					inside = ((x >= min[variable * nBins + bin]) && (x < max[variable * nBins + bin]));
+				}
+				if (inside)
+				{
+					bins[jet] = static_cast<int>(bin);
+					break;
+				}
+			}
+		}
+	}
+};
+
+// Parameters of all correction levels in structure-of-arrays form
+//
+// Only the levels with the usual chaining (the pt and the energy of the jet are scaled by the
+// correction of each level before the next level) are supported, the responses of the levels
+// L5Flavor, L7Parton, ... are left to the FactorizedJetCorrector.
+
+class JECCorrectionTables
+{
+public:
+	struct Level
+	{
+		JECBinning binning;
+		std::vector<JECVariable> parVariables;
+		std::vector<float> parMin, parMax; // [variable * nBins + bin], range of the variables of the formula
+		std::vector<double> parameters; // [parameter * nBins + bin]
+		JECFormula formula;
+	};
+
+	explicit JECCorrectionTables(const std::vector<JetCorrectorParameters> &parameters)
+	{
+		for (const JetCorrectorParameters &levelParameters : parameters)
+		{
+			levels.push_back(Level());
+			if (!load(levelParameters, levels.back()))
+			{
+				levels.clear();
+				break;
+			}
+		}
+	}
+
+	// empty if the tables can be used, otherwise the first unsupported feature of the parameters
+	const std::string &getUnsupported() const
+	{
+		return unsupported;
+	}
+
+	const std::vector<Level> &getLevels() const
+	{
+		return levels;
+	}
+
+private:
+	bool load(const JetCorrectorParameters &parameters, Level &level)
+	{
+		const JetCorrectorParameters::Definitions &definitions = parameters.definitions();
+		const std::string name = definitions.level();
+		if ((name != "L1Offset") && (name != "L1FastJet") && (name != "L2Relative") && (name != "L3Absolute") && (name != "L2L3Residual"))
+		{
+			unsupported = "level " + name;
+			return false;
+		}
+		if (definitions.isResponse())
+		{
+			unsupported = "response of level " + name;
+			return false;
+		}
+
+		std::vector<JECVariable> binVariables;
+		for (unsigned int variable = 0; variable < definitions.nBinVar(); ++variable)
+		{
+			binVariables.push_back(getJECVariable(definitions.binVar(variable)));
+		}
+		for (unsigned int variable = 0; variable < definitions.nParVar(); ++variable)
+		{
+			level.parVariables.push_back(getJECVariable(definitions.parVar(variable)));
+		}
+		if ((std::find(binVariables.begin(), binVariables.end(), jec_unsupported) != binVariables.end()) ||
+		    (std::find(level.parVariables.begin(), level.parVariables.end(), jec_unsupported) != level.parVariables.end()) ||
+		    (level.parVariables.size() > 4))
+		{
+			unsupported = "variables of level " + name;
+			return false;
+		}
+
+		level.formula = JECFormula(definitions.formula());
+		if (!level.formula.isValid())
+		{
+			unsupported = "formula " + definitions.formula() + " of level " + name;
+			return false;
+		}
+
+		level.binning.load(parameters, binVariables);
+		const size_t nBins = level.binning.nBins;
+		const size_t nParVariables = level.parVariables.size();
+		const size_t nParameters = level.formula.getNParameters();
+		level.parMin.resize(nParVariables * nBins);
+		level.parMax.resize(nParVariables * nBins);
+		level.parameters.resize(nParameters * nBins);
+		for (size_t bin = 0; bin < nBins; ++bin)
+		{
+			const std::vector<float> &values = parameters.record(static_cast<unsigned int>(bin)).parameters();
+			if (values.size() < 2 * nParVariables + nParameters)
+			{
+				unsupported = "number of parameters of level " + name;
+				return false;
+			}
+			for (size_t variable = 0; variable < nParVariables; ++variable)
+			{
+				level.parMin[variable * nBins + bin] = values[2 * variable];
+				level.parMax[variable * nBins + bin] = values[2 * variable + 1];
+			}
+			for (size_t parameter = 0; parameter < nParameters; ++parameter)
+			{
+				level.parameters[parameter * nBins + bin] = values[2 * nParVariables + parameter];
+			}
+		}
+		return true;
+	}
+
+	std::vector<Level> levels;
+	std::string unsupported;
+};
+
+// Uncertainties of the corrections in structure-of-arrays form
+//
+// The points of the uncertainties (parameter variable, uncertainty up, uncertainty down) of all bins
+// are stored one after another, the uncertainties are interpolated linearly between them as by
+// SimpleJetCorrectionUncertainty.
+
+class JECUncertaintyTable
+{
+public:
+	explicit JECUncertaintyTable(const JetCorrectorParameters &parameters)
+	{
+		const JetCorrectorParameters::Definitions &definitions = parameters.definitions();
+		std::vector<JECVariable> binVariables;
+		for (unsigned int variable = 0; variable < definitions.nBinVar(); ++variable)
+		{
+			binVariables.push_back(getJECVariable(definitions.binVar(variable)));
+		}
+		parVariable = ((definitions.nParVar() > 0) ? getJECVariable(definitions.parVar(0)) : jec_unsupported);
+		binVariables.push_back(parVariable);
+		for (JECVariable variable : binVariables)
+		{
+			if ((variable != jec_eta) && (variable != jec_pt) && (variable != jec_energy) && (variable != jec_phi))
+			{
+				unsupported = "variables of the uncertainties";
+				return;
+			}
+		}
+		binVariables.pop_back();
+
+		binning.load(parameters, binVariables);
+		pointsBegin.push_back(0);
+		orderedPoints = true;
+		for (size_t bin = 0; bin < binning.nBins; ++bin)
+		{
+			const std::vector<float> &values = parameters.record(static_cast<unsigned int>(bin)).parameters();
+			if (values.empty() || ((values.size() % 3) != 0))
+			{
+				unsupported = "number of parameters of the uncertainties";
+				return;
+			}
+			for (size_t value = 0; value < values.size(); value += 3)
+			{
+				orderedPoints = orderedPoints && ((value == 0) || (x.back() < values[value]));
+				x.push_back(values[value]);
+				up.push_back(values[value + 1]);
+				down.push_back(values[value + 2]);
+			}
+			pointsBegin.push_back(x.size());
+		}
+	}
+
+	// empty if the table can be used, otherwise the first unsupported feature of the parameters
+	const std::string &getUnsupported() const
+	{
+		return unsupported;
+	}
+
+	const JECBinning &getBinning() const
+	{
+		return binning;
+	}
+
+	JECVariable getParVariable() const
+	{
+		return parVariable;
+	}
+
+	// uncertainties in both directions for the value of the parameter variable in the given bin
+	void interpolate(const int bin, const float value, float &uncertaintyUp, float &uncertaintyDown) const
+	{
+		const size_t begin = pointsBegin[bin];
+		const size_t end = pointsBegin[bin + 1];
+		if (value <= x[begin])
+		{
+			uncertaintyUp = up[begin];
+			uncertaintyDown = down[begin];
+		}
+		else if (value >= x[end - 1])
+		{
+			uncertaintyUp = up[end - 1];
+			uncertaintyDown = down[end - 1];
+		}
+		else
+		{
+			// first point of the interval containing the value (first point if there is none)
+			size_t point = begin;
+			if (orderedPoints)
+			{
+				point = static_cast<size_t>(std::upper_bound(x.begin() + begin, x.begin() + end, value) - x.begin()) - 1;
+			}
+			else
+			{
+				while ((point + 1 < end) && (!((value >= x[point]) && (value < x[point + 1]))))
+				{
+					++point;
+				}
+			}
+			if (point + 1 >= end)
+			{
+				point = begin;
+			}
+			uncertaintyUp = interpolate(value, x[point], x[point + 1], up[point], up[point + 1]);
+			uncertaintyDown = interpolate(value, x[point], x[point + 1], down[point], down[point + 1]);
+		}
+	}
+
+private:
+	static float interpolate(const float value, const float x0, const float x1, const float y0, const float y1)
+	{
+		if (!((x0 < x1) || (x0 > x1)))
+		{
+			return (((y0 < y1) || (y0 > y1)) ? -999.0f : y0);
+		}
+		const float slope = (y1 - y0) / (x1 - x0);
+		const float offset = (y0 * x1 - y1 * x0) / (x1 - x0);
+		return slope * value + offset;
+	}
+
+	JECBinning binning;
+	JECVariable parVariable = jec_unsupported;
+	std::vector<size_t> pointsBegin; // [bin], first point of the bin
+	std::vector<float> x, up, down; // [point]
+	bool orderedPoints = false;
+	std::string unsupported;
+};
+
+// JEC tables for the parameters with the given name (e.g. the names of the parameter files),
+// which are created only once and shared by all evaluators
+template<class TTables, class TParameters>
+inline std::shared_ptr<const TTables> getSharedJECTables(const std::string &name, const TParameters &parameters)
+{
+	static std::mutex tablesMutex;
+	static std::map<std::string, std::weak_ptr<const TTables> > tablesByName;
+
+	std::lock_guard<std::mutex> lock(tablesMutex);
+	std::shared_ptr<const TTables> tables = tablesByName[name].lock();
+	if (!tables)
+	{
+		tables = std::make_shared<const TTables>(parameters);
+		tablesByName[name] = tables;
+	}
+	return tables;
+}
+
+class JECBatchEvaluator
+{
+public:
+	JECBatchEvaluator(FactorizedJetCorrector *jec = nullptr, JetCorrectionUncertainty *unc = nullptr)
+		: jec(jec), unc(unc), values(jec_unsupported)
+	{
+	}
+
+	// correctors for the evaluation jet by jet
+	void setCorrectors(FactorizedJetCorrector *corrector, JetCorrectionUncertainty *uncertainty)
+	{
+		jec = corrector;
+		unc = uncertainty;
+	}
+
+	// tables of the same parameters as the correctors, which are used instead of them if they support the parameters
+	void setTables(std::shared_ptr<const JECCorrectionTables> corrections, std::shared_ptr<const JECUncertaintyTable> uncertainties)
+	{
+		correctionTables = ((corrections && corrections->getUnsupported().empty()) ? corrections : nullptr);
+		uncertaintyTable = ((uncertainties && uncertainties->getUnsupported().empty()) ? uncertainties : nullptr);
+	}
+
+	bool hasCorrections() const
+	{
+		return ((jec != nullptr) || correctionTables);
+	}
+
+	bool hasUncertainties() const
+	{
+		return ((unc != nullptr) || uncertaintyTable);
+	}
+
+	// evaluate the corrections and the uncertainties of the jets, which are not yet in the result,
+	// the uncertainties refer to the corrected jets and the jets themselves are not modified
+	template<typename T>
+	void evaluate(const std::vector<T*> &jets, const double rho, const int npv, const float area, JECBatchResult &result)
+	{
+		const bool evaluateCorrections = (!result.correctionsEvaluated);
+		const bool evaluateUncertainties = (hasUncertainties() && (!result.uncertaintiesEvaluated));
+		if ((!evaluateCorrections) && (!evaluateUncertainties))
+		{
+			return;
+		}
+
+		// only the jets within the range of the corrections are corrected
+		selectedJets.clear();
+		for (size_t idx = 0; idx < jets.size(); ++idx)
+		{
+			if (std::abs(jets[idx]->p4.Eta()) < 5.4f)
+			{
+				selectedJets.push_back(idx);
+			}
+		}
+
+		if (evaluateCorrections)
+		{
+			result.correction.assign(jets.size(), 1.0f);
+			if (correctionTables)
+			{
+				setKinematics(jets, area, nullptr);
+				values[jec_rho].assign(selectedJets.size(), static_cast<float>(rho));
+				values[jec_npv].assign(selectedJets.size(), static_cast<float>(npv));
+				correctWithTables(result);
+			}
+			else if (jec != nullptr)
+			{
+				for (size_t idx : selectedJets)
+				{
+					const T &jet = *jets[idx];
+					jec->setRho(static_cast<float>(rho));
+					jec->setNPV(npv);
+					setupFactorProvider(jet, jec);
+					jec->setJetA((area > 0) ? area : jet.area);
+					result.correction[idx] = jec->getCorrection();
+				}
+			}
+			result.correctionsEvaluated = true;
+		}
+
+		if (evaluateUncertainties)
+		{
+			result.uncertaintyUp.assign(jets.size(), 0.0f);
+			result.uncertaintyDown.assign(jets.size(), 0.0f);
+			const std::vector<float> *correction = (hasCorrections() ? &(result.correction) : nullptr);
+			if (uncertaintyTable)
+			{
+				setKinematics(jets, area, correction);
+				uncertaintyTable->getBinning().findBins(selectedJets.size(), values, bins);
+				const std::vector<float> &parValues = values[uncertaintyTable->getParVariable()];
+				for (size_t jet = 0; jet < selectedJets.size(); ++jet)
+				{
+					float uncertaintyUp = -999.0f;
+					float uncertaintyDown = -999.0f;
+					if (bins[jet] >= 0)
+					{
+						uncertaintyTable->interpolate(bins[jet], parValues[jet], uncertaintyUp, uncertaintyDown);
+					}
+					result.uncertaintyUp[selectedJets[jet]] = uncertaintyUp;
+					result.uncertaintyDown[selectedJets[jet]] = uncertaintyDown;
+				}
+			}
+			else
+			{
+				for (size_t idx : selectedJets)
+				{
+					auto p4 = jets[idx]->p4;
+					if (correction != nullptr)
+					{
+						p4 *= (*correction)[idx];
+					}
+					setupUncertainty(p4);
+					result.uncertaintyUp[idx] = unc->getUncertainty(true);
+					setupUncertainty(p4);
+					result.uncertaintyDown[idx] = unc->getUncertainty(false);
+				}
+			}
+			result.uncertaintiesEvaluated = true;
+		}
+	}
+
+	// apply the evaluated corrections and the uncertainty shift to the jets passed to evaluate()
+	template<typename T>
+	void apply(std::vector<T*> &jets, const JECBatchResult &result, const float area = -1, float shift = 0.0f) const
+	{
+		const bool shifted = (hasUncertainties() && (std::abs(shift) > 0.00001f));
+		for (size_t idx = 0; idx < jets.size(); ++idx)
+		{
+			T &jet = *jets[idx];
+			if (std::abs(jet.p4.Eta()) < 5.4f)
+			{
+				if (area > 0)
+				{
+					jet.area = area;
+				}
+				if (hasCorrections())
+				{
+					jet.p4 *= result.correction[idx];
+				}
+				if (shifted)
+				{
+					jet.p4 *= 1.0f + (shift * ((shift > 0.0f) ? result.uncertaintyUp[idx] : result.uncertaintyDown[idx]));
+				}
+			}
+		}
+	}
+
+private:
+	// kinematics of the selected jets, optionally after applying the corrections
+	template<typename T>
+	void setKinematics(const std::vector<T*> &jets, const float area, const std::vector<float> *correction)
+	{
+		const size_t nJets = selectedJets.size();
+		for (JECVariable variable : { jec_eta, jec_pt, jec_energy, jec_phi, jec_area })
+		{
+			values[variable].resize(nJets);
+		}
+		for (size_t jet = 0; jet < nJets; ++jet)
+		{
+			const T &selectedJet = *jets[selectedJets[jet]];
+			auto p4 = selectedJet.p4;
+			if (correction != nullptr)
+			{
+				p4 *= (*correction)[selectedJets[jet]];
+			}
+			values[jec_eta][jet] = p4.eta();
+			values[jec_pt][jet] = p4.pt();
+			values[jec_energy][jet] = p4.E();
+			values[jec_phi][jet] = p4.phi();
+			values[jec_area][jet] = ((area > 0) ? area : selectedJet.area);
+		}
+	}
+
+	// pass all selected jets through the correction levels
+	void correctWithTables(JECBatchResult &result)
+	{
+		const size_t nJets = selectedJets.size();
+		factors.assign(nJets, 1.0f);
+		for (const JECCorrectionTables::Level &level : correctionTables->getLevels())
+		{
+			const size_t nBins = level.binning.nBins;
+			if (nBins == 0)
+			{
+				continue;
+			}
+			level.binning.findBins(nJets, values, bins);
+
+			// variables limited to the range given in the bins, parameters of the bins
+			// (jets outside of all bins use the first bin, their corrections are not used)
+			formulaVariables.resize(level.parVariables.size());
+			for (size_t variable = 0; variable < level.parVariables.size(); ++variable)
+			{
+				const std::vector<float> &x = values[level.parVariables[variable]];
+				const float *xMin = level.parMin.data() + variable * nBins;
+				const float *xMax = level.parMax.data() + variable * nBins;
+				formulaVariables[variable].resize(nJets);
+				for (size_t jet = 0; jet < nJets; ++jet)
+				{
+					const size_t bin = static_cast<size_t>(std::max(bins[jet], 0));
+					formulaVariables[variable][jet] = ((x[jet] < xMin[bin]) ? xMin[bin] : ((x[jet] > xMax[bin]) ? xMax[bin] : x[jet]));
+				}
+			}
+			formulaParameters.resize(level.formula.getNParameters());
+			for (size_t parameter = 0; parameter < formulaParameters.size(); ++parameter)
+			{
+				const double *binParameters = level.parameters.data() + parameter * nBins;
+				formulaParameters[parameter].resize(nJets);
+				for (size_t jet = 0; jet < nJets; ++jet)
+				{
+					formulaParameters[parameter][jet] = binParameters[std::max(bins[jet], 0)];
+				}
+			}
+			level.formula.evaluate(nJets, formulaVariables, formulaParameters, stack, formulaValues);
+
+			// the next level gets the jets corrected by this level
+			for (size_t jet = 0; jet < nJets; ++jet)
+			{
+				const float scale = ((bins[jet] < 0) ? 1.0f : static_cast<float>(formulaValues[jet]));
+				factors[jet] *= scale;
+				values[jec_pt][jet] *= scale;
+				values[jec_energy][jet] *= scale;
+			}
+		}
+
+		for (size_t jet = 0; jet < nJets; ++jet)
+		{
+			result.correction[selectedJets[jet]] = factors[jet];
+		}
+	}
+
+	template<typename TVector>
+	void setupUncertainty(const TVector &p4)
+	{
+		unc->setJetEta(p4.eta());
+		unc->setJetPt(p4.pt());
+		unc->setJetE(p4.E());
+		unc->setJetPhi(p4.phi());
+	}
+
+	FactorizedJetCorrector *jec;
+	JetCorrectionUncertainty *unc;
+	std::shared_ptr<const JECCorrectionTables> correctionTables;
+	std::shared_ptr<const JECUncertaintyTable> uncertaintyTable;
+
+	// reused for all events, the values of the selected jets are indexed by JECVariable
+	std::vector<size_t> selectedJets;
+	std::vector<std::vector<float> > values;
+	std::vector<int> bins;
+	std::vector<float> factors;
+	std::vector<std::vector<double> > formulaVariables, formulaParameters;
+	std::vector<double> formulaValues, stack;
+};
+
 #include "FileInterfaceBase.h"
 
 class JECService
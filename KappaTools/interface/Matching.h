@@ -7,9 +7,13 @@
 #ifndef KAPPA_MATCHING_H
 #define KAPPA_MATCHING_H
 
+#include <algorithm>
+#include <cmath>
+#include <cstdint>
+#include <limits>
 #include <vector>
 #include <Math/VectorUtil.h>
-#include "Artus/KappaTools/interface/Toolbox/interface/IOHelper.h"
+#include "Artus/KappaTools/interface/IOHelper.h"
 
 struct matchSort_deltaR
 {
@@ -44,7 +48,7 @@ template<typename T1, typename T2>
 std::vector<int> matchSort_Matrix(const std::vector<T1> &base, const size_t base_size,
 	const std::vector<T2> &target, const size_t target_size, const double dR = 0.3)
 {
-	static matchSort_deltaR metric(dR);
+	const matchSort_deltaR metric(dR);
 	return matchSort_Matrix(base, base_size, target, target_size, metric);
 }
 
@@ -56,15 +60,15 @@ template<typename T1, typename T2, typename TMetricClass>
 std::vector<int> matchSort_Matrix(const std::vector<T1> &base, const size_t base_size,
 	const std::vector<T2> &target, const size_t target_size, const TMetricClass &metricFct)
 {
-	double **match_metric = nullptr;
 	std::vector<int> result(target_size, -1);
 
-	// Build m x n Matrix with dR
-	match_metric = new double*[base_size];
+	// Build m x n Matrix with dR (one block, row i starts at i * target_size)
+	std::vector<double> match_metric_values(base_size * target_size);
+	std::vector<double*> match_metric(base_size);
 	for (unsigned int i = 0; i < base_size; ++i)
 	{
 		const T1 &jet_i = base[i];
-		match_metric[i] = new double[target_size];
+		match_metric[i] = match_metric_values.data() + i * target_size;
 		for (unsigned int j = 0; j < target_size; ++j)
 		{
 			const T2 &jet_j = target[j];
@@ -103,11 +107,153 @@ std::vector<int> matchSort_Matrix(const std::vector<T1> &base, const size_t base
 		result[bestTarget] = static_cast<int>(bestBase);
 	}
 
-	for (unsigned int i = 0; i < base_size; ++i)
-		delete [] match_metric[i];
-	delete [] match_metric;
-
 	return result;
 }
 
+/*
+Index of the directions of a collection in bins of eta and phi, built once per event and collection:
+
+    DeltaRIndex index;
+    index.Build(*event.m_genParticles);
+    int nearest = index.FindNearest(jet->p4, *event.m_genParticles, 0.3,
+        [](const KGenParticle &genParticle) { return (genParticle.status() == 1); });
+
+ForEachCandidate returns all objects within a given deltaR, but possibly also objects slightly
+further away, such that the exact deltaR has to be computed by the caller (FindNearest does this
+with ROOT::Math::VectorUtil::DeltaR, exactly as a loop over the whole collection). The cell size
+should be of the order of the deltaR used for the matching. The memory is reused by the next Build.
+*/
+class DeltaRIndex
+{
+public:
+	explicit DeltaRIndex(const double cellSize = 0.4, const double maxAbsEta = 5.0) :
+		maxAbsEta(maxAbsEta),
+		nEtaCells(2 + static_cast<int>(std::ceil(2.0 * maxAbsEta / cellSize))),
+		nPhiCells(std::max(1, static_cast<int>(2.0 * M_PI / cellSize))),
+		etaCellSize(2.0 * maxAbsEta / (nEtaCells - 2)),
+		phiCellSize(2.0 * M_PI / nPhiCells),
+		cellOffsets(nEtaCells * nPhiCells + 1, 0)
+	{
+	}
+
+	// objects with p4 members
+	template<typename T>
+	void Build(const std::vector<T> &objects)
+	{
+		Build(objects.size(), [&objects](const size_t index) -> const T & { return objects[index]; });
+	}
+
+	template<typename T>
+	void Build(const std::vector<T*> &objects)
+	{
+		Build(objects.size(), [&objects](const size_t index) -> const T & { return *(objects[index]); });
+	}
+
+	// calls function(index) for all objects within maxDeltaR of (eta, phi), in increasing order of the cells
+	template<typename TFunction>
+	void ForEachCandidate(const double eta, const double phi, const double maxDeltaR, TFunction function) const
+	{
+		if (std::isnan(eta) || std::isnan(phi))
+			return;
+		// padded for rounding, the exact deltaR is checked by the caller
+		const double deltaR = maxDeltaR + 1e-4;
+		const int firstEtaCell = GetEtaCell(eta - deltaR);
+		const int lastEtaCell = GetEtaCell(eta + deltaR);
+		const bool allPhiCells = ((2.0 * deltaR + phiCellSize) >= (2.0 * M_PI));
+		const int firstPhiCell = (allPhiCells ? 0 : static_cast<int>(std::floor((phi - deltaR + M_PI) / phiCellSize)));
+		const int lastPhiCell = (allPhiCells ? (nPhiCells - 1) : static_cast<int>(std::floor((phi + deltaR + M_PI) / phiCellSize)));
+		for (int etaCell = firstEtaCell; etaCell <= lastEtaCell; ++etaCell)
+			for (int phiCell = firstPhiCell; phiCell <= lastPhiCell; ++phiCell)
+			{
+				const size_t cell = etaCell * nPhiCells + WrapPhiCell(phiCell);
+				for (size_t position = cellOffsets[cell]; position < cellOffsets[cell + 1]; ++position)
+					function(static_cast<size_t>(cellObjects[position]));
+			}
+	}
+
+	// index of the object closest to p4 within deltaR < maxDeltaR, for which accept(object) is true,
+	// or -1 (for equal deltaR, the first object in the collection is chosen)
+	// The deltaR values are compared in the type of maxDeltaR, for a float maxDeltaR in the same way
+	// as by loops storing the deltaR in a float.
+	template<typename TP4, typename T, typename TDeltaR, typename TAccept>
+	int FindNearest(const TP4 &p4, const std::vector<T> &objects, const TDeltaR maxDeltaR, TAccept accept) const
+	{
+		int nearest = -1;
+		TDeltaR nearestDeltaR = std::numeric_limits<TDeltaR>::max();
+		ForEachCandidate(p4.Eta(), p4.Phi(), maxDeltaR, [&](const size_t index)
+		{
+			const T &object = objects[index];
+			if (!accept(object))
+				return;
+			const TDeltaR deltaR = ROOT::Math::VectorUtil::DeltaR(p4, object.p4);
+			if ((deltaR < maxDeltaR) && ((deltaR < nearestDeltaR) || ((deltaR == nearestDeltaR) && (static_cast<int>(index) < nearest))))
+			{
+				nearest = static_cast<int>(index);
+				nearestDeltaR = deltaR;
+			}
+		});
+		return nearest;
+	}
+
+	template<typename TP4, typename T, typename TDeltaR>
+	int FindNearest(const TP4 &p4, const std::vector<T> &objects, const TDeltaR maxDeltaR) const
+	{
+		return FindNearest(p4, objects, maxDeltaR, [](const T &) { return true; });
+	}
+
+private:
+	template<typename TGetter>
+	void Build(const size_t nObjects, TGetter getObject)
+	{
+		// counting sort of the objects by their cells
+		objectCells.resize(nObjects);
+		std::fill(cellOffsets.begin(), cellOffsets.end(), 0);
+		for (size_t index = 0; index < nObjects; ++index)
+		{
+			const double eta = getObject(index).p4.Eta();
+			const double phi = getObject(index).p4.Phi();
+			// objects without a direction are never matched
+			if (std::isnan(eta) || std::isnan(phi))
+			{
+				objectCells[index] = -1;
+				continue;
+			}
+			objectCells[index] = GetEtaCell(eta) * nPhiCells + WrapPhiCell(static_cast<int>(std::floor((phi + M_PI) / phiCellSize)));
+			++cellOffsets[objectCells[index] + 1];
+		}
+		for (size_t cell = 1; cell < cellOffsets.size(); ++cell)
+			cellOffsets[cell] += cellOffsets[cell - 1];
+
+		cellObjects.resize(cellOffsets.back());
+		cellPositions.assign(cellOffsets.begin(), cellOffsets.end() - 1);
+		for (size_t index = 0; index < nObjects; ++index)
+			if (objectCells[index] >= 0)
+				cellObjects[cellPositions[objectCells[index]]++] = static_cast<uint32_t>(index);
+	}
+
+	// objects beyond maxAbsEta are collected in the first and last eta cells
+	int GetEtaCell(const double eta) const
+	{
+		if (eta < -maxAbsEta)
+			return 0;
+		if (eta >= maxAbsEta)
+			return nEtaCells - 1;
+		return std::min(nEtaCells - 2, 1 + static_cast<int>((eta + maxAbsEta) / etaCellSize));
+	}
+
+	int WrapPhiCell(const int phiCell) const
+	{
+		return ((phiCell % nPhiCells) + nPhiCells) % nPhiCells;
+	}
+
+	double maxAbsEta;
+	int nEtaCells, nPhiCells;
+	double etaCellSize, phiCellSize;
+
+	std::vector<size_t> cellOffsets; // objects of cell i: cellObjects[cellOffsets[i]] ... cellObjects[cellOffsets[i + 1] - 1]
+	std::vector<uint32_t> cellObjects;
+	std::vector<int> objectCells;
+	std::vector<size_t> cellPositions;
+};
+
 #endif
@@ -8,6 +8,7 @@
 
 #define WITH_KAPPA
 
+#include <memory>
 #include <vector>
 #include <string>
 #include <iostream>
@@ -28,7 +29,11 @@ private:
 	void initTruthMatrix(std::vector<std::string> inputFilesData, std::vector<std::string> inputFilesMC);
 	void initApproxMatrix(std::vector<std::string> inputFilesData, float scaleFactor = 1.);
 
-	double weights3D[50][50][50];
+	static std::shared_ptr<const std::vector<double> > computeApproxMatrix(std::vector<std::string> inputFilesData, float scaleFactor);
+
+	// weights of (nPUm1, nPU, nPUp1) in [0, 50)^3 at index (nPUm1 * 50 + nPU) * 50 + nPUp1,
+	// the matrix is computed once per set of data files and scale factor and shared by all instances
+	std::shared_ptr<const std::vector<double> > weights3D;
 
 	TH1F *puDistrData;
 	TH1F *puDistrMC;
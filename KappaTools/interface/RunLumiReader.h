@@ -7,34 +7,37 @@
 #ifndef KAPPA_RUNLUMIREADER_H
 #define KAPPA_RUNLUMIREADER_H
 
+#include <algorithm>
 #include <set>
+#include <vector>
 #include <Kappa/DataFormats/interface/Kappa.h>
 #include "Artus/KappaTools/interface/FileInterface.h"
 
 void readLumiFilter(const std::string json, std::map<run_id, std::set<std::pair<lumi_id, lumi_id> > > &lumifilter);
+// with cache = true, the lumi ranges are read from / written to the binary file json + ".cache",
+// which is only used as long as the size and the modification time of the JSON file are unchanged
+void readLumiFilter(const std::string json, std::map<run_id, std::set<std::pair<lumi_id, lumi_id> > > &lumifilter, const bool cache);
 
 class RunLumiSelector
 {
 public:
-	RunLumiSelector(const std::string json = "", const run_id _passRunLow = 0, const run_id _passRunHigh = 0);
-	RunLumiSelector(const std::vector<std::string> &json, const run_id _passRunLow = 0, const run_id _passRunHigh = 0);
+	RunLumiSelector(const std::string json = "", const run_id _passRunLow = 0, const run_id _passRunHigh = 0, const bool _cacheJSON = false);
+	RunLumiSelector(const std::vector<std::string> &json, const run_id _passRunLow = 0, const run_id _passRunHigh = 0, const bool _cacheJSON = false);
 	void addJSONFile(const std::string json = "");
 	inline bool accept(const run_id run, const lumi_id lumi) const
 	{
 		if ((passRunLow > 0) && (run >= passRunLow) && ((passRunHigh == 0) || (run <= passRunHigh)))
 			return true;
-		typedef std::set<std::pair<lumi_id, lumi_id> > lumirange;
-		std::map<run_id, lumirange>::const_iterator itRun = lumifilter.find(run);
-		if (itRun == lumifilter.end())
+		std::vector<run_id>::const_iterator itRun = std::lower_bound(indexRuns.begin(), indexRuns.end(), run);
+		if ((itRun == indexRuns.end()) || (*itRun != run))
 			return false;
-		const lumirange &lumis = itRun->second;
-		for (lumirange::const_iterator itLumis = lumis.begin(); itLumis != lumis.end(); ++itLumis)
-			if (lumi < itLumis->first)
-				return false;
-			else
-				if ((lumi >= itLumis->first) && (lumi <= itLumis->second))
-					return true;
-		return false;
+		const size_t iRun = itRun - indexRuns.begin();
+		const std::vector<std::pair<lumi_id, lumi_id> >::const_iterator itLumisEnd = indexLumis.begin() + indexRunOffsets[iRun + 1];
+		// first range not ending before the lumi section
+		std::vector<std::pair<lumi_id, lumi_id> >::const_iterator itLumis = std::lower_bound(
+			indexLumis.begin() + indexRunOffsets[iRun], itLumisEnd, lumi,
+			[](const std::pair<lumi_id, lumi_id> &lumis, const lumi_id lumi) { return (lumis.second < lumi); });
+		return ((itLumis != itLumisEnd) && (itLumis->first <= lumi));
 	}
 	bool isCompatible(const FileInterface &fi) const;
 	std::pair<run_id, run_id> getBoundaries() const;
@@ -49,8 +52,17 @@ public:
 	const std::map<run_id, std::set<std::pair<lumi_id, lumi_id> > > &getRunLumiMap() const;
 	friend std::ostream &operator<<(std::ostream &os, const RunLumiSelector &m);
 private:
+	void buildIndex();
+
 	run_id passRunLow, passRunHigh;
+	bool cacheJSON;
 	std::map<run_id, std::set<std::pair<lumi_id, lumi_id> > > lumifilter;
+
+	// flat index of lumifilter used by accept: sorted runs and their merged, sorted lumi ranges
+	// indexLumis[indexRunOffsets[i]] ... indexLumis[indexRunOffsets[i + 1] - 1] of indexRuns[i]
+	std::vector<run_id> indexRuns;
+	std::vector<size_t> indexRunOffsets;
+	std::vector<std::pair<lumi_id, lumi_id> > indexLumis;
 };
 
 std::ostream &operator<<(std::ostream &os, const RunLumiSelector &m);
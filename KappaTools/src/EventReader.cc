@@ -0,0 +1,162 @@
+#include "Artus/KappaTools/interface/EventReader.h"
+
+#include <algorithm>
+
+#include <TROOT.h>
+
+EventReader::EventReader(FileInterface2 &fileInterface, size_t nPrefetchedEvents, std::chrono::minutes timeout) :
+	fileInterface(fileInterface),
+	eventInfo(fileInterface.GetEvent<KEventInfo>("eventInfo", false)),
+	nPrefetchedEvents(nPrefetchedEvents),
+	timeout(timeout),
+	slotInfos(std::max(nPrefetchedEvents, size_t(1))),
+	slotPositions(slotInfos.size())
+{
+	// the input is read, while objects are created and written by the analysis
+	if (nPrefetchedEvents > 0)
+		ROOT::EnableThreadSafety();
+
+	thread = std::thread(&EventReader::Run, this);
+}
+
+EventReader::~EventReader()
+{
+	{
+		std::lock_guard<std::mutex> lock(mutex);
+		stop = true;
+	}
+	condition.notify_all();
+	thread.join();
+}
+
+EventReader::EntryInfo const *EventReader::GetEntry(long long entry)
+{
+	std::unique_lock<std::mutex> lock(mutex);
+
+	// discard the entries read ahead, if they do not start with the requested one
+	if ((nextEntry - static_cast<long long>(nReadSlots)) != entry)
+	{
+		++generation;
+		nReadSlots = 0;
+		nextEntry = entry;
+		endOfInput = false;
+		readPosition = currentPosition;
+	}
+	requestedEntry = entry;
+	condition.notify_all();
+
+	if (! condition.wait_for(lock, timeout, [this]() { return (nReadSlots > 0); }))
+		return nullptr;
+
+	const size_t slot = firstSlot;
+	currentInfo = slotInfos[slot];
+	currentPosition = slotPositions[slot];
+
+	// the slot is not touched by the reader, until it is released
+	lock.unlock();
+	if ((nPrefetchedEvents > 0) && (currentInfo.nBytes != 0))
+	{
+		for (std::unique_ptr<BufferedObjectBase> &object : eventObjects)
+			object->Load(slot);
+		if (currentInfo.newLumisection)
+			for (std::unique_ptr<BufferedObjectBase> &object : lumiObjects)
+				object->Load(slot);
+		if (currentInfo.newRun)
+			for (std::unique_ptr<BufferedObjectBase> &object : runObjects)
+				object->Load(slot);
+	}
+	lock.lock();
+
+	firstSlot = (firstSlot + 1) % slotInfos.size();
+	--nReadSlots;
+	condition.notify_all();
+	return &currentInfo;
+}
+
+void EventReader::Run()
+{
+	std::unique_lock<std::mutex> lock(mutex);
+	while (true)
+	{
+		condition.wait(lock, [this]() { return (stop || CanReadEntry()); });
+		if (stop)
+			return;
+
+		const long long entry = nextEntry;
+		const size_t slot = (firstSlot + nReadSlots) % slotInfos.size();
+		const unsigned long long readGeneration = generation;
+		Position position = readPosition;
+
+		lock.unlock();
+		EntryInfo info = ReadEntry(entry, slot, position);
+		lock.lock();
+
+		// the entry is dropped, if other entries have been requested in the meantime
+		if (readGeneration == generation)
+		{
+			slotInfos[slot] = info;
+			slotPositions[slot] = position;
+			readPosition = position;
+			++nReadSlots;
+			++nextEntry;
+			endOfInput = (info.nBytes == 0);
+			condition.notify_all();
+		}
+	}
+}
+
+// without prefetching, only the requested entry is read
+bool EventReader::CanReadEntry() const
+{
+	return ((requestedEntry >= 0) && (! endOfInput) && (nReadSlots < slotInfos.size()) &&
+	        (nextEntry <= requestedEntry + static_cast<long long>(nPrefetchedEvents)));
+}
+
+EventReader::EntryInfo EventReader::ReadEntry(long long entry, size_t slot, Position &position)
+{
+	EntryInfo info;
+	TChain *eventdata = fileInterface.eventdata;
+	info.nBytes = eventdata->GetEntry(entry);
+	if (info.nBytes == 0)
+		return info;
+
+	info.treeNumber = eventdata->GetTreeNumber();
+	if (info.treeNumber != position.tree)
+	{
+		position = Position();
+		position.tree = info.treeNumber;
+		info.newTree = true;
+		info.fileName = eventdata->GetFile()->GetName();
+	}
+
+	// the run and lumi entries are found with the event info of the current entry
+	if (eventInfo != nullptr)
+	{
+		if (position.run != static_cast<long>(eventInfo->nRun))
+		{
+			position.run = eventInfo->nRun;
+			position.lumi = -1;
+			fileInterface.GetRunEntry();
+			info.newRun = true;
+		}
+		if (position.lumi != static_cast<long>(eventInfo->nLumi))
+		{
+			position.lumi = eventInfo->nLumi;
+			fileInterface.GetLumiEntry();
+			info.newLumisection = true;
+		}
+	}
+
+	if (nPrefetchedEvents > 0)
+	{
+		for (std::unique_ptr<BufferedObjectBase> &object : eventObjects)
+			object->Store(slot);
+		if (info.newLumisection)
+			for (std::unique_ptr<BufferedObjectBase> &object : lumiObjects)
+				object->Store(slot);
+		if (info.newRun)
+			for (std::unique_ptr<BufferedObjectBase> &object : runObjects)
+				object->Store(slot);
+	}
+	return info;
+}
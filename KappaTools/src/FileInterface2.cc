@@ -83,7 +83,6 @@ FileInterface2::FileInterface2(std::vector<std::string> files, RunLumiSelector *
 			if (!accept)
 				continue;
 
-			usedLumis = RunLumiSelector::getMinimalJSON(usedLumis);
 			if (dtAll == INVALID)
 				dtAll = dt;
 			assert(dtAll == dt);
@@ -106,6 +105,7 @@ FileInterface2::FileInterface2(std::vector<std::string> files, RunLumiSelector *
 		ofstream uf(string(reportFn + ".usedFiles").c_str(), fstream::out);
 		uf << KappaTools::join("\n", usedFiles) << std::endl;
 		ofstream fs(string(reportFn + ".json").c_str(), fstream::out);
+		usedLumis = RunLumiSelector::getMinimalJSON(usedLumis);
 		RunLumiSelector::printJSON(fs, usedLumis);
 	}
 
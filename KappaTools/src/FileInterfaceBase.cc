@@ -62,6 +62,36 @@ void FileInterfaceBase::SpeedupTree(long cache)
 	gEnv->SetValue("TFile.AsyncPrefetching", 1);
 }
 
+void FileInterfaceBase::PruneEventBranches()
+{
+	TObjArray *eventBranches = eventdata->GetListOfBranches();
+	if (eventBranches == 0)
+		return;
+
+	// the status is kept by the chain for all following trees
+	eventdata->SetBranchStatus("*", 0);
+	int nReadBranches = 0;
+	Long64_t totalBytes = 0, readBytes = 0;
+	for (int i = 0; i < eventBranches->GetEntries(); ++i)
+	{
+		TBranch *b = dynamic_cast<TBranch*>(eventBranches->At(i));
+		const Long64_t bytes = b->GetZipBytes("*");
+		totalBytes += bytes;
+		if (b->GetAddress() != 0)
+		{
+			UInt_t found = 0;
+			eventdata->SetBranchStatus(b->GetName(), 1, &found);
+			eventdata->SetBranchStatus((string(b->GetName()) + ".*").c_str(), 1, &found);
+			readBytes += bytes;
+			++nReadBranches;
+		}
+	}
+	if (verbosity > 0)
+		cout << "Reading " << nReadBranches << " of " << eventBranches->GetEntries() << " branches of the event tree, skipping "
+		     << (totalBytes - readBytes) / (1024. * 1024.) << " of " << totalBytes / (1024. * 1024.)
+		     << " MB (compressed) in the current file" << endl;
+}
+
 void *FileInterfaceBase::GetInternal(TTree* tree, std::map<std::string, BranchHolder*> &bmap,
 	const std::string cname, const std::string &name, const bool check)
 {
@@ -1,8 +1,6 @@
 
 #include "Artus/KappaTools/interface/HLTTools.h"
 
-#include <boost/regex.hpp>
-
 
 HLTTools::HLTTools(KLumiInfo * lumiInfo)
 {
@@ -86,17 +84,23 @@ std::string HLTTools::getHLTName(const std::string &hltName) const
 		return "";
 	}
 
-	boost::regex pattern(hltName+"(_v[[:digit:]]+)?$", boost::regex::icase | boost::regex::extended);
+	std::map<std::string, boost::regex>::const_iterator pattern = patternCache.find(hltName);
+	if (pattern == patternCache.end())
+	{
+		pattern = patternCache.emplace(hltName, boost::regex(hltName+"(_v[[:digit:]]+)?$", boost::regex::icase | boost::regex::extended)).first;
+	}
+	
+	std::string& name = nameCache[hltName];
 	for (std::vector<std::string>::const_iterator curIt = lumiInfo->hltNames.begin();
 	     curIt != lumiInfo->hltNames.end(); ++curIt)
 	{
-		if (boost::regex_search(*curIt, pattern))
+		if (boost::regex_search(*curIt, pattern->second))
 		{
-			nameCache[hltName] = *curIt;
-			return *curIt;
+			name = *curIt;
+			break;
 		}
 	}
-	return "";
+	return name;
 }
 
 size_t HLTTools::getHLTPosition(const std::string &hltName) const
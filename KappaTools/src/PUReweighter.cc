@@ -4,6 +4,9 @@
 
 #include "Artus/KappaTools/interface/PUReweighter.h"
 
+#include <map>
+#include <mutex>
+
 PUReweighter::PUReweighter(std::vector<std::string> inputFilesData, std::vector<std::string> inputFilesMC, float scaleFactor)
 {
 	assert(inputFilesData.size()>0);
@@ -170,11 +173,29 @@ void PUReweighter::initTruthMatrix(std::vector<std::string> inputFilesData, std:
 
 void PUReweighter::initApproxMatrix(std::vector<std::string> inputFiles, float scaleFactor)
 {
+	static std::mutex approxMatricesMutex;
+	static std::map<std::pair<std::vector<std::string>, float>, std::weak_ptr<const std::vector<double> > > approxMatrices;
+
+	std::lock_guard<std::mutex> lock(approxMatricesMutex);
+	std::weak_ptr<const std::vector<double> > &approxMatrix = approxMatrices[std::make_pair(inputFiles, scaleFactor)];
+	weights3D = approxMatrix.lock();
+	if (!weights3D)
+	{
+		weights3D = computeApproxMatrix(inputFiles, scaleFactor);
+		approxMatrix = weights3D;
+	}
+}
+
+// the weights are 0, if the matrix cannot be computed
+std::shared_ptr<const std::vector<double> > PUReweighter::computeApproxMatrix(std::vector<std::string> inputFiles, float scaleFactor)
+{
+	std::shared_ptr<std::vector<double> > weights(new std::vector<double>(50 * 50 * 50, 0.));
+
 	if (inputFiles.empty())
 	{
 		std::cout << "You did not provide any input files to PUReweighter::initApproxMatrix()!" << std::endl;
 		std::cout << "Please check. Terminating." << std::endl;
-		return;
+		return weights;
 	}
 
 	TH1F *Data_distr_ = nullptr;
@@ -198,7 +219,7 @@ void PUReweighter::initApproxMatrix(std::vector<std::string> inputFiles, float s
 	{
 		std::cout << "Data distribution could not be initialized in PUReweighter::initApproxMatrix()." << std::endl;
 		std::cout << "Please check. Terminating." << std::endl;
-		return;
+		return weights;
 	}
 
     Data_distr_->Scale(1.0 / Data_distr_->Integral());
@@ -245,21 +266,14 @@ void PUReweighter::initApproxMatrix(std::vector<std::string> inputFiles, float s
 		std::cout << " MC and Data distributions are not initialized! You must call the Lumi3DReWeighting constructor. " << std::endl;
     }
 
-    // arrays for storing number of interactions
+    // arrays for storing number of interactions (on the heap, 1 MB each)
 
-    double MC_ints[50][50][50];
-    double Data_ints[50][50][50];
-
-	for (int i = 0; i < 50; i++)
-		for (int j = 0; j < 50; j++)
-			for (int k = 0; k < 50; k++)
-			{
-				MC_ints[i][j][k] = 0.;
-				Data_ints[i][j][k] = 0.;
-			}
+    std::vector<double> MC_ints(50 * 50 * 50, 0.);
+    std::vector<double> Data_ints(50 * 50 * 50, 0.);
 
     double factorial[51];
     double PowerSer[50];
+    double prob[50];
     double base = 1.;
 
     factorial[0] = 1.;
@@ -273,7 +287,7 @@ void PUReweighter::initApproxMatrix(std::vector<std::string> inputFiles, float s
 
     double x;
     double xweight;
-    double probi, probj, probk;
+    double probij;
     double Expval, mean;
     int xi;
 
@@ -296,7 +310,7 @@ void PUReweighter::initApproxMatrix(std::vector<std::string> inputFiles, float s
 
 		if (mean < 0.) {
 			std::cout << " Your histogram generates MC luminosity values less than zero!" << " Please Check.  Terminating." << std::endl;
-			return;
+			return weights;
 		}
 
 		Expval = exp(-1. * mean);
@@ -311,14 +325,16 @@ void PUReweighter::initApproxMatrix(std::vector<std::string> inputFiles, float s
 
 		// compute poisson probability for each Nvtx in weight matrix
 
+		for (int i = 0; i < 50; i++)
+			prob[i] = PowerSer[i] / factorial[i] * Expval;
+
 		for (int i = 0; i < 50; i++) {
-			probi = PowerSer[i] / factorial[i] * Expval;
 			for (int j = 0; j < 50; j++) {
-			probj = PowerSer[j] / factorial[j] * Expval;
+			probij = prob[i] * prob[j] * xweight;
+			double *MC_ints_ij = &MC_ints[(i * 50 + j) * 50];
 			for (int k = 0; k < 50; k++) {
-				probk = PowerSer[k] / factorial[k] * Expval;
 				// joint probability is product of event weights multiplied by weight of input distribution bin
-				MC_ints[i][j][k] = MC_ints[i][j][k] + probi * probj * probk * xweight;
+				MC_ints_ij[k] += probij * prob[k];
 			}
 			}
 		}
@@ -335,7 +351,7 @@ void PUReweighter::initApproxMatrix(std::vector<std::string> inputFiles, float s
 
 	if (mean < 0.) {
 	    std::cout << " Your histogram generates Data luminosity values less than zero!" << " Please Check.  Terminating." << std::endl;
-	    return;
+	    return weights;
 	}
 
     Expval = exp(-1. * mean);
@@ -349,38 +365,33 @@ void PUReweighter::initApproxMatrix(std::vector<std::string> inputFiles, float s
 
 	// compute poisson probability for each Nvtx in weight matrix                                                                  
 
+		for (int i = 0; i < 50; i++)
+			prob[i] = PowerSer[i] / factorial[i] * Expval;
+
 		for (int i = 0; i < 50; i++)
 		{
-			probi = PowerSer[i] / factorial[i] * Expval;
 			for (int j = 0; j < 50; j++)
 			{
-				probj = PowerSer[j] / factorial[j] * Expval;
+				probij = prob[i] * prob[j] * xweight;
+				double *Data_ints_ij = &Data_ints[(i * 50 + j) * 50];
 				for (int k = 0; k < 50; k++)
 				{
-					probk = PowerSer[k] / factorial[k] * Expval;
 					// joint probability is product of event weights multiplied by weight of input distribution bin
-					Data_ints[i][j][k] = Data_ints[i][j][k] + probi * probj * probk * xweight;
+					Data_ints_ij[k] += probij * prob[k];
 				}
 			}
 		}
     }
 
-    for (int i = 0; i < 50; i++)
+    for (size_t ijk = 0; ijk < weights->size(); ijk++)
     {
-		for (int j = 0; j < 50; j++)
-		{
-			for (int k = 0; k < 50; k++)
-			{
-				if ((MC_ints[i][j][k]) > 0.)
-					weights3D[i][j][k] = Data_ints[i][j][k] / MC_ints[i][j][k];
-				else
-					weights3D[i][j][k] = 0.;
-			}
-		}
+		if (MC_ints[ijk] > 0.)
+			(*weights)[ijk] = Data_ints[ijk] / MC_ints[ijk];
+		else
+			(*weights)[ijk] = 0.;
     }
 
-	std::cout << weights3D[12][20][5] << "\n";
-    return;
+    return weights;
 
 }
 
@@ -400,7 +411,7 @@ float PUReweighter::getWeightTruth(float mean)
 
 float PUReweighter::getWeightApprox(unsigned int bxM1, unsigned int bx0, unsigned int bxP1)
 {
-	return weights3D[std::min<unsigned int>(49,bxM1)][std::min<unsigned int>(49,bx0)][std::min<unsigned int>(49,bxP1)];
+	return (*weights3D)[(std::min<unsigned int>(49,bxM1) * 50 + std::min<unsigned int>(49,bx0)) * 50 + std::min<unsigned int>(49,bxP1)];
 }
 
 #ifdef WITH_KAPPA
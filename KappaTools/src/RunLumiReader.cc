@@ -5,6 +5,10 @@
  */
 
 #include "Artus/KappaTools/interface/RunLumiReader.h"
+#include <cstdio>
+#include <fstream>
+#include <sys/stat.h>
+#include <unistd.h>
 #include <boost/property_tree/ptree.hpp>
 #include <boost/property_tree/json_parser.hpp>
 #include "Artus/KappaTools/interface/IOHelper.h"
@@ -33,23 +37,162 @@ void readLumiFilter(const std::string json, std::map<run_id, std::set<std::pair<
 	}
 }
 
-RunLumiSelector::RunLumiSelector(const std::string json, const run_id _passRunLow, const run_id _passRunHigh)
-	: passRunLow(_passRunLow), passRunHigh(_passRunHigh)
+namespace
 {
-	if (json != "")
+	const char lumiFilterCacheMagic[8] = {'K', 'L', 'U', 'M', 'I', 'S', '0', '1'};
+
+	// size and modification time of the JSON file, which are stored in the cache
+	bool getFileStamp(const std::string &fileName, unsigned long long &size, long long &mtime)
+	{
+		struct stat fileStat;
+		if (stat(fileName.c_str(), &fileStat) != 0)
+			return false;
+		size = fileStat.st_size;
+		mtime = fileStat.st_mtime;
+		return true;
+	}
+
+	template<typename T>
+	bool readCacheValue(std::istream &is, T &value)
+	{
+		return bool(is.read(reinterpret_cast<char*>(&value), sizeof(T)));
+	}
+
+	template<typename T>
+	void writeCacheValue(std::ostream &os, const T &value)
+	{
+		os.write(reinterpret_cast<const char*>(&value), sizeof(T));
+	}
+
+	bool readLumiFilterCache(const std::string &json, std::map<run_id, std::set<std::pair<lumi_id, lumi_id> > > &lumifilter)
+	{
+		unsigned long long size = 0, cachedSize = 0;
+		long long mtime = 0, cachedMtime = 0;
+		if (!getFileStamp(json, size, mtime))
+			return false;
+		std::ifstream is((json + ".cache").c_str(), std::ios::binary);
+		char magic[sizeof(lumiFilterCacheMagic)];
+		if (!is.read(magic, sizeof(magic)) || !std::equal(magic, magic + sizeof(magic), lumiFilterCacheMagic))
+			return false;
+		unsigned long long nRanges = 0;
+		if (!readCacheValue(is, cachedSize) || !readCacheValue(is, cachedMtime) || !readCacheValue(is, nRanges))
+			return false;
+		if ((cachedSize != size) || (cachedMtime != mtime))
+			return false;
+
+		std::map<run_id, std::set<std::pair<lumi_id, lumi_id> > > cachedLumifilter;
+		for (unsigned long long i = 0; i < nRanges; ++i)
+		{
+			run_id run = 0;
+			lumi_id lumi_low = 0, lumi_high = 0;
+			if (!readCacheValue(is, run) || !readCacheValue(is, lumi_low) || !readCacheValue(is, lumi_high))
+				return false;
+			cachedLumifilter[run].insert(std::make_pair(lumi_low, lumi_high));
+		}
+		for (std::map<run_id, std::set<std::pair<lumi_id, lumi_id> > >::const_iterator itRun = cachedLumifilter.begin(); itRun != cachedLumifilter.end(); ++itRun)
+			lumifilter[itRun->first].insert(itRun->second.begin(), itRun->second.end());
+		return true;
+	}
+
+	// failures are ignored, the JSON file is simply parsed again the next time
+	void writeLumiFilterCache(const std::string &json, const std::map<run_id, std::set<std::pair<lumi_id, lumi_id> > > &lumifilter)
+	{
+		unsigned long long size = 0;
+		long long mtime = 0;
+		if (!getFileStamp(json, size, mtime))
+			return;
+		unsigned long long nRanges = 0;
+		for (std::map<run_id, std::set<std::pair<lumi_id, lumi_id> > >::const_iterator itRun = lumifilter.begin(); itRun != lumifilter.end(); ++itRun)
+			nRanges += itRun->second.size();
+
+		// written to a temporary file first, such that concurrent jobs never read a partial cache
+		const std::string cacheFileName = json + ".cache";
+		const std::string tmpFileName = cacheFileName + "." + KappaTools::str(getpid());
+		{
+			std::ofstream os(tmpFileName.c_str(), std::ios::binary);
+			os.write(lumiFilterCacheMagic, sizeof(lumiFilterCacheMagic));
+			writeCacheValue(os, size);
+			writeCacheValue(os, mtime);
+			writeCacheValue(os, nRanges);
+			for (std::map<run_id, std::set<std::pair<lumi_id, lumi_id> > >::const_iterator itRun = lumifilter.begin(); itRun != lumifilter.end(); ++itRun)
+				for (std::set<std::pair<lumi_id, lumi_id> >::const_iterator itLumis = itRun->second.begin(); itLumis != itRun->second.end(); ++itLumis)
+				{
+					writeCacheValue(os, itRun->first);
+					writeCacheValue(os, itLumis->first);
+					writeCacheValue(os, itLumis->second);
+				}
+			if (!os)
+			{
+				os.close();
+				remove(tmpFileName.c_str());
+				return;
+			}
+		}
+		if (rename(tmpFileName.c_str(), cacheFileName.c_str()) != 0)
+			remove(tmpFileName.c_str());
+	}
+}
+
+void readLumiFilter(const std::string json, std::map<run_id, std::set<std::pair<lumi_id, lumi_id> > > &lumifilter, const bool cache)
+{
+	if (!cache)
+	{
 		readLumiFilter(json, lumifilter);
+		return;
+	}
+	if (readLumiFilterCache(json, lumifilter))
+		return;
+
+	std::map<run_id, std::set<std::pair<lumi_id, lumi_id> > > jsonLumifilter;
+	readLumiFilter(json, jsonLumifilter);
+	writeLumiFilterCache(json, jsonLumifilter);
+	for (std::map<run_id, std::set<std::pair<lumi_id, lumi_id> > >::const_iterator itRun = jsonLumifilter.begin(); itRun != jsonLumifilter.end(); ++itRun)
+		lumifilter[itRun->first].insert(itRun->second.begin(), itRun->second.end());
 }
 
-RunLumiSelector::RunLumiSelector(const std::vector<std::string> &json, const run_id _passRunLow, const run_id _passRunHigh)
-	: passRunLow(_passRunLow), passRunHigh(_passRunHigh)
+RunLumiSelector::RunLumiSelector(const std::string json, const run_id _passRunLow, const run_id _passRunHigh, const bool _cacheJSON)
+	: passRunLow(_passRunLow), passRunHigh(_passRunHigh), cacheJSON(_cacheJSON)
+{
+	if (json != "")
+		readLumiFilter(json, lumifilter, cacheJSON);
+	buildIndex();
+}
+
+RunLumiSelector::RunLumiSelector(const std::vector<std::string> &json, const run_id _passRunLow, const run_id _passRunHigh, const bool _cacheJSON)
+	: passRunLow(_passRunLow), passRunHigh(_passRunHigh), cacheJSON(_cacheJSON)
 {
 	for (size_t i = 0; i < json.size(); ++i)
-		readLumiFilter(json[i], lumifilter);
+		readLumiFilter(json[i], lumifilter, cacheJSON);
+	buildIndex();
 }
 
 void RunLumiSelector::addJSONFile(const std::string json)
 {
-	readLumiFilter(json, lumifilter);
+	readLumiFilter(json, lumifilter, cacheJSON);
+	buildIndex();
+}
+
+// overlapping and adjacent ranges (e.g. from several JSON files) are merged
+void RunLumiSelector::buildIndex()
+{
+	indexRuns.clear();
+	indexRunOffsets.assign(1, 0);
+	indexLumis.clear();
+	for (std::map<run_id, std::set<std::pair<lumi_id, lumi_id> > >::const_iterator itRun = lumifilter.begin(); itRun != lumifilter.end(); ++itRun)
+	{
+		for (std::set<std::pair<lumi_id, lumi_id> >::const_iterator itLumis = itRun->second.begin(); itLumis != itRun->second.end(); ++itLumis)
+		{
+			if (itLumis->second < itLumis->first)
+				continue;
+			// compared with first - 1, since back().second + 1 overflows for ranges up to the largest lumi section
+			if ((indexLumis.size() > indexRunOffsets.back()) && ((itLumis->first == 0) || (itLumis->first - 1 <= indexLumis.back().second)))
+				indexLumis.back().second = std::max(indexLumis.back().second, itLumis->second);
+			else
+				indexLumis.push_back(*itLumis);
+		}
+		indexRuns.push_back(itRun->first);
+		indexRunOffsets.push_back(indexLumis.size());
+	}
 }
 
 bool RunLumiSelector::isCompatible(const FileInterface &fi) const
@@ -0,0 +1,37 @@
+
+/*
+ *
+ * micro-benchmarks of the framework overhead
+ *
+ * usage: artusBenchmark [number of iterations] [name pattern]
+ *
+ */
+
+#include <cstdlib>
+
+#include "Artus/Utility/interface/ArtusLogging.h"
+
+#include "Benchmark.h"
+
+#include "PipelineRunner_b.h"
+#include "LambdaNtupleConsumer_b.h"
+#include "SettingsBase_b.h"
+#include "RoccoR2016_b.h"
+#include "TmvaBdt_b.h"
+
+int main(int argc, char** argv)
+{
+	long long nIterations = (argc > 1) ? std::atoll(argv[1]) : 1000000;
+	std::string pattern = (argc > 2) ? argv[2] : "";
+
+	// only warnings and errors, the initialisation messages would spoil the output
+	el::Configurations loggingConfig;
+	loggingConfig.setToDefault();
+	loggingConfig.set(el::Level::Debug, el::ConfigurationType::Enabled, "false");
+	loggingConfig.set(el::Level::Info, el::ConfigurationType::Enabled, "false");
+	el::Loggers::reconfigureLogger("default", loggingConfig);
+
+	Benchmark::RunAll(nIterations, pattern);
+	return 0;
+}
+
@@ -70,3 +70,61 @@ BOOST_AUTO_TEST_CASE( test_parse_config )
 	BOOST_CHECK( nodesOne.begin()->GetProcessNodeType() == ProcessNodeType::Producer );
 }
 
+
+BOOST_AUTO_TEST_CASE( test_parse_config_shared_processors )
+{
+	std::stringstream configStream;
+
+	configStream
+	<<	"{"
+	<<	    "\"Processors\": [ \"producer:test_global_producer\" ],"
+	<<	    "\"InputFiles\": [ \"sample_ntuple.root\" ],"
+	<<	    "\"OutputPath\": \"sample_output.root\","
+	<<	    "\"ShareCommonPipelineProcessors\": true,"
+	<<	    "\"SystematicShiftProcessors\": { \"Shift\": [ \"filter:testfilter2\" ] },"
+	<<	    "\"Pipelines\": {"
+	<<	    "    \"nominal\": {"
+	<<	    "        \"Consumers\": [ \"test_consumer\" ],"
+	<<	    "        \"Processors\": [ \"producer:test_local_producer\", \"filter:testfilter\" ],"
+	<<	    "        \"Shift\": 0"
+	<<	    "    },"
+	<<	    "    \"shiftUp\": {"
+	<<	    "        \"Consumers\": [ \"test_consumer\" ],"
+	<<	    "        \"Processors\": [ \"producer:test_local_producer\", \"filter:testfilter\", \"filter:testfilter2\" ],"
+	<<	    "        \"Shift\": 1"
+	<<	    "    },"
+	<<	    "    \"otherCut\": {"
+	<<	    "        \"Consumers\": [ \"test_consumer\" ],"
+	<<	    "        \"Processors\": [ \"producer:test_local_producer\", \"filter:testfilter\" ],"
+	<<	    "        \"Cut\": 1"
+	<<	    "    }"
+	<<	    "}"
+	<<	"}";
+
+	ArtusConfig cfg ( configStream );
+
+	TestEventProvider evtProvider;
+	TestPipelineInitializer pInit;
+	TestFactory factory;
+	TestPipelineRunner runner(false);
+	runner.ClearProgressReports();
+
+	cfg.LoadConfiguration( pInit, runner, factory, nullptr);
+
+	// nominal and shiftUp share both processors in front of the one reading the shift,
+	// otherCut has different settings and runs all of its processors
+	auto & pLine = runner.GetPipelines();
+	BOOST_REQUIRE_EQUAL( pLine.size() , size_t(3) );
+
+	auto pLineIt = pLine.begin();
+	BOOST_CHECK_EQUAL( pLineIt->GetNodes().size() , size_t(0) );
+	++pLineIt;
+	BOOST_CHECK_EQUAL( pLineIt->GetNodes().size() , size_t(1) );
+	BOOST_CHECK( pLineIt->GetNodes().begin()->GetProcessNodeType() == ProcessNodeType::Filter );
+	++pLineIt;
+	BOOST_CHECK_EQUAL( pLineIt->GetNodes().size() , size_t(2) );
+
+	// the test consumers check the local product created by the shared stage
+	TestSettings settings;
+	runner.RunPipelines( evtProvider, settings );
+}
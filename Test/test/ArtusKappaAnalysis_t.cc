@@ -0,0 +1,22 @@
+
+/*
+ *
+ * unit tests of the KappaAnalysis, KappaTools and Utility helpers, which do not need any input files
+ *
+ * use "scram b runtests" to run this code
+ *
+ */
+
+#define BOOST_TEST_DYN_LINK
+#define BOOST_TEST_MAIN
+
+#define BOOST_TEST_MODULE ArtusKappaAnalysis
+
+#include "BTagCalibrationStandalone_t.h"
+#include "EventReader_t.h"
+#include "JECTools_t.h"
+#include "Matching_t.h"
+#include "MetadataIndices_t.h"
+#include "RunLumiEventFilter_t.h"
+#include "RunLumiReader_t.h"
+#include "TmvaBdt_t.h"
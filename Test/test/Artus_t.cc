@@ -16,4 +16,9 @@
 #include "PipelineRunner_t.h"
 #include "ArtusConfig_t.h"
 #include "SafeMap_t.h"
+#include "CopyOnWrite_t.h"
+#include "RunTimeStatistics_t.h"
+#include "QuantityCache_t.h"
+#include "EventWeights_t.h"
+#include "ObjectArena_t.h"
 
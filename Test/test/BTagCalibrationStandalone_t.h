@@ -0,0 +1,276 @@
+#pragma once
+
+#include <cmath>
+#include <cstdio>
+#include <fstream>
+#include <limits>
+#include <string>
+#include <vector>
+
+#include <unistd.h>
+
+#include <boost/test/included/unit_test.hpp>
+
+#include <TF1.h>
+#include <TFile.h>
+#include <TH2.h>
+
+#include "Artus/KappaAnalysis/interface/Utility/BTagCalibrationStandalone.h"
+#include "Artus/KappaAnalysis/interface/Utility/BTagSF.h"
+
+/*
+ Compare the compiled b-tag calibration formulas with TF1 and the binned lookup of
+ BTagCalibrationReader::eval with the linear scan over all entries it replaces. The
+ scale factors of all jets of an event have to agree with the ones of the single jets.
+*/
+
+BOOST_AUTO_TEST_CASE( test_btagformula )
+{
+	// formula shapes of the official CSVv2 and cMVAv2 calibration files
+	std::vector<std::string> ptFormulas({
+		"0.887973*((1.+(0.0523821*x))/(1.+(0.0460876*x)))",
+		"0.561694*((1.+(0.31439*x))/(1.+(0.17756*x)))",
+		"(0.938887+(0.00017124*x))+(-2.76366e-07*(x*x))",
+		"((1.0344+(0.000962994*x))+(-3.65392e-06*(x*x)))+(3.23525e-09*(x*(x*x)))",
+		"1.0589+0.000382569*x+-2.4252e-07*x*x+2.20966e-10*x*x*x",
+		"0.97841+-0.000206585*x+-3.25567e-07*x*x",
+		"-(0.0443172)+(0.00496634*(log(x+1267.85)*(log(x+1267.85)*(3-(-0.110428*log(x+1267.85))))))",
+		"0.887973*((1.+(0.0523821*x))/(1.+(0.0460876*x)))+0.0232182",
+		"(0.887973*((1.+(0.0523821*x))/(1.+(0.0460876*x))))-(0.0364717*(1.+(-0.00156318*x)))",
+		"1.08*exp(-0.0012*x)+sqrt(x)/100.-pow(x,0.1)*0.02+abs(0.5-log10(x))*0.01",
+		"max(0.5,min(1.2,0.9+0.001*x))",
+		"TMath::Max(0.5,TMath::Min(1.2,0.9+0.001*x))+TMath::Power(x,-0.5)",
+	});
+	for (std::string const& formula : ptFormulas)
+	{
+		BTagFormula compiledFormula(formula, 20., 1000.);
+		BOOST_CHECK_MESSAGE(compiledFormula.isCompiled(), formula);
+		TF1 function("", formula.c_str(), 20., 1000.);
+		for (double pt = 20.; pt <= 1000.; pt += 7.3)
+		{
+			BOOST_CHECK_CLOSE(compiledFormula.Eval(pt), function.Eval(pt), 1e-10);
+		}
+	}
+
+	// the bin trees of histograms are left to TF1
+	std::string binTree = "x<0.2 ? (x<0.1 ? 0.9:0.95) : (x<0.5 ? 1.05:1.1)";
+	BTagFormula binTreeFormula(binTree, 0., 1.);
+	BOOST_CHECK(! binTreeFormula.isCompiled());
+	TF1 binTreeFunction("", binTree.c_str(), 0., 1.);
+	for (double discr = 0.; discr < 1.; discr += 0.05)
+	{
+		BOOST_CHECK_EQUAL(binTreeFormula.Eval(discr), binTreeFunction.Eval(discr));
+	}
+
+	// incomplete formulas are not compiled either
+	BOOST_CHECK(! BTagFormula("0.9+", 0., 1.).isCompiled());
+	BOOST_CHECK(! BTagFormula("(0.9*x", 0., 1.).isCompiled());
+}
+
+// entry i of a calibration evaluates to i + 1
+inline double EvalBTagCalibrationByLoop(std::vector<BTagEntry::Parameters> const& entries, BTagEntry::JetFlavor jetFlavor,
+                                        bool useAbsEta, float eta, float pt, float discr)
+{
+	if (useAbsEta && (eta < 0))
+	{
+		eta = -eta;
+	}
+	for (size_t index = 0; index < entries.size(); ++index)
+	{
+		BTagEntry::Parameters const& entry = entries[index];
+		if ((entry.jetFlavor == jetFlavor) &&
+		    (entry.etaMin <= eta) && (eta < entry.etaMax) &&
+		    (entry.ptMin <= pt) && (pt < entry.ptMax))
+		{
+			if (entry.operatingPoint != BTagEntry::OP_RESHAPING)
+			{
+				return index + 1.0;
+			}
+			else if ((entry.discrMin <= discr) && (discr < entry.discrMax))
+			{
+				return index + 1.0;
+			}
+		}
+	}
+	return 0.0;
+}
+
+inline void CheckBTagCalibrationReader(BTagEntry::OperatingPoint operatingPoint, std::vector<BTagEntry::Parameters> const& entries)
+{
+	BTagCalibration calibration("csv");
+	for (size_t index = 0; index < entries.size(); ++index)
+	{
+		calibration.addEntry(BTagEntry(std::to_string(index + 1), entries[index]));
+	}
+	BTagCalibrationReader reader(&calibration, operatingPoint, "comb", "central");
+
+	// all edges, values next to the edges, values in between and values outside of all entries
+	std::vector<float> etas({ -3.0f, 0.0f, 3.0f, std::numeric_limits<float>::quiet_NaN() });
+	std::vector<float> pts({ -1.0f, 0.0f, 10000.0f, std::numeric_limits<float>::quiet_NaN() });
+	std::vector<float> discrs({ -1.0f, 0.0f, 0.5f, 1.0f, 2.0f });
+	for (BTagEntry::Parameters const& entry : entries)
+	{
+		for (float eta : { entry.etaMin, entry.etaMax, -entry.etaMin, -entry.etaMax })
+		{
+			etas.insert(etas.end(), { eta, std::nextafter(eta, -100.0f), std::nextafter(eta, 100.0f), eta + 0.05f });
+		}
+		for (float pt : { entry.ptMin, entry.ptMax })
+		{
+			pts.insert(pts.end(), { pt, std::nextafter(pt, -100.0f), std::nextafter(pt, 100000.0f), pt + 5.0f });
+		}
+		discrs.insert(discrs.end(), { entry.discrMin, entry.discrMax, std::nextafter(entry.discrMax, -100.0f) });
+	}
+
+	for (BTagEntry::JetFlavor jetFlavor : { BTagEntry::FLAV_B, BTagEntry::FLAV_C, BTagEntry::FLAV_UDSG })
+	{
+		bool useAbsEta = true;
+		for (BTagEntry::Parameters const& entry : entries)
+		{
+			if ((entry.jetFlavor == jetFlavor) && (entry.etaMin < 0))
+			{
+				useAbsEta = false;
+			}
+		}
+		for (float eta : etas)
+		{
+			for (float pt : pts)
+			{
+				for (float discr : discrs)
+				{
+					BOOST_CHECK_EQUAL(reader.eval(jetFlavor, eta, pt, discr), EvalBTagCalibrationByLoop(entries, jetFlavor, useAbsEta, eta, pt, discr));
+				}
+			}
+		}
+	}
+}
+
+BOOST_AUTO_TEST_CASE( test_btagcalibrationreader )
+{
+	// edge-touching bins in |eta| and pt as in the official files, overlapping bins, a bin within a bin,
+	// an entry with a signed eta range (c jets) and empty ranges
+	CheckBTagCalibrationReader(BTagEntry::OP_MEDIUM, {
+		BTagEntry::Parameters(BTagEntry::OP_MEDIUM, "comb", "central", BTagEntry::FLAV_B, 0.0f, 2.4f, 20.0f, 30.0f),
+		BTagEntry::Parameters(BTagEntry::OP_MEDIUM, "comb", "central", BTagEntry::FLAV_B, 0.0f, 2.4f, 30.0f, 50.0f),
+		BTagEntry::Parameters(BTagEntry::OP_MEDIUM, "comb", "central", BTagEntry::FLAV_B, 0.0f, 2.4f, 50.0f, 670.0f),
+		BTagEntry::Parameters(BTagEntry::OP_MEDIUM, "comb", "central", BTagEntry::FLAV_B, 0.0f, 1.2f, 25.0f, 1000.0f),
+		BTagEntry::Parameters(BTagEntry::OP_MEDIUM, "comb", "central", BTagEntry::FLAV_B, 0.8f, 1.6f, 40.0f, 45.0f),
+		BTagEntry::Parameters(BTagEntry::OP_MEDIUM, "comb", "central", BTagEntry::FLAV_B, 1.0f, 1.0f, 20.0f, 1000.0f),
+		BTagEntry::Parameters(BTagEntry::OP_MEDIUM, "comb", "central", BTagEntry::FLAV_C, -2.4f, 0.0f, 20.0f, 670.0f),
+		BTagEntry::Parameters(BTagEntry::OP_MEDIUM, "comb", "central", BTagEntry::FLAV_C, 0.0f, 2.4f, 20.0f, 670.0f),
+		BTagEntry::Parameters(BTagEntry::OP_MEDIUM, "comb", "central", BTagEntry::FLAV_C, -1.0f, 1.0f, 100.0f, 200.0f),
+		BTagEntry::Parameters(BTagEntry::OP_MEDIUM, "comb", "central", BTagEntry::FLAV_UDSG, 0.0f, 2.4f, 20.0f, 1000.0f),
+		BTagEntry::Parameters(BTagEntry::OP_MEDIUM, "comb", "central", BTagEntry::FLAV_UDSG, 1.5f, 3.0f, 0.0f, 20.0f),
+	});
+
+	// reshaping: several discriminator bins in the same eta and pt bin
+	CheckBTagCalibrationReader(BTagEntry::OP_RESHAPING, {
+		BTagEntry::Parameters(BTagEntry::OP_RESHAPING, "comb", "central", BTagEntry::FLAV_B, 0.0f, 0.8f, 20.0f, 30.0f, -0.1f, 0.5f),
+		BTagEntry::Parameters(BTagEntry::OP_RESHAPING, "comb", "central", BTagEntry::FLAV_B, 0.0f, 0.8f, 20.0f, 30.0f, 0.5f, 1.1f),
+		BTagEntry::Parameters(BTagEntry::OP_RESHAPING, "comb", "central", BTagEntry::FLAV_B, 0.0f, 2.4f, 20.0f, 1000.0f, -0.1f, 1.1f),
+		BTagEntry::Parameters(BTagEntry::OP_RESHAPING, "comb", "central", BTagEntry::FLAV_B, 0.8f, 2.4f, 30.0f, 1000.0f, 0.0f, 0.9f),
+		BTagEntry::Parameters(BTagEntry::OP_RESHAPING, "comb", "central", BTagEntry::FLAV_C, 0.0f, 2.4f, 20.0f, 1000.0f, -0.1f, 1.1f),
+		BTagEntry::Parameters(BTagEntry::OP_RESHAPING, "comb", "central", BTagEntry::FLAV_UDSG, 0.0f, 2.4f, 20.0f, 1000.0f, -0.1f, 1.1f),
+	});
+}
+
+BOOST_AUTO_TEST_CASE( test_btagsf_scalefactors )
+{
+	char directoryTemplate[] = "/tmp/BTagSF_t.XXXXXX";
+	BOOST_REQUIRE(mkdtemp(directoryTemplate) != nullptr);
+	std::string directory = directoryTemplate;
+
+	// calibration of the medium working point in the format of the official files
+	BTagCalibration calibration("csvv2");
+	for (std::string sysType : { "central", "up", "down" })
+	{
+		std::string shift = ((sysType == "up") ? "+0.05" : ((sysType == "down") ? "-0.04" : ""));
+		for (BTagEntry::JetFlavor jetFlavor : { BTagEntry::FLAV_B, BTagEntry::FLAV_C })
+		{
+			calibration.addEntry(BTagEntry("0.92+0.0003*x" + shift, BTagEntry::Parameters(BTagEntry::OP_MEDIUM, "comb", sysType, jetFlavor, 0.0f, 2.4f, 20.0f, 100.0f)));
+			calibration.addEntry(BTagEntry("1.05-0.0002*x" + shift, BTagEntry::Parameters(BTagEntry::OP_MEDIUM, "comb", sysType, jetFlavor, 0.0f, 2.4f, 100.0f, 670.0f)));
+		}
+		calibration.addEntry(BTagEntry("1.1-0.0001*x" + shift, BTagEntry::Parameters(BTagEntry::OP_MEDIUM, "incl", sysType, BTagEntry::FLAV_UDSG, 0.0f, 1.2f, 20.0f, 1000.0f)));
+		calibration.addEntry(BTagEntry("1.2-0.0002*x" + shift, BTagEntry::Parameters(BTagEntry::OP_MEDIUM, "incl", sysType, BTagEntry::FLAV_UDSG, 1.2f, 2.4f, 20.0f, 1000.0f)));
+	}
+	std::string calibrationFileName = directory + "/calibration.csv";
+	{
+		std::ofstream calibrationFile(calibrationFileName.c_str());
+		calibration.makeCSV(calibrationFile);
+	}
+
+	// efficiencies of b, c and other jets in bins of pt and |eta|
+	std::string efficiencyFileName = directory + "/efficiencies.root";
+	{
+		TFile efficiencyFile(efficiencyFileName.c_str(), "RECREATE");
+		std::vector<std::string> histogramNames({ "btag_eff_b", "btag_eff_c", "btag_eff_oth" });
+		for (size_t flavourIndex = 0; flavourIndex < histogramNames.size(); ++flavourIndex)
+		{
+			TH2D* efficiencies = new TH2D(histogramNames[flavourIndex].c_str(), "", 10, 20.0, 520.0, 4, 0.0, 2.4);
+			for (int ptBin = 1; ptBin <= 10; ++ptBin)
+			{
+				for (int etaBin = 1; etaBin <= 4; ++etaBin)
+				{
+					efficiencies->SetBinContent(ptBin, etaBin, 0.6 / (flavourIndex + 1.0) + 0.01 * ptBin - 0.02 * etaBin);
+				}
+			}
+		}
+		efficiencyFile.Write();
+		efficiencyFile.Close();
+	}
+
+	BTagSF bTagSF(calibrationFileName, efficiencyFileName, "medium");
+
+	// jets within and outside of the calibrated pt and eta ranges
+	std::vector<double> pts;
+	std::vector<float> etas;
+	std::vector<int> jetFlavours;
+	for (int jetFlavour : { 5, -5, 4, -4, 0, 1, 21 })
+	{
+		for (double pt : { 10.0, 20.0, 25.0, 99.9, 100.0, 450.0, 670.0, 700.0, 999.0, 1500.0 })
+		{
+			for (float eta : { -2.5f, -1.3f, 0.0f, 0.7f, 1.2f, 2.3f })
+			{
+				pts.push_back(pt);
+				etas.push_back(eta);
+				jetFlavours.push_back(jetFlavour);
+			}
+		}
+	}
+
+	std::vector<BTagSF::ScaleFactor> scaleFactors;
+	for (int year : { 2016, 2012 })
+	{
+		bTagSF.getScaleFactors(pts, etas, jetFlavours, year, scaleFactors);
+		BOOST_REQUIRE_EQUAL(scaleFactors.size(), pts.size());
+		for (size_t jet = 0; jet < pts.size(); ++jet)
+		{
+			for (unsigned int sys : { BTagSF::kNo, BTagSF::kUp, BTagSF::kDown })
+			{
+				double scaleFactor = 0.0;
+				if (std::abs(jetFlavours[jet]) == 5)
+					scaleFactor = bTagSF.getSFb(pts[jet], etas[jet], sys, year);
+				else if (std::abs(jetFlavours[jet]) == 4)
+					scaleFactor = bTagSF.getSFc(pts[jet], etas[jet], sys, year);
+				else
+					scaleFactor = bTagSF.getSFl(pts[jet], etas[jet], sys, year);
+				BOOST_CHECK_EQUAL(scaleFactors[jet].get(sys), scaleFactor);
+			}
+
+			// the promotion/demotion does not depend on the way the scale factor is evaluated
+			for (float csv : { 0.5f, 0.9f })
+			{
+				for (unsigned int sys : { BTagSF::kNo, BTagSF::kUp, BTagSF::kDown })
+				{
+					bool heavyFlavour = ((std::abs(jetFlavours[jet]) == 5) || (std::abs(jetFlavours[jet]) == 4));
+					BOOST_CHECK_EQUAL(bTagSF.isbtaggedWithSF(pts[jet], etas[jet], csv, jetFlavours[jet], scaleFactors[jet].get(sys), year, 0.8f),
+					                  bTagSF.isbtagged(pts[jet], etas[jet], csv, jetFlavours[jet],
+					                                   (heavyFlavour ? sys : BTagSF::kNo), (heavyFlavour ? BTagSF::kNo : sys), year, 0.8f));
+				}
+			}
+		}
+	}
+
+	std::remove(calibrationFileName.c_str());
+	std::remove(efficiencyFileName.c_str());
+	rmdir(directory.c_str());
+}
@@ -0,0 +1,90 @@
+
+#pragma once
+
+#include <algorithm>
+#include <chrono>
+#include <iomanip>
+#include <iostream>
+#include <string>
+#include <vector>
+
+/*
+Minimal framework for the micro-benchmarks collected in ArtusBenchmark.cc.
+
+A benchmark is a function processing a given number of iterations (e.g. events):
+
+    ARTUS_BENCHMARK( benchmark_something )
+    {
+        for (long long iteration = 0; iteration < nIterations; ++iteration) { ... }
+    }
+
+The benchmarks are timed as a whole and the average time per iteration is reported.
+*/
+class Benchmark
+{
+public:
+	typedef void (*benchmark_function)(long long nIterations);
+
+	Benchmark(std::string const& name, benchmark_function function) :
+		m_name(name),
+		m_function(function)
+	{
+		GetBenchmarks().push_back(this);
+	}
+
+	std::string const& GetName() const
+	{
+		return m_name;
+	}
+
+	/// Run the benchmark and return the average time per iteration in nanoseconds.
+	double Run(long long nIterations) const
+	{
+		// warm up caches and lazily initialised objects
+		m_function(std::max(nIterations / 100, 1LL));
+
+		std::chrono::steady_clock::time_point start = std::chrono::steady_clock::now();
+		m_function(nIterations);
+		std::chrono::steady_clock::time_point end = std::chrono::steady_clock::now();
+
+		return std::chrono::duration<double, std::nano>(end - start).count() / std::max(nIterations, 1LL);
+	}
+
+	/// Run all registered benchmarks whose names contain the given pattern.
+	static void RunAll(long long nIterations, std::string const& pattern = "")
+	{
+		for (Benchmark const* benchmark : GetBenchmarks())
+		{
+			if (benchmark->GetName().find(pattern) != std::string::npos)
+			{
+				double nsPerIteration = benchmark->Run(nIterations);
+				std::cout << std::left << std::setw(72) << benchmark->GetName()
+				          << std::right << std::setw(12) << std::fixed << std::setprecision(1)
+				          << nsPerIteration << " ns/iteration" << std::endl;
+			}
+		}
+	}
+
+	/// Keep the compiler from optimising away the computation of a result.
+	template<class T>
+	static void DoNotOptimise(T const& value)
+	{
+		asm volatile("" : : "g"(&value) : "memory");
+	}
+
+	static std::vector<Benchmark const*>& GetBenchmarks()
+	{
+		static std::vector<Benchmark const*> benchmarks;
+		return benchmarks;
+	}
+
+private:
+	std::string m_name;
+	benchmark_function m_function;
+};
+
+#define ARTUS_BENCHMARK(name) \
+	static void name(long long nIterations); \
+	static Benchmark name##_benchmark(#name, &name); \
+	static void name(long long nIterations)
+
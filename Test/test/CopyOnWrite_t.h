@@ -0,0 +1,39 @@
+
+#pragma once
+
+#include <map>
+#include <string>
+
+#include <boost/test/included/unit_test.hpp>
+
+#include "Artus/Utility/interface/CopyOnWrite.h"
+
+BOOST_AUTO_TEST_CASE(test_copyonwrite)
+{
+	CopyOnWrite<std::map<int, std::string> > globalMap;
+	globalMap.GetMutable()[42] = "42";
+	BOOST_CHECK(! globalMap.IsShared());
+
+	// copies share the value until they are modified
+	CopyOnWrite<std::map<int, std::string> > localMap(globalMap);
+	BOOST_CHECK(localMap.IsShared());
+	BOOST_CHECK(&localMap.Get() == &globalMap.Get());
+	BOOST_CHECK(localMap->at(42) == "42");
+
+	localMap.GetMutable()[23] = "23";
+	BOOST_CHECK(! localMap.IsShared());
+	BOOST_CHECK(! globalMap.IsShared());
+	BOOST_CHECK(localMap->size() == 2);
+	BOOST_CHECK(globalMap->size() == 1);
+
+	// resetting a shared value does not touch the other copies
+	CopyOnWrite<std::map<int, std::string> > resetMap(globalMap);
+	BOOST_CHECK(resetMap.Reset().empty());
+	BOOST_CHECK(globalMap->size() == 1);
+
+	// assignment shares the value again
+	localMap = globalMap;
+	BOOST_CHECK(localMap.IsShared());
+	BOOST_CHECK(localMap->size() == 1);
+}
+
@@ -0,0 +1,231 @@
+#pragma once
+
+#include <chrono>
+#include <cstdio>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include <unistd.h>
+
+#include <boost/test/included/unit_test.hpp>
+
+#include <TFile.h>
+#include <TTree.h>
+
+#include "Kappa/DataFormats/interface/Kappa.h"
+#include "Artus/KappaTools/interface/EventReader.h"
+#include "Artus/KappaTools/interface/FileInterface2.h"
+
+/*
+ Read two small Kappa files through the EventReader with and without read-ahead: the events,
+ lumi sections and runs have to be delivered in the requested order, also after jumping between
+ the entries, and the reader thread has to stop with events still being read.
+*/
+
+struct EventReaderTestEvent
+{
+	run_id run;
+	lumi_id lumi;
+};
+
+class EventReaderTestFiles {
+public:
+	// file 0: run 1 with lumi sections 1 (3 events) and 2 (2 events)
+	// file 1: run 2 with lumi sections 1 (3 events) and 3 (2 events)
+	EventReaderTestFiles() :
+		events({ {1, 1}, {1, 1}, {1, 1}, {1, 2}, {1, 2}, {2, 1}, {2, 1}, {2, 1}, {2, 3}, {2, 3} })
+	{
+		char directoryTemplate[] = "/tmp/EventReader_t.XXXXXX";
+		BOOST_REQUIRE(mkdtemp(directoryTemplate) != nullptr);
+		directory = directoryTemplate;
+		WriteFile(0, 5);
+		WriteFile(5, 10);
+	}
+
+	~EventReaderTestFiles()
+	{
+		for (std::string const& fileName : fileNames)
+		{
+			std::remove(fileName.c_str());
+		}
+		rmdir(directory.c_str());
+	}
+
+	std::vector<EventReaderTestEvent> events;
+	std::vector<std::string> fileNames;
+
+private:
+	// events with the numbers firstEntry + 1 to lastEntry
+	void WriteFile(size_t firstEntry, size_t lastEntry)
+	{
+		std::string fileName = directory + "/kappa_" + std::to_string(fileNames.size()) + ".root";
+		fileNames.push_back(fileName);
+		TFile file(fileName.c_str(), "RECREATE");
+
+		KEventInfo* eventInfo = new KEventInfo();
+		TTree* eventTree = new TTree("Events", "Events");
+		eventTree->Branch("eventInfo", &eventInfo);
+		KLumiInfo* lumiInfo = new KLumiInfo();
+		TTree* lumiTree = new TTree("Lumis", "Lumis");
+		lumiTree->Branch("lumiInfo", &lumiInfo);
+		KRunInfo* runInfo = new KRunInfo();
+		TTree* runTree = new TTree("Runs", "Runs");
+		runTree->Branch("runInfo", &runInfo);
+
+		for (size_t entry = firstEntry; entry < lastEntry; ++entry)
+		{
+			eventInfo->nRun = events[entry].run;
+			eventInfo->nLumi = events[entry].lumi;
+			eventInfo->nEvent = entry + 1;
+			eventTree->Fill();
+
+			if ((entry == firstEntry) || (events[entry].lumi != events[entry - 1].lumi))
+			{
+				lumiInfo->nRun = events[entry].run;
+				lumiInfo->nLumi = events[entry].lumi;
+				lumiTree->Fill();
+			}
+			if (entry == firstEntry)
+			{
+				runInfo->nRun = events[entry].run;
+				runTree->Fill();
+			}
+		}
+
+		file.Write();
+		file.Close();
+		delete eventInfo;
+		delete lumiInfo;
+		delete runInfo;
+	}
+
+	std::string directory;
+};
+
+class EventReaderTest {
+public:
+	EventReaderTest(EventReaderTestFiles const& files, size_t nPrefetchedEvents) :
+		files(files),
+		fileInterface(files.fileNames, nullptr, false, 0),
+		reader(fileInterface, nPrefetchedEvents)
+	{
+		eventInfo = reader.AddEventObject(fileInterface.GetEvent<KEventInfo>("eventInfo"));
+		lumiInfo = reader.AddLumiObject(fileInterface.GetLumi<KLumiInfo>("lumiInfo"));
+		runInfo = reader.AddRunObject(fileInterface.GetRun<KRunInfo>("runInfo"));
+	}
+
+	// read an entry and check the objects seen by the analysis and the changes
+	// of the file, run and lumi section with respect to the previously read entry
+	void CheckEntry(long long entry)
+	{
+		EventReader::EntryInfo const* entryInfo = reader.GetEntry(entry);
+		BOOST_REQUIRE(entryInfo != nullptr);
+		BOOST_REQUIRE_MESSAGE(entryInfo->nBytes > 0, "entry " << entry);
+		BOOST_CHECK_EQUAL(static_cast<long long>(eventInfo->nEvent), entry + 1);
+		BOOST_CHECK_EQUAL(eventInfo->nRun, files.events[entry].run);
+		BOOST_CHECK_EQUAL(eventInfo->nLumi, files.events[entry].lumi);
+		BOOST_CHECK_EQUAL(lumiInfo->nRun, files.events[entry].run);
+		BOOST_CHECK_EQUAL(lumiInfo->nLumi, files.events[entry].lumi);
+		BOOST_CHECK_EQUAL(runInfo->nRun, files.events[entry].run);
+
+		const int treeNumber = (entry < 5) ? 0 : 1;
+		const bool newTree = ((previousEntry < 0) || (treeNumber != ((previousEntry < 5) ? 0 : 1)));
+		const bool newRun = (newTree || (files.events[entry].run != files.events[previousEntry].run));
+		const bool newLumisection = (newRun || (files.events[entry].lumi != files.events[previousEntry].lumi));
+		BOOST_CHECK_EQUAL(entryInfo->treeNumber, treeNumber);
+		BOOST_CHECK_MESSAGE(entryInfo->newTree == newTree, "entry " << entry << " after entry " << previousEntry);
+		BOOST_CHECK_MESSAGE(entryInfo->newRun == newRun, "entry " << entry << " after entry " << previousEntry);
+		BOOST_CHECK_MESSAGE(entryInfo->newLumisection == newLumisection, "entry " << entry << " after entry " << previousEntry);
+		BOOST_CHECK_EQUAL(entryInfo->fileName, newTree ? files.fileNames[treeNumber] : std::string());
+		previousEntry = entry;
+	}
+
+	// read an entry beyond the end of the chain
+	void CheckEndOfChain(long long entry)
+	{
+		EventReader::EntryInfo const* entryInfo = reader.GetEntry(entry);
+		BOOST_REQUIRE(entryInfo != nullptr);
+		BOOST_CHECK_EQUAL(entryInfo->nBytes, 0);
+	}
+
+	EventReaderTestFiles const& files;
+	FileInterface2 fileInterface;
+	EventReader reader;
+	KEventInfo* eventInfo = nullptr;
+	KLumiInfo* lumiInfo = nullptr;
+	KRunInfo* runInfo = nullptr;
+	long long previousEntry = -1;
+};
+
+BOOST_AUTO_TEST_CASE( test_eventreader_in_order )
+{
+	EventReaderTestFiles files;
+	for (size_t nPrefetchedEvents : { 0, 1, 3, 20 })
+	{
+		EventReaderTest test(files, nPrefetchedEvents);
+
+		// without read-ahead, the analysis uses the branch objects
+		BOOST_CHECK_EQUAL((test.eventInfo == test.fileInterface.GetEvent<KEventInfo>("eventInfo")), (nPrefetchedEvents == 0));
+
+		// new files in entries 0 and 5, new lumi sections in entries 3 and 8
+		for (long long entry = 0; entry < static_cast<long long>(files.events.size()); ++entry)
+		{
+			test.CheckEntry(entry);
+		}
+		test.CheckEndOfChain(files.events.size());
+	}
+}
+
+BOOST_AUTO_TEST_CASE( test_eventreader_seek )
+{
+	EventReaderTestFiles files;
+	for (size_t nPrefetchedEvents : { 0, 3, 20 })
+	{
+		EventReaderTest test(files, nPrefetchedEvents);
+
+		// the events read ahead are discarded by requests out of order,
+		// also while the reader thread is still reading them
+		for (bool waitForReader : { false, true })
+		{
+			for (long long entry : { 0, 7, 2, 3, 4, 9, 1, 8, 8, 5, 6 })
+			{
+				test.CheckEntry(entry);
+				if (waitForReader)
+				{
+					std::this_thread::sleep_for(std::chrono::milliseconds(20));
+				}
+			}
+		}
+
+		// continue after the end of the chain
+		test.CheckEntry(9);
+		test.CheckEndOfChain(10);
+		test.CheckEndOfChain(10);
+		test.CheckEntry(4);
+		test.CheckEntry(5);
+	}
+}
+
+BOOST_AUTO_TEST_CASE( test_eventreader_shutdown )
+{
+	EventReaderTestFiles files;
+
+	// the reader thread is stopped before any entry has been requested,
+	// while it is reading ahead and after the end of the chain
+	for (size_t nPrefetchedEvents : { 0, 5, 20 })
+	{
+		{
+			EventReaderTest test(files, nPrefetchedEvents);
+		}
+		{
+			EventReaderTest test(files, nPrefetchedEvents);
+			test.CheckEntry(0);
+		}
+		{
+			EventReaderTest test(files, nPrefetchedEvents);
+			test.CheckEntry(9);
+			test.CheckEndOfChain(10);
+		}
+	}
+}
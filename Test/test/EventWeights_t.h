@@ -0,0 +1,43 @@
+#pragma once
+
+#include <string>
+#include <vector>
+
+#include <boost/test/included/unit_test.hpp>
+
+#include "Artus/Core/interface/EventWeights.h"
+
+BOOST_AUTO_TEST_CASE( test_eventweights )
+{
+	size_t puWeightIndex = EventWeights::GetIndex("test_eventweights_puWeight");
+	size_t generatorWeightIndex = EventWeights::GetIndex("test_eventweights_generatorWeight");
+	BOOST_CHECK(puWeightIndex != generatorWeightIndex);
+	BOOST_CHECK_EQUAL(EventWeights::GetIndex("test_eventweights_puWeight"), puWeightIndex);
+	BOOST_CHECK_EQUAL(EventWeights::GetName(generatorWeightIndex), "test_eventweights_generatorWeight");
+
+	EventWeights weights;
+	BOOST_CHECK(! weights.Contains(puWeightIndex));
+	BOOST_CHECK_EQUAL(weights.GetWithDefault(puWeightIndex, 2.0), 2.0);
+	BOOST_CHECK_EQUAL(weights.GetProduct(), 1.0);
+
+	weights.Set(generatorWeightIndex, 0.5);
+	BOOST_CHECK(weights.Contains(generatorWeightIndex));
+	BOOST_CHECK(! weights.Contains(puWeightIndex));
+	BOOST_CHECK_EQUAL(weights.GetWithDefault("test_eventweights_generatorWeight", 1.0), 0.5);
+
+	weights.Set("test_eventweights_puWeight", 3.0);
+	BOOST_CHECK_EQUAL(weights.GetWithDefault(puWeightIndex, 1.0), 3.0);
+	BOOST_CHECK_EQUAL(weights.GetProduct(), 1.5);
+
+	std::vector<size_t> indices = weights.GetIndices();
+	BOOST_REQUIRE_EQUAL(indices.size(), 2);
+	BOOST_CHECK(((indices[0] == puWeightIndex) && (indices[1] == generatorWeightIndex)) ||
+	            ((indices[0] == generatorWeightIndex) && (indices[1] == puWeightIndex)));
+
+	// copies take over all weights, as the local products of the pipelines
+	EventWeights localWeights;
+	localWeights.Set(EventWeights::GetIndex("test_eventweights_localWeight"), 4.0);
+	localWeights = weights;
+	BOOST_CHECK(! localWeights.Contains("test_eventweights_localWeight"));
+	BOOST_CHECK_EQUAL(localWeights.GetProduct(), 1.5);
+}
@@ -127,3 +127,46 @@ BOOST_AUTO_TEST_CASE( test_filter_result_copy_constr )
 	BOOST_CHECK( fres_local.GetFilterDecision("local1") == FilterResult::Decision::Passed );
 }
 
+
+BOOST_AUTO_TEST_CASE( test_filter_result_extend_filter_names )
+{
+	FilterResult::FilterNames globalNames;
+	for (size_t filterIndex = 0; filterIndex < 70; ++filterIndex)
+	{
+		globalNames.push_back( "global_filter" + std::to_string(filterIndex) );
+	}
+	FilterResult::FilterNames taggingNames;
+	taggingNames.push_back( "local_tagging" );
+
+	FilterResult fres_global( globalNames );
+	FilterResult fres_local;
+	fres_local.ExtendFilterNames( fres_global, FilterResult::FilterNames( { "local1", "local_tagging" } ), taggingNames );
+
+	BOOST_CHECK( fres_local.ExtendsFilterNames( fres_global ) );
+	BOOST_CHECK( fres_local.GetNumberOfFilters() == 72 );
+	BOOST_CHECK( fres_local.GetFilterIndex( "global_filter69" ) == 69 );
+	BOOST_CHECK( fres_local.GetFilterIndex( "local1" ) == 70 );
+	BOOST_CHECK( fres_local.GetFilterIndex( "unknown" ) == FilterResult::NotFound );
+	BOOST_CHECK( fres_local.GetTaggingMode( 71 ) == FilterResult::TaggingMode::Tagging );
+
+	// copies of the global result share the filter names
+	FilterResult fres_event( fres_global );
+	fres_event.SetFilterDecision( 65, false );
+	fres_local.SetFilterDecision( 70, true );
+	fres_local.CopyDecisions( fres_event );
+
+	BOOST_CHECK( fres_local.GetFilterDecision( "global_filter65" ) == FilterResult::Decision::NotPassed );
+	BOOST_CHECK( fres_local.GetFilterDecision( "local1" ) == FilterResult::Decision::Undefined );
+	BOOST_CHECK( fres_local.HasPassed() == false );
+	BOOST_CHECK( fres_local.HasPassedIfExcludingFilter( 65 ) == true );
+
+	// tagging filters do not affect the overall result
+	fres_local.SetFilterDecision( 65, true );
+	fres_local.SetFilterDecision( "local_tagging", false );
+	BOOST_CHECK( fres_local.HasPassed() == true );
+
+	// adding names to the global result invalidates the extension
+	fres_global.AddFilterName( "global_filter70" );
+	BOOST_CHECK( ! fres_local.ExtendsFilterNames( fres_global ) );
+}
+
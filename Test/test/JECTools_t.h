@@ -0,0 +1,322 @@
+#pragma once
+
+#include <cmath>
+#include <cstdio>
+#include <fstream>
+#include <memory>
+#include <string>
+#include <vector>
+
+#include <unistd.h>
+
+#include <boost/test/included/unit_test.hpp>
+
+#include "Kappa/DataFormats/interface/Kappa.h"
+
+#define USE_JEC
+#include "Artus/KappaTools/interface/JECTools.h"
+
+/*
+ Correct jets with a synthetic set of JEC parameters in the format of the official files through
+ the JECBatchEvaluator, with and without the JEC tables, and compare the corrected jets and the
+ uncertainties with the corrections of correctJets (FactorizedJetCorrector/JetCorrectionUncertainty).
+*/
+
+class JECToolsTestFiles {
+public:
+	JECToolsTestFiles()
+	{
+		char directoryTemplate[] = "/tmp/JECTools_t.XXXXXX";
+		BOOST_REQUIRE(mkdtemp(directoryTemplate) != nullptr);
+		directory = directoryTemplate;
+
+		// pile-up offset depending on rho, pt and area
+		WriteFile("L1FastJet", "{1 JetEta 3 Rho JetPt JetA max(0.0001,1-z*([0]+[1]*(x-1.5)*(1+[2]*log(y)))/y) Correction L1FastJet}",
+		          { "-5.4 -2.5 9 0 40 1 3000 0 5 0.8 0.35 0.02",
+		            "-2.5 0 9 0 40 1 3000 0 5 -0.2 0.6 0.04",
+		            "0 2.5 9 0 40 1 3000 0 5 -0.3 0.55 0.03",
+		            "2.5 5.4 9 0 40 1 3000 0 5 0.7 0.4 0.01" });
+
+		// relative correction in eta (without the outermost jets), the pt is clamped to 10-1000 GeV
+		WriteFile("L2Relative", "{1 JetEta 1 JetPt [0]+[1]*pow(log10(x),2)+[2]*exp(-[3]*x) Correction L2Relative}",
+		          { "-4.7 -3 6 10 1000 1.2 -0.02 0.3 0.05",
+		            "-3 -1.3 6 10 1000 1.1 -0.015 0.2 0.04",
+		            "-1.3 0 6 10 1000 1.05 -0.01 0.15 0.03",
+		            "0 1.3 6 10 1000 1.04 -0.008 0.16 0.035",
+		            "1.3 3 6 10 1000 1.09 -0.014 0.22 0.045",
+		            "3 4.7 6 10 1000 1.22 -0.021 0.28 0.06" });
+
+		WriteFile("L3Absolute", "{1 JetEta 1 JetPt 1 Correction L3Absolute}",
+		          { "-5.4 5.4 2 4 5000" });
+
+		// residual correction in bins of eta and phi
+		WriteFile("L2L3Residual", "{2 JetEta JetPhi 1 JetPt [0]*(1+[1]*TMath::Log(TMath::Max(x,20.)))^2-[2]/x Correction L2L3Residual}",
+		          { "-5.4 0 -3.15 0 5 8 6000 0.98 0.004 1.5",
+		            "-5.4 0 0 3.15 5 8 6000 0.99 0.003 -1.2",
+		            "0 5.4 -3.15 3.15 5 8 6000 1.01 -0.002 0.8" });
+
+		// uncertainties in two sections, the second one is used
+		std::ofstream uncertainties(GetFileName("Uncertainty").c_str());
+		for (const char* section : { "Total", "FlavorQCD" })
+		{
+			const float scale = ((std::string(section) == "Total") ? 2.0f : 1.0f);
+			uncertainties << "[" << section << "]" << std::endl;
+			uncertainties << "{1 JetEta 1 JetPt \"\" Correction Uncertainty}" << std::endl;
+			for (int bin = 0; bin < 6; ++bin)
+			{
+				uncertainties << (-5.4 + 1.8 * bin) << " " << (-3.6 + 1.8 * bin) << " 12";
+				uncertainties << " 10 " << scale * (0.05 + 0.002 * bin) << " " << scale * (0.06 + 0.002 * bin);
+				uncertainties << " 30 " << scale * (0.03 + 0.002 * bin) << " " << scale * (0.035 + 0.002 * bin);
+				uncertainties << " 100 " << scale * (0.02 + 0.001 * bin) << " " << scale * (0.022 + 0.001 * bin);
+				uncertainties << " 1000 " << scale * (0.015 + 0.001 * bin) << " " << scale * (0.016 + 0.001 * bin) << std::endl;
+			}
+		}
+		fileNames.push_back(GetFileName("Uncertainty"));
+	}
+
+	~JECToolsTestFiles()
+	{
+		for (std::string const& fileName : fileNames)
+		{
+			std::remove(fileName.c_str());
+		}
+		rmdir(directory.c_str());
+	}
+
+	std::string GetFileName(std::string const& name) const
+	{
+		return directory + "/" + name + ".txt";
+	}
+
+	std::vector<JetCorrectorParameters> GetCorrectionParameters() const
+	{
+		std::vector<JetCorrectorParameters> parameters;
+		for (const char* level : { "L1FastJet", "L2Relative", "L3Absolute", "L2L3Residual" })
+		{
+			parameters.push_back(JetCorrectorParameters(GetFileName(level)));
+		}
+		return parameters;
+	}
+
+	JetCorrectorParameters GetUncertaintyParameters() const
+	{
+		return JetCorrectorParameters(GetFileName("Uncertainty"), "FlavorQCD");
+	}
+
+	void WriteFile(std::string const& name, std::string const& definition, std::vector<std::string> const& records)
+	{
+		fileNames.push_back(GetFileName(name));
+		std::ofstream file(fileNames.back().c_str());
+		file << definition << std::endl;
+		for (std::string const& record : records)
+		{
+			file << record << std::endl;
+		}
+	}
+
+private:
+	std::string directory;
+	std::vector<std::string> fileNames;
+};
+
+// jets in all bins and outside of them, with pt and area below and above the ranges of the parameters
+inline std::vector<KBasicJet> GetJECToolsTestJets()
+{
+	std::vector<KBasicJet> jets;
+	for (int index = 0; index < 60; ++index)
+	{
+		KBasicJet jet;
+		jet.p4 = RMFLV(2.0f + std::fmod(index * 37.3f, 1400.0f), -5.9f + std::fmod(index * 0.613f, 11.8f),
+		               -3.1f + std::fmod(index * 1.37f, 6.2f), 1.0f + std::fmod(index * 2.1f, 20.0f));
+		jet.area = 0.3f + std::fmod(index * 0.117f, 0.6f);
+		jets.push_back(jet);
+	}
+	return jets;
+}
+
+// the tables evaluate the formulas with the same operations, up to the rounding of the functions
+inline bool IsJECToolsTestClose(float value, float expected, bool useTables)
+{
+	return (useTables ? (std::abs(value - expected) <= 1e-6f * std::abs(expected)) : (value == expected));
+}
+
+inline void CheckJECBatchEvaluator(JECToolsTestFiles const& files, bool useTables)
+{
+	const double rho = 17.3;
+	const int npv = 23;
+	std::vector<JetCorrectorParameters> correctionParameters = files.GetCorrectionParameters();
+	JetCorrectorParameters uncertaintyParameters = files.GetUncertaintyParameters();
+	FactorizedJetCorrector jec(correctionParameters);
+	JetCorrectionUncertainty unc(uncertaintyParameters);
+
+	JECBatchEvaluator evaluator(&jec, &unc);
+	if (useTables)
+	{
+		std::shared_ptr<const JECCorrectionTables> correctionTables = std::make_shared<const JECCorrectionTables>(correctionParameters);
+		std::shared_ptr<const JECUncertaintyTable> uncertaintyTable = std::make_shared<const JECUncertaintyTable>(uncertaintyParameters);
+		BOOST_REQUIRE_MESSAGE(correctionTables->getUnsupported().empty(), correctionTables->getUnsupported());
+		BOOST_REQUIRE_MESSAGE(uncertaintyTable->getUnsupported().empty(), uncertaintyTable->getUnsupported());
+		evaluator.setTables(correctionTables, uncertaintyTable);
+	}
+
+	const std::vector<KBasicJet> jets = GetJECToolsTestJets();
+	JECBatchResult result;
+	for (float shift : { 0.0f, 1.0f, -1.0f, 0.5f })
+	{
+		std::vector<KBasicJet> expectedJets = jets;
+		correctJets(&expectedJets, &jec, &unc, rho, npv, -1, shift, false);
+
+		// the result of the first shift is reused
+		std::vector<KBasicJet> batchJets = jets;
+		std::vector<KBasicJet*> batchJetPointers;
+		for (KBasicJet& jet : batchJets)
+		{
+			batchJetPointers.push_back(&jet);
+		}
+		evaluator.evaluate(batchJetPointers, rho, npv, -1, result);
+		evaluator.apply(batchJetPointers, result, -1, shift);
+
+		for (size_t jetIndex = 0; jetIndex < jets.size(); ++jetIndex)
+		{
+			RMFLV const& expected = expectedJets[jetIndex].p4;
+			RMFLV const& batch = batchJets[jetIndex].p4;
+			BOOST_CHECK_MESSAGE(IsJECToolsTestClose(batch.Pt(), expected.Pt(), useTables) && IsJECToolsTestClose(batch.M(), expected.M(), useTables) &&
+			                    (batch.Eta() == expected.Eta()) && (batch.Phi() == expected.Phi()),
+			                    "jet " << jetIndex << " with shift " << shift << ": " << batch << " instead of " << expected);
+		}
+	}
+
+	// uncertainties of the corrected jets, the jets outside of the range of the corrections are not shifted
+	for (size_t jetIndex = 0; jetIndex < jets.size(); ++jetIndex)
+	{
+		if (std::abs(jets[jetIndex].p4.Eta()) < 5.4f)
+		{
+			KBasicJet correctedJet = jets[jetIndex];
+			correctedJet.p4 *= result.correction[jetIndex];
+			setupFactorProvider(correctedJet, &unc);
+			const float uncertaintyUp = unc.getUncertainty(true);
+			setupFactorProvider(correctedJet, &unc);
+			const float uncertaintyDown = unc.getUncertainty(false);
+			BOOST_CHECK_MESSAGE(IsJECToolsTestClose(result.uncertaintyUp[jetIndex], uncertaintyUp, useTables) &&
+			                    IsJECToolsTestClose(result.uncertaintyDown[jetIndex], uncertaintyDown, useTables),
+			                    "jet " << jetIndex << ": uncertainties " << result.uncertaintyUp[jetIndex] << ", " << result.uncertaintyDown[jetIndex]
+			                    << " instead of " << uncertaintyUp << ", " << uncertaintyDown);
+		}
+		else
+		{
+			BOOST_CHECK_EQUAL(result.correction[jetIndex], 1.0f);
+			BOOST_CHECK_EQUAL(result.uncertaintyUp[jetIndex], 0.0f);
+			BOOST_CHECK_EQUAL(result.uncertaintyDown[jetIndex], 0.0f);
+		}
+	}
+}
+
+BOOST_AUTO_TEST_CASE( test_jec_batch_evaluator_correctors )
+{
+	JECToolsTestFiles files;
+	CheckJECBatchEvaluator(files, false);
+}
+
+BOOST_AUTO_TEST_CASE( test_jec_batch_evaluator_tables )
+{
+	JECToolsTestFiles files;
+	CheckJECBatchEvaluator(files, true);
+}
+
+BOOST_AUTO_TEST_CASE( test_jec_tables_unsupported )
+{
+	JECToolsTestFiles files;
+	files.WriteFile("L5Flavor", "{1 JetEta 1 JetPt [0]+[1]*x Response L5Flavor}", { "-5.4 5.4 4 10 1000 1 0.001" });
+	files.WriteFile("Erf", "{1 JetEta 1 JetPt TMath::Erf([0]*x) Correction L2Relative}", { "-5.4 5.4 3 10 1000 0.01" });
+	files.WriteFile("Power", "{1 JetEta 1 JetPt [0]^[1]^x Correction L2Relative}", { "-5.4 5.4 4 10 1000 1 2" });
+	files.WriteFile("Parameters", "{1 JetEta 1 JetPt [0]+[1]*x Correction L2Relative}", { "-5.4 5.4 3 10 1000 1" });
+	for (const char* name : { "L5Flavor", "Erf", "Power", "Parameters" })
+	{
+		std::vector<JetCorrectorParameters> parameters = files.GetCorrectionParameters();
+		parameters.push_back(JetCorrectorParameters(files.GetFileName(name)));
+		BOOST_CHECK_MESSAGE(! JECCorrectionTables(parameters).getUnsupported().empty(), name);
+	}
+	BOOST_CHECK(JECCorrectionTables(files.GetCorrectionParameters()).getUnsupported().empty());
+
+	// the evaluator falls back to the correctors
+	std::vector<JetCorrectorParameters> parameters = files.GetCorrectionParameters();
+	parameters.push_back(JetCorrectorParameters(files.GetFileName("Erf")));
+	FactorizedJetCorrector jec(parameters);
+	JECBatchEvaluator evaluator(&jec, nullptr);
+	evaluator.setTables(std::make_shared<const JECCorrectionTables>(parameters), nullptr);
+	std::vector<KBasicJet> jets = GetJECToolsTestJets();
+	std::vector<KBasicJet*> jetPointers;
+	for (KBasicJet& jet : jets)
+	{
+		jetPointers.push_back(&jet);
+	}
+	JECBatchResult result;
+	evaluator.evaluate(jetPointers, 12.0, 10, -1, result);
+	BOOST_REQUIRE_EQUAL(result.correction.size(), jets.size());
+	BOOST_CHECK(! result.uncertaintiesEvaluated);
+	for (size_t jetIndex = 0; jetIndex < jets.size(); ++jetIndex)
+	{
+		if (std::abs(jets[jetIndex].p4.Eta()) < 5.4f)
+		{
+			jec.setRho(12.0f);
+			jec.setNPV(10);
+			setupFactorProvider(jets[jetIndex], &jec);
+			jec.setJetA(jets[jetIndex].area);
+			BOOST_CHECK_EQUAL(result.correction[jetIndex], jec.getCorrection());
+		}
+	}
+}
+
+BOOST_AUTO_TEST_CASE( test_jec_formula )
+{
+	std::vector<std::vector<double> > variables = { { 2.0, 3.0 }, { 10.0, 100.0 } };
+	std::vector<std::vector<double> > parameters = { { 0.5, 0.25 }, { 4.0, 8.0 } };
+	std::vector<double> stack;
+	std::vector<double> result;
+
+	JECFormula formula("1+2*3-4/2 + -[0]*x^2 + max(y,50)*TMath::Min([1],5.) - log10(y) + (x+1)^-1");
+	BOOST_REQUIRE(formula.isValid());
+	BOOST_CHECK_EQUAL(formula.getNParameters(), 2u);
+	formula.evaluate(2, variables, parameters, stack, result);
+	BOOST_REQUIRE_EQUAL(result.size(), 2u);
+	BOOST_CHECK_CLOSE(result[0], 5.0 - 0.5 * 4.0 + 50.0 * 4.0 - 1.0 + 1.0 / 3.0, 1e-12);
+	BOOST_CHECK_CLOSE(result[1], 5.0 - 0.25 * 9.0 + 100.0 * 5.0 - 2.0 + 1.0 / 4.0, 1e-12);
+
+	// variables not given by the parameters are zero
+	JECFormula constant("z + t + 1.5e1");
+	BOOST_REQUIRE(constant.isValid());
+	constant.evaluate(2, variables, parameters, stack, result);
+	BOOST_CHECK_EQUAL(result[0], 15.0);
+	BOOST_CHECK_EQUAL(result[1], 15.0);
+
+	for (const char* invalid : { "", "1+", "(x", "x)", "erf(x)", "pow(x)", "[a]", "2^3^2", "x y" })
+	{
+		BOOST_CHECK_MESSAGE(! JECFormula(invalid).isValid(), invalid);
+	}
+}
+
+BOOST_AUTO_TEST_CASE( test_jec_batch_results )
+{
+	std::vector<KBasicJet> jets(2);
+	std::vector<KBasicJet> otherJets(2);
+	JECBatchResults results;
+
+	JECBatchResult& nominal = results.get("jec", "", &jets);
+	BOOST_CHECK(! nominal.correctionsEvaluated);
+	nominal.correction = { 1.1f, 0.9f };
+	nominal.correctionsEvaluated = true;
+	BOOST_CHECK_EQUAL(&results.get("jec", "", &jets), &nominal);
+
+	// the shifted pipelines share the corrections of the nominal pipeline
+	JECBatchResult& shifted = results.get("jec", "unc", &jets);
+	BOOST_CHECK_NE(&shifted, &nominal);
+	BOOST_CHECK(shifted.correctionsEvaluated);
+	BOOST_CHECK(! shifted.uncertaintiesEvaluated);
+	BOOST_CHECK(shifted.correction == nominal.correction);
+	BOOST_CHECK_EQUAL(&results.get("jec", "", &jets), &nominal);
+	BOOST_CHECK_EQUAL(&results.get("jec", "unc", &jets), &shifted);
+
+	// nothing is shared with other parameters or jets
+	BOOST_CHECK(! results.get("other", "", &jets).correctionsEvaluated);
+	BOOST_CHECK(! results.get("jec", "", &otherJets).correctionsEvaluated);
+}
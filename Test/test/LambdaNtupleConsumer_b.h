@@ -0,0 +1,184 @@
+#pragma once
+
+#include <cmath>
+#include <string>
+#include <vector>
+
+#include <boost/property_tree/ptree.hpp>
+
+#include <TMemFile.h>
+
+#include "Artus/Consumer/interface/LambdaNtupleConsumer.h"
+
+#include "Benchmark.h"
+#include "TestTypes.h"
+
+class BenchmarkLambdaNtupleConsumer: public LambdaNtupleConsumer<TestTypes> {
+public:
+	std::string GetConsumerId() const override {
+		return "BenchmarkLambdaNtupleConsumer";
+	}
+};
+
+// fill nEvents into nConsumers ntuples with nFloatQuantities float and nVFloatQuantities vector<float> quantities
+inline void RunBenchmarkLambdaNtupleConsumer(long long nEvents, size_t nFloatQuantities, size_t nVFloatQuantities,
+                                             size_t nConsumers = 1, bool memoiseQuantities = false)
+{
+	TestMetadata metadata;
+	metadata.m_memoiseQuantities = memoiseQuantities;
+	boost::property_tree::ptree quantities;
+	for (size_t quantityIndex = 0; quantityIndex < nFloatQuantities + nVFloatQuantities; ++quantityIndex)
+	{
+		std::string quantity = "quantity" + std::to_string(quantityIndex);
+		if (quantityIndex < nFloatQuantities)
+		{
+			LambdaNtupleConsumer<TestTypes>::AddFloatQuantity(metadata, quantity, [quantityIndex](TestEvent const& event, TestProduct const& product) {
+				return static_cast<float>(event.iVal + quantityIndex);
+			});
+		}
+		else
+		{
+			LambdaNtupleConsumer<TestTypes>::AddVFloatQuantity(metadata, quantity, [quantityIndex](TestEvent const& event, TestProduct const& product) {
+				return std::vector<float>(4, static_cast<float>(event.iVal + quantityIndex));
+			});
+		}
+		quantities.push_back(std::make_pair("", boost::property_tree::ptree(quantity)));
+	}
+
+	boost::property_tree::ptree propertyTree;
+	propertyTree.add_child("Quantities", quantities);
+
+	TMemFile rootFile("LambdaNtupleConsumer_b.root", "RECREATE");
+	TestSettings settings;
+	settings.SetPropTree(&propertyTree);
+	settings.SetRootOutFile(&rootFile);
+
+	std::vector<BenchmarkLambdaNtupleConsumer> consumers(nConsumers);
+	for (BenchmarkLambdaNtupleConsumer& consumer : consumers)
+	{
+		consumer.Init(settings, metadata);
+	}
+
+	TestEvent event;
+	TestProduct const globalProduct;
+	TestProduct product;
+	for (long long iEvent = 0; iEvent < nEvents; ++iEvent)
+	{
+		event.iVal = static_cast<int>(iEvent);
+		// new event, as in Pipeline::RunEvent
+		product = globalProduct;
+		for (BenchmarkLambdaNtupleConsumer& consumer : consumers)
+		{
+			consumer.ProcessFilteredEvent(event, product, settings, metadata);
+		}
+	}
+}
+
+// fill nEvents into nConsumers ntuples with nCompositeQuantities, each combining two of nBaseQuantities
+// expensive quantities (e.g. properties of the leading objects computed from the whole collection)
+inline void RunBenchmarkLambdaNtupleConsumerCompositeQuantities(long long nEvents, size_t nBaseQuantities, size_t nCompositeQuantities,
+                                                                size_t nConsumers = 1, bool memoiseQuantities = false)
+{
+	TestMetadata metadata;
+	metadata.m_memoiseQuantities = memoiseQuantities;
+	boost::property_tree::ptree quantities;
+	std::vector<float> objectPts(50);
+	for (size_t objectIndex = 0; objectIndex < objectPts.size(); ++objectIndex)
+	{
+		objectPts[objectIndex] = 20.0f + 3.7f * objectIndex;
+	}
+
+	std::vector<float_extractor_lambda_base> baseQuantities;
+	for (size_t quantityIndex = 0; quantityIndex < nBaseQuantities; ++quantityIndex)
+	{
+		std::string quantity = "baseQuantity" + std::to_string(quantityIndex);
+		LambdaNtupleConsumer<TestTypes>::AddFloatQuantity(metadata, quantity, [quantityIndex, objectPts](TestEvent const& event, TestProduct const& product) {
+			float sum = 0.0f;
+			for (float objectPt : objectPts)
+			{
+				sum += std::sqrt(objectPt * static_cast<float>(event.iVal + quantityIndex + 1));
+			}
+			return sum;
+		});
+		baseQuantities.push_back(metadata.m_commonFloatQuantities.at(quantity));
+		quantities.push_back(std::make_pair("", boost::property_tree::ptree(quantity)));
+	}
+	for (size_t quantityIndex = 0; quantityIndex < nCompositeQuantities; ++quantityIndex)
+	{
+		std::string quantity = "compositeQuantity" + std::to_string(quantityIndex);
+		float_extractor_lambda_base firstQuantity = baseQuantities[quantityIndex % nBaseQuantities];
+		float_extractor_lambda_base secondQuantity = baseQuantities[(quantityIndex + 3) % nBaseQuantities];
+		LambdaNtupleConsumer<TestTypes>::AddFloatQuantity(metadata, quantity, [firstQuantity, secondQuantity](TestEvent const& event, TestProduct const& product) {
+			return firstQuantity(event, product) * secondQuantity(event, product);
+		});
+		quantities.push_back(std::make_pair("", boost::property_tree::ptree(quantity)));
+	}
+
+	boost::property_tree::ptree propertyTree;
+	propertyTree.add_child("Quantities", quantities);
+
+	TMemFile rootFile("LambdaNtupleConsumer_b.root", "RECREATE");
+	TestSettings settings;
+	settings.SetPropTree(&propertyTree);
+	settings.SetRootOutFile(&rootFile);
+
+	std::vector<BenchmarkLambdaNtupleConsumer> consumers(nConsumers);
+	for (BenchmarkLambdaNtupleConsumer& consumer : consumers)
+	{
+		consumer.Init(settings, metadata);
+	}
+
+	TestEvent event;
+	TestProduct const globalProduct;
+	TestProduct product;
+	for (long long iEvent = 0; iEvent < nEvents; ++iEvent)
+	{
+		event.iVal = static_cast<int>(iEvent);
+		// new event, as in Pipeline::RunEvent
+		product = globalProduct;
+		for (BenchmarkLambdaNtupleConsumer& consumer : consumers)
+		{
+			consumer.ProcessFilteredEvent(event, product, settings, metadata);
+		}
+	}
+}
+
+ARTUS_BENCHMARK( benchmark_lambdantupleconsumer_300_float_quantities )
+{
+	RunBenchmarkLambdaNtupleConsumer(nIterations, 300, 0);
+}
+
+ARTUS_BENCHMARK( benchmark_lambdantupleconsumer_200_float_100_vfloat_quantities )
+{
+	RunBenchmarkLambdaNtupleConsumer(nIterations, 200, 100);
+}
+
+ARTUS_BENCHMARK( benchmark_lambdantupleconsumer_200_float_100_vfloat_quantities_3_consumers )
+{
+	RunBenchmarkLambdaNtupleConsumer(nIterations, 200, 100, 3);
+}
+
+ARTUS_BENCHMARK( benchmark_lambdantupleconsumer_200_float_100_vfloat_quantities_3_consumers_memoised )
+{
+	RunBenchmarkLambdaNtupleConsumer(nIterations, 200, 100, 3, true);
+}
+
+ARTUS_BENCHMARK( benchmark_lambdantupleconsumer_10_expensive_100_composite_quantities )
+{
+	RunBenchmarkLambdaNtupleConsumerCompositeQuantities(nIterations, 10, 100);
+}
+
+ARTUS_BENCHMARK( benchmark_lambdantupleconsumer_10_expensive_100_composite_quantities_memoised )
+{
+	RunBenchmarkLambdaNtupleConsumerCompositeQuantities(nIterations, 10, 100, 1, true);
+}
+
+ARTUS_BENCHMARK( benchmark_lambdantupleconsumer_10_expensive_100_composite_quantities_3_consumers )
+{
+	RunBenchmarkLambdaNtupleConsumerCompositeQuantities(nIterations, 10, 100, 3);
+}
+
+ARTUS_BENCHMARK( benchmark_lambdantupleconsumer_10_expensive_100_composite_quantities_3_consumers_memoised )
+{
+	RunBenchmarkLambdaNtupleConsumerCompositeQuantities(nIterations, 10, 100, 3, true);
+}
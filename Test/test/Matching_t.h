@@ -0,0 +1,116 @@
+#pragma once
+
+#include <cmath>
+#include <limits>
+#include <random>
+#include <vector>
+
+#include <boost/test/included/unit_test.hpp>
+
+#include <Math/VectorUtil.h>
+
+#include "Kappa/DataFormats/interface/Kappa.h"
+#include "Artus/KappaTools/interface/Matching.h"
+
+/*
+ Compare DeltaRIndex::FindNearest with the loops over the whole collection it replaces, which
+ store the deltaR in a float and keep the first of several equally close objects.
+*/
+
+template<typename TAccept>
+inline int FindNearestByLoop(RMFLV const& p4, std::vector<KLV> const& objects, float maxDeltaR, TAccept accept)
+{
+	int nearest = -1;
+	float deltaRmin = std::numeric_limits<float>::max();
+	for (size_t index = 0; index < objects.size(); ++index)
+	{
+		if (accept(objects[index]))
+		{
+			float deltaR = ROOT::Math::VectorUtil::DeltaR(p4, objects[index].p4);
+			if ((deltaR < maxDeltaR) && (deltaR < deltaRmin))
+			{
+				nearest = static_cast<int>(index);
+				deltaRmin = deltaR;
+			}
+		}
+	}
+	return nearest;
+}
+
+inline KLV CreateMatchingTestObject(float pt, float eta, float phi)
+{
+	KLV object;
+	object.p4 = RMFLV(pt, eta, phi, 0.0f);
+	return object;
+}
+
+BOOST_AUTO_TEST_CASE( test_deltarindex_findnearest )
+{
+	std::mt19937 generator(42);
+	std::uniform_real_distribution<float> uniformPt(1.0f, 100.0f);
+	std::uniform_real_distribution<float> uniformEta(-6.0f, 6.0f);
+	std::uniform_real_distribution<float> uniformPhi(-M_PI, M_PI);
+	std::uniform_real_distribution<float> uniformShift(-0.3f, 0.3f);
+
+	// random directions, directions close to phi = +-pi and beyond |eta| = 5, and duplicates for the choice between equal deltaR
+	std::vector<KLV> objects;
+	for (size_t index = 0; index < 300; ++index)
+	{
+		objects.push_back(CreateMatchingTestObject(uniformPt(generator), uniformEta(generator), uniformPhi(generator)));
+	}
+	for (float phi : { float(-M_PI), float(M_PI), float(M_PI) - 1e-3f, float(-M_PI) + 1e-3f })
+	{
+		for (float eta : { -5.5f, -5.0f, -0.5f, 0.0f, 4.99f, 5.0f, 5.8f })
+		{
+			objects.push_back(CreateMatchingTestObject(uniformPt(generator), eta, phi));
+			objects.push_back(CreateMatchingTestObject(uniformPt(generator), eta + uniformShift(generator), phi + uniformShift(generator)));
+		}
+	}
+	std::vector<KLV> duplicates({ objects[3], objects[310] });
+	objects.insert(objects.end(), duplicates.begin(), duplicates.end());
+
+	// the directions of the objects themselves, random directions and directions close to the objects
+	std::vector<RMFLV> directions;
+	for (KLV const& object : objects)
+	{
+		directions.push_back(object.p4);
+		directions.push_back(RMFLV(10.0f, object.p4.Eta() + uniformShift(generator), object.p4.Phi() + uniformShift(generator), 0.0f));
+	}
+	for (size_t index = 0; index < 300; ++index)
+	{
+		directions.push_back(RMFLV(10.0f, uniformEta(generator), uniformPhi(generator), 0.0f));
+	}
+
+	auto acceptAll = [](KLV const&) { return true; };
+	auto acceptHighPt = [](KLV const& object) { return (object.p4.Pt() > 30.0f); };
+	for (float maxDeltaR : { 0.05f, 0.1f, 0.3f, 0.5f, 1.0f, 4.0f })
+	{
+		DeltaRIndex index(std::max(0.1f, maxDeltaR));
+		index.Build(objects);
+		for (RMFLV const& direction : directions)
+		{
+			BOOST_CHECK_EQUAL(index.FindNearest(direction, objects, maxDeltaR), FindNearestByLoop(direction, objects, maxDeltaR, acceptAll));
+			BOOST_CHECK_EQUAL(index.FindNearest(direction, objects, maxDeltaR, acceptHighPt), FindNearestByLoop(direction, objects, maxDeltaR, acceptHighPt));
+		}
+	}
+}
+
+BOOST_AUTO_TEST_CASE( test_deltarindex_rebuild )
+{
+	std::vector<KLV> objects({ CreateMatchingTestObject(10.0f, 0.0f, float(M_PI) - 0.01f), CreateMatchingTestObject(10.0f, 6.0f, 0.0f) });
+	std::vector<KLV*> objectPointers({ &objects[1] });
+
+	DeltaRIndex index;
+	index.Build(objects);
+	BOOST_CHECK_EQUAL(index.FindNearest(RMFLV(10.0f, 0.0f, float(-M_PI) + 0.01f, 0.0f), objects, 0.1f), 0);
+	BOOST_CHECK_EQUAL(index.FindNearest(RMFLV(10.0f, 5.9f, 0.0f, 0.0f), objects, 0.3f), 1);
+	BOOST_CHECK_EQUAL(index.FindNearest(RMFLV(10.0f, 5.0f, 0.0f, 0.0f), objects, 0.3f), -1);
+
+	// the index only knows the objects of the last build
+	index.Build(objectPointers);
+	size_t nCandidates = 0;
+	index.ForEachCandidate(0.0, M_PI, 0.1, [&nCandidates](size_t) { ++nCandidates; });
+	BOOST_CHECK_EQUAL(nCandidates, 0);
+	index.ForEachCandidate(6.0, 0.0, 0.1, [&nCandidates](size_t candidate) { BOOST_CHECK_EQUAL(candidate, 0); ++nCandidates; });
+	BOOST_CHECK_EQUAL(nCandidates, 1);
+}
@@ -0,0 +1,69 @@
+#pragma once
+
+#include <string>
+#include <vector>
+
+#include <boost/test/included/unit_test.hpp>
+
+#include "Artus/KappaAnalysis/interface/Utility/MetadataIndices.h"
+
+BOOST_AUTO_TEST_CASE( test_metadataindex )
+{
+	std::vector<std::string> metadataNames({ "decayModeFinding", "decayModeFindingNewDMs", "byIsolationMVArun2v1DBoldDMwLTraw" });
+
+	MetadataIndex index("decayModeFindingNewDMs");
+	BOOST_CHECK( ! index.IsResolved() );
+
+	index.Resolve(metadataNames);
+	BOOST_CHECK( index.IsResolved() );
+	BOOST_CHECK_EQUAL( index.GetIndex(), 1 );
+	BOOST_CHECK_EQUAL( index.GetName(), "decayModeFindingNewDMs" );
+
+	// objects with fewer values than names are evaluated by name
+	BOOST_CHECK( index.IsResolvedFor(std::vector<float>({ 1.0f, 0.0f, 0.5f })) );
+	BOOST_CHECK( ! index.IsResolvedFor(std::vector<float>({ 1.0f })) );
+
+	// names missing in the metadata of the next lumi section are evaluated by name
+	index.Resolve(std::vector<std::string>({ "decayModeFinding" }));
+	BOOST_CHECK( ! index.IsResolved() );
+	BOOST_CHECK( ! index.IsResolvedFor(std::vector<float>({ 1.0f, 0.0f, 0.5f })) );
+	BOOST_CHECK_EQUAL( index.GetName(), "decayModeFindingNewDMs" );
+}
+
+BOOST_AUTO_TEST_CASE( test_metadatabitmask )
+{
+	std::vector<std::string> metadataNames;
+	for (size_t name = 0; name < 70; ++name)
+	{
+		metadataNames.push_back("discriminator" + std::to_string(name));
+	}
+
+	MetadataBitMask bitMask(std::vector<std::string>({ "discriminator0", "discriminator63", "discriminator64", "missing" }));
+	BOOST_CHECK_EQUAL( bitMask.GetUnresolvedNames().size(), 4 );
+	BOOST_CHECK( bitMask.PassesBits(0ull) );
+
+	bitMask.Resolve(metadataNames, 64);
+
+	// names beyond the 64 bits of the objects and missing names are evaluated by name
+	BOOST_CHECK( bitMask.GetUnresolvedNames() == std::vector<std::string>({ "discriminator64", "missing" }) );
+	BOOST_CHECK( bitMask.PassesBits((1ull << 63) | 1ull) );
+	BOOST_CHECK( bitMask.PassesBits(~0ull) );
+	BOOST_CHECK( ! bitMask.PassesBits(1ull) );
+	BOOST_CHECK( ! bitMask.PassesBits(1ull << 63) );
+
+	// the metadata can contain fewer names than bits
+	bitMask.Resolve(std::vector<std::string>({ "missing", "discriminator0" }), 64);
+	BOOST_CHECK( bitMask.GetUnresolvedNames() == std::vector<std::string>({ "discriminator63", "discriminator64" }) );
+	BOOST_CHECK( bitMask.PassesBits(3ull) );
+	BOOST_CHECK( ! bitMask.PassesBits(1ull) );
+}
+
+BOOST_AUTO_TEST_CASE( test_metadatalumisection )
+{
+	MetadataLumiSection lumiSection;
+	BOOST_CHECK( lumiSection.Update(1, 1) );
+	BOOST_CHECK( ! lumiSection.Update(1, 1) );
+	BOOST_CHECK( lumiSection.Update(1, 2) );
+	BOOST_CHECK( lumiSection.Update(2, 2) );
+	BOOST_CHECK( ! lumiSection.Update(2, 2) );
+}
@@ -0,0 +1,59 @@
+#pragma once
+
+#include <string>
+#include <vector>
+
+#include <boost/test/included/unit_test.hpp>
+
+#include "Artus/Utility/interface/ObjectArena.h"
+
+struct ArenaTestObject
+{
+	explicit ArenaTestObject(int* nDestroyed) : m_nDestroyed(nDestroyed), m_name("arena_test_object") {}
+	~ArenaTestObject() { ++(*m_nDestroyed); }
+
+	int* m_nDestroyed;
+	std::string m_name;
+};
+
+BOOST_AUTO_TEST_CASE( test_objectarena )
+{
+	int nDestroyed = 0;
+	ObjectArena arena(256);
+
+	std::vector<double*> numbers;
+	for (int index = 0; index < 100; ++index)
+	{
+		numbers.push_back(arena.Create<double>(index));
+	}
+	ArenaTestObject* object = arena.Create<ArenaTestObject>(&nDestroyed);
+	BOOST_CHECK_EQUAL(object->m_name, "arena_test_object");
+	BOOST_CHECK_EQUAL(*numbers[42], 42.0);
+	BOOST_CHECK_EQUAL(reinterpret_cast<size_t>(numbers[42]) % alignof(double), 0);
+	size_t nBlocks = arena.GetNumberOfBlocks();
+	BOOST_CHECK(nBlocks > 1);
+
+	// objects larger than a block
+	std::vector<char>* largeObject = arena.Create<std::vector<char> >(10, 'a');
+	BOOST_CHECK_EQUAL(largeObject->size(), 10);
+
+	// copies are empty and do not touch the objects of the original
+	ObjectArena copiedArena(arena);
+	BOOST_CHECK_EQUAL(copiedArena.GetNumberOfBlocks(), 0);
+	copiedArena = arena;
+	BOOST_CHECK_EQUAL(nDestroyed, 0);
+
+	// reset destroys the objects and reuses the memory
+	arena.Reset();
+	BOOST_CHECK_EQUAL(nDestroyed, 1);
+	for (int index = 0; index < 100; ++index)
+	{
+		arena.Create<double>(index);
+	}
+	BOOST_CHECK(arena.GetNumberOfBlocks() <= nBlocks + 1);
+
+	// assignment (next event) resets as well
+	arena.Create<ArenaTestObject>(&nDestroyed);
+	arena = copiedArena;
+	BOOST_CHECK_EQUAL(nDestroyed, 2);
+}
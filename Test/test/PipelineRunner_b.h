@@ -0,0 +1,168 @@
+
+#pragma once
+
+#include "Artus/Core/interface/EventBase.h"
+#include "Artus/Core/interface/EventProviderBase.h"
+#include "Artus/Core/interface/Pipeline.h"
+#include "Artus/Core/interface/PipelineRunner.h"
+
+#include "Benchmark.h"
+#include "TestProduct.h"
+#include "TestSettings.h"
+#include "TestMetadata.h"
+
+/*
+Benchmarks of the per-event overhead of the framework itself. All producers, filters and consumers do nothing,
+such that only the bookkeeping of the pipeline runner and the pipelines is measured.
+The event carries a payload comparable to a real event content, in order to make
+unintended copies of the event visible.
+*/
+
+class BenchmarkEvent : public EventBase {
+public:
+	BenchmarkEvent() : m_payload(10000, 1.0) {}
+
+	std::vector<double> m_payload;
+};
+
+struct BenchmarkTypes {
+	typedef BenchmarkEvent event_type;
+	typedef TestProduct product_type;
+	typedef TestSettings setting_type;
+	typedef TestMetadata metadata_type;
+};
+
+class BenchmarkEventProvider: public EventProviderBase<BenchmarkTypes> {
+public:
+	explicit BenchmarkEventProvider(long long nEvents) : m_nEvents(nEvents) {}
+
+	BenchmarkTypes::event_type const& GetCurrentEvent() const override {
+		return m_event;
+	}
+	bool GetEntry(long long lEventNumber) override {
+		return lEventNumber < GetEntries();
+	}
+	long long GetEntries() const override {
+		return m_nEvents;
+	}
+
+	long long m_nEvents;
+	BenchmarkTypes::event_type m_event;
+};
+
+class BenchmarkProducer: public ProducerBase<BenchmarkTypes> {
+public:
+	std::string GetProducerId() const override {
+		return "benchmark_producer";
+	}
+
+	void Produce(BenchmarkEvent const& event, TestProduct& product,
+	             TestSettings const& settings, TestMetadata const& metadata) const override {
+	}
+};
+
+class BenchmarkFilter: public FilterBase<BenchmarkTypes> {
+public:
+	explicit BenchmarkFilter(std::string const& filterId) : m_filterId(filterId) {}
+
+	std::string GetFilterId() const override {
+		return m_filterId;
+	}
+
+	bool DoesEventPass(BenchmarkEvent const& event, TestProduct const& product,
+	                   TestSettings const& settings, TestMetadata const& metadata) const override {
+		return true;
+	}
+
+	std::string m_filterId;
+};
+
+class BenchmarkConsumer: public ConsumerBase<BenchmarkTypes> {
+public:
+	std::string GetConsumerId() const override {
+		return "benchmark_consumer";
+	}
+
+	void Finish(TestSettings const& settings, TestMetadata const& metadata) override {
+	}
+};
+
+typedef Pipeline<BenchmarkTypes> BenchmarkPipeline;
+typedef PipelineRunner<BenchmarkPipeline, BenchmarkTypes> BenchmarkPipelineRunner;
+
+// run nEvents through a runner with the given number of global/local producers, local filters, consumers and pipelines
+inline void RunBenchmarkPipelines(long long nEvents, size_t nGlobalProducers, size_t nPipelines, size_t nLocalProducers,
+                                  size_t nLocalFilters = 0, size_t nConsumers = 1, bool runTimeMeasurement = false)
+{
+	TestMetadata metadata;
+	TestSettings globalSettings;
+	globalSettings.SetRunTimeMeasurement(runTimeMeasurement);
+
+	BenchmarkPipelineRunner runner(false);
+	runner.ClearProgressReports();
+
+	for (size_t globalProducerIndex = 0; globalProducerIndex < nGlobalProducers; ++globalProducerIndex)
+	{
+		runner.AddProducer(new BenchmarkProducer());
+	}
+
+	for (size_t pipelineIndex = 0; pipelineIndex < nPipelines; ++pipelineIndex)
+	{
+		BenchmarkPipeline* pipeline = new BenchmarkPipeline();
+		for (size_t localProducerIndex = 0; localProducerIndex < nLocalProducers; ++localProducerIndex)
+		{
+			pipeline->AddProducer(new BenchmarkProducer());
+		}
+		for (size_t localFilterIndex = 0; localFilterIndex < nLocalFilters; ++localFilterIndex)
+		{
+			pipeline->AddFilter(new BenchmarkFilter("benchmark_filter" + std::to_string(localFilterIndex)));
+		}
+		for (size_t consumerIndex = 0; consumerIndex < nConsumers; ++consumerIndex)
+		{
+			pipeline->AddConsumer(new BenchmarkConsumer());
+		}
+		TestSettings pipelineSettings(std::to_string(pipelineIndex));
+		pipelineSettings.SetRunTimeMeasurement(runTimeMeasurement);
+		pipeline->InitPipeline(pipelineSettings, metadata, PipelineInitilizerBase<BenchmarkTypes>());
+		runner.AddPipeline(pipeline);
+	}
+
+	BenchmarkEventProvider evtProvider(nEvents);
+	runner.RunPipelines(evtProvider, globalSettings);
+}
+
+ARTUS_BENCHMARK( benchmark_prunner_empty )
+{
+	RunBenchmarkPipelines(nIterations, 0, 0, 0);
+}
+
+ARTUS_BENCHMARK( benchmark_prunner_10_global_producers )
+{
+	RunBenchmarkPipelines(nIterations, 10, 0, 0);
+}
+
+ARTUS_BENCHMARK( benchmark_prunner_1_pipeline_10_local_producers )
+{
+	RunBenchmarkPipelines(nIterations, 0, 1, 10);
+}
+
+ARTUS_BENCHMARK( benchmark_prunner_1_pipeline_20_local_filters )
+{
+	RunBenchmarkPipelines(nIterations, 0, 1, 0, 20);
+}
+
+ARTUS_BENCHMARK( benchmark_prunner_1_pipeline_20_local_filters_runtime_measurement )
+{
+	RunBenchmarkPipelines(nIterations, 0, 1, 0, 20, 1, true);
+}
+
+ARTUS_BENCHMARK( benchmark_prunner_1_pipeline_20_consumers )
+{
+	RunBenchmarkPipelines(nIterations, 0, 1, 0, 0, 20);
+}
+
+ARTUS_BENCHMARK( benchmark_prunner_10_global_producers_10_pipelines_10_local_producers )
+{
+	RunBenchmarkPipelines(nIterations, 10, 10, 10);
+}
+
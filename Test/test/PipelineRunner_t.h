@@ -236,3 +236,88 @@ BOOST_AUTO_TEST_CASE( test_event_prunner_multi_level )
 	// could be changed at a later stage
 	tline3->CheckCalls(0,1);
 }
+
+BOOST_AUTO_TEST_CASE( test_event_prunner_required_event_members )
+{
+	TestPipelineRunnerInstr prunner(false);
+	prunner.ClearProgressReports();
+	BOOST_CHECK( prunner.GetRequiredEventMembers().empty() );
+
+	// only reads the product
+	TestPipelineInstr * pline = new TestPipelineInstr;
+	pline->AddProducer( new TestLocalProducerFromGlobal() );
+	pline->AddConsumer( new TestConsumer() );
+	prunner.AddPipeline( pline );
+	BOOST_CHECK( prunner.GetRequiredEventMembers().empty() );
+
+	// reads TestEvent::iVal
+	pline->AddProducer( new TestLocalProducer() );
+	BOOST_CHECK( prunner.GetRequiredEventMembers() == std::set<std::string>({ "iVal" }) );
+
+	TestPipelineRunnerInstr prunnerGlobal(false);
+	prunnerGlobal.ClearProgressReports();
+	prunnerGlobal.AddProducer( new TestGlobalProducer() );
+	BOOST_CHECK( prunnerGlobal.GetRequiredEventMembers() == std::set<std::string>({ "iVal" }) );
+}
+
+BOOST_AUTO_TEST_CASE( test_event_prunner_parallel )
+{
+	TestMetadata metadata;
+	TestSettings global_tset;
+
+	TestPipelineRunner prunner(false);
+	// don't show progress report in this test cases
+	prunner.ClearProgressReports();
+
+	// the main runner and two replicas with identical setup
+	std::vector<TestConsumer *> vConsumers;
+	std::vector<TestPipelineRunner *> vRunners;
+	vRunners.push_back( &prunner );
+	vRunners.push_back( new TestPipelineRunner(false) );
+	vRunners.push_back( new TestPipelineRunner(false) );
+
+	boost::ptr_vector<TestEventProvider> evtProviders;
+	std::vector<TestEventProvider *> vEvtProviders;
+
+	for ( TestPipelineRunner * runner : vRunners )
+	{
+		runner->AddProducer( new TestGlobalProducer() );
+
+		// no checks within the worker threads, boost test is not thread-safe
+		TestConsumer * pCons = new TestConsumer( false );
+		vConsumers.push_back( pCons );
+
+		TestPipeline * pline = new TestPipeline;
+		pline->AddConsumer( pCons );
+		pline->AddProducer( new TestLocalProducer() );
+		pline->InitPipeline( TestSettings("1"), metadata, TestPipelineInitializer() );
+		runner->AddPipeline( pline );
+
+		if ( runner != &prunner )
+		{
+			prunner.AddReplica( runner );
+		}
+
+		evtProviders.push_back( new TestEventProvider() );
+		vEvtProviders.push_back( &evtProviders.back() );
+	}
+
+	prunner.RunPipelinesParallel( vEvtProviders, global_tset, 2 );
+
+	// all events are merged into the consumer of the main runner
+	vConsumers[0]->CheckCalls(10, 10);
+	BOOST_CHECK_EQUAL( vConsumers[1]->iFinish + vConsumers[2]->iFinish, 0 );
+	BOOST_CHECK( vConsumers[1]->iProcessEvent + vConsumers[2]->iProcessEvent <= 10 );
+}
+
+BOOST_AUTO_TEST_CASE( test_event_prunner_parallel_consumers_without_merge )
+{
+	TestPipeline pline;
+	pline.AddConsumer( new TestConsumer() );
+	BOOST_CHECK( pline.GetConsumersWithoutMerge().empty() );
+
+	// parallel runs are not started with consumers which cannot merge their results
+	pline.AddConsumer( new TestConsumerLocalProduct() );
+	BOOST_CHECK( pline.GetConsumersWithoutMerge() == std::vector<std::string>({ "test_consumer_local" }) );
+}
+
@@ -207,8 +207,11 @@ BOOST_AUTO_TEST_CASE( test_multiplefilter_producer_stop_exec )
 
 	pline.FinishPipeline();
 
-	BOOST_CHECK( pCons1->fres.GetFilterDecisions().size() == 1 );
+	// all filters of the pipeline are known, but the ones not run have no decision
+	BOOST_CHECK( pCons1->fres.GetFilterDecisions().size() == 3 );
 	BOOST_CHECK( pCons1->fres.GetFilterDecision("testfilter3") == FilterResult::Decision::NotPassed );
+	BOOST_CHECK( pCons1->fres.GetFilterDecision("testfilter2") == FilterResult::Decision::Undefined );
+	BOOST_CHECK( pCons1->fres.GetFilterDecision("testfilter") == FilterResult::Decision::Undefined );
 	BOOST_CHECK( pCons1->fres.HasPassed() == false);
 }
 
@@ -0,0 +1,178 @@
+#pragma once
+
+#include <string>
+#include <vector>
+
+#include <boost/test/included/unit_test.hpp>
+
+#include "Artus/Core/interface/Pipeline.h"
+#include "Artus/Core/interface/QuantityCache.h"
+#include "Artus/Consumer/interface/LambdaNtupleConsumer.h"
+
+#include "TestLocalProducer.h"
+#include "TestPipelineRunner.h"
+#include "TestTypes.h"
+
+BOOST_AUTO_TEST_CASE( test_quantitycache )
+{
+	size_t intSlot = QuantityCache::GetSlot<int>("test_quantitycache");
+	size_t vDoubleSlot = QuantityCache::GetSlot<std::vector<double> >("test_quantitycache");
+	BOOST_CHECK(intSlot != vDoubleSlot);
+	BOOST_CHECK_EQUAL(QuantityCache::GetSlot<int>("test_quantitycache"), intSlot);
+
+	QuantityCache cache;
+	BOOST_CHECK(cache.Get<int>(intSlot) == nullptr);
+
+	cache.Set<int>(intSlot, 42);
+	cache.Set<std::vector<double> >(vDoubleSlot, std::vector<double>(3, 1.0));
+	BOOST_REQUIRE(cache.Get<int>(intSlot) != nullptr);
+	BOOST_CHECK_EQUAL(*cache.Get<int>(intSlot), 42);
+	BOOST_CHECK_EQUAL(cache.Get<std::vector<double> >(vDoubleSlot)->size(), 3);
+
+	// copies never take over the values
+	QuantityCache copiedCache(cache);
+	BOOST_CHECK(copiedCache.Get<int>(intSlot) == nullptr);
+
+	QuantityCache assignedCache;
+	assignedCache.Set<int>(intSlot, 23);
+	assignedCache = cache;
+	BOOST_CHECK(assignedCache.Get<int>(intSlot) == nullptr);
+
+	cache.Invalidate();
+	BOOST_CHECK(cache.Get<int>(intSlot) == nullptr);
+	BOOST_CHECK(cache.Get<std::vector<double> >(vDoubleSlot) == nullptr);
+
+	cache.Set<int>(intSlot, 5);
+	BOOST_CHECK_EQUAL(*cache.Get<int>(intSlot), 5);
+}
+
+BOOST_AUTO_TEST_CASE( test_quantitycache_lambda_quantities )
+{
+	TestMetadata metadata;
+	metadata.m_memoiseQuantities = true;
+	int nEvaluations = 0;
+	LambdaNtupleConsumer<TestTypes>::AddIntQuantity(metadata, "test_memoised_quantity", [&nEvaluations](TestEvent const& event, TestProduct const& product) {
+		++nEvaluations;
+		return event.iVal + product.iGlobalProduct;
+	});
+
+	TestEvent event;
+	event.iVal = 1;
+	TestProduct product;
+	product.iGlobalProduct = 2;
+	int_extractor_lambda_base const& valueExtractor = metadata.m_commonIntQuantities.at("test_memoised_quantity");
+
+	BOOST_CHECK_EQUAL(valueExtractor(event, product), 3);
+	BOOST_CHECK_EQUAL(valueExtractor(event, product), 3);
+	BOOST_CHECK_EQUAL(nEvaluations, 1);
+
+	// a producer has changed the product and evaluates the quantity again
+	product.iGlobalProduct = 3;
+	BOOST_CHECK_EQUAL(valueExtractor(event, product), 3);
+	product.quantityCache.Invalidate();
+	BOOST_CHECK_EQUAL(valueExtractor(event, product), 4);
+	BOOST_CHECK_EQUAL(nEvaluations, 2);
+
+	// next event
+	TestProduct nextProduct;
+	nextProduct.iGlobalProduct = 5;
+	product = nextProduct;
+	BOOST_CHECK_EQUAL(valueExtractor(event, product), 6);
+	BOOST_CHECK_EQUAL(nEvaluations, 3);
+
+	// without memoisation, the quantities are evaluated on every call
+	TestMetadata metadataWithoutMemoisation;
+	LambdaNtupleConsumer<TestTypes>::AddIntQuantity(metadataWithoutMemoisation, "test_memoised_quantity", [&nEvaluations](TestEvent const& event, TestProduct const& product) {
+		++nEvaluations;
+		return event.iVal + product.iGlobalProduct;
+	});
+	int_extractor_lambda_base const& plainValueExtractor = metadataWithoutMemoisation.m_commonIntQuantities.at("test_memoised_quantity");
+	BOOST_CHECK_EQUAL(plainValueExtractor(event, product), 6);
+	BOOST_CHECK_EQUAL(plainValueExtractor(event, product), 6);
+	BOOST_CHECK_EQUAL(nEvaluations, 5);
+}
+
+// evaluates a quantity twice, as e.g. several MVA methods reading the same inputs
+class QuantityCacheTestReader: public ProducerBase<TestTypes> {
+public:
+	std::string GetProducerId() const override {
+		return "QuantityCacheTestReader";
+	}
+
+	void Produce(TestEvent const& event, TestProduct& product,
+	             TestSettings const& settings, TestMetadata const& metadata) const override
+	{
+		int_extractor_lambda_base const& valueExtractor = metadata.m_commonIntQuantities.at("test_pipeline_quantity");
+		product.iGlobalProduct2 = valueExtractor(event, product) + valueExtractor(event, product);
+	}
+};
+
+class QuantityCacheTestModifier: public ProducerBase<TestTypes> {
+public:
+	std::string GetProducerId() const override {
+		return "QuantityCacheTestModifier";
+	}
+
+	void Produce(TestEvent const& event, TestProduct& product,
+	             TestSettings const& settings, TestMetadata const& metadata) const override
+	{
+		product.iLocalProduct += 10;
+	}
+};
+
+class QuantityCacheTestConsumer: public ConsumerBase<TestTypes> {
+public:
+	std::string GetConsumerId() const override {
+		return "QuantityCacheTestConsumer";
+	}
+
+	void ProcessFilteredEvent(TestEvent const& event, TestProduct const& product,
+	                          TestSettings const& settings, TestMetadata const& metadata) override
+	{
+		values.push_back(metadata.m_commonIntQuantities.at("test_pipeline_quantity")(event, product));
+	}
+
+	void Finish(TestSettings const& settings, TestMetadata const& metadata) override {
+	}
+
+	std::vector<int> values;
+};
+
+BOOST_AUTO_TEST_CASE( test_quantitycache_pipeline )
+{
+	TestMetadata metadata;
+	metadata.m_memoiseQuantities = true;
+	int nEvaluations = 0;
+	LambdaNtupleConsumer<TestTypes>::AddIntQuantity(metadata, "test_pipeline_quantity", [&nEvaluations](TestEvent const& event, TestProduct const& product) {
+		++nEvaluations;
+		return product.iLocalProduct;
+	});
+
+	// the values are shared within a producer and between the consumers,
+	// but every producer can change the values of the following processors
+	QuantityCacheTestConsumer* firstConsumer = new QuantityCacheTestConsumer();
+	QuantityCacheTestConsumer* secondConsumer = new QuantityCacheTestConsumer();
+	Pipeline<TestTypes> pipeline;
+	pipeline.AddProducer(new TestLocalProducer());
+	pipeline.AddProducer(new QuantityCacheTestReader());
+	pipeline.AddProducer(new QuantityCacheTestModifier());
+	pipeline.AddConsumer(firstConsumer);
+	pipeline.AddConsumer(secondConsumer);
+
+	TestSettings settings;
+	pipeline.InitPipeline(settings, metadata, TestPipelineInitializer());
+
+	TestProduct globalProduct;
+	FilterResult globalFilterResult;
+	TestEvent event;
+	for (int iVal : { 1, 5 })
+	{
+		event.iVal = iVal;
+		pipeline.RunEvent(event, globalProduct, globalFilterResult);
+	}
+	pipeline.FinishPipeline();
+
+	BOOST_CHECK_EQUAL(nEvaluations, 4);
+	BOOST_CHECK(firstConsumer->values == std::vector<int>({ 12, 16 }));
+	BOOST_CHECK(secondConsumer->values == std::vector<int>({ 12, 16 }));
+}
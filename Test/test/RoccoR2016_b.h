@@ -0,0 +1,237 @@
+#pragma once
+
+#include <cmath>
+#include <cstdio>
+#include <fstream>
+#include <string>
+#include <vector>
+
+#include <unistd.h>
+
+#include "Artus/Utility/interface/ArtusLogging.h"
+#include "Artus/Utility/interface/RoccoR2016.h"
+
+#include "Benchmark.h"
+
+/*
+Benchmarks of the 2016 Rochester muon corrections for simulated events, correcting the muons
+of an event one by one (as done before) or all at once with the tabulated scale bins.
+
+The corrections are read from a synthetic parameter set in the format of the official files,
+which is written to a temporary directory. Before the first run, the batch corrections are
+checked against the corrections of single muons.
+*/
+
+class BenchmarkRochester2016 {
+public:
+	static const size_t nEvents = 1024;
+	static const size_t nMuonsPerEvent = 4;
+
+	BenchmarkRochester2016()
+	{
+		char directory[] = "/tmp/RoccoR2016_b.XXXXXX";
+		if (mkdtemp(directory) == nullptr)
+		{
+			LOG(FATAL) << "Could not create a temporary directory for the Rochester corrections.";
+		}
+		WriteParameters(directory);
+		rochesterCorrections.init(directory);
+		std::remove((std::string(directory) + "/0.0.txt").c_str());
+		std::remove((std::string(directory) + "/config.txt").c_str());
+		rmdir(directory);
+
+		// muons with every second muon matched to a generator muon,
+		// the generator pt of the others is filled but must not be used
+		events.resize(nEvents);
+		size_t muonIndex = 0;
+		for (std::vector<RocMuon2016>& muons : events)
+		{
+			muons.resize(nMuonsPerEvent);
+			for (RocMuon2016& muon : muons)
+			{
+				muon.Q = ((muonIndex % 3) == 0) ? -1 : 1;
+				muon.pt = 10.0 + std::fmod(muonIndex * 7.31, 150.0);
+				muon.eta = -2.4 + std::fmod(muonIndex * 0.173, 4.8);
+				muon.phi = -M_PI + std::fmod(muonIndex * 0.389, 2.0 * M_PI);
+				muon.n = 6 + (muonIndex % 11);
+				muon.genMatched = ((muonIndex % 2) == 0);
+				muon.gt = muon.pt * (0.97 + std::fmod(muonIndex * 0.0071, 0.06));
+				muon.u = std::fmod(muonIndex * 0.618034, 1.0);
+				muon.w = std::fmod(muonIndex * 0.414214, 1.0);
+				++muonIndex;
+			}
+		}
+
+		CheckBatchCorrections();
+	}
+
+	double CorrectMuonsOneByOne(std::vector<RocMuon2016> const& muons, std::vector<double>& scaleFactors) const
+	{
+		double sum = 0.0;
+		scaleFactors.resize(muons.size());
+		for (size_t muonIndex = 0; muonIndex < muons.size(); ++muonIndex)
+		{
+			RocMuon2016 const& muon = muons[muonIndex];
+			if (muon.genMatched)
+			{
+				scaleFactors[muonIndex] = rochesterCorrections.kScaleFromGenMC(muon.Q, muon.pt, muon.eta, muon.phi, muon.n, muon.gt, muon.w);
+			}
+			else
+			{
+				scaleFactors[muonIndex] = rochesterCorrections.kScaleAndSmearMC(muon.Q, muon.pt, muon.eta, muon.phi, muon.n, muon.u, muon.w);
+			}
+			sum += scaleFactors[muonIndex];
+		}
+		return sum;
+	}
+
+	double CorrectMuonsAtOnce(std::vector<RocMuon2016> const& muons, std::vector<double>& scaleFactors) const
+	{
+		rochesterCorrections.kScaleAndSmearMC(muons, scaleFactors);
+		double sum = 0.0;
+		for (double scaleFactor : scaleFactors)
+		{
+			sum += scaleFactor;
+		}
+		return sum;
+	}
+
+	std::vector<std::vector<RocMuon2016> > events;
+
+private:
+	static void WriteParameters(std::string const& directory)
+	{
+		std::ofstream config((directory + "/config.txt").c_str());
+		config << "Default 0 1" << std::endl;
+
+		const int nResolutionEtaBins = 12;
+		const int nTrackBins = 12;
+		const int nScaleEtaBins = 22;
+		const int nPhiBins = 16;
+
+		std::ofstream parameters((directory + "/0.0.txt").c_str());
+		parameters << "RMIN 5" << std::endl;
+		parameters << "RTRK " << nTrackBins << std::endl;
+		parameters << "RETA " << nResolutionEtaBins;
+		for (int bin = 0; bin <= nResolutionEtaBins; ++bin)
+		{
+			parameters << " " << 0.2 * bin;
+		}
+		parameters << std::endl;
+
+		// resolution parameters: rms (A, B, C) and Crystal Ball (width, alpha, power) per eta and track bin
+		const double offsets[6] = { 0.01, 1.0e-4, 2.0e-4, 0.9, 1.4, 2.0 };
+		const double slopes[6] = { 1.0e-3, 1.0e-5, 1.0e-5, 0.02, 0.05, 0.3 };
+		for (int bin = 0; bin < nResolutionEtaBins; ++bin)
+		{
+			for (int variable = 0; variable < 6; ++variable)
+			{
+				parameters << "R 0 0 0 0 " << variable << " " << bin;
+				for (int trackBin = 0; trackBin < nTrackBins; ++trackBin)
+				{
+					parameters << " " << offsets[variable] + slopes[variable] * ((bin + trackBin) % 5);
+				}
+				parameters << std::endl;
+			}
+			for (int isData = 0; isData < 2; ++isData)
+			{
+				parameters << "T 0 0 0 " << isData << " 0 " << bin;
+				for (int trackBin = 0; trackBin <= nTrackBins; ++trackBin)
+				{
+					parameters << " " << std::pow(static_cast<double>(trackBin) / nTrackBins, 1.0 + 0.1 * isData);
+				}
+				parameters << std::endl;
+			}
+		}
+		for (int isData = 0; isData < 2; ++isData)
+		{
+			parameters << "F 0 0 0 " << isData << " 0 0";
+			for (int bin = 0; bin < nResolutionEtaBins; ++bin)
+			{
+				parameters << " " << 1.0 + 0.1 * isData + 0.01 * bin;
+			}
+			parameters << std::endl;
+		}
+
+		// scale parameters: M and A (in per cent) per eta and phi bin, D (in units of 10^-4) per eta bin
+		parameters << "CPHI " << nPhiBins << std::endl;
+		parameters << "CETA " << nScaleEtaBins;
+		for (int bin = 0; bin <= nScaleEtaBins; ++bin)
+		{
+			parameters << " " << -2.4 + 4.8 * bin / nScaleEtaBins;
+		}
+		parameters << std::endl;
+		for (int isData = 0; isData < 2; ++isData)
+		{
+			for (int bin = 0; bin < nScaleEtaBins; ++bin)
+			{
+				for (int variable = 0; variable < 2; ++variable)
+				{
+					parameters << "C 0 0 0 " << isData << " " << variable << " " << bin;
+					for (int phiBin = 0; phiBin < nPhiBins; ++phiBin)
+					{
+						parameters << " " << ((variable == 0) ? 0.05 : 0.002) * std::sin(bin + 0.5 * phiBin + isData);
+					}
+					parameters << std::endl;
+				}
+			}
+			parameters << "F 0 0 0 " << isData << " 1 0";
+			for (int bin = 0; bin < nScaleEtaBins; ++bin)
+			{
+				parameters << " " << 3.0 * std::cos(bin + isData);
+			}
+			parameters << std::endl;
+		}
+	}
+
+	void CheckBatchCorrections() const
+	{
+		std::vector<double> singleScaleFactors;
+		std::vector<double> batchScaleFactors;
+		for (std::vector<RocMuon2016> const& muons : events)
+		{
+			CorrectMuonsOneByOne(muons, singleScaleFactors);
+			CorrectMuonsAtOnce(muons, batchScaleFactors);
+			for (size_t muonIndex = 0; muonIndex < muons.size(); ++muonIndex)
+			{
+				if (std::abs(batchScaleFactors[muonIndex] - singleScaleFactors[muonIndex]) > 1e-12 * std::abs(singleScaleFactors[muonIndex]))
+				{
+					LOG(FATAL) << "Rochester correction of all muons at once (" << batchScaleFactors[muonIndex]
+					           << ") differs from the correction of a single muon (" << singleScaleFactors[muonIndex] << ")!";
+				}
+			}
+		}
+	}
+
+	RoccoR2016 rochesterCorrections;
+};
+
+inline BenchmarkRochester2016 const& GetBenchmarkRochester2016()
+{
+	static BenchmarkRochester2016 benchmarkRochester2016;
+	return benchmarkRochester2016;
+}
+
+ARTUS_BENCHMARK( benchmark_rochester_2016_mc_4_muons_one_by_one )
+{
+	BenchmarkRochester2016 const& benchmarkRochester2016 = GetBenchmarkRochester2016();
+	std::vector<double> scaleFactors;
+	double sum = 0.0;
+	for (long long iteration = 0; iteration < nIterations; ++iteration)
+	{
+		sum += benchmarkRochester2016.CorrectMuonsOneByOne(benchmarkRochester2016.events[iteration % BenchmarkRochester2016::nEvents], scaleFactors);
+	}
+	Benchmark::DoNotOptimise(sum);
+}
+
+ARTUS_BENCHMARK( benchmark_rochester_2016_mc_4_muons_at_once )
+{
+	BenchmarkRochester2016 const& benchmarkRochester2016 = GetBenchmarkRochester2016();
+	std::vector<double> scaleFactors;
+	double sum = 0.0;
+	for (long long iteration = 0; iteration < nIterations; ++iteration)
+	{
+		sum += benchmarkRochester2016.CorrectMuonsAtOnce(benchmarkRochester2016.events[iteration % BenchmarkRochester2016::nEvents], scaleFactors);
+	}
+	Benchmark::DoNotOptimise(sum);
+}
@@ -0,0 +1,124 @@
+#pragma once
+
+#include <algorithm>
+#include <cstdint>
+#include <cstdio>
+#include <fstream>
+#include <sstream>
+#include <string>
+#include <vector>
+
+#include <unistd.h>
+
+#include <boost/property_tree/json_parser.hpp>
+#include <boost/property_tree/ptree.hpp>
+#include <boost/test/included/unit_test.hpp>
+
+#include "Artus/KappaAnalysis/interface/Filters/RunLumiEventFilter.h"
+#include "Artus/KappaAnalysis/interface/KappaEvent.h"
+#include "Artus/KappaAnalysis/interface/KappaMetadata.h"
+#include "Artus/KappaAnalysis/interface/KappaProduct.h"
+#include "Artus/KappaAnalysis/interface/KappaSettings.h"
+
+/*
+ The RunLumiEventFilter has to take the same decisions for (run, lumi, event) tuples given as
+ lists in the configuration and given as binary files.
+*/
+
+inline std::string WriteRunLumiEventTestList(std::string const& directory, std::string const& name,
+                                             std::vector<std::vector<uint64_t> > const& runLumiEvents)
+{
+	std::string fileName = directory + "/" + name;
+	std::ofstream outStream(fileName, std::ios::out | std::ios::binary);
+	for (std::vector<uint64_t> const& runLumiEvent : runLumiEvents)
+	{
+		outStream.write(reinterpret_cast<char const*>(runLumiEvent.data()), 3 * sizeof(uint64_t));
+	}
+	return fileName;
+}
+
+inline std::string GetRunLumiEventTestLists(std::string const& listType, std::vector<std::vector<uint64_t> > const& runLumiEvents)
+{
+	std::stringstream lists;
+	std::vector<std::string> names({ "Run", "Lumi", "Event" });
+	for (size_t position = 0; position < names.size(); ++position)
+	{
+		lists << "\"" << names[position] << listType << "\": [";
+		for (size_t index = 0; index < runLumiEvents.size(); ++index)
+		{
+			lists << ((index > 0) ? ", " : "") << runLumiEvents[index][position];
+		}
+		lists << "], ";
+	}
+	return lists.str();
+}
+
+BOOST_AUTO_TEST_CASE( test_runlumieventfilter_text_and_binary_lists )
+{
+	// event numbers beyond 32 bits and tuples sharing single numbers with other tuples
+	std::vector<std::vector<uint64_t> > whitelist({
+		{ 1, 10, 100 }, { 1, 10, 101 }, { 1, 11, 100 }, { 2, 10, 100 },
+		{ 273158, 5, 5000000000ull }, { 273158, 6, 18446744073709551615ull },
+	});
+	std::vector<std::vector<uint64_t> > blacklist({ { 1, 10, 101 }, { 3, 10, 100 } });
+
+	char directoryTemplate[] = "/tmp/RunLumiEventFilter_t.XXXXXX";
+	BOOST_REQUIRE(mkdtemp(directoryTemplate) != nullptr);
+	std::string directory = directoryTemplate;
+	std::string whitelistFile = WriteRunLumiEventTestList(directory, "whitelist.bin", whitelist);
+	std::string blacklistFile = WriteRunLumiEventTestList(directory, "blacklist.bin", blacklist);
+
+	boost::property_tree::ptree textPropertyTree;
+	std::stringstream textConfig("{ " + GetRunLumiEventTestLists("Whitelist", whitelist) +
+	                             GetRunLumiEventTestLists("Blacklist", blacklist) + "\"MatchRunLumiEventTuples\": true }");
+	boost::property_tree::json_parser::read_json(textConfig, textPropertyTree);
+	KappaSettings textSettings;
+	textSettings.SetPropTree(&textPropertyTree);
+
+	boost::property_tree::ptree binaryPropertyTree;
+	std::stringstream binaryConfig("{ \"RunLumiEventWhitelistFile\": \"" + whitelistFile + "\", " +
+	                               "\"RunLumiEventBlacklistFile\": \"" + blacklistFile + "\", \"MatchRunLumiEventTuples\": true }");
+	boost::property_tree::json_parser::read_json(binaryConfig, binaryPropertyTree);
+	KappaSettings binarySettings;
+	binarySettings.SetPropTree(&binaryPropertyTree);
+
+	KappaMetadata metadata;
+	RunLumiEventFilter textFilter;
+	textFilter.Init(textSettings, metadata);
+	RunLumiEventFilter binaryFilter;
+	binaryFilter.Init(binarySettings, metadata);
+
+	std::remove(whitelistFile.c_str());
+	std::remove(blacklistFile.c_str());
+	rmdir(directory.c_str());
+
+	KEventInfo eventInfo;
+	KappaEvent event;
+	event.m_eventInfo = &eventInfo;
+	KappaProduct product;
+	size_t nPassingEvents = 0;
+
+	// all combinations of the numbers in the lists
+	for (uint64_t run : { 0ull, 1ull, 2ull, 3ull, 273158ull })
+	{
+		for (uint64_t lumi : { 5ull, 6ull, 10ull, 11ull })
+		{
+			for (uint64_t eventNumber : { 100ull, 101ull, 5000000000ull, 705032704ull, 18446744073709551615ull })
+			{
+				eventInfo.nRun = run;
+				eventInfo.nLumi = lumi;
+				eventInfo.nEvent = eventNumber;
+				bool passesText = textFilter.DoesEventPass(event, product, textSettings, metadata);
+				bool passesBinary = binaryFilter.DoesEventPass(event, product, binarySettings, metadata);
+				BOOST_CHECK_MESSAGE(passesText == passesBinary, run << ":" << lumi << ":" << eventNumber);
+
+				std::vector<uint64_t> runLumiEvent({ run, lumi, eventNumber });
+				bool expected = ((std::find(whitelist.begin(), whitelist.end(), runLumiEvent) != whitelist.end()) &&
+				                 (std::find(blacklist.begin(), blacklist.end(), runLumiEvent) == blacklist.end()));
+				BOOST_CHECK_EQUAL(passesText, expected);
+				nPassingEvents += (passesText ? 1 : 0);
+			}
+		}
+	}
+	BOOST_CHECK_EQUAL(nPassingEvents, 5);
+}
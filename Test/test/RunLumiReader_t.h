@@ -0,0 +1,166 @@
+#pragma once
+
+#include <cstdio>
+#include <fstream>
+#include <limits>
+#include <map>
+#include <set>
+#include <string>
+#include <vector>
+
+#include <sys/stat.h>
+#include <unistd.h>
+#include <utime.h>
+
+#include <boost/test/included/unit_test.hpp>
+
+#include "Artus/KappaTools/interface/RunLumiReader.h"
+
+/*
+ Lookups of RunLumiSelector in the merged lumi ranges of several JSON files and the binary
+ cache of the JSON files.
+*/
+
+typedef std::map<run_id, std::set<std::pair<lumi_id, lumi_id> > > LumiFilter;
+
+class RunLumiReaderTestDirectory {
+public:
+	RunLumiReaderTestDirectory()
+	{
+		char directoryTemplate[] = "/tmp/RunLumiReader_t.XXXXXX";
+		BOOST_REQUIRE(mkdtemp(directoryTemplate) != nullptr);
+		directory = directoryTemplate;
+	}
+
+	~RunLumiReaderTestDirectory()
+	{
+		for (std::string const& fileName : fileNames)
+		{
+			std::remove(fileName.c_str());
+			std::remove((fileName + ".cache").c_str());
+		}
+		rmdir(directory.c_str());
+	}
+
+	std::string WriteFile(std::string const& name, std::string const& content)
+	{
+		std::string fileName = directory + "/" + name;
+		std::ofstream(fileName.c_str()) << content;
+		fileNames.insert(fileName);
+		return fileName;
+	}
+
+private:
+	std::string directory;
+	std::set<std::string> fileNames;
+};
+
+BOOST_AUTO_TEST_CASE( test_runlumiselector )
+{
+	RunLumiReaderTestDirectory directory;
+	std::vector<std::string> jsonFiles({
+		directory.WriteFile("first.json", "{\"1\": [[1, 10], [20, 30], [41, 41]], \"3\": [[5, 4294967295]], \"5\": [[7, 8]]}"),
+		// overlapping, adjacent and contained ranges, a range up to the largest lumi section and an empty range
+		directory.WriteFile("second.json", "{\"1\": [[11, 12], [25, 35], [40, 40], [2, 3]], \"3\": [[10, 20]], \"4\": [[1, 4294967295]], \"5\": [[20, 10]]}"),
+	});
+	RunLumiSelector selector(jsonFiles);
+
+	LumiFilter expectedLumiFilter({
+		{ 1, { {1, 10}, {2, 3}, {11, 12}, {20, 30}, {25, 35}, {40, 40}, {41, 41} } },
+		{ 3, { {5, 4294967295u}, {10, 20} } },
+		{ 4, { {1, 4294967295u} } },
+		{ 5, { {7, 8}, {20, 10} } },
+	});
+	BOOST_CHECK(selector.getRunLumiMap() == expectedLumiFilter);
+
+	std::vector<std::pair<run_id, lumi_id> > acceptedLumis({
+		{1, 1}, {1, 5}, {1, 10}, {1, 11}, {1, 12}, {1, 20}, {1, 30}, {1, 35}, {1, 40}, {1, 41},
+		{3, 5}, {3, 15}, {3, 21}, {3, 1000000}, {3, 4294967295u},
+		{4, 1}, {4, 4294967295u},
+		{5, 7}, {5, 8},
+	});
+	for (std::pair<run_id, lumi_id> const& lumi : acceptedLumis)
+	{
+		BOOST_CHECK_MESSAGE(selector.accept(lumi.first, lumi.second), lumi.first << ":" << lumi.second);
+	}
+	std::vector<std::pair<run_id, lumi_id> > rejectedLumis({
+		{1, 0}, {1, 13}, {1, 19}, {1, 36}, {1, 39}, {1, 42}, {1, 4294967295u},
+		{2, 1}, {3, 4}, {4, 0}, {5, 9}, {5, 15}, {5, 20}, {0, 0}, {6, 7},
+	});
+	for (std::pair<run_id, lumi_id> const& lumi : rejectedLumis)
+	{
+		BOOST_CHECK_MESSAGE(! selector.accept(lumi.first, lumi.second), lumi.first << ":" << lumi.second);
+	}
+
+	// JSON files added later are merged into the index
+	selector.addJSONFile(directory.WriteFile("third.json", "{\"1\": [[13, 19]], \"2\": [[1, 1]]}"));
+	for (lumi_id lumi = 1; lumi <= 35; ++lumi)
+	{
+		BOOST_CHECK(selector.accept(1, lumi));
+	}
+	BOOST_CHECK(selector.accept(2, 1));
+	BOOST_CHECK(! selector.accept(2, 2));
+
+	// all runs from passRunLow on are accepted
+	RunLumiSelector passingSelector(jsonFiles, 5, 0);
+	BOOST_CHECK(passingSelector.accept(5, 15));
+	BOOST_CHECK(passingSelector.accept(100, 1));
+	BOOST_CHECK(! passingSelector.accept(2, 1));
+	BOOST_CHECK(passingSelector.accept(1, 5));
+}
+
+BOOST_AUTO_TEST_CASE( test_runlumireader_cache )
+{
+	RunLumiReaderTestDirectory directory;
+	std::string jsonFile = directory.WriteFile("lumis.json", "{\"1\": [[1, 10], [20, 30]], \"2\": [[5, 4294967295]]}");
+	LumiFilter expectedLumiFilter({
+		{ 1, { {1, 10}, {20, 30} } },
+		{ 2, { {5, 4294967295u} } },
+	});
+
+	// the cache is written when the JSON file is read for the first time
+	LumiFilter lumiFilter;
+	readLumiFilter(jsonFile, lumiFilter, true);
+	BOOST_CHECK(lumiFilter == expectedLumiFilter);
+	struct stat fileStat;
+	BOOST_REQUIRE(stat((jsonFile + ".cache").c_str(), &fileStat) == 0);
+	BOOST_REQUIRE(stat(jsonFile.c_str(), &fileStat) == 0);
+
+	// a JSON file with the same size and modification time is read from the cache
+	directory.WriteFile("lumis.json", "{\"1\": [[1, 10], [20, 30]], \"3\": [[5, 4294967295]]}");
+	struct utimbuf times;
+	times.actime = fileStat.st_atime;
+	times.modtime = fileStat.st_mtime;
+	BOOST_REQUIRE(utime(jsonFile.c_str(), &times) == 0);
+
+	LumiFilter cachedLumiFilter;
+	readLumiFilter(jsonFile, cachedLumiFilter, true);
+	BOOST_CHECK(cachedLumiFilter == expectedLumiFilter);
+
+	LumiFilter jsonLumiFilter;
+	readLumiFilter(jsonFile, jsonLumiFilter, false);
+	BOOST_CHECK(jsonLumiFilter.count(3) == 1);
+	BOOST_CHECK(jsonLumiFilter.count(2) == 0);
+
+	// the cache is invalidated by a modified JSON file and replaced
+	times.modtime = fileStat.st_mtime - 10;
+	BOOST_REQUIRE(utime(jsonFile.c_str(), &times) == 0);
+	LumiFilter modifiedLumiFilter;
+	readLumiFilter(jsonFile, modifiedLumiFilter, true);
+	BOOST_CHECK(modifiedLumiFilter == jsonLumiFilter);
+	LumiFilter recachedLumiFilter;
+	readLumiFilter(jsonFile, recachedLumiFilter, true);
+	BOOST_CHECK(recachedLumiFilter == jsonLumiFilter);
+
+	// a broken cache is ignored
+	directory.WriteFile("lumis.json.cache", "KLUMIS01");
+	LumiFilter brokenCacheLumiFilter;
+	readLumiFilter(jsonFile, brokenCacheLumiFilter, true);
+	BOOST_CHECK(brokenCacheLumiFilter == jsonLumiFilter);
+
+	// the lumi ranges are added to the ranges already read
+	LumiFilter combinedLumiFilter({ { 1, { {40, 50} } } });
+	readLumiFilter(jsonFile, combinedLumiFilter, true);
+	BOOST_CHECK(combinedLumiFilter[1] == (std::set<std::pair<lumi_id, lumi_id> >({ {1, 10}, {20, 30}, {40, 50} })));
+	BOOST_CHECK(combinedLumiFilter.count(3) == 1);
+}
@@ -0,0 +1,130 @@
+#pragma once
+
+#include <boost/test/included/unit_test.hpp>
+
+#include "Artus/Core/interface/Pipeline.h"
+#include "Artus/Core/interface/RunTimeStatistics.h"
+
+#include "TestPipelineRunner.h"
+#include "TestLocalProducer.h"
+#include "TestFilter.h"
+#include "TestTypes.h"
+
+BOOST_AUTO_TEST_CASE( test_runtimestatistics )
+{
+	RunTimeStatistics statistics;
+	size_t producerSlot = statistics.AddProcessor("producer");
+	size_t filterSlot = statistics.AddProcessor("filter");
+	BOOST_CHECK(producerSlot != filterSlot);
+	BOOST_CHECK_EQUAL(statistics.AddProcessor("producer"), producerSlot);
+
+	RunTimeStatistics::Clock::time_point start = RunTimeStatistics::Clock::now();
+	statistics.AddRunTime(producerSlot, start, start + std::chrono::nanoseconds(100));
+	statistics.AddRunTime(producerSlot, start, start + std::chrono::nanoseconds(300));
+
+	RunTimeStatistics::ProcessorStatistics const* producer = statistics.GetProcessorStatistics("producer");
+	BOOST_REQUIRE(producer != nullptr);
+	BOOST_CHECK_EQUAL(producer->count, 2);
+	BOOST_CHECK_EQUAL(producer->sum, 400);
+	BOOST_CHECK_EQUAL(producer->min, 100);
+	BOOST_CHECK_EQUAL(producer->max, 300);
+	BOOST_CHECK_EQUAL(producer->GetMean(), 200.0);
+	// 100 ns in [64, 128), 300 ns in [256, 512)
+	BOOST_CHECK_EQUAL(producer->histogram[6], 1);
+	BOOST_CHECK_EQUAL(producer->histogram[8], 1);
+	BOOST_CHECK_EQUAL(RunTimeStatistics::GetHistogramBinLowEdge(6), 64);
+
+	BOOST_CHECK_EQUAL(statistics.GetProcessorStatistics("filter")->count, 0);
+	BOOST_CHECK(statistics.GetProcessorStatistics("unknown") == nullptr);
+
+	// processors are matched by name, unknown ones are added
+	RunTimeStatistics replica;
+	replica.AddProcessor("other");
+	replica.AddRunTime(replica.AddProcessor("producer"), start, start + std::chrono::nanoseconds(50));
+	statistics.Merge(replica);
+
+	producer = statistics.GetProcessorStatistics("producer");
+	BOOST_CHECK_EQUAL(producer->count, 3);
+	BOOST_CHECK_EQUAL(producer->min, 50);
+	BOOST_CHECK_EQUAL(producer->histogram[5], 1);
+	BOOST_CHECK_EQUAL(statistics.GetProcessorStatistics().size(), 3);
+}
+
+BOOST_AUTO_TEST_CASE( test_pipeline_runtime_measurement )
+{
+	Pipeline<TestTypes> pline;
+	pline.AddProducer(new TestLocalProducer());
+	pline.AddFilter(new TestFilter());
+
+	TestPipelineInitializer init;
+	TestMetadata metadata;
+	TestSettings settings;
+	settings.SetRunTimeMeasurement(true);
+	pline.InitPipeline(settings, metadata, init);
+
+	TestProduct product;
+	TestEvent td;
+	FilterResult globalFilterResult;
+
+	// the filter passes the first event and rejects the second one
+	td.iVal = 0;
+	BOOST_CHECK(pline.RunEvent(td, product, globalFilterResult));
+	td.iVal = 5;
+	BOOST_CHECK(! pline.RunEvent(td, product, globalFilterResult));
+
+	RunTimeStatistics const* statistics = pline.GetMetadata().m_runTimeStatistics;
+	BOOST_REQUIRE(statistics != nullptr);
+	BOOST_CHECK_EQUAL(statistics->GetProcessorStatistics("test_local_producer")->count, 2);
+	BOOST_CHECK_EQUAL(statistics->GetProcessorStatistics("testfilter")->count, 2);
+
+	// nothing is measured by default
+	Pipeline<TestTypes> plineWithoutMeasurement;
+	plineWithoutMeasurement.AddProducer(new TestLocalProducer());
+	plineWithoutMeasurement.InitPipeline(TestSettings(), metadata, init);
+	plineWithoutMeasurement.RunEvent(td, product, globalFilterResult);
+	BOOST_CHECK_EQUAL(plineWithoutMeasurement.GetMetadata().m_runTimeStatistics->GetProcessorStatistics("test_local_producer")->count, 0);
+}
+
+BOOST_AUTO_TEST_CASE( test_shared_stage_runtime_measurement )
+{
+	TestPipelineInitializer init;
+	TestMetadata metadata;
+	TestSettings settings;
+	settings.SetRunTimeMeasurement(true);
+
+	// the producer is run once per event for both pipelines
+	Pipeline<TestTypes> stage;
+	stage.AddProducer(new TestLocalProducer());
+	stage.InitSharedStage(settings, metadata);
+
+	boost::ptr_vector<Pipeline<TestTypes> > plines;
+	for (size_t pipelineIndex = 0; pipelineIndex < 2; ++pipelineIndex)
+	{
+		plines.push_back(new Pipeline<TestTypes>());
+		plines.back().SetSharedStage(&stage);
+		plines.back().AddFilter(new TestFilter());
+		plines.back().InitPipeline(settings, stage.GetMetadata(), init);
+	}
+
+	TestProduct product;
+	TestEvent td;
+	FilterResult globalFilterResult;
+	for (td.iVal = 0; td.iVal < 3; ++td.iVal)
+	{
+		stage.RunSharedStage(td, product, globalFilterResult);
+		for (Pipeline<TestTypes>& pline : plines)
+		{
+			pline.RunEvent(td, product, globalFilterResult);
+		}
+	}
+
+	// the RunTimeConsumer of every pipeline finds the run times of the shared producer via the metadata
+	for (Pipeline<TestTypes>& pline : plines)
+	{
+		RunTimeStatistics::ProcessorStatistics const* producer = pline.GetMetadata().GetProcessorRunTimeStatistics("test_local_producer");
+		BOOST_REQUIRE(producer != nullptr);
+		BOOST_CHECK_EQUAL(producer->count, 3);
+		BOOST_CHECK_EQUAL(pline.GetMetadata().GetProcessorRunTimeStatistics("testfilter")->count, 3);
+		BOOST_CHECK(pline.GetMetadata().GetProcessorRunTimeStatistics("unknown") == nullptr);
+	}
+}
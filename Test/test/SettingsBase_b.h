@@ -0,0 +1,72 @@
+#pragma once
+
+#include <string>
+
+#include <boost/property_tree/ptree.hpp>
+
+#include "Artus/Configuration/interface/SettingsBase.h"
+
+#include "Benchmark.h"
+
+/*
+Benchmarks of the access to cached settings, as done by the processors in every event.
+*/
+
+class BenchmarkSettings : public SettingsBase {
+public:
+	IMPL_SETTING_DEFAULT(std::string, BenchmarkString, "benchmark_setting_with_a_typical_length")
+	IMPL_SETTING_DEFAULT(float, BenchmarkFloat, 1.0f)
+	IMPL_SETTING_UINT64LIST_DEFAULT(BenchmarkList, {})
+};
+
+ARTUS_BENCHMARK( benchmark_settings_string )
+{
+	boost::property_tree::ptree propertyTree;
+	BenchmarkSettings settings;
+	settings.SetPropTree(&propertyTree);
+
+	size_t sum = 0;
+	for (long long iteration = 0; iteration < nIterations; ++iteration)
+	{
+		sum += settings.GetBenchmarkString().size();
+	}
+	Benchmark::DoNotOptimise(sum);
+}
+
+ARTUS_BENCHMARK( benchmark_settings_float )
+{
+	boost::property_tree::ptree propertyTree;
+	BenchmarkSettings settings;
+	settings.SetPropTree(&propertyTree);
+
+	float sum = 0.0f;
+	for (long long iteration = 0; iteration < nIterations; ++iteration)
+	{
+		sum += settings.GetBenchmarkFloat();
+	}
+	Benchmark::DoNotOptimise(sum);
+}
+
+// list setting accessed in a loop over its entries, as in RunLumiEventFilter
+ARTUS_BENCHMARK( benchmark_settings_list_10_entries )
+{
+	boost::property_tree::ptree benchmarkList;
+	for (int entry = 0; entry < 10; ++entry)
+	{
+		benchmarkList.push_back(std::make_pair("", boost::property_tree::ptree(std::to_string(entry))));
+	}
+	boost::property_tree::ptree propertyTree;
+	propertyTree.add_child("BenchmarkList", benchmarkList);
+	BenchmarkSettings settings;
+	settings.SetPropTree(&propertyTree);
+
+	uint64_t sum = 0;
+	for (long long iteration = 0; iteration < nIterations; ++iteration)
+	{
+		for (size_t index = 0; index < settings.GetBenchmarkList().size(); ++index)
+		{
+			sum += settings.GetBenchmarkList()[index];
+		}
+	}
+	Benchmark::DoNotOptimise(sum);
+}
@@ -30,7 +30,7 @@ public:
 	// this method is called for all events
 	void ProcessEvent(TestEvent const& event, TestProduct const& product,
 			TestSettings const& setting, TestMetadata const& metadata,
-			FilterResult& result) override
+			FilterResult const& result) override
 	{
 		if ( bCheckInProcessEvent ) {
 			// did product work ?
@@ -46,6 +46,17 @@ public:
 		++iProcess;
 	}
 
+	bool SupportsMerge() const override {
+		return true;
+	}
+
+	void Merge(ConsumerBase<TestTypes> const& replica, TestSettings const& setting, TestMetadata const& metadata) override {
+		TestConsumer const& testReplica = static_cast<TestConsumer const&>(replica);
+		iProcessFilteredEvent += testReplica.iProcessFilteredEvent;
+		iProcessEvent += testReplica.iProcessEvent;
+		iProcess += testReplica.iProcess;
+	}
+
 	void CheckCalls(int ProcessFilteredEvt, int ProcessEvt,	int Process_ = 0) {
 		BOOST_CHECK_EQUAL(iInit, 1);
 		BOOST_CHECK_EQUAL(iFinish, 1);
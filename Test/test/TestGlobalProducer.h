@@ -12,6 +12,10 @@ public:
 	std::string GetProducerId() const override {
 		return "test_global_producer";
 	}
+
+	void GetRequiredEventMembers(std::set<std::string>& eventMembers) const override {
+		eventMembers.insert("iVal");
+	}
 	
 	void Produce(TestEvent const& event,
 			TestProduct & product,
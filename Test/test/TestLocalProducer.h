@@ -14,6 +14,10 @@ public:
 		return "test_local_producer";
 	}
 
+	void GetRequiredEventMembers(std::set<std::string>& eventMembers) const override {
+		eventMembers.insert("iVal");
+	}
+
 	// for each pipeline
 	void Produce(TestEvent const& event,
 			TestProduct & product,
@@ -42,6 +42,8 @@ public:
 		return 0;
 	}
 
+	IMPL_PROPERTY_INITIALIZE(bool, RunTimeMeasurement, false)
+
 	IMPL_PROPERTY(unsigned int, Offset)
 };
 
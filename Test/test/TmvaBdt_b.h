@@ -0,0 +1,202 @@
+#pragma once
+
+#include <cmath>
+#include <cstdio>
+#include <fstream>
+#include <iomanip>
+#include <random>
+#include <sstream>
+#include <string>
+#include <vector>
+
+#include <unistd.h>
+
+#include <boost/property_tree/ptree.hpp>
+#include <boost/property_tree/xml_parser.hpp>
+
+#include "Artus/Utility/interface/ArtusLogging.h"
+#include "Artus/Utility/interface/TmvaBdt.h"
+
+#include "Benchmark.h"
+
+/*
+Benchmarks of the evaluation of BDTs from TMVA weight files without TMVA, for single events
+and for blocks of events.
+
+The weight files are random forests written in the TMVA XML format to a temporary file. Before
+the first run, the outputs are checked against a straightforward evaluation of the XML trees
+following TMVA::DecisionTree::CheckEvent and TMVA::MethodBDT.
+*/
+
+class BenchmarkTmvaBdt {
+public:
+	static const size_t nVariables = 12;
+	static const size_t nEvents = 4096;
+
+	BenchmarkTmvaBdt(std::string const& boostType, size_t nTrees, size_t depth)
+	{
+		std::mt19937 generator(42);
+		std::uniform_real_distribution<float> uniform(-1.0f, 1.0f);
+
+		std::stringstream weights;
+		weights << "<?xml version=\"1.0\"?>\n<MethodSetup Method=\"BDT::BDT\">\n";
+		weights << "  <Options>\n    <Option name=\"BoostType\" modified=\"Yes\">" << boostType << "</Option>\n";
+		weights << "    <Option name=\"UseYesNoLeaf\" modified=\"No\">True</Option>\n  </Options>\n";
+		weights << "  <Variables NVar=\"" << nVariables << "\">\n";
+		for (size_t variable = 0; variable < nVariables; ++variable)
+		{
+			weights << "    <Variable VarIndex=\"" << variable << "\" Expression=\"var" << variable << "\" Label=\"var" << variable << "\" Type=\"F\"/>\n";
+			variables.push_back("var" + std::to_string(variable));
+		}
+		weights << "  </Variables>\n  <Transformations NTransformations=\"0\"/>\n";
+		weights << "  <Weights NTrees=\"" << nTrees << "\" AnalysisType=\"0\">\n";
+		for (size_t tree = 0; tree < nTrees; ++tree)
+		{
+			weights << "    <BinaryTree type=\"DecisionTree\" boostWeight=\"" << std::setprecision(16) << 0.5 + 0.5 * std::abs(uniform(generator)) << "\" itree=\"" << tree << "\">\n";
+			WriteNode(weights, generator, "s", 0, depth);
+			weights << "    </BinaryTree>\n";
+		}
+		weights << "  </Weights>\n</MethodSetup>\n";
+
+		char weightFile[] = "/tmp/TmvaBdt_b.XXXXXX";
+		int fileDescriptor = mkstemp(weightFile);
+		if (fileDescriptor < 0)
+		{
+			LOG(FATAL) << "Could not create a temporary weight file for the BDT benchmarks.";
+		}
+		close(fileDescriptor);
+		std::ofstream(weightFile) << weights.str();
+		if (! bdt.ReadWeightFile(weightFile, variables))
+		{
+			LOG(FATAL) << "Could not read the BDT of the benchmark weight file.";
+		}
+		boost::property_tree::read_xml(weightFile, referenceWeights);
+		std::remove(weightFile);
+
+		inputs.resize(nEvents * nVariables);
+		for (float& input : inputs)
+		{
+			input = uniform(generator);
+		}
+
+		CheckOutputs(boostType == "Grad");
+	}
+
+	TmvaBdt bdt;
+	std::vector<std::string> variables;
+	std::vector<float> inputs;
+
+private:
+	static void WriteNode(std::ostream& weights, std::mt19937& generator, std::string const& position, size_t depth, size_t maxDepth)
+	{
+		std::uniform_real_distribution<float> uniform(-1.0f, 1.0f);
+		std::string indentation(6 + 2 * depth, ' ');
+		weights << indentation << "<Node pos=\"" << position << "\" depth=\"" << depth << "\" NCoef=\"0\"";
+		if (depth == maxDepth)
+		{
+			weights << " IVar=\"-1\" Cut=\"0\" cType=\"1\" res=\"" << std::setprecision(9) << 0.1 * uniform(generator)
+			        << "\" rms=\"0\" purity=\"" << 0.5 + 0.5 * uniform(generator)
+			        << "\" nType=\"" << ((uniform(generator) > 0.0f) ? 1 : -1) << "\"/>\n";
+			return;
+		}
+		weights << " IVar=\"" << (generator() % nVariables) << "\" Cut=\"" << std::setprecision(9) << uniform(generator)
+		        << "\" cType=\"" << (generator() % 2) << "\" res=\"0\" rms=\"0\" purity=\"0.5\" nType=\"0\">\n";
+		WriteNode(weights, generator, "l", depth + 1, maxDepth);
+		WriteNode(weights, generator, "r", depth + 1, maxDepth);
+		weights << indentation << "</Node>\n";
+	}
+
+	double EvaluateReference(float const* eventInputs, bool gradientBoost) const
+	{
+		double sum = 0.0;
+		double norm = 0.0;
+		for (boost::property_tree::ptree::value_type const& tree : referenceWeights.get_child("MethodSetup.Weights"))
+		{
+			if (tree.first != "BinaryTree")
+			{
+				continue;
+			}
+			boost::property_tree::ptree const* node = &(tree.second.get_child("Node"));
+			while (node->get<int>("<xmlattr>.nType") == 0)
+			{
+				bool goesRight = (eventInputs[node->get<int>("<xmlattr>.IVar")] >= node->get<float>("<xmlattr>.Cut"));
+				std::string daughterPosition = ((goesRight == (node->get<int>("<xmlattr>.cType") != 0)) ? "r" : "l");
+				for (boost::property_tree::ptree::value_type const& daughter : *node)
+				{
+					if ((daughter.first == "Node") && (daughter.second.get<std::string>("<xmlattr>.pos") == daughterPosition))
+					{
+						node = &(daughter.second);
+						break;
+					}
+				}
+			}
+			double boostWeight = tree.second.get<double>("<xmlattr>.boostWeight");
+			sum += (gradientBoost ? node->get<float>("<xmlattr>.res") : boostWeight * node->get<int>("<xmlattr>.nType"));
+			norm += boostWeight;
+		}
+		return (gradientBoost ? 2.0 / (1.0 + std::exp(-2.0 * sum)) - 1.0 : sum / norm);
+	}
+
+	void CheckOutputs(bool gradientBoost) const
+	{
+		std::vector<double> outputs(nEvents);
+		bdt.Evaluate(inputs.data(), nEvents, outputs.data());
+		for (size_t event = 0; event < nEvents; ++event)
+		{
+			float const* eventInputs = inputs.data() + (event * nVariables);
+			double reference = EvaluateReference(eventInputs, gradientBoost);
+			double output = bdt.Evaluate(eventInputs);
+			if ((std::abs(output - reference) > 1e-12) || (outputs[event] != output))
+			{
+				LOG(FATAL) << "BDT output " << output << " (" << outputs[event] << " for blocks of events) differs from the reference " << reference << "!";
+			}
+		}
+	}
+
+	boost::property_tree::ptree referenceWeights;
+};
+
+inline BenchmarkTmvaBdt const& GetBenchmarkTmvaBdt(bool gradientBoost)
+{
+	static BenchmarkTmvaBdt benchmarkGradientBoost("Grad", 400, 4);
+	static BenchmarkTmvaBdt benchmarkAdaBoost("AdaBoost", 400, 4);
+	return (gradientBoost ? benchmarkGradientBoost : benchmarkAdaBoost);
+}
+
+// evaluate the BDT for nIterations events, one at a time or in blocks of nEventsPerBlock events
+inline void RunBenchmarkTmvaBdt(long long nIterations, bool gradientBoost, size_t nEventsPerBlock)
+{
+	BenchmarkTmvaBdt const& benchmarkTmvaBdt = GetBenchmarkTmvaBdt(gradientBoost);
+	std::vector<double> outputs(nEventsPerBlock);
+	double sum = 0.0;
+	for (long long iteration = 0; iteration < nIterations; iteration += nEventsPerBlock)
+	{
+		size_t event = (iteration % (BenchmarkTmvaBdt::nEvents - nEventsPerBlock));
+		float const* eventInputs = benchmarkTmvaBdt.inputs.data() + (event * BenchmarkTmvaBdt::nVariables);
+		if (nEventsPerBlock == 1)
+		{
+			sum += benchmarkTmvaBdt.bdt.Evaluate(eventInputs);
+		}
+		else
+		{
+			benchmarkTmvaBdt.bdt.Evaluate(eventInputs, nEventsPerBlock, outputs.data());
+			sum += outputs[0];
+		}
+	}
+	Benchmark::DoNotOptimise(sum);
+}
+
+ARTUS_BENCHMARK( benchmark_tmva_bdt_grad_400_trees_single_events )
+{
+	RunBenchmarkTmvaBdt(nIterations, true, 1);
+}
+
+ARTUS_BENCHMARK( benchmark_tmva_bdt_grad_400_trees_blocks_of_64_events )
+{
+	RunBenchmarkTmvaBdt(nIterations, true, 64);
+}
+
+ARTUS_BENCHMARK( benchmark_tmva_bdt_adaboost_400_trees_single_events )
+{
+	RunBenchmarkTmvaBdt(nIterations, false, 1);
+}
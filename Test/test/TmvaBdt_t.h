@@ -0,0 +1,145 @@
+#pragma once
+
+#include <algorithm>
+#include <cstdio>
+#include <string>
+#include <vector>
+
+#include <unistd.h>
+
+#include <boost/test/included/unit_test.hpp>
+
+#include <TFile.h>
+#include <TRandom3.h>
+#include <TTree.h>
+#include <TMVA/Config.h>
+#include <TMVA/Factory.h>
+#include <TMVA/Reader.h>
+#include <TMVA/Types.h>
+
+#include "Artus/Utility/interface/TmvaBdt.h"
+
+/*
+ Train small BDTs with TMVA and compare the outputs of TMVA::Reader with the ones of TmvaBdt
+ for the same weight files and inputs.
+*/
+
+// train a BDT with the given options on Gaussian signal and background samples and return the weight file
+inline std::string TrainTmvaBdtForTest(std::string const& directory, std::string const& methodTitle, std::string const& methodOptions,
+                                       std::vector<std::string> const& variables)
+{
+	TRandom3 random(4357);
+	std::vector<float> values(variables.size());
+	TTree signalTree("signal", "signal");
+	TTree backgroundTree("background", "background");
+	for (size_t variable = 0; variable < variables.size(); ++variable)
+	{
+		signalTree.Branch(variables[variable].c_str(), &(values[variable]), (variables[variable] + "/F").c_str());
+		backgroundTree.Branch(variables[variable].c_str(), &(values[variable]), (variables[variable] + "/F").c_str());
+	}
+	for (size_t event = 0; event < 2000; ++event)
+	{
+		for (size_t variable = 0; variable < variables.size(); ++variable)
+		{
+			values[variable] = random.Gaus(0.5, 1.0 + 0.1 * variable);
+		}
+		signalTree.Fill();
+		for (size_t variable = 0; variable < variables.size(); ++variable)
+		{
+			values[variable] = random.Gaus(-0.5, 1.0);
+		}
+		backgroundTree.Fill();
+	}
+
+	(TMVA::gConfig().GetIONames()).fWeightFileDir = directory.c_str();
+	TFile outputFile((directory + "/" + methodTitle + ".root").c_str(), "RECREATE");
+	{
+		TMVA::Factory factory("TmvaBdt_t", &outputFile, "!V:Silent:!Color:!DrawProgressBar:AnalysisType=Classification");
+		for (std::string const& variable : variables)
+		{
+			factory.AddVariable(variable.c_str(), 'F');
+		}
+		factory.AddSignalTree(&signalTree, 1.0);
+		factory.AddBackgroundTree(&backgroundTree, 1.0);
+		factory.PrepareTrainingAndTestTree("", "SplitMode=Random:NormMode=None:!V");
+		factory.BookMethod(TMVA::Types::kBDT, methodTitle.c_str(), methodOptions.c_str());
+		factory.TrainAllMethods();
+	}
+	outputFile.Close();
+	std::remove((directory + "/" + methodTitle + ".root").c_str());
+
+	return directory + "/TmvaBdt_t_" + methodTitle + ".weights.xml";
+}
+
+inline void CheckTmvaBdt(std::string const& methodTitle, std::string const& methodOptions)
+{
+	char directory[] = "/tmp/TmvaBdt_t.XXXXXX";
+	BOOST_REQUIRE(mkdtemp(directory) != nullptr);
+
+	std::vector<std::string> variables({ "var0", "var1", "var2" });
+	std::string weightFile = TrainTmvaBdtForTest(directory, methodTitle, methodOptions, variables);
+
+	std::vector<float> inputs(variables.size());
+	TMVA::Reader reader("!Color:Silent");
+	for (size_t variable = 0; variable < variables.size(); ++variable)
+	{
+		reader.AddVariable(variables[variable].c_str(), &(inputs[variable]));
+	}
+	reader.BookMVA(methodTitle.c_str(), weightFile.c_str());
+
+	TmvaBdt bdt;
+	BOOST_REQUIRE(bdt.ReadWeightFile(weightFile, variables));
+	BOOST_CHECK_EQUAL(bdt.GetNVariables(), variables.size());
+	BOOST_CHECK_EQUAL(bdt.GetNTrees(), 20);
+
+	std::remove(weightFile.c_str());
+	std::remove((std::string(directory) + "/TmvaBdt_t_" + methodTitle + ".class.C").c_str());
+	rmdir(directory);
+
+	const size_t nEvents = 1000;
+	std::vector<float> eventInputs(nEvents * variables.size());
+	std::vector<double> outputs(nEvents);
+	TRandom3 random(65539);
+	for (float& input : eventInputs)
+	{
+		input = random.Gaus(0.0, 1.5);
+	}
+	bdt.Evaluate(eventInputs.data(), nEvents, outputs.data());
+
+	for (size_t event = 0; event < nEvents; ++event)
+	{
+		std::copy(eventInputs.begin() + (event * variables.size()), eventInputs.begin() + ((event + 1) * variables.size()), inputs.begin());
+		double output = bdt.Evaluate(inputs.data());
+		BOOST_CHECK_SMALL(output - reader.EvaluateMVA(methodTitle.c_str()), 1e-9);
+		BOOST_CHECK_EQUAL(outputs[event], output);
+	}
+}
+
+BOOST_AUTO_TEST_CASE( test_tmvabdt_gradient_boost )
+{
+	CheckTmvaBdt("BDTG", "!H:!V:NTrees=20:BoostType=Grad:Shrinkage=0.2:MaxDepth=3");
+}
+
+BOOST_AUTO_TEST_CASE( test_tmvabdt_adaboost )
+{
+	CheckTmvaBdt("BDT", "!H:!V:NTrees=20:BoostType=AdaBoost:AdaBoostBeta=0.5:MaxDepth=3");
+}
+
+BOOST_AUTO_TEST_CASE( test_tmvabdt_unsupported_options )
+{
+	char directory[] = "/tmp/TmvaBdt_t.XXXXXX";
+	BOOST_REQUIRE(mkdtemp(directory) != nullptr);
+
+	std::vector<std::string> variables({ "var0", "var1", "var2" });
+	std::string weightFile = TrainTmvaBdtForTest(directory, "BDTPreselection", "!H:!V:NTrees=20:BoostType=Grad:MaxDepth=3:DoPreselection", variables);
+
+	// these weight files are left to TMVA
+	TmvaBdt bdt;
+	BOOST_CHECK(! bdt.ReadWeightFile(weightFile, variables));
+	BOOST_CHECK(! bdt.ReadWeightFile(weightFile, std::vector<std::string>({ "var0", "var2", "var1" })));
+	BOOST_CHECK(! bdt.ReadWeightFile(directory + std::string("/missing.weights.xml"), variables));
+
+	std::remove(weightFile.c_str());
+	std::remove((std::string(directory) + "/TmvaBdt_t_BDTPreselection.class.C").c_str());
+	rmdir(directory);
+}
@@ -7,6 +7,8 @@
 #define ELPP_DISABLE_TRACE_LOGS
 #define ELPP_DISABLE_DEFAULT_CRASH_HANDLING
 #define ELPP_STACKTRACE_ON_CRASH
+// pipelines can be run on several threads (PipelineRunner::RunPipelinesParallel)
+#define ELPP_THREAD_SAFE
 
 #include "Artus/Utility/interface/easylogging++.h"
 
@@ -0,0 +1,90 @@
+
+#pragma once
+
+#include <memory>
+
+/*
+Wrapper for (large) product members, which are shared between copies of the product
+until one of the copies writes to them:
+
+    CopyOnWrite<std::map<int, std::string> > globalMap;
+    globalMap.GetMutable()[42] = "42";
+
+    CopyOnWrite<std::map<int, std::string> > localMap(globalMap); // no copy of the map
+    std::string const& value = localMap->at(42);                  // still no copy
+    localMap.GetMutable()[23] = "23";                             // localMap gets its own copy
+
+The pipelines copy the global product for every event. Members wrapped in this class
+behave like a read-only view on the global product for pipelines that never modify
+them, and only the pipelines writing to them pay for the copy.
+
+Pointers or references obtained from GetMutable() are only valid until the next copy
+of the wrapper is modified for the first time. Keep this in mind for products storing
+pointers into their own members.
+*/
+template<class T>
+class CopyOnWrite
+{
+public:
+
+	CopyOnWrite() :
+		m_value(std::make_shared<T>())
+	{
+	}
+
+	CopyOnWrite(T const& value) :
+		m_value(std::make_shared<T>(value))
+	{
+	}
+
+	// read access, never copies the value
+	T const& Get() const
+	{
+		return *m_value;
+	}
+
+	T const& operator*() const
+	{
+		return *m_value;
+	}
+
+	T const* operator->() const
+	{
+		return m_value.get();
+	}
+
+	// write access, creates a private copy of the value if it is shared with other products
+	T& GetMutable()
+	{
+		if (IsShared())
+		{
+			m_value = std::make_shared<T>(*m_value);
+		}
+		return *m_value;
+	}
+
+	// write access to an empty (default constructed) value
+	// Use this instead of GetMutable().clear() in order to avoid copying a shared value that
+	// is going to be dropped anyway.
+	T& Reset()
+	{
+		if (IsShared())
+		{
+			m_value = std::make_shared<T>();
+		}
+		else
+		{
+			*m_value = T();
+		}
+		return *m_value;
+	}
+
+	bool IsShared() const
+	{
+		return (m_value.use_count() > 1);
+	}
+
+private:
+	std::shared_ptr<T> m_value;
+};
+
@@ -0,0 +1,123 @@
+#pragma once
+
+#include <algorithm>
+#include <cstddef>
+#include <memory>
+#include <new>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+/*
+Memory for objects which only live until the end of the event, e.g. the corrected
+physics objects in the product:
+
+    KTau* correctedTau = product.m_correctedObjectsArena.Create<KTau>(*tau);
+
+The objects are placed one after another in large blocks, which are kept and reused
+for the next events. Reset() destroys all objects at once, there is no way to free
+single objects.
+
+Copies of an arena are empty and assigning an arena resets it, such that the pipelines
+reset the arena of their local product when it is overwritten with the global product
+of the next event. Pointers into the arena of the global product (copied together with
+the product) stay valid until the global product is destroyed at the end of the event.
+*/
+class ObjectArena
+{
+public:
+
+	explicit ObjectArena(size_t blockSize = 65536) :
+		m_blockSize(blockSize)
+	{
+	}
+
+	ObjectArena(ObjectArena const& arena) :
+		ObjectArena(arena.m_blockSize)
+	{
+	}
+
+	ObjectArena& operator=(ObjectArena const&)
+	{
+		Reset();
+		return *this;
+	}
+
+	~ObjectArena()
+	{
+		Reset();
+	}
+
+	template<class T, class... TArguments>
+	T* Create(TArguments&&... arguments)
+	{
+		T* object = new (Allocate(sizeof(T), alignof(T))) T(std::forward<TArguments>(arguments)...);
+		if (! std::is_trivially_destructible<T>::value)
+		{
+			m_destructors.push_back(std::make_pair(static_cast<void*>(object), &Destroy<T>));
+		}
+		return object;
+	}
+
+	// destroy all objects, the memory is kept for the next event
+	void Reset()
+	{
+		for (std::vector<std::pair<void*, void (*)(void*)> >::reverse_iterator destructor = m_destructors.rbegin();
+		     destructor != m_destructors.rend(); ++destructor)
+		{
+			destructor->second(destructor->first);
+		}
+		m_destructors.clear();
+		m_currentBlock = 0;
+		m_currentOffset = 0;
+	}
+
+	size_t GetNumberOfBlocks() const
+	{
+		return m_blocks.size();
+	}
+
+private:
+
+	struct Block
+	{
+		std::unique_ptr<char[]> memory;
+		size_t size;
+	};
+
+	template<class T>
+	static void Destroy(void* object)
+	{
+		static_cast<T*>(object)->~T();
+	}
+
+	void* Allocate(size_t size, size_t alignment)
+	{
+		while (m_currentBlock < m_blocks.size())
+		{
+			Block& block = m_blocks[m_currentBlock];
+			size_t offset = (m_currentOffset + alignment - 1) & ~(alignment - 1);
+			if (offset + size <= block.size)
+			{
+				m_currentOffset = offset + size;
+				return block.memory.get() + offset;
+			}
+			++m_currentBlock;
+			m_currentOffset = 0;
+		}
+
+		// new blocks are aligned for all fundamental types, objects larger than a block get their own one
+		Block block;
+		block.size = std::max(size, m_blockSize);
+		block.memory.reset(new char[block.size]);
+		m_blocks.push_back(std::move(block));
+		m_currentOffset = size;
+		return m_blocks.back().memory.get();
+	}
+
+	size_t m_blockSize;
+	std::vector<Block> m_blocks;
+	size_t m_currentBlock = 0;
+	size_t m_currentOffset = 0;
+	std::vector<std::pair<void*, void (*)(void*)> > m_destructors;
+};
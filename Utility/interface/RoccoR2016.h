@@ -1,6 +1,8 @@
 
 #pragma once
 
+#include <vector>
+
 #include "TRandom3.h"
 #include "TMath.h"
 
@@ -96,6 +98,19 @@ struct CrystalBall2016{
 //const double CrystalBall::SPiO2 = sqrt(TMath::Pi()/2.0);
 //const double CrystalBall::S2    = sqrt(2.0);
 
+// kinematics of one muon for the corrections of all muons of an event
+struct RocMuon2016{
+    int Q;
+    double pt;
+    double eta;
+    double phi;
+    int n;      // tracker layers with measurement (MC only)
+    bool genMatched; // matched to a generator muon (MC only)
+    double gt;  // pt of the matched generator muon, only used for generator matched muons (MC only)
+    double u;   // random numbers (MC only), only w is used for generator matched muons
+    double w;
+};
+
 class RocRes2016{
     private:
 	static const int NMAXETA=12;
@@ -145,6 +160,9 @@ class RocRes2016{
 	double kSmear(double pt, double eta, TYPE type, double v, double u) const;
 	double kSmear(double pt, double eta, TYPE type, double v, double u, int n) const;
 	double kExtra(double pt, double eta, int nlayers, double u, double w) const;
+	// same as kSpread and kExtra for a known |eta| bin H
+	double kSpreadBin(double gpt, double rpt, int H, int nlayers, double w) const;
+	double kExtraBin(double pt, int H, int nlayers, double u, double w) const;
 	double getkDat(int H) const{return kDat[H];}
 	double getkRes(int H) const{return kRes[H];}
 };
@@ -166,10 +184,19 @@ class RocOne2016{
 	double A[2][NMAXETA][NMAXPHI];
 	double D[2][NMAXETA];
 
+	// M, A and D of each eta/phi bin next to each other, filled from the arrays above
+	struct ScaleBin{
+	    double m;
+	    double a;
+	    double d;
+	};
+	ScaleBin scaleBins[2][NMAXETA*NMAXPHI];
+
 	RocRes2016 RR;
 
 	int getBin(double x, const int NN, const double *b) const;
 	int getBin(double x, const int nmax, const double xmin, const double dx) const;
+	void fillScaleBins();
 
     public:
 	enum TYPE{MC, DT};
@@ -189,6 +216,11 @@ class RocOne2016{
 	double kScaleFromGenMC(int Q, double pt, double eta, double phi, int n, double gt, double w) const;
 	double kGenSmear(double pt, double eta, double v, double u, RocRes2016::TYPE TT=RocRes2016::Data) const;
 
+	// corrections of nMuons muons at once, identical to kScaleDT and to kScaleFromGenMC
+	// (generator matched muons) or kScaleAndSmearMC (other muons) per muon
+	void kScaleDT(const RocMuon2016 *muons, size_t nMuons, double *k) const;
+	void kScaleAndSmearMC(const RocMuon2016 *muons, size_t nMuons, double *k) const;
+
 	double getM(int T, int H, int F) const{return M[T][H][F];}
 	double getA(int T, int H, int F) const{return A[T][H][F];}
 	double getK(int T, int H) const{return T==DT?RR.getkDat(H):RR.getkRes(H);}
@@ -210,6 +242,10 @@ class RoccoR2016{
 	double kScaleAndSmearMC(int Q, double pt, double eta, double phi, int n, double u, double w, int s=0, int m=0) const;  
 	double kScaleFromGenMC(int Q, double pt, double eta, double phi, int n, double gt, double w, int s=0, int m=0) const; 
 
+	// corrections of all muons of an event, see RocOne2016
+	void kScaleDT(std::vector<RocMuon2016> const& muons, std::vector<double>& k, int s=0, int m=0) const;
+	void kScaleAndSmearMC(std::vector<RocMuon2016> const& muons, std::vector<double>& k, int s=0, int m=0) const;
+
 
 	double getM(int T, int H, int F, int E=0, int m=0) const{return RC[E][m].getM(T,H,F);}
 	double getA(int T, int H, int F, int E=0, int m=0) const{return RC[E][m].getA(T,H,F);}
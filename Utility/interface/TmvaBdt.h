@@ -0,0 +1,71 @@
+#pragma once
+
+#include <cmath>
+#include <limits>
+#include <string>
+#include <vector>
+
+#include <boost/property_tree/ptree.hpp>
+
+
+/**
+   \brief Evaluation of boosted decision trees from TMVA XML weight files without TMVA
+
+   The trees of the weight file are flattened into one array of nodes, which is walked with
+   one comparison per level. The output is the same as that of TMVA::Reader::EvaluateMVA for
+   classification BDTs with gradient boosting or AdaBoost without variable transformations.
+   Other methods and options (e.g. Fisher cuts, preselection cuts or transformations) are not
+   supported and ReadWeightFile returns false, such that they can still be evaluated with TMVA.
+
+   The inputs are the float values of the variables in the order of the weight file.
+*/
+class TmvaBdt {
+
+public:
+	/// Read the trees of a weight file. The variables need to match the variables of the file
+	/// in number and order (by expression or label). Returns false if the BDT cannot be evaluated.
+	bool ReadWeightFile(std::string const& weightFile, std::vector<std::string> const& variables);
+
+	size_t GetNVariables() const
+	{
+		return m_nVariables;
+	}
+
+	size_t GetNTrees() const
+	{
+		return m_roots.size();
+	}
+
+	double Evaluate(float const* inputs) const;
+
+	/// Evaluate nEvents sets of inputs (GetNVariables values each), looping over the trees in the
+	/// outer loop such that each tree is kept in the cache for all events.
+	void Evaluate(float const* inputs, size_t nEvents, double* outputs) const;
+
+private:
+	struct Node {
+		int variable; // -1 for leaves
+		float cut;
+		unsigned int next[2]; // next node for inputs below the cut and for inputs not below the cut
+		double value; // contribution of a leaf to the sum over the trees
+	};
+
+	// appends a node and its daughters to m_nodes and returns its index
+	unsigned int ReadNode(boost::property_tree::ptree const& node, double boostWeight, bool useYesNoLeaf);
+
+	double GetOutput(double sum) const
+	{
+		if (m_gradientBoost)
+		{
+			return 2.0 / (1.0 + std::exp(-2.0 * sum)) - 1.0;
+		}
+		return ((m_norm > std::numeric_limits<double>::epsilon()) ? sum / m_norm : 0.0);
+	}
+
+	size_t m_nVariables = 0;
+	bool m_gradientBoost = false;
+	double m_norm = 0.0;
+	std::vector<Node> m_nodes;
+	std::vector<unsigned int> m_roots;
+};
+
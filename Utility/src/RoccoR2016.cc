@@ -1,3 +1,4 @@
+#include <algorithm>
 #include <fstream>
 #include <sstream>
 #include <iostream>
@@ -8,9 +9,9 @@ const double CrystalBall2016::pi    = TMath::Pi();
 const double CrystalBall2016::SPiO2 = sqrt(TMath::Pi()/2.0);
 const double CrystalBall2016::S2    = sqrt(2.0);
 
+// first bin with x below its upper edge, the last bin otherwise
 int RocRes2016::getBin(double x, const int NN, const double *b) const{
-    for(int i=0; i<NN; ++i) if(x<b[i+1]) return i;
-    return NN-1;
+    return std::upper_bound(b+1, b+NN, x) - (b+1);
 }
 
 RocRes2016::RocRes2016(){
@@ -83,7 +84,7 @@ void RocRes2016::dumpParams(){
 	
 void RocRes2016::init(std::string filename){
     std::ifstream in(filename.c_str());
-    char tag[4];
+    std::string tag;
     int type, sys, mem, isdt, var, bin;	
     std::string s;
     while(std::getline(in, s)){
@@ -138,7 +139,10 @@ double RocRes2016::getUrnd(int H, int F, double w) const{
 }
 
 double RocRes2016::kSpread(double gpt, double rpt, double eta, int n, double w) const{
-    int     H = getBin(fabs(eta), NETA, BETA);
+    return kSpreadBin(gpt, rpt, getBin(fabs(eta), NETA, BETA), n, w);
+}
+
+double RocRes2016::kSpreadBin(double gpt, double rpt, int H, int n, double w) const{
     int     F = n>NMIN ? n-NMIN : 0;
     double  v = getUrnd(H, F, w);
     int     D = getBin(v, NTRK, dtrk[H]);
@@ -167,7 +171,10 @@ double RocRes2016::kSmear(double pt, double eta, TYPE type, double w, double u,
 }
 
 double RocRes2016::kExtra(double pt, double eta, int n, double u, double w) const{
-    int H = getBin(fabs(eta), NETA, BETA);
+    return kExtraBin(pt, getBin(fabs(eta), NETA, BETA), n, u, w);
+}
+
+double RocRes2016::kExtraBin(double pt, int H, int n, double u, double w) const{
     int F = n>NMIN ? n-NMIN : 0;
     double  v = ntrk[H][F]+(ntrk[H][F+1]-ntrk[H][F])*w;
     int     D = getBin(v, NTRK, dtrk[H]);
@@ -187,8 +194,7 @@ double RocRes2016::kExtra(double pt, double eta, int n, double u, double w) cons
 const double RocOne2016::MPHI=-TMath::Pi();
 
 int RocOne2016::getBin(double x, const int NN, const double *b) const{
-    for(int i=0; i<NN; ++i) if(x<b[i+1]) return i;
-    return NN-1;
+    return std::upper_bound(b+1, b+NN, x) - (b+1);
 }
 
 int RocOne2016::getBin(double x, const int nmax, const double xmin, const double dx) const{
@@ -238,6 +244,19 @@ void RocOne2016::reset(){
 	}
     }
     BETA[NMAXETA]=0;
+    fillScaleBins();
+}
+
+void RocOne2016::fillScaleBins(){
+    for(int T=0; T<2; ++T){
+	for(int H=0; H<NETA; ++H){
+	    for(int F=0; F<NPHI; ++F){
+		scaleBins[T][H*NPHI+F].m=M[T][H][F];
+		scaleBins[T][H*NPHI+F].a=A[T][H][F];
+		scaleBins[T][H*NPHI+F].d=D[T][H];
+	    }
+	}
+    }
 }
 
 void RocOne2016::init(std::string filename, int iTYPE, int iSYS, int iMEM){
@@ -247,7 +266,7 @@ void RocOne2016::init(std::string filename, int iTYPE, int iSYS, int iMEM){
     RR.init(filename);
 
     std::ifstream in(filename.c_str());
-    char tag[4];
+    std::string tag;
     int type, sys, mem, isdt, var, bin;	
 
     bool initialized=false;
@@ -284,6 +303,7 @@ void RocOne2016::init(std::string filename, int iTYPE, int iSYS, int iMEM){
     }
     if(!initialized) std::cout << "Problem with input file: " << filename << std::endl;
     in.close();
+    fillScaleBins();
 }
 
 double RocOne2016::kScaleDT(int Q, double pt, double eta, double phi) const{
@@ -324,6 +344,27 @@ double RocOne2016::kGenSmear(double pt, double eta, double v, double u, RocRes20
     return RR.kSmear(pt, eta, TT, v, u);
 }
 
+void RocOne2016::kScaleDT(const RocMuon2016 *muons, size_t nMuons, double *k) const{
+    for(size_t i=0; i<nMuons; ++i){
+	const ScaleBin &bin=scaleBins[DT][getBin(muons[i].eta, NETA, BETA)*NPHI + getBin(muons[i].phi, NPHI, MPHI, DPHI)];
+	k[i]=bin.d/(bin.m+muons[i].Q*bin.a*muons[i].pt);
+    }
+}
+
+void RocOne2016::kScaleAndSmearMC(const RocMuon2016 *muons, size_t nMuons, double *k) const{
+    // scale of all muons first, the resolution corrections are evaluated for the scaled pt
+    for(size_t i=0; i<nMuons; ++i){
+	const ScaleBin &bin=scaleBins[MC][getBin(muons[i].eta, NETA, BETA)*NPHI + getBin(muons[i].phi, NPHI, MPHI, DPHI)];
+	k[i]=bin.d/(bin.m+muons[i].Q*bin.a*muons[i].pt);
+    }
+    for(size_t i=0; i<nMuons; ++i){
+	const RocMuon2016 &mu=muons[i];
+	int H=RR.getEtaBin(fabs(mu.eta));
+	if(mu.genMatched) k[i]*=RR.kSpreadBin(mu.gt, k[i]*mu.pt, H, mu.n, mu.w);
+	else        k[i]*=RR.kExtraBin(k[i]*mu.pt, H, mu.n, mu.u, mu.w);
+    }
+}
+
 
 //-------------------------------------
 
@@ -384,3 +425,13 @@ double RoccoR2016::kScaleAndSmearMC(int Q, double pt, double eta, double phi, in
 double RoccoR2016::kScaleFromGenMC(int Q, double pt, double eta, double phi, int n, double gt, double w, int s, int m) const{
     return RC[s][m].kScaleFromGenMC(Q, pt, eta, phi, n, gt, w);
 }
+
+void RoccoR2016::kScaleDT(std::vector<RocMuon2016> const& muons, std::vector<double>& k, int s, int m) const{
+    k.resize(muons.size());
+    RC[s][m].kScaleDT(muons.data(), muons.size(), k.data());
+}
+
+void RoccoR2016::kScaleAndSmearMC(std::vector<RocMuon2016> const& muons, std::vector<double>& k, int s, int m) const{
+    k.resize(muons.size());
+    RC[s][m].kScaleAndSmearMC(muons.data(), muons.size(), k.data());
+}
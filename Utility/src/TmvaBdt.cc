@@ -0,0 +1,271 @@
+#include <algorithm>
+#include <sstream>
+#include <stdexcept>
+
+#include <boost/algorithm/string/case_conv.hpp>
+#include <boost/algorithm/string/erase.hpp>
+#include <boost/algorithm/string/predicate.hpp>
+#include <boost/algorithm/string/trim.hpp>
+#include <boost/property_tree/xml_parser.hpp>
+
+#include "Artus/Utility/interface/ArtusLogging.h"
+#include "Artus/Utility/interface/TmvaBdt.h"
+
+
+namespace
+{
+	// attributes are converted in the same way as by TMVA::Tools::ReadAttr
+	template<class T>
+	T ReadAttribute(boost::property_tree::ptree const& node, std::string const& name)
+	{
+		std::stringstream stream(node.get<std::string>("<xmlattr>." + name));
+		T value;
+		stream >> value;
+		if (stream.fail())
+		{
+			throw std::runtime_error("attribute " + name + " cannot be read");
+		}
+		return value;
+	}
+
+	bool ReadBoolOption(std::string const& value)
+	{
+		std::string lowerValue = boost::algorithm::to_lower_copy(boost::algorithm::trim_copy(value));
+		if ((lowerValue == "true") || (lowerValue == "t") || (lowerValue == "1"))
+		{
+			return true;
+		}
+		else if ((lowerValue == "false") || (lowerValue == "f") || (lowerValue == "0"))
+		{
+			return false;
+		}
+		throw std::runtime_error("boolean option " + value + " cannot be read");
+	}
+
+	// variables are declared as "expression" or "label := expression", TMVA compares the expressions
+	bool MatchesVariable(std::string const& variable, boost::property_tree::ptree const& variableNode)
+	{
+		size_t separator = variable.find(":=");
+		std::string expression = ((separator == std::string::npos) ? variable : variable.substr(separator + 2));
+		return (boost::algorithm::erase_all_copy(expression, " ") ==
+		        boost::algorithm::erase_all_copy(variableNode.get<std::string>("<xmlattr>.Expression"), " "));
+	}
+}
+
+
+bool TmvaBdt::ReadWeightFile(std::string const& weightFile, std::vector<std::string> const& variables)
+{
+	m_nVariables = 0;
+	m_gradientBoost = false;
+	m_norm = 0.0;
+	m_nodes.clear();
+	m_roots.clear();
+
+	try
+	{
+		boost::property_tree::ptree weights;
+		boost::property_tree::read_xml(weightFile, weights);
+		boost::property_tree::ptree const& methodSetup = weights.get_child("MethodSetup");
+
+		if (! boost::algorithm::starts_with(methodSetup.get<std::string>("<xmlattr>.Method"), "BDT::"))
+		{
+			throw std::runtime_error("method is not a BDT");
+		}
+
+		std::string boostType = "AdaBoost";
+		bool useYesNoLeaf = true;
+		for (boost::property_tree::ptree::value_type const& option : methodSetup.get_child("Options"))
+		{
+			if (option.first == "Option")
+			{
+				std::string name = option.second.get<std::string>("<xmlattr>.name");
+				if (name == "BoostType")
+				{
+					boostType = boost::algorithm::trim_copy(option.second.data());
+				}
+				else if (name == "UseYesNoLeaf")
+				{
+					useYesNoLeaf = ReadBoolOption(option.second.data());
+				}
+			}
+		}
+		if ((boostType != "Grad") && (boostType != "AdaBoost"))
+		{
+			throw std::runtime_error("boost type " + boostType + " is not supported");
+		}
+		m_gradientBoost = (boostType == "Grad");
+
+		for (boost::property_tree::ptree::value_type const& variable : methodSetup.get_child("Variables"))
+		{
+			if (variable.first == "Variable")
+			{
+				if ((m_nVariables >= variables.size()) || (! MatchesVariable(variables[m_nVariables], variable.second)))
+				{
+					throw std::runtime_error("variables do not match the variables of the weight file");
+				}
+				++m_nVariables;
+			}
+		}
+		if (m_nVariables != variables.size())
+		{
+			throw std::runtime_error("variables do not match the variables of the weight file");
+		}
+
+		if (methodSetup.get<int>("Transformations.<xmlattr>.NTransformations", 0) != 0)
+		{
+			throw std::runtime_error("variable transformations are not supported");
+		}
+
+		boost::property_tree::ptree const& forest = methodSetup.get_child("Weights");
+		if (forest.get<int>("<xmlattr>.AnalysisType", forest.get<int>("<xmlattr>.TreeType", 0)) != 0)
+		{
+			throw std::runtime_error("only classification is supported");
+		}
+
+		// TMVA stores the cuts of the option DoPreselection as attributes PreselectionLowBkgVar0 etc.
+		boost::optional<boost::property_tree::ptree const&> forestAttributes = forest.get_child_optional("<xmlattr>");
+		if (forestAttributes)
+		{
+			for (boost::property_tree::ptree::value_type const& attribute : *forestAttributes)
+			{
+				if (boost::algorithm::starts_with(attribute.first, "Preselection"))
+				{
+					throw std::runtime_error("preselection cuts are not supported");
+				}
+			}
+		}
+		for (boost::property_tree::ptree::value_type const& tree : forest)
+		{
+			if (tree.first == "BinaryTree")
+			{
+				double boostWeight = ReadAttribute<double>(tree.second, "boostWeight");
+				boost::property_tree::ptree const& root = tree.second.get_child("Node");
+				m_roots.push_back(ReadNode(root, boostWeight, useYesNoLeaf));
+				m_norm += boostWeight;
+			}
+		}
+		if (m_roots.empty())
+		{
+			throw std::runtime_error("no trees found");
+		}
+	}
+	catch (std::runtime_error const& error)
+	{
+		LOG(DEBUG) << "BDT of weight file " << weightFile << " cannot be evaluated without TMVA: " << error.what();
+		m_nVariables = 0;
+		m_nodes.clear();
+		m_roots.clear();
+		return false;
+	}
+	return true;
+}
+
+unsigned int TmvaBdt::ReadNode(boost::property_tree::ptree const& node, double boostWeight, bool useYesNoLeaf)
+{
+	unsigned int index = m_nodes.size();
+	m_nodes.push_back(Node());
+	int nodeType = ReadAttribute<int>(node, "nType");
+
+	if (nodeType != 0)
+	{
+		// leaf: TMVA sums the responses for gradient boosting and the weighted node types (or purities) otherwise
+		double value = 0.0;
+		if (m_gradientBoost)
+		{
+			value = ReadAttribute<float>(node, "res");
+		}
+		else
+		{
+			value = boostWeight * (useYesNoLeaf ? static_cast<double>(nodeType) : static_cast<double>(ReadAttribute<float>(node, "purity")));
+		}
+		m_nodes[index].variable = -1;
+		m_nodes[index].cut = 0.0f;
+		m_nodes[index].next[0] = index;
+		m_nodes[index].next[1] = index;
+		m_nodes[index].value = value;
+		return index;
+	}
+
+	if (node.get<int>("<xmlattr>.NCoef", 0) != 0)
+	{
+		throw std::runtime_error("Fisher cuts are not supported");
+	}
+	int variable = ReadAttribute<int>(node, "IVar");
+	if ((variable < 0) || (static_cast<size_t>(variable) >= m_nVariables))
+	{
+		throw std::runtime_error("node with invalid variable index");
+	}
+
+	boost::property_tree::ptree const* left = nullptr;
+	boost::property_tree::ptree const* right = nullptr;
+	for (boost::property_tree::ptree::value_type const& daughter : node)
+	{
+		if (daughter.first == "Node")
+		{
+			std::string position = daughter.second.get<std::string>("<xmlattr>.pos");
+			if (position == "l")
+			{
+				left = &daughter.second;
+			}
+			else if (position == "r")
+			{
+				right = &daughter.second;
+			}
+		}
+	}
+	if ((left == nullptr) || (right == nullptr))
+	{
+		throw std::runtime_error("intermediate node without two daughters");
+	}
+
+	// TMVA goes to the right daughter for inputs >= cut, inverted for cType 0
+	bool rightForInputsAboveCut = (ReadAttribute<int>(node, "cType") != 0);
+	unsigned int leftIndex = ReadNode(*left, boostWeight, useYesNoLeaf);
+	unsigned int rightIndex = ReadNode(*right, boostWeight, useYesNoLeaf);
+
+	m_nodes[index].variable = variable;
+	m_nodes[index].cut = ReadAttribute<float>(node, "Cut");
+	m_nodes[index].next[0] = (rightForInputsAboveCut ? leftIndex : rightIndex);
+	m_nodes[index].next[1] = (rightForInputsAboveCut ? rightIndex : leftIndex);
+	m_nodes[index].value = 0.0;
+	return index;
+}
+
+double TmvaBdt::Evaluate(float const* inputs) const
+{
+	double sum = 0.0;
+	for (unsigned int root : m_roots)
+	{
+		unsigned int index = root;
+		while (m_nodes[index].variable >= 0)
+		{
+			Node const& node = m_nodes[index];
+			index = node.next[inputs[node.variable] >= node.cut];
+		}
+		sum += m_nodes[index].value;
+	}
+	return GetOutput(sum);
+}
+
+void TmvaBdt::Evaluate(float const* inputs, size_t nEvents, double* outputs) const
+{
+	std::fill(outputs, outputs + nEvents, 0.0);
+	for (unsigned int root : m_roots)
+	{
+		for (size_t event = 0; event < nEvents; ++event)
+		{
+			float const* eventInputs = inputs + (event * m_nVariables);
+			unsigned int index = root;
+			while (m_nodes[index].variable >= 0)
+			{
+				Node const& node = m_nodes[index];
+				index = node.next[eventInputs[node.variable] >= node.cut];
+			}
+			outputs[event] += m_nodes[index].value;
+		}
+	}
+	for (size_t event = 0; event < nEvents; ++event)
+	{
+		outputs[event] = GetOutput(outputs[event]);
+	}
+}